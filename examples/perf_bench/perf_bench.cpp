@@ -0,0 +1,959 @@
+// perf_bench — synthetic throughput benchmarks for the backtest engines.
+//
+// Usage: perf_bench [section ...]   (no arguments = run every section)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/Covariance.hpp"
+#include "core/CpuFeatures.hpp"
+#include "core/Parallel.hpp"
+#include "domain/Instrument.hpp"
+#include "domain/backtest/BarPanel.hpp"
+#include "domain/backtest/Engine.hpp"
+#include "domain/backtest/EventScheduler.hpp"
+#include "domain/backtest/MonteCarlo.hpp"
+#include "domain/backtest/Optimizer.hpp"
+#include "domain/backtest/OrderBook.hpp"
+#include "domain/backtest/PortfolioEngine.hpp"
+#include "domain/backtest/RebalanceEngine.hpp"
+#include "domain/backtest/SeriesJoin.hpp"
+#include "domain/backtest/SweepRunner.hpp"
+#include "domain/backtest/WarmupCache.hpp"
+#include "domain/backtest/WalkForward.hpp"
+#include "strategy/CrossSectionalMomentum.hpp"
+#include "strategy/EqualWeight.hpp"
+#include "strategy/MACrossover.hpp"
+#include "strategy/Ranker.hpp"
+#include "strategy/StateBlob.hpp"
+#include "strategy/indicators/ColumnKernels.hpp"
+#include "strategy/indicators/IndicatorCache.hpp"
+#include "strategy/indicators/Indicators.hpp"
+#include "strategy/rules/Rule.hpp"
+
+using namespace qga;
+using namespace qga::domain::backtest;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point t0)
+    {
+        return std::chrono::duration<double>(Clock::now() - t0).count();
+    }
+
+    /// Deterministic geometric random walks, one series per symbol.
+    std::vector<BarSeries> makeUniverse(std::size_t symbols, std::size_t bars,
+                                        std::uint64_t seed = 7)
+    {
+        std::vector<BarSeries> out(symbols);
+        std::uint64_t state = seed;
+        for (std::size_t s = 0; s < symbols; ++s)
+        {
+            double px = 20.0 + static_cast<double>(s % 200);
+            for (std::size_t i = 0; i < bars; ++i)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                px *= 1.0 + (static_cast<double>(state >> 40) / double(1ULL << 24) - 0.5) * 0.02;
+                const auto TS = static_cast<std::int64_t>(i) * 86'400'000;
+                out[s].add({TS, px, px * 1.01, px * 0.99, px, 1.0e6});
+            }
+        }
+        return out;
+    }
+
+    std::vector<domain::Instrument> makeInstruments(std::size_t symbols)
+    {
+        std::vector<domain::Instrument> out;
+        out.reserve(symbols);
+        for (std::size_t s = 0; s < symbols; ++s)
+            out.emplace_back("S" + std::to_string(s), domain::AssetClass::Equity, "XNAS");
+        return out;
+    }
+
+    // ------------------------------------------------------------
+    // portfolio: multi-asset engine vs. independent single-asset runs
+    // ------------------------------------------------------------
+    void benchPortfolio()
+    {
+        constexpr std::size_t SYMBOLS = 500;
+        constexpr std::size_t BARS = 2520; // ~10 years of daily bars
+        const auto UNIVERSE = makeUniverse(SYMBOLS, BARS);
+        const BarPanel PANEL{UNIVERSE};
+        const auto INSTRUMENTS = makeInstruments(SYMBOLS);
+        const double CELLS = static_cast<double>(SYMBOLS * BARS);
+
+        auto t0 = Clock::now();
+        double sink = 0.0;
+        for (const auto& s : UNIVERSE)
+        {
+            strategy::MACrossover ma{10, 50};
+            sink += Engine{10'000.0}.run(s, ma).final_equity_;
+        }
+        const double SINGLE = secondsSince(t0);
+
+        t0 = Clock::now();
+        const auto RES = PortfolioEngine{1.0e6}.run(
+            PANEL, INSTRUMENTS,
+            [](std::size_t) { return std::make_unique<strategy::MACrossover>(10, 50); });
+        const double MULTI = secondsSince(t0);
+
+        std::printf("[portfolio] %zu symbols x %zu bars\n", SYMBOLS, BARS);
+        std::printf("  single-asset loop : %8.2f ns/bar\n", SINGLE * 1e9 / CELLS);
+        std::printf("  portfolio engine  : %8.2f ns/bar  (%zu trades, ratio %.2fx)\n",
+                    MULTI * 1e9 / CELLS, RES.trades_.size(), MULTI / SINGLE);
+        (void) sink;
+    }
+
+    // ------------------------------------------------------------
+    // events: k-way merge throughput as the universe grows
+    // ------------------------------------------------------------
+    void benchEvents()
+    {
+        constexpr std::size_t EVENT_BUDGET = 2'000'000;
+        std::printf("[events] k-way merge, ~%zu events per universe, staggered calendars\n",
+                    EVENT_BUDGET);
+        for (const std::size_t SYMBOLS : {1, 10, 100, 1000, 5000})
+        {
+            const std::size_t BARS = EVENT_BUDGET / SYMBOLS;
+            auto universe = makeUniverse(SYMBOLS, BARS);
+            // Drop roughly one bar in four per symbol so calendars differ.
+            std::uint64_t state = 11;
+            for (auto& s : universe)
+            {
+                BarSeries thinned;
+                for (const auto& q : s.data())
+                {
+                    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                    if ((state >> 62) != 0)
+                        thinned.add(q);
+                }
+                s = std::move(thinned);
+            }
+
+            EventScheduler sched{universe};
+            double sink = 0.0;
+            std::size_t batches = 0;
+            const auto T0 = Clock::now();
+            const std::size_t EVENTS = sched.run(
+                [&](std::int64_t, std::span<const domain::BarEvent> batch)
+                {
+                    ++batches;
+                    for (const auto& e : batch)
+                        sink += e.bar_->close_;
+                });
+            const double SECS = secondsSince(T0);
+            std::printf(
+                "  %5zu symbols : %9zu events in %7zu batches  %8.2f M events/s  %6.2f ns/event\n",
+                SYMBOLS, EVENTS, batches, EVENTS / SECS / 1e6, SECS * 1e9 / EVENTS);
+            (void) sink;
+        }
+    }
+
+    // ------------------------------------------------------------
+    // orderbook: per-bar matching cost vs. number of resting orders
+    // ------------------------------------------------------------
+    void benchOrderBook()
+    {
+        constexpr std::size_t BARS = 1'000'000;
+        constexpr double MID = 100.0;
+        // Bars oscillating within +-5% of MID, so the book's levels never trigger.
+        std::vector<domain::Quote> bars;
+        bars.reserve(BARS);
+        std::uint64_t state = 3;
+        for (std::size_t i = 0; i < BARS; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const double PX =
+                MID * (1.0 + (static_cast<double>(state >> 40) / double(1ULL << 24) - 0.5) * 0.08);
+            bars.push_back({static_cast<std::int64_t>(i), PX, PX * 1.005, PX * 0.995, PX, 1.0e6});
+        }
+        const domain::Instrument INS{"S0", domain::AssetClass::Equity, "XNAS"};
+
+        std::printf("[orderbook] %zu bars, resting orders 20-30%% away from the market\n", BARS);
+        for (const std::size_t RESTING : {100, 10'000, 1'000'000})
+        {
+            OrderBook book;
+            const auto SLOT = book.slotFor(INS);
+            for (std::size_t i = 0; i < RESTING; ++i)
+            {
+                const double OFF = 0.2 + static_cast<double>(i % 1000) * 1e-4;
+                const double BELOW = MID * (1.0 - OFF);
+                const double ABOVE = MID * (1.0 + OFF);
+                if (i % 2 == 0)
+                {
+                    book.submit(Order{INS, Side::Buy, 1.0, OrderType::Limit, BELOW, 0.0});
+                    book.submit(Order{INS, Side::Sell, 1.0, OrderType::Limit, ABOVE, 0.0});
+                }
+                else
+                {
+                    book.submit(Order{INS, Side::Buy, 1.0, OrderType::Stop, 0.0, ABOVE});
+                    book.submit(Order{INS, Side::Sell, 1.0, OrderType::Stop, 0.0, BELOW});
+                }
+            }
+
+            std::vector<Fill> fills;
+            fills.reserve(1024);
+            std::size_t filled = 0;
+            const auto T0 = Clock::now();
+            for (const auto& q : bars)
+            {
+                book.onBar(SLOT, q, fills);
+                filled += fills.size();
+                fills.clear();
+            }
+            const double SECS = secondsSince(T0);
+            std::printf("  %9zu resting : %7.2f ns/bar  (%zu filled)\n", 2 * RESTING,
+                        SECS * 1e9 / BARS, filled);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // walkforward: rolling folds x parameter grid, serial vs. parallel
+    // ------------------------------------------------------------
+    void benchWalkForward()
+    {
+        constexpr std::size_t BARS = 500'000;
+        constexpr std::int64_t DAY = 86'400'000;
+        const auto SERIES = makeUniverse(1, BARS);
+        const std::vector<std::pair<int, int>> GRID = []
+        {
+            std::vector<std::pair<int, int>> g;
+            for (int f : {5, 10, 20, 30})
+                for (int s : {50, 100, 150, 200, 250, 300})
+                    g.emplace_back(f, s);
+            return g;
+        }();
+        const auto MAKE = [&](std::size_t p)
+        { return std::make_unique<strategy::MACrossover>(GRID[p].first, GRID[p].second); };
+
+        std::printf("[walkforward] %zu bars, %zu parameter sets, rolling 5000/1000-bar folds\n",
+                    BARS, GRID.size());
+        std::vector<std::size_t> thread_counts{1};
+        if (core::defaultThreads() > 1)
+            thread_counts.push_back(core::defaultThreads());
+        double serial = 0.0;
+        for (const std::size_t THREADS : thread_counts)
+        {
+            const WalkForward WF{
+                10'000.0,
+                {},
+                WalkForwardParams{5000 * DAY, 1000 * DAY, WindowMode::Rolling, THREADS}};
+            const auto T0 = Clock::now();
+            const auto RES = WF.run(SERIES[0], GRID.size(), MAKE);
+            const double SECS = secondsSince(T0);
+            if (THREADS == 1)
+                serial = SECS;
+            std::printf(
+                "  %2zu thread(s) : %7.3f s  (%zu folds, final OOS equity %.2f, speed-up %.2fx)\n",
+                THREADS, SECS, RES.folds_.size(), RES.oos_equity_.back(), serial / SECS);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // montecarlo: 100k bootstrap paths over ~10 years of daily returns
+    // ------------------------------------------------------------
+    void benchMonteCarlo()
+    {
+        constexpr std::size_t BARS = 2520;
+        const auto SERIES = makeUniverse(1, BARS + 1);
+        std::vector<double> closes;
+        for (const auto& q : SERIES[0].data())
+            closes.push_back(q.close_);
+        const auto RETURNS = MonteCarlo::returnsFromEquity(closes);
+
+        MonteCarloParams p;
+        p.paths_ = 100'000;
+        for (const auto METHOD : {ResampleMethod::BlockBootstrap, ResampleMethod::TradeShuffle})
+        {
+            p.method_ = METHOD;
+            const auto T0 = Clock::now();
+            const auto RES = MonteCarlo{p}.run(RETURNS);
+            const double SECS = secondsSince(T0);
+            std::printf("[montecarlo] %-15s %zu paths x %zu returns: %6.3f s (%zu threads)  "
+                        "MDD p5/p50/p95 = %.3f/%.3f/%.3f\n",
+                        METHOD == ResampleMethod::BlockBootstrap ? "block-bootstrap"
+                                                                 : "trade-shuffle",
+                        p.paths_, RETURNS.size(), SECS, core::defaultThreads(),
+                        RES.max_drawdown_.quantile(0.05), RES.max_drawdown_.quantile(0.5),
+                        RES.max_drawdown_.quantile(0.95));
+        }
+    }
+
+    // ------------------------------------------------------------
+    // optimizer: exhaustive grid vs. successive halving vs. evolution
+    // ------------------------------------------------------------
+    void benchOptimizer()
+    {
+        constexpr std::size_t BARS = 20'000;
+        const auto SERIES = makeUniverse(1, BARS);
+        const ParamSpace SPACE{{"fast", 2, 60, 1}, {"slow", 20, 300, 5}};
+        const ParamStrategyFactory MAKE = [](const ParamSet& p)
+        { return std::make_unique<strategy::MACrossover>(p[0], p[1]); };
+
+        auto t0 = Clock::now();
+        double grid_best = -1e300;
+        std::size_t grid_runs = 0;
+        for (int f = SPACE[0].min_; f <= SPACE[0].max_; f += SPACE[0].step_)
+            for (int sl = SPACE[1].min_; sl <= SPACE[1].max_; sl += SPACE[1].step_)
+            {
+                strategy::MACrossover ma{f, sl};
+                grid_best = std::max(grid_best, Engine{10'000.0}.run(SERIES[0], ma).final_equity_);
+                ++grid_runs;
+            }
+        const double GRID_SECS = secondsSince(t0);
+
+        std::printf("[optimizer] MA crossover, %zu bars, %zu-point grid\n", BARS, grid_runs);
+        std::printf("  exhaustive grid     : %7.3f s  %7.1f full runs  best %.2f\n", GRID_SECS,
+                    static_cast<double>(grid_runs), grid_best);
+
+        const auto REPORT = [&](const char* name, const OptimizerResult& r, double secs)
+        {
+            std::printf("  %-19s : %7.3f s  %7.1f full runs  best %.2f  (%zux fewer full runs)\n",
+                        name, secs, r.full_runs_, r.best_score_,
+                        static_cast<std::size_t>(grid_runs / r.full_runs_));
+        };
+
+        t0 = Clock::now();
+        const auto SH =
+            SuccessiveHalving{10'000.0, {}, HalvingParams{30.0}}.run(SERIES[0], SPACE, MAKE);
+        REPORT("successive halving", SH, secondsSince(t0));
+
+        t0 = Clock::now();
+        const auto EVO =
+            EvolutionarySearch{10'000.0, {}, EvolutionParams{150}}.run(SERIES[0], SPACE, MAKE);
+        REPORT("evolutionary search", EVO, secondsSince(t0));
+    }
+
+    // ------------------------------------------------------------
+    // rebalance: target-weight engine, 500 names x 20 years daily
+    // ------------------------------------------------------------
+    void benchRebalance()
+    {
+        constexpr std::size_t SYMBOLS = 500;
+        constexpr std::size_t BARS = 5040;
+        const auto UNIVERSE = makeUniverse(SYMBOLS, BARS);
+        const BarPanel PANEL{UNIVERSE};
+        std::printf("[rebalance] equal weight, %zu symbols x %zu bars\n", SYMBOLS, BARS);
+        for (const std::size_t PERIOD : {1u, 21u})
+        {
+            strategy::EqualWeight ew{PERIOD};
+            const auto T0 = Clock::now();
+            const auto RES = RebalanceEngine{1.0e6, ExecParams{0.0, 1.0, 2.0}}.run(PANEL, ew);
+            const double SECS = secondsSince(T0);
+            std::printf("  every %2zu rows : %7.3f s  %6.2f ns/cell  %zu trades  turnover %.1f\n",
+                        PERIOD, SECS, SECS * 1e9 / double(SYMBOLS * BARS),
+                        static_cast<std::size_t>(RES.summary_.trades_executed_), RES.turnover_);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // ranking: cross-sectional top-k / bottom-k, 500 names x 20 years daily
+    // ------------------------------------------------------------
+    void benchRanking()
+    {
+        constexpr std::size_t SYMBOLS = 500;
+        constexpr std::size_t BARS = 5040;
+        constexpr std::size_t K = 50;
+        const auto UNIVERSE = makeUniverse(SYMBOLS, BARS);
+        const BarPanel PANEL{UNIVERSE};
+        std::printf("[ranking] momentum top/bottom %zu, %zu symbols x %zu bars\n", K, SYMBOLS,
+                    BARS);
+
+        // Selection kernel alone: nth_element on reused buffers vs a full sort per row.
+        std::vector<double> scores(SYMBOLS);
+        const auto SCORE_ROW = [&](std::size_t t)
+        {
+            const double* now = PANEL.closeRow(t);
+            const double* then = PANEL.closeRow(t - 252);
+            for (std::size_t s = 0; s < SYMBOLS; ++s)
+                scores[s] = now[s] / then[s] - 1.0;
+        };
+        strategy::Ranker ranker;
+        std::size_t sink = 0;
+        auto t0 = Clock::now();
+        for (std::size_t t = 252; t < BARS; ++t)
+        {
+            SCORE_ROW(t);
+            sink += ranker.top(scores, K)[0] + ranker.bottom(scores, K)[0];
+        }
+        const double SELECT = secondsSince(t0);
+        std::vector<std::uint32_t> order(SYMBOLS);
+        t0 = Clock::now();
+        for (std::size_t t = 252; t < BARS; ++t)
+        {
+            SCORE_ROW(t);
+            std::iota(order.begin(), order.end(), 0u);
+            std::sort(order.begin(), order.end(),
+                      [&](std::uint32_t a, std::uint32_t b) { return scores[a] > scores[b]; });
+            sink += order[0] + order[SYMBOLS - 1];
+        }
+        const double SORT = secondsSince(t0);
+        std::printf("  select (nth_element): %7.3f s  %6.2f us/row\n", SELECT,
+                    SELECT * 1e6 / double(BARS - 252));
+        std::printf("  select (full sort)  : %7.3f s  %6.2f us/row  (sink %zu)\n", SORT,
+                    SORT * 1e6 / double(BARS - 252), sink);
+
+        const RebalanceEngine ENGINE{1.0e6, ExecParams{0.0, 1.0, 2.0}};
+        for (const std::size_t THREADS : {std::size_t{1}, core::defaultThreads()})
+        {
+            strategy::CrossSectionalMomentum mom{252, K, K, 1};
+            t0 = Clock::now();
+            const auto RES = ENGINE.run(PANEL, mom, THREADS);
+            std::printf(
+                "  daily rebalance, %2zu thread(s): %7.3f s  %zu rebalances  final equity %.0f\n",
+                THREADS, secondsSince(t0), RES.rebalances_, RES.summary_.final_equity_);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // covariance: blocked vs naive cross-products, rolling updates
+    // ------------------------------------------------------------
+    void benchCovariance()
+    {
+        constexpr std::size_t BARS = 1261; // five years of daily returns
+        for (const std::size_t SYMBOLS : {std::size_t{500}, std::size_t{2000}})
+        {
+            const auto UNIVERSE = makeUniverse(SYMBOLS, BARS);
+            const BarPanel PANEL{UNIVERSE};
+            const auto RETURNS = PANEL.returns();
+            const std::size_t ROWS = BARS - 1;
+            const std::size_t STRIDE = PANEL.stride();
+            std::printf("[covariance] %zu symbols x %zu returns (%s)\n", SYMBOLS, ROWS,
+                        core::toString(core::activeSimdLevel()));
+
+            if (SYMBOLS <= 500)
+            {
+                // Baseline: centred two-pass upper triangle, one dot product per pair.
+                auto t0 = Clock::now();
+                std::vector<double> mean(SYMBOLS, 0.0);
+                for (std::size_t t = 0; t < ROWS; ++t)
+                    for (std::size_t s = 0; s < SYMBOLS; ++s)
+                        mean[s] += RETURNS[t * STRIDE + s] / double(ROWS);
+                double sink = 0.0;
+                for (std::size_t i = 0; i < SYMBOLS; ++i)
+                    for (std::size_t j = i; j < SYMBOLS; ++j)
+                    {
+                        double acc = 0.0;
+                        for (std::size_t t = 0; t < ROWS; ++t)
+                            acc += (RETURNS[t * STRIDE + i] - mean[i])
+                                   * (RETURNS[t * STRIDE + j] - mean[j]);
+                        sink += acc;
+                    }
+                std::printf("  naive pairs          : %7.3f s  (sink %.3g)\n", secondsSince(t0),
+                            sink);
+            }
+            for (const auto LEVEL : {core::SimdLevel::Scalar, core::activeSimdLevel()})
+                for (const std::size_t THREADS : {std::size_t{1}, core::defaultThreads()})
+                {
+                    const auto T0 = Clock::now();
+                    const auto COV =
+                        core::stats::covariance(RETURNS, SYMBOLS, STRIDE, {THREADS, LEVEL});
+                    const double SECS = secondsSince(T0);
+                    std::printf("  blocked %-7s %2zu th : %7.3f s  %6.2f GFLOP/s  (c01 %.3g)\n",
+                                core::toString(core::clampSimdLevel(LEVEL)), THREADS, SECS,
+                                double(SYMBOLS) * double(SYMBOLS + 1) * double(ROWS) / SECS * 1e-9,
+                                COV(0, 1));
+                }
+            auto t0 = Clock::now();
+            const auto LW = core::stats::ledoitWolf(RETURNS, SYMBOLS, STRIDE);
+            std::printf("  ledoit-wolf          : %7.3f s  intensity %.3f\n", secondsSince(t0),
+                        LW.intensity_);
+
+            // Rolling 252-row window: one O(N^2) update per row (rebases included).
+            core::stats::RollingCovariance roll{SYMBOLS, 252};
+            t0 = Clock::now();
+            for (std::size_t t = 0; t < ROWS; ++t)
+                roll.push(std::span<const double>(RETURNS.data() + t * STRIDE, SYMBOLS));
+            const double ROLL = secondsSince(t0);
+            std::printf("  rolling push (252)   : %7.3f s  %8.1f us/row  (c01 %.3g)\n", ROLL,
+                        ROLL * 1e6 / double(ROWS), roll.covariance()(0, 1));
+        }
+    }
+
+    // ------------------------------------------------------------
+    // join: pairwise timestamp alignment across a gappy minute universe
+    // ------------------------------------------------------------
+    void benchJoin()
+    {
+        constexpr std::size_t SYMBOLS = 60;
+        constexpr std::size_t BARS = 20'000;
+        std::vector<BarSeries> universe(SYMBOLS);
+        std::vector<std::vector<std::int64_t>> clocks(SYMBOLS);
+        std::uint64_t state = 3;
+        for (std::size_t s = 0; s < SYMBOLS; ++s)
+        {
+            std::int64_t ts = 0;
+            for (std::size_t i = 0; i < BARS; ++i)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                ts += static_cast<std::int64_t>(1 + (state >> 40) % 3) * 60'000; // irregular gaps
+                universe[s].add({ts, 10.0, 10.0, 10.0, 10.0, 1.0});
+                clocks[s].push_back(ts);
+            }
+        }
+        std::vector<SeriesPair> pairs;
+        for (std::size_t a = 0; a < SYMBOLS; ++a)
+            for (std::size_t b = a + 1; b < SYMBOLS; ++b)
+                pairs.push_back({a, b});
+        std::printf("[join] %zu pairs of %zu-bar minute series with random gaps\n", pairs.size(),
+                    BARS);
+
+        // Baseline: textbook if/else merge over the same timestamp columns.
+        auto t0 = Clock::now();
+        std::size_t matched = 0;
+        std::vector<std::uint32_t> li, ri;
+        for (const auto& p : pairs)
+        {
+            const auto& L = clocks[p.left_];
+            const auto& R = clocks[p.right_];
+            li.clear();
+            ri.clear();
+            std::size_t i = 0, j = 0;
+            while (i < L.size() && j < R.size())
+            {
+                if (L[i] < R[j])
+                    ++i;
+                else if (R[j] < L[i])
+                    ++j;
+                else
+                {
+                    li.push_back(static_cast<std::uint32_t>(i++));
+                    ri.push_back(static_cast<std::uint32_t>(j));
+                }
+            }
+            matched += li.size();
+        }
+        const double BRANCHY = secondsSince(t0);
+        t0 = Clock::now();
+        std::size_t check = 0;
+        for (const auto& p : pairs)
+            check += joinTimestamps(clocks[p.left_], clocks[p.right_]).size();
+        const double BRANCHLESS = secondsSince(t0);
+        std::printf("  inner, if/else merge : %7.3f s  %5.2f ns/row  (%zu matches)\n", BRANCHY,
+                    BRANCHY * 1e9 / double(2 * BARS * pairs.size()), matched);
+        std::printf("  inner, branchless    : %7.3f s  %5.2f ns/row  (%zu matches)\n", BRANCHLESS,
+                    BRANCHLESS * 1e9 / double(2 * BARS * pairs.size()), check);
+
+        for (const std::size_t THREADS : {std::size_t{1}, core::defaultThreads()})
+            for (const JoinOptions OPT :
+                 {JoinOptions{JoinKind::Inner}, JoinOptions{JoinKind::AsOf, 120'000}})
+            {
+                t0 = Clock::now();
+                const auto ALL = joinPairs(universe, pairs, OPT, THREADS);
+                std::printf("  joinPairs %-5s %2zu th : %7.3f s  (%zu rows in pair 0)\n",
+                            OPT.kind_ == JoinKind::Inner ? "inner" : "asof", THREADS,
+                            secondsSince(t0), ALL[0].size());
+            }
+
+        // Daily signals against minute bars: the search path.
+        std::vector<std::int64_t> daily;
+        for (std::int64_t d = 0; d < clocks[0].back(); d += 86'400'000)
+            daily.push_back(d);
+        t0 = Clock::now();
+        for (std::size_t s = 0; s < SYMBOLS; ++s)
+            check += joinTimestamps(daily, clocks[s], {JoinKind::AsOf}).size();
+        std::printf("  asof daily x minute  : %7.3f s  for %zu symbols  (sink %zu)\n",
+                    secondsSince(t0), SYMBOLS, check);
+    }
+
+    // ------------------------------------------------------------
+    // sweep: early termination of runs trailing the best at a checkpoint
+    // ------------------------------------------------------------
+    void benchSweep()
+    {
+        constexpr std::size_t BARS = 20'000;
+        const auto SERIES = makeUniverse(1, BARS);
+        std::vector<std::pair<int, int>> grid;
+        for (int f = 2; f <= 60; ++f)
+            for (int sl = 20; sl <= 300; sl += 5)
+                grid.emplace_back(f, sl);
+        const auto MAKE = [&](std::size_t i)
+        { return std::make_unique<strategy::MACrossover>(grid[i].first, grid[i].second); };
+
+        std::printf("[sweep] MA crossover, %zu bars, %zu candidates, checkpoint at 25%%\n", BARS,
+                    grid.size());
+        for (const double BEHIND : {0.0, 20.0, 5.0})
+        {
+            SweepParams sp;
+            sp.rules_.checkpoint_bar_ = BARS / 4;
+            sp.behind_best_ = BEHIND;
+            const auto T0 = Clock::now();
+            const auto RES = SweepRunner{10'000.0, {}, sp}.run(SERIES[0].data(), grid.size(), MAKE);
+            const double SECS = secondsSince(T0);
+            std::printf("  behind-best %5.1f : %7.3f s  %5zu aborted  %5.1f%% of bars  best %.2f\n",
+                        BEHIND, SECS, RES.aborted_,
+                        100.0 * RES.bars_processed_ / double(BARS * grid.size()),
+                        RES.best_ ? RES.results_[*RES.best_].final_equity_ : 0.0);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // columns: whole-history indicator kernels per SIMD level
+    // ------------------------------------------------------------
+    void benchColumns()
+    {
+        namespace col = strategy::indicators::columns;
+        constexpr std::size_t N = 5'000'000;
+        constexpr std::size_t P = 50;
+        const auto SERIES = makeUniverse(1, N);
+        std::vector<double> closes;
+        closes.reserve(N);
+        for (const auto& q : SERIES[0].data())
+            closes.push_back(q.close_);
+        std::vector<double> out(N), fast(N);
+        std::vector<strategy::Signal> signals(N);
+        std::printf("[columns] %zu values, period %zu (ns per value)\n", N, P);
+
+        const auto NS = [&](auto&& fn)
+        {
+            const auto T0 = Clock::now();
+            fn();
+            return 1e9 * secondsSince(T0) / double(N);
+        };
+        strategy::indicators::Sma sma{P};
+        strategy::indicators::RollingStdDev sd{P};
+        strategy::indicators::RollingMax mx{P};
+        const auto STREAMED = [&](auto& ind)
+        {
+            return NS(
+                [&]
+                {
+                    ind.reset();
+                    for (std::size_t i = 0; i < N; ++i)
+                        out[i] = ind.update(closes[i]);
+                });
+        };
+        std::printf("  %-9s: sma %5.2f  stddev %5.2f  max %5.2f\n", "streaming", STREAMED(sma),
+                    STREAMED(sd), STREAMED(mx));
+
+        for (const auto LEVEL :
+             {core::SimdLevel::Scalar, core::SimdLevel::Avx2, core::SimdLevel::Avx512})
+        {
+            if (core::clampSimdLevel(LEVEL) != LEVEL)
+                continue;
+            col::sma(closes, 10, fast, LEVEL);
+            std::printf("  %-9s: sma %5.2f  stddev %5.2f  max %5.2f  ema %5.2f  min %5.2f  "
+                        "crossover %5.2f\n",
+                        core::toString(LEVEL), NS([&] { col::sma(closes, P, out, LEVEL); }),
+                        NS([&] { col::rollingStdDev(closes, P, out, LEVEL); }),
+                        NS([&] { col::rollingMax(closes, P, out, LEVEL); }),
+                        NS([&] { col::ema(closes, P, out, LEVEL); }),
+                        NS([&] { col::rollingMin(closes, P, out, LEVEL); }),
+                        NS([&] { col::crossover(fast, out, signals, LEVEL); }));
+        }
+    }
+
+    // ------------------------------------------------------------
+    // engine: single-asset loop cost per capture level, with counters
+    // ------------------------------------------------------------
+    void benchEngine()
+    {
+        constexpr std::size_t BARS = 2'000'000;
+        const auto SERIES = makeUniverse(1, BARS);
+        std::printf("[engine] MA crossover (10/50), %zu bars\n", BARS);
+
+        const auto RUN = [&](const char* label, CaptureLevel level, EngineCounters* counters)
+        {
+            strategy::MACrossover ma{10, 50};
+            const auto T0 = Clock::now();
+            const auto R = Engine{10'000.0}.run(SERIES[0], ma, level, counters);
+            std::printf("  %-18s: %6.1f ns/bar  final %.2f\n", label,
+                        1e9 * secondsSince(T0) / double(BARS), R.final_equity_);
+        };
+        RUN("capture none", CaptureLevel::None, nullptr);
+        RUN("capture summary", CaptureLevel::Summary, nullptr);
+        RUN("capture full", CaptureLevel::Full, nullptr);
+
+        EngineCounters c;
+        RUN("with counters", CaptureLevel::None, &c);
+        std::printf("  counters          : %6.1f ns/bar  onBar %.1f%%  signals %zu  fills %zu\n",
+                    c.nsPerBar(), 100.0 * c.strategyShare(), c.signals_, c.fills_);
+    }
+
+    // ------------------------------------------------------------
+    // warmup: rolling test windows, cold warm-up vs. cached snapshots
+    // ------------------------------------------------------------
+    void benchWarmup()
+    {
+        constexpr std::size_t BARS = 200'000;
+        constexpr std::size_t WINDOW = 5'000;
+        const auto SERIES = makeUniverse(1, BARS);
+        const auto ALL = std::span<const domain::Quote>{SERIES[0].data()};
+        std::printf("[warmup] MA crossover (10/200), %zu bars, %zu windows of %zu bars\n", BARS,
+                    BARS / WINDOW - 1, WINDOW);
+
+        // Cold: every window replays its whole history to warm the indicators up.
+        auto t0 = Clock::now();
+        double cold_sum = 0.0;
+        for (std::size_t b = WINDOW; b + WINDOW <= BARS; b += WINDOW)
+        {
+            strategy::MACrossover warm{10, 200};
+            warm.onStart();
+            for (std::size_t i = 0; i < b; ++i)
+                (void) warm.onBar(ALL[i]);
+            strategy::StateWriter out;
+            warm.saveState(out);
+            const auto STATE = out.release();
+            strategy::MACrossover ma{10, 200};
+            cold_sum += Engine{10'000.0}.runFrom(ALL.subspan(b, WINDOW), ma, STATE).final_equity_;
+        }
+        std::printf("  cold warm-up   : %7.3f s\n", secondsSince(t0));
+
+        t0 = Clock::now();
+        WarmupCache cache;
+        const WarmupKey KEY{"MACrossover", {10.0, 200.0}, seriesFingerprint(ALL)};
+        double cached_sum = 0.0;
+        for (std::size_t b = WINDOW; b + WINDOW <= BARS; b += WINDOW)
+        {
+            strategy::MACrossover scratch{10, 200}, ma{10, 200};
+            const auto STATE = cache.state(KEY, ALL, ALL[b].ts_, scratch);
+            cached_sum +=
+                Engine{10'000.0}.runFrom(ALL.subspan(b, WINDOW), ma, *STATE).final_equity_;
+        }
+        std::printf("  warmup cache   : %7.3f s  (%zu bars fed, same result: %s)\n",
+                    secondsSince(t0), cache.stats().bars_fed_,
+                    cold_sum == cached_sum ? "yes" : "no");
+    }
+
+    // ------------------------------------------------------------
+    // indicators: per-update cost of the streaming indicators
+    // ------------------------------------------------------------
+    void benchIndicators()
+    {
+        constexpr std::size_t N = 5'000'000;
+        constexpr std::size_t P = 50;
+        const auto SERIES = makeUniverse(1, N);
+        std::vector<double> closes;
+        closes.reserve(N);
+        for (const auto& q : SERIES[0].data())
+            closes.push_back(q.close_);
+        std::printf("[indicators] %zu updates, period %zu\n", N, P);
+
+        const auto TIME = [&](const char* label, auto&& ind)
+        {
+            ind.reset();
+            double sink = 0.0;
+            const auto T0 = Clock::now();
+            for (const double X : closes)
+            {
+                const double V = ind.update(X);
+                sink += std::isnan(V) ? 0.0 : V;
+            }
+            std::printf("  %-16s: %5.2f ns/update  (checksum %.6g)\n", label,
+                        1e9 * secondsSince(T0) / double(N), sink);
+        };
+
+        // Baseline: the deque window MACrossover used before the indicator library.
+        struct DequeSma
+        {
+            std::deque<double> w_;
+            double sum_ = 0.0;
+            void reset()
+            {
+                w_.clear();
+                sum_ = 0.0;
+            }
+            double update(double x)
+            {
+                w_.push_back(x);
+                sum_ += x;
+                if (w_.size() > P)
+                {
+                    sum_ -= w_.front();
+                    w_.pop_front();
+                }
+                return w_.size() == P ? sum_ / double(P) : std::nan("");
+            }
+        };
+        TIME("sma (deque)", DequeSma{});
+        TIME("sma", strategy::indicators::Sma{P});
+        TIME("ema", strategy::indicators::Ema{P});
+        TIME("wma", strategy::indicators::Wma{P});
+        TIME("rsi", strategy::indicators::Rsi{P});
+        TIME("rolling stddev", strategy::indicators::RollingStdDev{P});
+        TIME("rolling max", strategy::indicators::RollingMax{P});
+        TIME("rolling min", strategy::indicators::RollingMin{P});
+
+        // Compile-time windows: inline storage, masked indexing.
+        namespace fx = strategy::indicators::fixed;
+        TIME("fixed sma", fx::Sma<P>{});
+        TIME("fixed wma", fx::Wma<P>{});
+        TIME("fixed stddev", fx::RollingStdDev<P>{});
+        TIME("fixed max", fx::RollingMax<P>{});
+        TIME("fixed min", fx::RollingMin<P>{});
+
+        strategy::indicators::Atr atr{P};
+        strategy::indicators::Bollinger bb{P};
+        atr.reset();
+        bb.reset();
+        double sink = 0.0;
+        auto t0 = Clock::now();
+        for (const auto& q : SERIES[0].data())
+        {
+            const double V = atr.update(q);
+            sink += std::isnan(V) ? 0.0 : V;
+        }
+        std::printf("  %-16s: %5.2f ns/update  (checksum %.6g)\n", "atr",
+                    1e9 * secondsSince(t0) / double(N), sink);
+        sink = 0.0;
+        t0 = Clock::now();
+        for (const double X : closes)
+        {
+            const auto B = bb.update(X);
+            sink += std::isnan(B.upper_) ? 0.0 : B.upper_ - B.lower_;
+        }
+        std::printf("  %-16s: %5.2f ns/update  (checksum %.6g)\n", "bollinger",
+                    1e9 * secondsSince(t0) / double(N), sink);
+    }
+
+    // ------------------------------------------------------------
+    // indcache: MA grid sweep, inline indicators vs. shared cached columns
+    // ------------------------------------------------------------
+    void benchIndicatorCache()
+    {
+        constexpr std::size_t BARS = 50'000;
+        const auto SERIES = makeUniverse(1, BARS);
+        const auto ALL = std::span<const domain::Quote>{SERIES[0].data()};
+        std::vector<std::pair<int, int>> grid;
+        for (int f = 2; f < 52; ++f)
+            for (int sl = 60; sl < 310; sl += 5)
+                grid.emplace_back(f, sl);
+        std::printf("[indcache] MA crossover, %zu bars, %zu candidates (%zu threads)\n", BARS,
+                    grid.size(), core::defaultThreads());
+
+        std::vector<double> plain(grid.size()), cached(grid.size());
+        auto t0 = Clock::now();
+        core::parallelFor(grid.size(),
+                          [&](std::size_t i, std::size_t)
+                          {
+                              strategy::MACrossover ma{grid[i].first, grid[i].second};
+                              plain[i] = Engine{10'000.0}.run(SERIES[0], ma).final_equity_;
+                          });
+        std::printf("  inline indicators : %7.3f s\n", secondsSince(t0));
+
+        t0 = Clock::now();
+        strategy::indicators::IndicatorCache cache;
+        const auto ID = seriesFingerprint(ALL);
+        core::parallelFor(
+            grid.size(),
+            [&](std::size_t i, std::size_t)
+            {
+                strategy::MACrossover ma{cache, ID, ALL, grid[i].first, grid[i].second};
+                cached[i] = Engine{10'000.0}.run(SERIES[0], ma).final_equity_;
+            });
+        const auto STATS = cache.stats();
+        std::printf("  indicator cache   : %7.3f s  (%zu columns computed, %zu hits, %.1f MiB, "
+                    "same result: %s)\n",
+                    secondsSince(t0), STATS.misses_, STATS.hits_,
+                    double(cache.bytes()) / double(1 << 20), plain == cached ? "yes" : "no");
+    }
+
+    // ------------------------------------------------------------
+    // rules: compiled expression rules vs. the hand-written strategy
+    // ------------------------------------------------------------
+    void benchRules()
+    {
+        constexpr std::size_t N = 2'000'000;
+        const auto SERIES = makeUniverse(1, N);
+        const auto ALL = std::span<const domain::Quote>{SERIES[0].data()};
+        std::printf("[rules] %zu bars\n", N);
+
+        const auto TIME = [&](const char* label, strategy::IStrategy& s)
+        {
+            std::size_t trades = 0;
+            const auto T0 = Clock::now();
+            s.onStart();
+            for (const auto& q : ALL)
+                trades += s.onBar(q) != strategy::Signal::None;
+            std::printf("  %-28s: %6.2f ns/bar  (%zu signals)\n", label,
+                        1e9 * secondsSince(T0) / double(N), trades);
+        };
+
+        strategy::MACrossover ma{10, 50};
+        TIME("MACrossover", ma);
+        const auto MA_RULE = std::make_shared<const strategy::rules::Rule>(
+            strategy::rules::Rule::compile("sma(close, 10) crosses above sma(close, 50)",
+                                           "sma(close, 10) crosses below sma(close, 50)"));
+        strategy::rules::RuleStrategy streaming{MA_RULE};
+        TIME("MA rule, streaming", streaming);
+        auto t0 = Clock::now();
+        strategy::rules::RuleStrategy blocks{MA_RULE, ALL};
+        const double EVAL = secondsSince(t0);
+        TIME("MA rule, block-evaluated", blocks);
+        std::printf("  %-28s: %6.2f ns/bar\n", "  (block evaluation itself)",
+                    1e9 * EVAL / double(N));
+
+        const auto RICH =
+            std::make_shared<const strategy::rules::Rule>(strategy::rules::Rule::compile(
+                "sma(close, 10) crosses above sma(close, 50) and rsi(14) < 70 and close > "
+                "lowest(low, 20) * 1.01",
+                "sma(close, 10) crosses below sma(close, 50) or atr(14) > 2 * stddev(close, 20)"));
+        strategy::rules::RuleStrategy rich_streaming{RICH};
+        TIME("5-indicator rule, streaming", rich_streaming);
+        t0 = Clock::now();
+        const auto SIGNALS = RICH->evaluate(ALL);
+        std::printf("  %-28s: %6.2f ns/bar  (%zu nodes)\n", "5-indicator rule, blocks",
+                    1e9 * secondsSince(t0) / double(N), RICH->nodes().size());
+        (void) SIGNALS;
+    }
+
+    const std::map<std::string, std::function<void()>>& sections()
+    {
+        static const std::map<std::string, std::function<void()>> SECTIONS{
+            {"columns", benchColumns},
+            {"covariance", benchCovariance},
+            {"engine", benchEngine},
+            {"events", benchEvents},
+            {"indcache", benchIndicatorCache},
+            {"join", benchJoin},
+            {"indicators", benchIndicators},
+            {"montecarlo", benchMonteCarlo},
+            {"optimizer", benchOptimizer},
+            {"orderbook", benchOrderBook},
+            {"portfolio", benchPortfolio},
+            {"ranking", benchRanking},
+            {"rebalance", benchRebalance},
+            {"rules", benchRules},
+            {"sweep", benchSweep},
+            {"walkforward", benchWalkForward},
+            {"warmup", benchWarmup},
+        };
+        return SECTIONS;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const auto& all = sections();
+    if (argc < 2)
+    {
+        for (const auto& [name, fn] : all)
+            fn();
+        return 0;
+    }
+    for (int i = 1; i < argc; ++i)
+    {
+        auto it = all.find(argv[i]);
+        if (it == all.end())
+        {
+            std::fprintf(stderr, "unknown section: %s\n", argv[i]);
+            return 1;
+        }
+        it->second();
+    }
+    return 0;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file Covariance.hpp
+ * @brief Covariance and correlation matrices of return panels (hundreds to thousands of symbols).
+ *
+ * Inputs are time-major return matrices, one row per period and one column
+ * per symbol, with a row stride (e.g. `BarPanel::returns()` with
+ * `BarPanel::stride()`). Values must be finite; a missing observation is
+ * best entered as a zero return.
+ *
+ * The batch kernel is a blocked symmetric rank-k update: the centred
+ * returns are packed once into panels of 8 symbols, and each thread owns a
+ * band of output rows, accumulating 8-column tiles in SIMD registers over
+ * cache-sized chunks of periods (scalar, AVX2 or AVX-512 build, picked at
+ * runtime). Only the upper triangle is computed and then mirrored.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "core/CpuFeatures.hpp"
+
+namespace qga::core::stats
+{
+
+    /**
+     * @class SymmetricMatrix
+     * @brief Dense n x n symmetric matrix, row-major with rows padded to a multiple of 8.
+     *
+     * Storage is padded to stride() rows as well, so blocked kernels can
+     * write whole 8 x 8 tiles.
+     */
+    class SymmetricMatrix
+    {
+      public:
+        SymmetricMatrix() = default;
+
+        /// @brief Zero matrix of order @p n.
+        explicit SymmetricMatrix(std::size_t n)
+            : n_(n), stride_((n + 7) / 8 * 8), values_(stride_ * stride_, 0.0)
+        {
+        }
+
+        std::size_t size() const noexcept { return n_; }
+        std::size_t stride() const noexcept { return stride_; }
+
+        double operator()(std::size_t i, std::size_t j) const noexcept
+        {
+            return values_[i * stride_ + j];
+        }
+        double& operator()(std::size_t i, std::size_t j) noexcept
+        {
+            return values_[i * stride_ + j];
+        }
+
+        /// @return Row @p i (n values).
+        std::span<const double> row(std::size_t i) const noexcept
+        {
+            return {values_.data() + i * stride_, n_};
+        }
+
+        /// @return Storage: stride() rows of stride() values.
+        double* data() noexcept { return values_.data(); }
+        const double* data() const noexcept { return values_.data(); }
+
+      private:
+        std::size_t n_ = 0;
+        std::size_t stride_ = 0;
+        std::vector<double> values_;
+    };
+
+    /**
+     * @brief Execution settings of the covariance kernels.
+     */
+    struct CovarianceOptions
+    {
+        std::size_t threads_ = 0;             ///< Worker threads (0 = all cores).
+        SimdLevel level_ = activeSimdLevel(); ///< Instruction set (clamped to the host).
+    };
+
+    /**
+     * @brief Sample covariance (divisor T - 1) of the columns of a return matrix.
+     * @param returns Time-major values, `rows * stride` long.
+     * @param symbols Columns to use (the first @p symbols of each row).
+     * @param stride  Row stride (0 = @p symbols).
+     * @throws std::invalid_argument if the size is not a multiple of the stride,
+     *         @p symbols exceeds it, or there are fewer than 2 rows.
+     */
+    SymmetricMatrix covariance(std::span<const double> returns, std::size_t symbols,
+                               std::size_t stride = 0, const CovarianceOptions& options = {});
+
+    /**
+     * @brief Correlation matrix of a covariance matrix.
+     *
+     * The diagonal is 1; pairs involving a zero-variance symbol are 0.
+     */
+    SymmetricMatrix correlation(const SymmetricMatrix& cov);
+
+    /**
+     * @brief Shrunk covariance estimate and the intensity that was applied.
+     */
+    struct ShrunkCovariance
+    {
+        SymmetricMatrix matrix_; ///< (1 - intensity) * sample + intensity * target.
+        double intensity_ = 0.0; ///< Shrinkage intensity in [0, 1].
+    };
+
+    /**
+     * @brief Ledoit-Wolf (2004) shrinkage towards a scaled identity, with the optimal intensity.
+     *
+     * The estimate stays well conditioned (invertible) even with fewer
+     * periods than symbols. The intensity's extra terms cost O(T N) on top of
+     * the covariance itself.
+     *
+     * @throws std::invalid_argument as covariance().
+     */
+    ShrunkCovariance ledoitWolf(std::span<const double> returns, std::size_t symbols,
+                                std::size_t stride = 0, const CovarianceOptions& options = {});
+
+    /**
+     * @brief Shrinks @p cov towards `mean variance * I` with a given intensity.
+     * @throws std::invalid_argument if @p intensity is outside [0, 1].
+     */
+    SymmetricMatrix shrinkToIdentity(const SymmetricMatrix& cov, double intensity);
+
+    /**
+     * @brief Shrinks @p cov towards the constant-correlation matrix (same variances,
+     *        every correlation replaced by the average one) with a given intensity.
+     * @throws std::invalid_argument if @p intensity is outside [0, 1].
+     */
+    SymmetricMatrix shrinkToConstantCorrelation(const SymmetricMatrix& cov, double intensity);
+
+    /**
+     * @class RollingCovariance
+     * @brief Covariance over the last `window` rows, updated in O(N^2) per row.
+     *
+     * Keeps the window and the sums and cross-products of its rows; push()
+     * adds the new row's outer product and removes the evicted one's instead
+     * of recomputing O(window N^2). Every `window` pushes the sums are
+     * recomputed exactly with the blocked kernel, which bounds the drift of
+     * the add/subtract updates at amortised O(N^2) per row.
+     */
+    class RollingCovariance
+    {
+      public:
+        /**
+         * @throws std::invalid_argument if @p symbols is 0 or @p window is below 2.
+         */
+        RollingCovariance(std::size_t symbols, std::size_t window,
+                          const CovarianceOptions& options = {});
+
+        /**
+         * @brief Adds one row of returns (the oldest one leaves once the window is full).
+         * @throws std::invalid_argument if @p row does not hold `symbols()` values.
+         */
+        void push(std::span<const double> row);
+
+        /// @return True once `window` rows were pushed.
+        bool ready() const noexcept { return count_ >= window_; }
+
+        std::size_t symbols() const noexcept { return n_; }
+        std::size_t window() const noexcept { return window_; }
+
+        /**
+         * @return Sample covariance of the rows in the window (divisor rows - 1).
+         * @throws std::logic_error if fewer than 2 rows were pushed.
+         */
+        SymmetricMatrix covariance() const;
+
+        /// @return Correlation of the rows in the window.
+        SymmetricMatrix correlation() const { return stats::correlation(covariance()); }
+
+      private:
+        void rebase();
+
+        std::size_t n_;
+        std::size_t stride_; ///< Padded row length.
+        std::size_t window_;
+        CovarianceOptions options_;
+        std::vector<double> rows_;     ///< Ring of window_ padded rows.
+        std::vector<double> sum_;      ///< Column sums over the window.
+        std::vector<double> cross_;    ///< Upper triangle of the cross-products, stride_ x stride_.
+        std::vector<double> next_;     ///< Padded copy of the row being pushed.
+        std::vector<double> zero_;     ///< Padded zero row (evicted row while filling).
+        std::size_t count_ = 0;        ///< Rows pushed.
+        std::size_t since_rebase_ = 0; ///< Pushes since the sums were recomputed.
+    };
+
+} // namespace qga::core::stats
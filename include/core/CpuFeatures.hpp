@@ -0,0 +1,55 @@
+/**
+ * @file CpuFeatures.hpp
+ * @brief Runtime detection of SIMD instruction sets used by vectorised kernels.
+ *
+ * Hosts running the engine mix CPU generations, so vectorised kernels are
+ * compiled for several instruction sets and picked at runtime. This header
+ * exposes the detected level and an optional override (`QGA_SIMD` env var).
+ */
+
+#pragma once
+
+namespace qga::core
+{
+
+    /**
+     * @enum SimdLevel
+     * @brief Widest SIMD instruction set a kernel may use (ordered by width).
+     */
+    enum class SimdLevel
+    {
+        Scalar = 0, ///< Portable C++ fallback, no vector instructions.
+        Avx2 = 1,   ///< 256-bit AVX2 (4 doubles per register).
+        Avx512 = 2  ///< 512-bit AVX-512F (8 doubles per register).
+    };
+
+    /**
+     * @brief Detects the widest SIMD level supported by the CPU and the OS.
+     *
+     * @return Detected level; always Scalar on non-x86 targets.
+     */
+    SimdLevel detectSimdLevel() noexcept;
+
+    /**
+     * @brief Level that dispatching kernels should use by default.
+     *
+     * Equal to @ref detectSimdLevel(), optionally lowered by the `QGA_SIMD`
+     * environment variable (`scalar`, `avx2`, `avx512`). The override can only
+     * narrow the level, never enable an unsupported instruction set.
+     * The value is computed once and cached.
+     */
+    SimdLevel activeSimdLevel() noexcept;
+
+    /**
+     * @brief Clamps a requested level to what the host actually supports.
+     * @param requested Desired level.
+     * @return `min(requested, detectSimdLevel())`.
+     */
+    SimdLevel clampSimdLevel(SimdLevel requested) noexcept;
+
+    /**
+     * @brief Human-readable name of a level ("scalar", "avx2", "avx512").
+     */
+    const char* toString(SimdLevel level) noexcept;
+
+} // namespace qga::core
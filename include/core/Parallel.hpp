@@ -0,0 +1,85 @@
+/**
+ * @file Parallel.hpp
+ * @brief Minimal fork-join helper for data-parallel loops over independent tasks.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace qga::core
+{
+
+    /**
+     * @brief Number of worker threads to use when the caller passes 0.
+     * @return Hardware concurrency, at least 1.
+     */
+    inline std::size_t defaultThreads() noexcept
+    {
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * @brief Calls @p fn(i, worker) for every i in [0, n) across a pool of threads.
+     *
+     * Tasks are handed out dynamically from a shared counter, so uneven task
+     * costs balance themselves. `worker` is the index of the executing thread
+     * in [0, threads), letting callers keep preallocated per-worker buffers.
+     * Runs inline when a single thread suffices. The first exception thrown
+     * by any task is rethrown on the calling thread once all workers stopped.
+     *
+     * @param n       Number of tasks.
+     * @param fn      Callable `void(std::size_t task, std::size_t worker)`.
+     * @param threads Worker count (0 = defaultThreads()).
+     */
+    template <class Fn> void parallelFor(std::size_t n, Fn&& fn, std::size_t threads = 0)
+    {
+        if (threads == 0)
+            threads = defaultThreads();
+        threads = std::min(threads, n);
+        if (threads <= 1)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                fn(i, std::size_t{0});
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        const auto WORK = [&](std::size_t worker)
+        {
+            try
+            {
+                for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < n;
+                     i = next.fetch_add(1, std::memory_order_relaxed))
+                    fn(i, worker);
+            }
+            catch (...)
+            {
+                std::lock_guard lock{error_mutex};
+                if (!error)
+                    error = std::current_exception();
+                next.store(n, std::memory_order_relaxed); // stop handing out tasks
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (std::size_t w = 1; w < threads; ++w)
+            pool.emplace_back(WORK, w);
+        WORK(0);
+        for (auto& t : pool)
+            t.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+} // namespace qga::core
@@ -0,0 +1,96 @@
+/**
+ * @file Random.hpp
+ * @brief Small, fast, reproducible pseudo-random generators for simulations.
+ *
+ * Unlike the standard distributions, the output sequences here are fully
+ * specified, so a given seed reproduces the same results on every platform
+ * and standard library.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace qga::core
+{
+
+    /**
+     * @brief SplitMix64 step; used for seeding and stream derivation.
+     * @param state Generator state, advanced in place.
+     * @return Next 64-bit output.
+     */
+    inline std::uint64_t splitMix64(std::uint64_t& state) noexcept
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @class Xoshiro256
+     * @brief xoshiro256** generator (Blackman & Vigna), 256-bit state.
+     *
+     * Satisfies UniformRandomBitGenerator. Independent streams are obtained by
+     * seeding with (seed, stream) pairs, e.g. one stream per simulated path,
+     * which keeps results independent of how work is split across threads.
+     */
+    class Xoshiro256
+    {
+      public:
+        using result_type = std::uint64_t;
+
+        /**
+         * @brief Seeds stream @p stream of @p seed through SplitMix64.
+         */
+        explicit Xoshiro256(std::uint64_t seed, std::uint64_t stream = 0) noexcept
+        {
+            std::uint64_t sm = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+            for (auto& w : s_)
+                w = splitMix64(sm);
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        /// @return Next 64-bit output.
+        result_type operator()() noexcept
+        {
+            const std::uint64_t RESULT = rotl(s_[1] * 5, 7) * 9;
+            const std::uint64_t T = s_[1] << 17;
+            s_[2] ^= s_[0];
+            s_[3] ^= s_[1];
+            s_[1] ^= s_[2];
+            s_[0] ^= s_[3];
+            s_[2] ^= T;
+            s_[3] = rotl(s_[3], 45);
+            return RESULT;
+        }
+
+        /**
+         * @brief Uniform integer in [0, n) by multiply-shift (n < 2^32).
+         *
+         * The bias is below n / 2^32, negligible for resampling indices.
+         */
+        std::uint32_t below(std::uint32_t n) noexcept
+        {
+            return static_cast<std::uint32_t>(((*this)() >> 32) * n >> 32);
+        }
+
+        /// @return Uniform double in [0, 1) with 53 random bits.
+        double uniform() noexcept { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+      private:
+        static std::uint64_t rotl(std::uint64_t x, int k) noexcept
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        std::uint64_t s_[4]; ///< Generator state.
+    };
+
+} // namespace qga::core
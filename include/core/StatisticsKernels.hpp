@@ -0,0 +1,80 @@
+/**
+ * @file StatisticsKernels.hpp
+ * @brief Allocation- and logging-free performance metrics over contiguous data.
+ *
+ * The arithmetic behind Statistics' financial metrics, exposed as inline
+ * span-based functions for hot loops (Monte Carlo paths, sweeps) where the
+ * per-call logging and vector arguments of Statistics would dominate.
+ * Statistics delegates to these, so both always agree bit for bit.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <span>
+
+namespace qga::core::stats
+{
+
+    /**
+     * @brief Maximum drawdown of an equity curve, in [0, 1]; 0 for fewer than 2 points.
+     */
+    inline double maxDrawdown(std::span<const double> equity) noexcept
+    {
+        if (equity.size() < 2)
+            return 0.0;
+
+        double peak = equity[0];
+        double max_dd = 0.0;
+        for (double v : equity)
+        {
+            peak = std::max(peak, v);
+            double dd = (peak - v) / peak;
+            max_dd = std::max(max_dd, dd);
+        }
+        return max_dd;
+    }
+
+    /**
+     * @brief CAGR = (final / initial)^(1 / years) - 1; 0 for invalid input.
+     */
+    inline double cagr(std::span<const double> equity, double periods_per_year) noexcept
+    {
+        if (equity.size() < 2 || periods_per_year <= 0.0 || !std::isfinite(periods_per_year))
+            return 0.0;
+        double start = equity.front();
+        double end = equity.back();
+        double years = (equity.size() - 1) / periods_per_year;
+
+        if (start <= 0.0 || years <= 0.0)
+            return 0.0;
+        return std::pow(end / start, 1.0 / years) - 1.0;
+    }
+
+    /**
+     * @brief Per-period Sharpe ratio (mean excess return / sample stddev); 0 for invalid input.
+     */
+    inline double sharpeRatio(std::span<const double> returns, double risk_free_annual,
+                              double periods_per_year) noexcept
+    {
+        if (returns.size() < 2 || periods_per_year <= 0.0 || !std::isfinite(periods_per_year))
+            return 0.0;
+
+        // Convert annual risk-free to per-period
+        double rf = risk_free_annual / periods_per_year;
+
+        double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+
+        double sumsq = 0.0;
+        for (double r : returns)
+            sumsq += (r - mean) * (r - mean);
+        double stddev = std::sqrt(sumsq / (returns.size() - 1));
+
+        if (stddev == 0.0)
+            return 0.0;
+        return (mean - rf) / stddev;
+    }
+
+} // namespace qga::core::stats
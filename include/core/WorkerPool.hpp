@@ -0,0 +1,82 @@
+/**
+ * @file WorkerPool.hpp
+ * @brief Runs batches of tasks in child processes and collects their line results.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace qga::core
+{
+
+    /**
+     * @brief Worker pool settings.
+     */
+    struct WorkerPoolParams
+    {
+        std::size_t workers_ = 0;      ///< Concurrent processes (0 = defaultThreads()).
+        std::size_t chunk_ = 0;        ///< Tasks per launch (0 = about four chunks per worker).
+        std::size_t max_attempts_ = 3; ///< Launches allowed per task before the run fails.
+    };
+
+    /**
+     * @brief What happened during WorkerPool::run().
+     */
+    struct WorkerPoolStats
+    {
+        std::size_t launched_ = 0;      ///< Processes started.
+        std::size_t failed_ = 0;        ///< Processes that crashed, failed or missed tasks.
+        std::size_t retried_tasks_ = 0; ///< Tasks handed out again after a failure.
+    };
+
+    /**
+     * @class WorkerPool
+     * @brief Coordinator for local worker processes (e.g. `qga_cli` in worker mode).
+     *
+     * Tasks `[0, n)` are split into contiguous chunks. For each chunk the pool
+     * launches the command returned by the caller, with the child's stdout
+     * connected to a pipe, and keeps up to `workers_` children running. A
+     * worker reports each finished task as one line, `"<task> <payload>\n"`;
+     * the payload (rest of the line) goes to the result callback as soon as it
+     * arrives, on the calling thread. Lines for tasks outside the chunk, and
+     * repeats, are ignored.
+     *
+     * A worker that dies, exits non-zero or ends without reporting every task
+     * of its chunk counts as failed: its missing tasks are requeued as new
+     * chunks. Results it did report are kept. A task failing `max_attempts_`
+     * times aborts the run: remaining workers are killed and
+     * std::runtime_error is thrown.
+     *
+     * POSIX only (spawn + pipes + poll); elsewhere run() throws
+     * std::runtime_error.
+     */
+    class WorkerPool
+    {
+      public:
+        /// Builds the argv (program first, looked up in PATH) for tasks [first, first + count).
+        using Command =
+            std::function<std::vector<std::string>(std::size_t first, std::size_t count)>;
+
+        /// Receives the payload of a finished task.
+        using OnResult = std::function<void(std::size_t task, std::string_view payload)>;
+
+        explicit WorkerPool(WorkerPoolParams params = {});
+
+        /**
+         * @brief Runs @p tasks tasks to completion.
+         * @throws std::runtime_error if a task exhausts its attempts or a process cannot be
+         *         managed. Exceptions from @p on_result are rethrown after the workers are killed.
+         */
+        WorkerPoolStats run(std::size_t tasks, const Command& command,
+                            const OnResult& on_result) const;
+
+      private:
+        WorkerPoolParams params_;
+    };
+
+} // namespace qga::core
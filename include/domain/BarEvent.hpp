@@ -0,0 +1,25 @@
+/**
+ * @file BarEvent.hpp
+ * @brief One symbol's bar delivered by a multi-symbol event stream.
+ */
+#pragma once
+#include <cstddef>
+#include "domain/Quote.hpp"
+
+namespace qga::domain
+{
+
+    /**
+     * @struct BarEvent
+     * @brief Pairs a bar with the index of the symbol (series) it belongs to.
+     *
+     * Events are produced in batches sharing one timestamp; the pointed-to bar
+     * is owned by the source series and stays valid while that series lives.
+     */
+    struct BarEvent
+    {
+        std::size_t symbol_{};      ///< Index of the source series.
+        const Quote* bar_{nullptr}; ///< Bar data (non-owning).
+    };
+
+} // namespace qga::domain
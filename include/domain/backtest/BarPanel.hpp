@@ -0,0 +1,103 @@
+/**
+ * @file BarPanel.hpp
+ * @brief Timestamp-aligned, multi-symbol view over several BarSeries.
+ *
+ * Many strategies run the same logic independently over hundreds of symbols
+ * (e.g. an S&P 500 universe). The panel aligns their bars on the union of all
+ * timestamps and stores the close prices time-major so that a block of
+ * neighbouring symbols can be loaded into SIMD lanes with a single load.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "domain/backtest/BarSeries.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @class BarPanel
+     * @brief Aligned grid of bars: one row per timestamp, one column per symbol.
+     *
+     * Missing bars (a symbol that did not trade at a given timestamp) are
+     * stored as NaN in the close matrix and as @ref MISSING in the row map.
+     * The number of columns is padded to a multiple of @ref LANE_PAD with
+     * permanently missing columns, so vector kernels never need a tail loop.
+     *
+     * @note The panel does not own the source series; they must outlive it.
+     * @note Each source series is expected to be sorted by timestamp.
+     */
+    class BarPanel
+    {
+      public:
+        /// Row-map marker for a symbol without a bar at a timestamp.
+        static constexpr std::uint32_t MISSING = std::numeric_limits<std::uint32_t>::max();
+
+        /// Column padding; matches the widest supported vector (8 doubles).
+        static constexpr std::size_t LANE_PAD = 8;
+
+        BarPanel() = default;
+
+        /**
+         * @brief Builds the panel from a set of series.
+         * @param series Source series, one per symbol (column order is preserved).
+         */
+        explicit BarPanel(const std::vector<BarSeries>& series);
+
+        /// @return Number of aligned timestamps (rows).
+        std::size_t size() const noexcept { return timestamps_.size(); }
+
+        /// @return Number of real symbols (columns, without padding).
+        std::size_t symbols() const noexcept { return series_.size(); }
+
+        /// @return Row stride in doubles (symbols rounded up to @ref LANE_PAD).
+        std::size_t stride() const noexcept { return stride_; }
+
+        /// @return Timestamp of row @p t.
+        std::int64_t timestamp(std::size_t t) const noexcept { return timestamps_[t]; }
+
+        /// @return All aligned timestamps in ascending order.
+        const std::vector<std::int64_t>& timestamps() const noexcept { return timestamps_; }
+
+        /**
+         * @brief Close prices of row @p t, `stride()` values long.
+         * @return Pointer to the first column; NaN marks a missing bar.
+         */
+        const double* closeRow(std::size_t t) const noexcept { return close_.data() + t * stride_; }
+
+        /**
+         * @brief Returns the full bar of symbol @p s at row @p t.
+         * @return Pointer into the source series, or nullptr when the bar is missing.
+         */
+        const Quote* quote(std::size_t t, std::size_t s) const noexcept
+        {
+            const std::uint32_t ROW = rows_[t * stride_ + s];
+            return ROW == MISSING ? nullptr : bars_[s] + ROW;
+        }
+
+        /**
+         * @brief Simple close-to-close returns, `(size() - 1) x stride()` time-major.
+         *
+         * Row t holds the return from row t to row t + 1 on prices carried
+         * forward over missing bars; a symbol without a price yet (or a padded
+         * column) has a zero return, which suits the covariance kernels.
+         */
+        std::vector<double> returns() const;
+
+        /// @return Source series of symbol @p s.
+        const BarSeries& series(std::size_t s) const noexcept { return *series_[s]; }
+
+      private:
+        std::vector<const BarSeries*> series_;   ///< Non-owning source series, one per column.
+        std::vector<const Quote*> bars_;         ///< First bar of each source series.
+        std::vector<std::int64_t> timestamps_;   ///< Union of all timestamps (sorted, unique).
+        std::vector<double> close_;              ///< Time-major close matrix (size() x stride()).
+        std::vector<std::uint32_t> rows_;        ///< Time-major index into the source series.
+        std::size_t stride_ = 0;                 ///< Padded column count.
+    };
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,68 @@
+/**
+ * @file Checkpoint.hpp
+ * @brief Serializable snapshot of a single-asset backtest in progress.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @struct EngineCheckpoint
+     * @brief Account and strategy state after the last processed bar.
+     *
+     * Produced and consumed by Engine::resume(). Signals are executed on the
+     * bar that produced them, so no order is ever pending between bars; the
+     * account plus the strategy snapshot fully determine the continuation.
+     *
+     * A default-constructed checkpoint means "nothing processed yet".
+     */
+    struct EngineCheckpoint
+    {
+        static constexpr std::int64_t NO_BARS = std::numeric_limits<std::int64_t>::min();
+
+        double initial_equity_ = 0.0;              ///< Starting capital of the run.
+        double cash_ = 0.0;                        ///< Cash after the last bar.
+        double qty_ = 0.0;                         ///< Open quantity (0 when flat).
+        bool has_pos_ = false;                     ///< Whether a position is open.
+        int trades_executed_ = 0;                  ///< Entries executed so far.
+        std::uint64_t bars_processed_ = 0;         ///< Bars consumed so far.
+        std::int64_t last_ts_ = NO_BARS;           ///< Timestamp of the last processed bar.
+        double last_close_ = 0.0;                  ///< Close of the last processed bar.
+        std::vector<std::uint8_t> strategy_state_; ///< Output of IStrategy::saveState().
+
+        /// @return True if no bar has been processed yet.
+        bool empty() const noexcept { return bars_processed_ == 0; }
+
+        /**
+         * @brief Encodes the checkpoint (versioned, native byte order).
+         */
+        std::vector<std::uint8_t> serialize() const;
+
+        /**
+         * @brief Decodes bytes produced by serialize().
+         * @throws std::runtime_error on bad magic, version or truncated input.
+         */
+        static EngineCheckpoint deserialize(std::span<const std::uint8_t> bytes);
+
+        /**
+         * @brief Writes serialize() output to @p path.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        void save(const std::filesystem::path& path) const;
+
+        /**
+         * @brief Reads a checkpoint written by save().
+         * @throws std::runtime_error if the file cannot be read or decoded.
+         */
+        static EngineCheckpoint load(const std::filesystem::path& path);
+    };
+
+} // namespace qga::domain::backtest
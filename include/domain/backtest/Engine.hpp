@@ -8,10 +8,17 @@
 
 #pragma once
 
+#include <cstdint>
+#include <span>
+#include <vector>
+
 #include "domain/backtest/BarSeries.hpp"
 #include "domain/backtest/Result.hpp"
 #include "strategy/IStrategy.hpp"
 #include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Checkpoint.hpp"
+#include "domain/backtest/EngineCounters.hpp"
+#include "domain/backtest/StopRules.hpp"
 
 namespace qga::domain::backtest {
 
@@ -23,7 +30,11 @@ namespace qga::domain::backtest {
  * - Initializes strategy and portfolio.
  * - Feeds market data (bars) to the strategy.
  * - Executes generated signals via slippage and commission model.
- * - Records trades and final metrics.
+ * - Records trades and final metrics (detail chosen per run by CaptureLevel).
+ * - Optionally aborts early when a StopRules condition fires.
+ *
+ * Strategies declaring IStrategy::timeframes() are driven through a
+ * strategy::TimeframeFeed, so they receive their resampled bars as they close.
  */
 class Engine {
     public:
@@ -31,22 +42,83 @@ class Engine {
          * @brief Constructs the backtest engine.
          * @param initial_equity Starting capital used in the simulation.
          * @param exec Execution parameters (slippage, commission).
+         * @param rules Early-termination rules for run() (default: none).
          */
         explicit Engine(double initial_equity = 10000.0,
-                ExecParams exec = {})
-        : initial_equity_(initial_equity), exec_(exec) {}
+                ExecParams exec = {}, StopRules rules = {})
+        : initial_equity_(initial_equity), exec_(exec), rules_(rules) {}
 
         /**
          * @brief Execute the backtest over the given series with the provided strategy.
          * @param series Input time series of bars (OHLCV).
          * @param strat  Strategy to be executed.
-         * @return BacktestResult summary (equity, trades).
+         * @param capture Detail to record (default: none, the cheapest).
+         * @param counters Optional hot-path counters to add this run's figures to
+         *                 (null: counting is compiled out of the loop).
+         * @return BacktestResult summary (equity, trades, plus captured metrics).
+         */
+        BacktestResult run(BarSeries const& series, strategy::IStrategy& strat,
+                CaptureLevel capture = CaptureLevel::None, EngineCounters* counters = nullptr);
+
+        /**
+         * @brief Execute the backtest over a contiguous range of bars (zero-copy slice).
+         * @param bars   Bars to simulate, e.g. a window of `BarSeries::data()`.
+         * @param strat  Strategy to be executed.
+         * @param capture Detail to record; at CaptureLevel::Full the equity curve and
+         *                returns hold one value per processed bar.
+         * @param counters Optional hot-path counters (see EngineCounters).
+         * @return BacktestResult summary (equity, trades, plus captured metrics).
+         */
+        BacktestResult run(std::span<const Quote> bars, strategy::IStrategy& strat,
+                CaptureLevel capture = CaptureLevel::None, EngineCounters* counters = nullptr);
+
+        /**
+         * @brief Run over @p bars starting from a saved strategy state instead of onStart().
+         *
+         * Lets a test window begin with indicators already warmed up on earlier
+         * history (see WarmupCache). The account always starts flat with the
+         * initial equity.
+         *
+         * @param bars    Bars to simulate.
+         * @param strat   Strategy; must implement loadState().
+         * @param state   Output of IStrategy::saveState().
+         * @param capture Detail to record.
+         * @param counters Optional hot-path counters.
+         * @throws std::logic_error if the strategy does not support snapshots.
          */
-        BacktestResult run(BarSeries const& series, strategy::IStrategy& strat);
+        BacktestResult runFrom(std::span<const Quote> bars, strategy::IStrategy& strat,
+                std::span<const std::uint8_t> state, CaptureLevel capture = CaptureLevel::None,
+                EngineCounters* counters = nullptr);
+
+        /**
+         * @brief Incremental run: continue from @p checkpoint over bars newer than it.
+         *
+         * Only bars with a timestamp after `checkpoint.last_ts_` are processed, so
+         * @p series may be either the grown full history or just the appended bars.
+         * An empty checkpoint starts a fresh run. On return the checkpoint holds the
+         * state after the last processed bar (before the final close-out), and the
+         * result equals what run() would return over the whole history. Stop rules
+         * are not applied.
+         *
+         * @param series Input bars (sorted by timestamp).
+         * @param strat  Strategy; must implement saveState()/loadState().
+         * @param checkpoint State to resume from; updated in place.
+         * @return BacktestResult summary as of the last processed bar.
+         * @throws std::logic_error if the strategy does not support snapshots.
+         */
+        BacktestResult resume(BarSeries const& series, strategy::IStrategy& strat,
+                EngineCheckpoint& checkpoint);
 
     private:
+        BacktestResult resumeWith(BarSeries const& series, strategy::IStrategy& strat,
+                EngineCheckpoint& checkpoint);
+
+        BacktestResult simulateFrom(std::span<const Quote> bars, strategy::IStrategy& strat,
+                CaptureLevel capture, EngineCounters* counters);
+
         double initial_equity_;  ///< Initial equity for the backtest.
         ExecParams exec_;          ///< Execution model (commissions, slippage).
+        StopRules rules_;          ///< Early-termination rules (run() only).
 };
 
 } // namespace qga::domain::backtest
@@ -0,0 +1,111 @@
+/**
+ * @file EventScheduler.hpp
+ * @brief k-way timestamp merge of many BarSeries into per-timestamp batches.
+ *
+ * Lets symbols with different trading calendars be backtested together
+ * without materialising a dense timestamp x symbol grid.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "domain/BarEvent.hpp"
+#include "domain/backtest/BarSeries.hpp"
+#include "strategy/IBatchStrategy.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @class EventScheduler
+     * @brief Merges sorted series by timestamp with a tournament (loser) tree.
+     *
+     * Every series contributes a cursor; the tree keeps the cursor with the
+     * smallest next timestamp at its root. Popping an event and replaying the
+     * winner's path costs O(log k) comparisons over flat arrays (keys, cursors,
+     * tree nodes), so the working set stays small even for thousands of
+     * symbols. Ties are broken by series index, so each batch is ordered by
+     * symbol.
+     *
+     * @note The scheduler does not own the series; they must outlive it and
+     *       each must be sorted by timestamp.
+     */
+    class EventScheduler
+    {
+      public:
+        /**
+         * @brief Prepares the merge over @p series (cursors at the first bar).
+         */
+        explicit EventScheduler(const std::vector<BarSeries>& series);
+
+        /// @return Number of merged series.
+        std::size_t symbols() const noexcept { return bars_.size(); }
+
+        /// @return Total number of bars across all series.
+        std::size_t totalEvents() const noexcept { return total_; }
+
+        /**
+         * @brief Advances to the next timestamp.
+         * @param[out] ts    Timestamp of the batch.
+         * @param[out] batch Bars stamped @p ts; valid until the next call.
+         * @return False once every series is exhausted.
+         */
+        bool next(std::int64_t& ts, std::span<const BarEvent>& batch);
+
+        /**
+         * @brief Rewinds every cursor to its first bar.
+         */
+        void reset();
+
+        /**
+         * @brief Delivers every batch to @p on_batch(ts, batch) in timestamp order.
+         * @return Number of events delivered.
+         */
+        template <class Fn>
+            requires std::invocable<Fn&, std::int64_t, std::span<const BarEvent>>
+        std::size_t run(Fn&& on_batch)
+        {
+            std::size_t events = 0;
+            std::int64_t ts = 0;
+            std::span<const BarEvent> batch;
+            while (next(ts, batch))
+            {
+                on_batch(ts, batch);
+                events += batch.size();
+            }
+            return events;
+        }
+
+        /**
+         * @brief Drives a batch strategy through its full lifecycle.
+         * @return Number of events delivered.
+         */
+        std::size_t run(strategy::IBatchStrategy& strat);
+
+      private:
+        static constexpr std::int64_t EXHAUSTED = std::numeric_limits<std::int64_t>::max();
+
+        bool less(std::uint32_t a, std::uint32_t b) const noexcept
+        {
+            return keys_[a] < keys_[b] || (keys_[a] == keys_[b] && a < b);
+        }
+
+        void build();
+        void replay(std::uint32_t leaf) noexcept;
+
+        std::vector<const Quote*> bars_;  ///< First bar of each series.
+        std::vector<std::size_t> sizes_;  ///< Bar count of each series.
+        std::vector<std::size_t> pos_;    ///< Cursor of each series.
+        std::vector<std::int64_t> keys_;  ///< Next timestamp per leaf (EXHAUSTED = done/padding).
+        std::vector<std::uint32_t> tree_; ///< Loser per internal node; tree_[0] = winner.
+        std::vector<BarEvent> batch_;     ///< Reused batch buffer.
+        std::size_t leaves_ = 1;          ///< Leaf count (power of two >= symbols).
+        std::size_t total_ = 0;           ///< Total bars across series.
+    };
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,79 @@
+/**
+ * @file LaneEngine.hpp
+ * @brief Lane-parallel backtests of one strategy across many symbols.
+ *
+ * Runs the MA-crossover strategy with the single-unit execution model of
+ * @ref Engine independently on every column of a @ref BarPanel, packing 4
+ * (AVX2) or 8 (AVX-512) symbols into SIMD lanes that advance in lockstep.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "core/CpuFeatures.hpp"
+#include "domain/backtest/BarPanel.hpp"
+#include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Result.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @class LaneEngine
+     * @brief Vectorised multi-symbol counterpart of `Engine` + `MACrossover`.
+     *
+     * Every lane keeps its own SMA windows, crossover state and account
+     * (cash, quantity, open flag). Bars missing for a symbol are masked out:
+     * the lane state is left untouched, which is equivalent to running the
+     * scalar engine over that symbol's own series. Results are bit-identical
+     * to `Engine::run(series, MACrossover{fast, slow})` for every symbol.
+     *
+     * The kernel is compiled for scalar, AVX2 and AVX-512 targets and picked
+     * at runtime via @ref core::activeSimdLevel(), so one binary runs on every
+     * host generation.
+     */
+    class LaneEngine
+    {
+      public:
+        /**
+         * @brief Constructs the lane engine.
+         * @param initial_equity Starting capital of every symbol's account.
+         * @param exec Execution parameters (slippage, commission).
+         */
+        explicit LaneEngine(double initial_equity = 10000.0, ExecParams exec = {})
+            : initial_equity_(initial_equity), exec_(exec)
+        {
+        }
+
+        /**
+         * @brief Runs MA crossover over every symbol using the active SIMD level.
+         * @param panel Aligned multi-symbol bars.
+         * @param fast_period Fast SMA window (bars).
+         * @param slow_period Slow SMA window (bars).
+         * @return One result per panel symbol, in column order.
+         * @throws std::invalid_argument if a period is not positive.
+         */
+        std::vector<BacktestResult> runMACrossover(const BarPanel& panel, int fast_period,
+                                                   int slow_period) const;
+
+        /**
+         * @brief Same as above with an explicit kernel choice.
+         *
+         * @p level is clamped to what the host supports, so requesting
+         * AVX-512 on an AVX2 machine silently uses the AVX2 kernel.
+         */
+        std::vector<BacktestResult> runMACrossover(const BarPanel& panel, int fast_period,
+                                                   int slow_period, core::SimdLevel level) const;
+
+        /**
+         * @brief Number of symbols processed per kernel step at a given level.
+         */
+        static std::size_t laneWidth(core::SimdLevel level) noexcept;
+
+      private:
+        double initial_equity_; ///< Starting capital per symbol.
+        ExecParams exec_;       ///< Execution model (commissions, slippage).
+    };
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,107 @@
+/**
+ * @file MonteCarlo.hpp
+ * @brief Parallel Monte Carlo resampling of backtest returns into metric distributions.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @enum ResampleMethod
+     * @brief How each simulated path is drawn from the observed returns.
+     *
+     * - BlockBootstrap: concatenates randomly chosen blocks of consecutive
+     *   returns (with replacement), preserving short-range autocorrelation.
+     * - TradeShuffle: random permutation of per-trade returns; the total
+     *   return is unchanged, only the path (and so the drawdown) varies.
+     */
+    enum class ResampleMethod
+    {
+        BlockBootstrap,
+        TradeShuffle
+    };
+
+    /**
+     * @brief Simulation settings.
+     */
+    struct MonteCarloParams
+    {
+        std::size_t paths_ = 10'000;                             ///< Number of simulated paths.
+        ResampleMethod method_ = ResampleMethod::BlockBootstrap; ///< Resampling scheme.
+        std::size_t block_size_ = 20;     ///< Block length for the bootstrap.
+        std::uint64_t seed_ = 42;         ///< Master seed.
+        std::size_t threads_ = 0;         ///< Worker threads (0 = hardware concurrency).
+        double periods_per_year_ = 252.0; ///< Sampling frequency for CAGR/Sharpe.
+        double risk_free_annual_ = 0.0;   ///< Annual risk-free rate for Sharpe.
+    };
+
+    /**
+     * @brief Sampled distribution of one metric.
+     */
+    struct MetricDistribution
+    {
+        std::vector<double> values_; ///< One value per path, sorted ascending.
+        double mean_ = 0.0;          ///< Sample mean.
+        double stddev_ = 0.0;        ///< Sample standard deviation.
+
+        /**
+         * @brief Empirical quantile with linear interpolation.
+         * @param q Probability in [0, 1].
+         */
+        double quantile(double q) const noexcept;
+    };
+
+    /**
+     * @brief Distributions of the re-evaluated metrics.
+     */
+    struct MonteCarloResult
+    {
+        MetricDistribution sharpe_;       ///< Per-period Sharpe ratio (as Statistics::sharpeRatio).
+        MetricDistribution max_drawdown_; ///< Maximum drawdown (as Statistics::maxDrawdown).
+        MetricDistribution cagr_;         ///< CAGR (as Statistics::cagr).
+        MetricDistribution final_equity_; ///< Ending equity of each path.
+    };
+
+    /**
+     * @class MonteCarlo
+     * @brief Resamples a return series into many paths and scores every path.
+     *
+     * Paths are independent tasks spread over worker threads; each worker
+     * owns preallocated return and equity buffers, so the path loop does not
+     * allocate. Path `i` always draws from RNG stream `(seed_, i)`, making
+     * results identical for any thread count.
+     */
+    class MonteCarlo
+    {
+      public:
+        /**
+         * @brief Constructs the simulator.
+         * @throws std::invalid_argument if `paths_` or `block_size_` is zero.
+         */
+        explicit MonteCarlo(MonteCarloParams params);
+
+        /**
+         * @brief Simulates paths from @p returns (periodic or per-trade, as decimals).
+         * @param returns Observed returns (at least 2).
+         * @param initial_equity Starting equity of every path.
+         * @throws std::invalid_argument if fewer than 2 returns are given.
+         */
+        MonteCarloResult run(std::span<const double> returns,
+                             double initial_equity = 10000.0) const;
+
+        /**
+         * @brief Simple returns of an equity curve: `e[i+1] / e[i] - 1`.
+         */
+        static std::vector<double> returnsFromEquity(std::span<const double> equity);
+
+      private:
+        MonteCarloParams params_; ///< Simulation settings.
+    };
+
+} // namespace qga::domain::backtest
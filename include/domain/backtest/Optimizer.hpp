@@ -0,0 +1,171 @@
+/**
+ * @file Optimizer.hpp
+ * @brief Budgeted parameter search: successive halving and evolutionary search.
+ *
+ * Alternatives to exhaustive grids for large parameter spaces. Both optimisers
+ * spend a fixed evaluation budget, run backtests in parallel and are fully
+ * reproducible from their seed.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "domain/backtest/BarSeries.hpp"
+#include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Result.hpp"
+#include "strategy/IStrategy.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /// One candidate: a value per dimension of the ParamSpace.
+    using ParamSet = std::vector<int>;
+
+    /**
+     * @brief Integer parameter dimension `{min, min + step, ..., <= max}`.
+     */
+    struct ParamRange
+    {
+        std::string name_; ///< Display name.
+        int min_ = 0;      ///< Smallest value.
+        int max_ = 0;      ///< Largest value (inclusive).
+        int step_ = 1;     ///< Grid step (> 0).
+
+        /// @return Number of grid values.
+        std::size_t count() const noexcept
+        {
+            return static_cast<std::size_t>((max_ - min_) / step_) + 1;
+        }
+
+        /// @return Value at grid index @p i.
+        int value(std::size_t i) const noexcept { return min_ + static_cast<int>(i) * step_; }
+    };
+
+    /// Search space: one range per strategy parameter.
+    using ParamSpace = std::vector<ParamRange>;
+
+    /**
+     * @brief One evaluated candidate.
+     */
+    struct Trial
+    {
+        ParamSet params_;      ///< Candidate.
+        double score_ = 0.0;   ///< Objective value.
+        std::size_t bars_ = 0; ///< Length of the slice it was scored on.
+    };
+
+    /**
+     * @brief Outcome of an optimisation.
+     */
+    struct OptimizerResult
+    {
+        ParamSet best_;             ///< Best candidate on the full series.
+        double best_score_ = 0.0;   ///< Its objective value.
+        std::size_t backtests_ = 0; ///< Backtests executed (any length).
+        double full_runs_ = 0.0;    ///< Cost in full-length backtests (bars / series length).
+        std::vector<Trial> trials_; ///< Every evaluation in execution order.
+    };
+
+    /// Creates a strategy for a candidate. Called concurrently.
+    using ParamStrategyFactory =
+        std::function<std::unique_ptr<strategy::IStrategy>(const ParamSet&)>;
+
+    /// Scores a result; higher is better (default: final equity).
+    using ResultObjective = std::function<double(const BacktestResult&)>;
+
+    /**
+     * @brief Settings for SuccessiveHalving.
+     */
+    struct HalvingParams
+    {
+        double budget_ = 20.0;    ///< Cost cap in full-length backtest equivalents.
+        std::size_t eta_ = 3;     ///< Keep 1/eta of the candidates per rung; slices grow by eta.
+        std::size_t rungs_ = 3;   ///< Promotions after the first rung (final rung = full series).
+        std::uint64_t seed_ = 42; ///< Seed for candidate sampling.
+        std::size_t threads_ = 0; ///< Worker threads (0 = hardware concurrency).
+    };
+
+    /**
+     * @class SuccessiveHalving
+     * @brief Scores many candidates on short prefixes, promoting the best to longer ones.
+     *
+     * Rung `r` (0..R) evaluates `n0 / eta^r` candidates on the first
+     * `N / eta^(R-r)` bars, so every rung costs about the same and the last
+     * runs on the full series. `n0` is derived from the budget
+     * (`budget * eta^R / (R + 1)`), capped by the grid size; candidates are
+     * sampled uniformly without replacement.
+     */
+    class SuccessiveHalving
+    {
+      public:
+        /**
+         * @throws std::invalid_argument if eta < 2 or the budget is not positive.
+         */
+        SuccessiveHalving(double initial_equity, ExecParams exec, HalvingParams params);
+
+        /**
+         * @brief Runs the search.
+         * @throws std::invalid_argument for an empty series or an invalid space.
+         */
+        OptimizerResult run(const BarSeries& series, const ParamSpace& space,
+                            const ParamStrategyFactory& make,
+                            const ResultObjective& objective = {}) const;
+
+      private:
+        double initial_equity_;
+        ExecParams exec_;
+        HalvingParams params_;
+    };
+
+    /**
+     * @brief Settings for EvolutionarySearch.
+     */
+    struct EvolutionParams
+    {
+        std::size_t budget_ = 200;    ///< Full-length backtests allowed.
+        std::size_t population_ = 32; ///< Candidates per generation.
+        std::size_t elite_ = 2;       ///< Best candidates copied unchanged.
+        std::size_t tournament_ = 3;  ///< Tournament size for parent selection.
+        double mutation_rate_ = 0.25; ///< Per-gene mutation probability.
+        std::uint64_t seed_ = 42;     ///< Seed for sampling and breeding.
+        std::size_t threads_ = 0;     ///< Worker threads (0 = hardware concurrency).
+    };
+
+    /**
+     * @class EvolutionarySearch
+     * @brief Generational genetic search over the parameter grid.
+     *
+     * Each generation's new candidates are backtested in parallel on the full
+     * series; parents are chosen by tournament, children combine parent genes
+     * uniformly and mutate by a few grid steps. Scores are cached, so revisited
+     * candidates cost nothing; the search stops when the budget is spent or a
+     * generation produces no unseen candidate.
+     */
+    class EvolutionarySearch
+    {
+      public:
+        /**
+         * @throws std::invalid_argument if budget or population is zero.
+         */
+        EvolutionarySearch(double initial_equity, ExecParams exec, EvolutionParams params);
+
+        /**
+         * @brief Runs the search.
+         * @throws std::invalid_argument for an empty series or an invalid space.
+         */
+        OptimizerResult run(const BarSeries& series, const ParamSpace& space,
+                            const ParamStrategyFactory& make,
+                            const ResultObjective& objective = {}) const;
+
+      private:
+        double initial_equity_;
+        ExecParams exec_;
+        EvolutionParams params_;
+    };
+
+} // namespace qga::domain::backtest
@@ -3,7 +3,8 @@
  * @brief Order abstraction used in backtests: side, type, quantity, timestamp.
  *
  * Represents a simplified financial order object for use in the backtest engine.
- * Supports only market orders for now, but can be extended for limit/stop/etc.
+ * Supports market orders plus resting limit, stop and stop-limit orders
+ * (see OrderBook).
  */
 #pragma once
 
@@ -22,9 +23,14 @@ enum class Side { Buy, Sell };
 
 /**
  * @enum OrderType
- * @brief Currently supports only market orders.
+ * @brief Execution style of an order.
+ *
+ * - Market: fill immediately at the current price.
+ * - Limit: fill at the limit price or better.
+ * - Stop: becomes a market order once the stop price trades.
+ * - StopLimit: becomes a limit order once the stop price trades.
  */
-enum class OrderType { Market };
+enum class OrderType { Market, Limit, Stop, StopLimit };
 /**
  * @brief Represents a single order in the backtest system.
  *
@@ -33,7 +39,7 @@ enum class OrderType { Market };
  * - Direction (side)
  * - Quantity
  * - Timestamp
- * - Type (currently only market orders)
+ * - Type, with limit/stop prices for resting orders
  */
 class Order {
     public:
@@ -43,8 +49,9 @@ class Order {
      * @param instrument Financial instrument metadata (symbol, etc.).
      * @param side Buy or sell.
      * @param quantity Positive trade quantity.
-     * @param type Order type (default: Market).
+     * @param type Order type (default: Market; priced types need the overload below).
      * @param ts Optional timestamp (default: now).
+     * @throws std::invalid_argument if quantity is not > 0 or type is not Market.
      */
     Order(domain::Instrument instrument,
         Side side,
@@ -52,6 +59,26 @@ class Order {
         OrderType type = OrderType::Market,
         std::chrono::system_clock::time_point ts = std::chrono::system_clock::now());
 
+    /**
+     * @brief Constructs a priced (limit, stop or stop-limit) order.
+     *
+     * @param instrument Financial instrument metadata (symbol, etc.).
+     * @param side Buy or sell.
+     * @param quantity Positive trade quantity.
+     * @param type Limit, Stop or StopLimit.
+     * @param limit_price Limit price (required for Limit and StopLimit).
+     * @param stop_price Stop (trigger) price (required for Stop and StopLimit).
+     * @param ts Optional timestamp (default: now).
+     * @throws std::invalid_argument if a required price is not > 0.
+     */
+    Order(domain::Instrument instrument,
+        Side side,
+        double quantity,
+        OrderType type,
+        double limit_price,
+        double stop_price,
+        std::chrono::system_clock::time_point ts = std::chrono::system_clock::now());
+
     #ifdef UNIT_TEST
         Order() = default; // only for test mocks
     #endif
@@ -68,6 +95,14 @@ class Order {
     * @brief Returns order type.
     */
     OrderType type() const noexcept { return type_; }
+    /**
+     * @brief Returns the limit price (0 when not applicable).
+     */
+    double limitPrice() const noexcept { return limit_price_; }
+    /**
+     * @brief Returns the stop price (0 when not applicable).
+     */
+    double stopPrice() const noexcept { return stop_price_; }
     /**
      * @brief Returns quantity of the order.
      */
@@ -86,6 +121,8 @@ class Order {
     Side side_{Side::Buy};                  ///< Buy or sell side.
     OrderType type_{OrderType::Market};     ///< Order type.
     double quantity_{0.0};                  ///< Quantity of asset to trade.
+    double limit_price_{0.0};               ///< Limit price (Limit/StopLimit).
+    double stop_price_{0.0};                ///< Stop price (Stop/StopLimit).
     std::chrono::system_clock::time_point ts_{};    ///< Timestamp of order.
 };
 
@@ -0,0 +1,170 @@
+/**
+ * @file OrderBook.hpp
+ * @brief Resting limit / stop / stop-limit orders matched against bar ranges.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "domain/Instrument.hpp"
+#include "domain/Quote.hpp"
+#include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Order.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /// Identifier returned by OrderBook::submit(), dense from 0.
+    using OrderId = std::uint32_t;
+
+    /**
+     * @enum OrderStatus
+     * @brief Lifecycle of a resting order.
+     *
+     * - Pending: waiting for its limit or stop price.
+     * - Active: stop-limit whose stop traded, now resting as a limit order.
+     * - Filled / Cancelled: terminal.
+     */
+    enum class OrderStatus
+    {
+        Pending,
+        Active,
+        Filled,
+        Cancelled
+    };
+
+    /**
+     * @brief One execution produced by OrderBook::onBar() or VolumeFillModel::onBar().
+     */
+    struct Fill
+    {
+        OrderId id_{};           ///< Order that filled.
+        std::size_t slot_{};     ///< Instrument slot of the order.
+        Side side_{Side::Buy};   ///< Order side.
+        OrderType type_{};       ///< Original order type.
+        double price_{};         ///< Execution price.
+        double quantity_{};      ///< Filled quantity (whole order; a slice for VolumeFillModel).
+        std::int64_t ts_{};      ///< Timestamp of the bar that filled it.
+    };
+
+    /**
+     * @class OrderBook
+     * @brief Holds resting orders per instrument and fills them bar by bar.
+     *
+     * Each instrument slot keeps four binary heaps (buy/sell x limit/stop)
+     * ordered so that the order closest to triggering is on top: buy limits
+     * and sell stops by highest price, sell limits and buy stops by lowest.
+     * A bar therefore only pops orders whose price lies inside its
+     * [low, high] range, at O(log n) each, and untouched orders cost nothing.
+     * Equal prices fill in submission order.
+     *
+     * Fill prices, given the bar open `O`:
+     * - Buy limit `L`: `min(O, L)`; sell limit: `max(O, L)` (no slippage).
+     * - Buy stop `S`: `max(O, S)`; sell stop: `min(O, S)`, then slippage is applied
+     *   as for a market order.
+     * - Stop-limit: triggers like a stop. If the trigger price already satisfies
+     *   the limit it fills there; otherwise it rests as a limit order from the
+     *   next bar on, since the intrabar path after the trigger is unknown.
+     *
+     * Within one bar stops are processed before limits. Cancellation is lazy:
+     * cancelled entries are dropped when they surface or when a slot's heaps
+     * are compacted.
+     *
+     * PortfolioEngine drives a book for strategy::IOrderStrategy runs.
+     */
+    class OrderBook
+    {
+      public:
+        /**
+         * @brief Constructs an empty book.
+         * @param exec Execution model; only slippage (for stop fills) is used.
+         */
+        explicit OrderBook(ExecParams exec = {}) : exec_(exec) {}
+
+        /**
+         * @brief Returns the stable slot index of an instrument (created on first use).
+         */
+        std::size_t slotFor(const domain::Instrument& ins);
+
+        /**
+         * @brief Adds a resting order.
+         * @return Identifier of the order.
+         * @throws std::invalid_argument for market orders (fill those directly).
+         */
+        OrderId submit(Order order);
+
+        /**
+         * @brief Cancels an open order.
+         * @return True if the order was still open.
+         */
+        bool cancel(OrderId id);
+
+        /**
+         * @brief Returns the order submitted under @p id.
+         * @throws std::out_of_range for unknown identifiers.
+         */
+        const Order& order(OrderId id) const { return orders_.at(id); }
+
+        /**
+         * @brief Returns the status of @p id.
+         * @throws std::out_of_range for unknown identifiers.
+         */
+        OrderStatus status(OrderId id) const { return records_.at(id).status_; }
+
+        /// @return Number of open (pending or active) orders across all instruments.
+        std::size_t openOrders() const noexcept { return open_; }
+
+        /**
+         * @brief Matches one bar of an instrument against its resting orders.
+         * @param slot Instrument slot (from slotFor()).
+         * @param bar  Bar of that instrument.
+         * @param fills Output; fills are appended in execution order.
+         */
+        void onBar(std::size_t slot, const Quote& bar, std::vector<Fill>& fills);
+
+      private:
+        struct Level
+        {
+            double price_;
+            OrderId id_;
+        };
+
+        struct Record
+        {
+            std::size_t slot_;
+            OrderStatus status_;
+        };
+
+        struct Book
+        {
+            std::vector<Level> buy_limit_;  ///< Highest limit on top.
+            std::vector<Level> sell_limit_; ///< Lowest limit on top.
+            std::vector<Level> buy_stop_;   ///< Lowest stop on top.
+            std::vector<Level> sell_stop_;  ///< Highest stop on top.
+            std::size_t stale_ = 0;         ///< Cancelled entries still in the heaps.
+        };
+
+        bool isOpen(OrderId id) const noexcept
+        {
+            const auto S = records_[id].status_;
+            return S == OrderStatus::Pending || S == OrderStatus::Active;
+        }
+
+        void rest(Book& book, OrderId id, bool as_limit);
+        void fill(OrderId id, double price, std::int64_t ts, std::vector<Fill>& fills);
+        void compact(Book& book);
+
+        ExecParams exec_;                                    ///< Slippage for stop fills.
+        std::vector<Order> orders_;                          ///< Orders by id.
+        std::vector<Record> records_;                        ///< Slot and status by id.
+        std::vector<Book> books_;                            ///< Heaps per instrument slot.
+        std::unordered_map<std::string, std::size_t> slots_; ///< Instrument key -> slot.
+        std::vector<OrderId> activated_;                     ///< Stop-limits triggered this bar.
+        std::size_t open_ = 0;                               ///< Open order count.
+    };
+
+} // namespace qga::domain::backtest
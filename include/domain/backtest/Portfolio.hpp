@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <deque>
 #include <unordered_map>
 #include <string>
 #include "domain/backtest/Position.hpp"
@@ -47,12 +48,43 @@ public:
      */
     Position& getOrCreate(const domain::Instrument& ins);
 
+    /**
+     * @brief Returns the stable slot index of an instrument's position.
+     *
+     * Creates an empty position on first use. Slots never move, so hot loops
+     * can resolve them once up front and use the slot-based overloads below
+     * without building lookup keys on every trade.
+     *
+     * @param ins Financial instrument.
+     * @return Slot index valid for the lifetime of the portfolio.
+     */
+    std::size_t slotFor(const domain::Instrument& ins);
+
+    /**
+     * @brief Returns the position stored in a slot.
+     * @param slot Index obtained from @ref slotFor().
+     */
+    const Position& position(std::size_t slot) const { return positions_[slot]; }
+
     /**
      * @brief Applies a trade to the portfolio.
      * @param t Trade to be executed (affects position, cash, PnL).
      */
     void applyTrade(const Trade& t);
 
+    /**
+     * @brief Applies a trade to a known slot (no instrument lookup).
+     * @param t    Trade to be executed.
+     * @param slot Index obtained from @ref slotFor() for the trade's instrument.
+     */
+    void applyTrade(const Trade& t, std::size_t slot);
+
+    /**
+     * @brief Deducts execution costs (commissions, fees) from cash.
+     * @param fee Non-negative cost in currency units.
+     */
+    void chargeFee(double fee) noexcept { cash_ -= fee; }
+
     /**
      * @brief Computes the mark-to-market value for an instrument.
      * @param ins Instrument to evaluate.
@@ -70,8 +102,8 @@ public:
      */
     double totalValue() const noexcept{
         double total = cash_;
-        for (const auto& kv : positions_) {
-            total += kv.second.qty() * kv.second.avgPrice();
+        for (const auto& p : positions_) {
+            total += p.qty() * p.avgPrice();
         }
         return total;
     }
@@ -83,13 +115,8 @@ private:
      */
     static std::string keyFor(const domain::Instrument& ins);
 
-    /**
-     * @brief Aggregates total realized PnL across all closed positions.
-     * @return Total realized profit/loss.
-     */
-    double aggregateRealized() const;
-
-    std::unordered_map<std::string, Position> positions_;   ///< Active positions by instrument.
+    std::deque<Position> positions_;                          ///< Positions by slot (stable refs).
+    std::unordered_map<std::string, std::size_t> slots_;      ///< Instrument key -> slot index.
     double cash_{0.0};                                       ///< Available cash.
     double realized_pnl_{0.0};                                  ///< Accumulated realized PnL.
 };
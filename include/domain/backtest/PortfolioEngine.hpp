@@ -0,0 +1,157 @@
+/**
+ * @file PortfolioEngine.hpp
+ * @brief Multi-asset backtest: one strategy instance per instrument, one shared account.
+ *
+ * Routes every strategy signal through the full accounting chain
+ * (`Order` → fill → `Trade` → `Portfolio::applyTrade`) across a universe of
+ * instruments aligned in a @ref BarPanel, with equity-based position sizing.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "domain/Instrument.hpp"
+#include "domain/backtest/BarPanel.hpp"
+#include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Result.hpp"
+#include "domain/backtest/Trade.hpp"
+#include "domain/backtest/VolumeFillModel.hpp"
+#include "strategy/IOrderStrategy.hpp"
+#include "strategy/IStrategy.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @brief Position sizing rules for entries.
+     */
+    struct SizingParams
+    {
+        double equity_fraction_ = 0.1;       ///< Share of current equity committed per entry.
+        std::size_t trades_per_symbol_ = 64; ///< Trade-log capacity reserved per instrument.
+    };
+
+    /**
+     * @brief Outcome of a multi-asset run.
+     */
+    struct PortfolioResult
+    {
+        BacktestResult summary_;    ///< Aggregate equity and entry count (as in Engine).
+        std::vector<Trade> trades_; ///< Every fill in execution order (entries, exits, close-out).
+    };
+
+    /**
+     * @class PortfolioEngine
+     * @brief Runs per-instrument strategies against one shared Portfolio.
+     *
+     * For every panel timestamp each instrument that has a bar is fed to its
+     * own strategy instance. A `Buy` while flat opens a long position sized to
+     * `equity_fraction_` of the current mark-to-market equity, rounded down to
+     * the instrument lot size and capped by available cash; a `Sell` closes the
+     * whole position. Open positions are closed at their last close after the
+     * final bar, mirroring @ref Engine.
+     *
+     * Strategies do not observe the account, so the run has two passes:
+     * signals are generated symbol-major (one strategy's state hot in cache
+     * at a time), then a time-major pass does sizing and accounting. The bar
+     * loops perform no heap allocation: position slots are resolved once, the
+     * trade log is reserved up front and mark-to-market equity is maintained
+     * incrementally instead of summing the book on every bar.
+     *
+     * With a @ref VolumeFillModel enabled, signal orders no longer fill in
+     * full at the signal bar's close: they are queued and filled from the
+     * next bar on, at most `max_participation_` of each bar's volume, with
+     * the remainder carried to later bars (see run()).
+     *
+     * Strategies that work resting orders (strategy::IOrderStrategy) run
+     * through the second run() overload, which matches an @ref OrderBook
+     * against every bar.
+     */
+    class PortfolioEngine
+    {
+      public:
+        /// Creates the strategy instance for panel column @p symbol.
+        using StrategyFactory =
+            std::function<std::unique_ptr<strategy::IStrategy>(std::size_t symbol)>;
+
+        /// Creates the order-placing strategy instance for panel column @p symbol.
+        using OrderStrategyFactory =
+            std::function<std::unique_ptr<strategy::IOrderStrategy>(std::size_t symbol)>;
+
+        /**
+         * @brief Constructs the engine.
+         * @param initial_equity Starting capital of the shared account.
+         * @param exec Execution parameters (slippage, commission).
+         * @param sizing Entry sizing rules.
+         * @param volume_fill Volume participation model for signal orders
+         *        (empty = fill in full at the signal bar's close).
+         */
+        explicit PortfolioEngine(double initial_equity = 10000.0, ExecParams exec = {},
+                                 SizingParams sizing = {},
+                                 std::optional<VolumeFillParams> volume_fill = std::nullopt)
+            : initial_equity_(initial_equity), exec_(exec), sizing_(sizing),
+              volume_fill_(volume_fill)
+        {
+        }
+
+        /**
+         * @brief Runs the universe backtest.
+         * @param panel Aligned bars, one column per instrument.
+         * @param instruments Instrument metadata in panel column order.
+         * @param make_strategy Factory invoked once per instrument before the run.
+         * @return Summary and full trade log.
+         * @throws std::invalid_argument if @p instruments does not match the panel.
+         *
+         * With the volume fill model, a `Buy` while flat and without a working
+         * order queues an entry sized as above; a `Sell` cancels a working
+         * entry's remainder and queues an exit of the quantity held. Each
+         * slice is one `Trade` (commission charged per slice, price from the
+         * model); buy slices are trimmed to what cash affords, which cancels
+         * the rest of the order. An entry counts once, at its first slice.
+         * Remainders still working after the final bar are dropped and the
+         * position is closed in full at its last close.
+         */
+        PortfolioResult run(const BarPanel& panel,
+                            const std::vector<domain::Instrument>& instruments,
+                            const StrategyFactory& make_strategy) const;
+
+        /**
+         * @brief Runs a universe of order-placing strategies against one OrderBook.
+         *
+         * Single time-major pass. For every bar of an instrument its resting
+         * orders are matched first (see OrderBook for trigger and fill
+         * prices), each fill goes through `Order` → `Trade` →
+         * `Portfolio::applyTrade` and is reported to the strategy's onFill(),
+         * then the strategy sees the bar in onBar(). Orders placed in either
+         * callback rest from the next bar on.
+         *
+         * The account is long-only and cash-backed, as in the signal run:
+         * buy fills are cut to what cash affords at the fill price (lot-rounded),
+         * sell fills to the quantity held, and a fill cut to zero is dropped
+         * without an onFill() call. Commissions follow ExecParams; slippage
+         * applies to stop fills only. Every buy fill counts as an entry in
+         * `trades_executed_`. Positions left open are closed at their last
+         * close after the final bar.
+         *
+         * @param panel Aligned bars, one column per instrument.
+         * @param instruments Instrument metadata in panel column order.
+         * @param make_strategy Factory invoked once per instrument before the run.
+         * @return Summary and full trade log.
+         * @throws std::invalid_argument if @p instruments does not match the panel.
+         */
+        PortfolioResult run(const BarPanel& panel,
+                            const std::vector<domain::Instrument>& instruments,
+                            const OrderStrategyFactory& make_strategy) const;
+
+      private:
+        double initial_equity_;                       ///< Starting capital.
+        ExecParams exec_;                             ///< Execution model (commissions, slippage).
+        SizingParams sizing_;                         ///< Entry sizing.
+        std::optional<VolumeFillParams> volume_fill_; ///< Participation-limited fills (signal run).
+    };
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,106 @@
+/**
+ * @file RebalanceEngine.hpp
+ * @brief Target-weight portfolio backtest over a BarPanel.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "domain/backtest/BarPanel.hpp"
+#include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Result.hpp"
+#include "strategy/ICrossSectionalStrategy.hpp"
+#include "strategy/IWeightStrategy.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @brief Rebalancing settings.
+     */
+    struct RebalanceParams
+    {
+        /// Skip trades smaller than this fraction of equity (no-trade band).
+        double min_trade_weight_ = 0.0;
+    };
+
+    /**
+     * @brief Outcome of a target-weight run.
+     */
+    struct RebalanceResult
+    {
+        BacktestResult summary_;       ///< Equity, trades and, per row, equity curve and returns.
+        std::vector<double> holdings_; ///< Units held per symbol before the final close-out.
+        std::size_t rebalances_ = 0;   ///< Rows at which the strategy requested new weights.
+        double turnover_ = 0.0;        ///< Sum over rebalances of traded notional / equity.
+        double costs_ = 0.0;           ///< Total slippage plus commission paid.
+    };
+
+    /**
+     * @class RebalanceEngine
+     * @brief Trades a universe toward the weights returned by an IWeightStrategy.
+     *
+     * Every panel row updates the latest price of each symbol that traded and
+     * asks the strategy for targets. On a rebalance each tradable symbol (one
+     * with a bar at that row) moves to `weight * equity / price` units, where
+     * equity is the pre-trade mark-to-market value; symbols without a bar keep
+     * their holdings until a later rebalance. Fractional units are allowed.
+     * Slippage and commission follow ExecParams, with the fixed commission
+     * charged per symbol traded, and are paid from cash; weights summing to 1
+     * can therefore leave cash marginally negative.
+     *
+     * All per-row work is dense arithmetic over flat arrays of `stride()`
+     * doubles (prices, holdings, weights), written without branches so the
+     * compiler vectorises it; nothing allocates inside the row loop. The
+     * final equity liquidates all holdings at their last price, mirroring
+     * Engine's close-out.
+     */
+    class RebalanceEngine
+    {
+      public:
+        /**
+         * @brief Constructs the engine.
+         * @param initial_equity Starting capital.
+         * @param exec Execution parameters (slippage, commission).
+         * @param params Rebalancing settings.
+         */
+        explicit RebalanceEngine(double initial_equity = 10000.0, ExecParams exec = {},
+                                 RebalanceParams params = {})
+            : initial_equity_(initial_equity), exec_(exec), params_(params)
+        {
+        }
+
+        /**
+         * @brief Runs the strategy over every row of @p panel.
+         * @param panel Aligned bars, one column per symbol.
+         * @param strat Allocation strategy.
+         * @return Summary with equity curve, returns, drawdown and Sharpe.
+         */
+        RebalanceResult run(const BarPanel& panel, strategy::IWeightStrategy& strat) const;
+
+        /**
+         * @brief Runs a cross-sectional (ranking) strategy over every row of @p panel.
+         *
+         * Each row is presented as a strategy::CrossSection of the raw closes
+         * (NaN = no bar), with one strategy::Ranker per thread. If the strategy
+         * is stateless() its targets for all rows are computed first, in
+         * parallel over blocks of rows, and then replayed in order; otherwise
+         * it is called row by row. Both paths give identical results.
+         *
+         * @param panel   Aligned bars, one column per symbol.
+         * @param strat   Ranking strategy.
+         * @param threads Worker threads for stateless strategies (0 = all cores).
+         * @return Summary with equity curve, returns, drawdown and Sharpe.
+         */
+        RebalanceResult run(const BarPanel& panel, strategy::ICrossSectionalStrategy& strat,
+                            std::size_t threads = 0) const;
+
+      private:
+        double initial_equity_;  ///< Starting capital.
+        ExecParams exec_;        ///< Execution model (commissions, slippage).
+        RebalanceParams params_; ///< Rebalancing settings.
+    };
+
+} // namespace qga::domain::backtest
@@ -4,18 +4,72 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace qga::domain::backtest {
 
+/**
+ * @enum StopReason
+ * @brief Why a run ended before the last bar (see StopRules).
+ */
+enum class StopReason { None, MaxDrawdown, EquityFloor, BehindBest };
+
+/**
+ * @enum CaptureLevel
+ * @brief How much detail Engine::run() records.
+ *
+ * - None: equity, trade count and bar count only (fastest).
+ * - Summary: adds drawdown, Sharpe and hit ratio, computed in one streaming pass
+ *   without buffers.
+ * - Full: additionally fills the per-bar equity curve and returns (preallocated
+ *   from the series length) and the per-trade log.
+ */
+enum class CaptureLevel { None, Summary, Full };
+
+/**
+ * @struct TradeRecord
+ * @brief One completed round trip (entry and exit fill).
+ */
+struct TradeRecord {
+    std::int64_t entry_ts_ = 0;     ///< Timestamp of the entry bar.
+    std::int64_t exit_ts_ = 0;      ///< Timestamp of the exit bar (last bar on close-out).
+    double entry_price_ = 0.0;      ///< Entry execution price (after slippage).
+    double exit_price_ = 0.0;       ///< Exit execution price (after slippage).
+    double quantity_ = 0.0;         ///< Units traded.
+    double pnl_ = 0.0;              ///< Net P&L including both commissions.
+    double return_ = 0.0;           ///< pnl_ relative to the entry cost (price plus fee).
+};
+
 /**
  * @struct BacktestResult
- * @brief Minimal backtest summary returned by the engine.
+ * @brief Backtest summary returned by the engine.
  *
- * Extend with PnL series, drawdown, Sharpe, etc. in future versions.
+ * Risk metrics and series are filled according to the CaptureLevel of the run.
+ * Returns are per bar: `equity[t] / equity[t-1] - 1`, starting from the initial equity.
  */
 struct BacktestResult {
     double initial_equity_ = 10000.0;    ///< Initial equity for the backtest.
     double final_equity_ = 0.0;          ///< Final equity after the backtest
     int trades_executed_ = 0;            ///< Number of trades executed during the backtest.
+    std::size_t bars_processed_ = 0;     ///< Bars simulated (fewer than the input if aborted).
+    bool aborted_ = false;               ///< True if a stop rule ended the run early.
+    StopReason stop_reason_ = StopReason::None;  ///< Rule that aborted the run.
+    /// Equity at StopRules::checkpoint_bar_ (NaN if not reached).
+    double checkpoint_equity_ = std::numeric_limits<double>::quiet_NaN();
+
+    // --- Summary capture ---
+    double max_drawdown_ = 0.0;          ///< Largest peak-to-trough equity decline, in [0, 1].
+    double sharpe_ = 0.0;                ///< Per-bar Sharpe ratio (mean / sample stddev, rf = 0).
+    double hit_ratio_ = 0.0;             ///< Share of round trips with positive P&L.
+    std::size_t round_trips_ = 0;        ///< Completed round trips, including the final close-out.
+
+    // --- Full capture ---
+    std::vector<double> equity_curve_;   ///< Mark-to-market equity after each processed bar.
+    std::vector<double> returns_;        ///< Per-bar returns.
+    std::vector<TradeRecord> trades_;    ///< Round trips in exit order.
 };
 
 } // namespace qga::domain::backtest
@@ -0,0 +1,124 @@
+/**
+ * @file SeriesJoin.hpp
+ * @brief Timestamp-aligned joins of two BarSeries (inner, left and as-of).
+ *
+ * Spread and pairs strategies need two series on a common clock. The join
+ * works on the sorted timestamp columns and returns aligned row indices;
+ * the prices themselves are gathered on demand with alignedColumn(), so one
+ * join serves every field of both series.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "domain/backtest/BarSeries.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @enum JoinKind
+     * @brief Which right row, if any, is paired with each left row.
+     *
+     * - Inner: the first right row with the same timestamp; unmatched left
+     *   rows are dropped.
+     * - Left: as Inner, but every left row is kept (unmatched ones get
+     *   @ref AlignedRows::NO_MATCH).
+     * - AsOf: the last right row at or before the left timestamp, if it is
+     *   at most @ref JoinOptions::tolerance_ older; every left row is kept.
+     */
+    enum class JoinKind
+    {
+        Inner,
+        Left,
+        AsOf
+    };
+
+    /**
+     * @brief Join settings.
+     */
+    struct JoinOptions
+    {
+        JoinKind kind_ = JoinKind::Inner; ///< Join semantics.
+        /// AsOf: max staleness (ms).
+        std::int64_t tolerance_ = std::numeric_limits<std::int64_t>::max();
+    };
+
+    /**
+     * @brief Aligned row indices: output row k pairs `left_[k]` with `right_[k]`.
+     */
+    struct AlignedRows
+    {
+        /// Marker in right_ for a left row without a partner.
+        static constexpr std::uint32_t NO_MATCH = std::numeric_limits<std::uint32_t>::max();
+
+        std::vector<std::uint32_t> left_;  ///< Rows of the left series (ascending).
+        std::vector<std::uint32_t> right_; ///< Rows of the right series, or NO_MATCH.
+
+        std::size_t size() const noexcept { return left_.size(); }
+    };
+
+    /**
+     * @brief Joins two sorted timestamp columns.
+     *
+     * Comparable lengths are merged in one pass whose cursor updates are
+     * computed from comparison results rather than branches, so irregular
+     * gaps do not cost mispredictions. When the right column is much longer
+     * than the left one (daily against minute bars), each left row instead
+     * runs a branchless binary search over the remaining right rows.
+     *
+     * @pre Both columns are sorted ascending.
+     * @throws std::invalid_argument if an AsOf tolerance is negative.
+     * @throws std::length_error if a column has 2^32 - 1 rows or more.
+     */
+    AlignedRows joinTimestamps(std::span<const std::int64_t> left,
+                               std::span<const std::int64_t> right,
+                               const JoinOptions& options = {});
+
+    /**
+     * @brief Joins two series on their bar timestamps (see joinTimestamps()).
+     */
+    AlignedRows join(const BarSeries& left, const BarSeries& right,
+                     const JoinOptions& options = {});
+
+    /**
+     * @brief Left and right series of one pair, as indices into a universe.
+     */
+    struct SeriesPair
+    {
+        std::size_t left_ = 0;  ///< Index of the left series.
+        std::size_t right_ = 0; ///< Index of the right series.
+    };
+
+    /**
+     * @brief Joins many pairs of a universe, e.g. for pairs scanning.
+     *
+     * The timestamp column of every referenced series is extracted once and
+     * shared by all pairs using it; the pairs are then joined in parallel.
+     *
+     * @param universe Source series.
+     * @param pairs    Pairs to join; result i belongs to pairs[i].
+     * @param options  Join settings, shared by all pairs.
+     * @param threads  Worker threads (0 = all cores).
+     * @throws std::out_of_range if a pair refers outside @p universe.
+     * @throws std::invalid_argument / std::length_error as joinTimestamps().
+     */
+    std::vector<AlignedRows> joinPairs(const std::vector<BarSeries>& universe,
+                                       std::span<const SeriesPair> pairs,
+                                       const JoinOptions& options = {}, std::size_t threads = 0);
+
+    /**
+     * @brief Gathers one field of @p series along aligned rows.
+     * @param rows  `AlignedRows::left_` or `right_` of a join involving @p series.
+     * @param field Quote member to read (close by default).
+     * @return One value per row; NaN for NO_MATCH.
+     */
+    std::vector<double> alignedColumn(const BarSeries& series, std::span<const std::uint32_t> rows,
+                                      double Quote::*field = &Quote::close_);
+
+} // namespace qga::domain::backtest
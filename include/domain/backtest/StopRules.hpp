@@ -0,0 +1,39 @@
+/**
+ * @file StopRules.hpp
+ * @brief Early-termination rules that abort hopeless backtests.
+ */
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @struct StopRules
+     * @brief Conditions checked against mark-to-market equity after every bar.
+     *
+     * Every rule is disabled by its default value. When any rule fires the
+     * engine stops feeding bars, closes the position at that bar's close and
+     * returns a result flagged `aborted_` with the matching StopReason.
+     */
+    struct StopRules
+    {
+        /// Abort when drawdown from the equity peak exceeds this fraction (0 = off).
+        double max_drawdown_ = 0.0;
+        /// Abort when equity drops below this level (0 = off).
+        double equity_floor_ = 0.0;
+        /// Bars after which the checkpoint is evaluated (0 = off).
+        std::size_t checkpoint_bar_ = 0;
+        /// Abort if equity at the checkpoint is below this.
+        double checkpoint_floor_ = -std::numeric_limits<double>::infinity();
+
+        /// @return True if any rule (or checkpoint recording) is enabled.
+        bool active() const noexcept
+        {
+            return max_drawdown_ > 0.0 || equity_floor_ > 0.0 || checkpoint_bar_ > 0;
+        }
+    };
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,82 @@
+/**
+ * @file SweepRunner.hpp
+ * @brief Parallel parameter sweep that prunes runs falling behind the best so far.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "domain/Quote.hpp"
+#include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Result.hpp"
+#include "domain/backtest/StopRules.hpp"
+#include "strategy/IStrategy.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @brief Sweep settings.
+     */
+    struct SweepParams
+    {
+        StopRules rules_;          ///< Base rules applied to every run.
+        double behind_best_ = 0.0; ///< Abort at `rules_.checkpoint_bar_` if equity trails the best
+                                   ///< completed run there by more than this (0 = off).
+        std::size_t threads_ = 0;  ///< Worker threads (0 = hardware concurrency).
+    };
+
+    /**
+     * @brief Outcome of a sweep.
+     */
+    struct SweepResult
+    {
+        std::vector<BacktestResult> results_; ///< One result per candidate, in input order.
+        std::optional<std::size_t> best_;     ///< Highest final equity among completed runs
+                                              ///< (empty when every run aborted).
+        std::size_t aborted_ = 0;             ///< Runs stopped early by a rule.
+        std::size_t bars_processed_ = 0;      ///< Total bars simulated.
+    };
+
+    /**
+     * @class SweepRunner
+     * @brief Runs many candidates in parallel with shared, tightening stop rules.
+     *
+     * Every run uses the base rules. With `behind_best_` set, each completed
+     * run that beats the current best publishes its checkpoint equity; runs
+     * starting afterwards abort at the checkpoint when they trail it by more
+     * than `behind_best_`. The bar is raised as better results arrive, so the
+     * later part of a sweep prunes more aggressively. With several threads
+     * the pruning of borderline runs depends on completion order; a single
+     * thread is fully deterministic.
+     */
+    class SweepRunner
+    {
+      public:
+        /// Creates the strategy for candidate @p index. Called concurrently.
+        using StrategyFactory =
+            std::function<std::unique_ptr<strategy::IStrategy>(std::size_t index)>;
+
+        /**
+         * @throws std::invalid_argument if `behind_best_` is set without a checkpoint bar.
+         */
+        SweepRunner(double initial_equity, ExecParams exec, SweepParams params);
+
+        /**
+         * @brief Backtests candidates `0 .. count-1` over @p bars.
+         */
+        SweepResult run(std::span<const Quote> bars, std::size_t count,
+                        const StrategyFactory& make) const;
+
+      private:
+        double initial_equity_; ///< Starting capital per run.
+        ExecParams exec_;       ///< Execution model.
+        SweepParams params_;    ///< Rules and threading.
+    };
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,141 @@
+/**
+ * @file VolumeFillModel.hpp
+ * @brief Market orders filled over several bars under a volume participation cap,
+ *        priced with square-root market impact.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "domain/Instrument.hpp"
+#include "domain/Quote.hpp"
+#include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Order.hpp"
+#include "domain/backtest/OrderBook.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @brief Participation and impact settings of a VolumeFillModel.
+     */
+    struct VolumeFillParams
+    {
+        /// Largest share of a bar's volume filled per instrument, in (0, 1].
+        double max_participation_ = 0.1;
+        /// Square-root law prefactor Y (>= 0; 0 disables impact).
+        double impact_coef_ = 1.0;
+        /// Per-bar volatility sigma; 0 = use the bar range (high - low) / price.
+        double volatility_ = 0.0;
+    };
+
+    /**
+     * @class VolumeFillModel
+     * @brief Executes market orders against bar volume, carrying unfilled remainders.
+     *
+     * Each bar of an instrument offers `max_participation_ * volume` units.
+     * Open orders of that instrument take it in submission order; whatever an
+     * order cannot get stays queued for the next bar. The queue per instrument
+     * is a flat array of order ids with a moving head, so a bar touches only
+     * the orders it fills plus one.
+     *
+     * Fill price: the bar's typical price `P = (high + low + close) / 3` moved
+     * against the order by the square-root law
+     * `P * Y * sigma * sqrt(q / V)`, where `q` is the quantity this instrument
+     * has filled so far in the bar (the order's own slice included) and `V`
+     * the bar volume; market slippage from ExecParams is applied on top.
+     * Buys and sells share the participation budget.
+     *
+     * Fills reuse the OrderBook Fill record; `quantity_` is the slice filled on
+     * that bar.
+     *
+     * PortfolioEngine executes signal orders through this model when it is
+     * constructed with VolumeFillParams.
+     */
+    class VolumeFillModel
+    {
+      public:
+        /**
+         * @brief Constructs an empty model.
+         * @throws std::invalid_argument if max_participation_ is not in (0, 1]
+         *         or impact_coef_ / volatility_ is negative.
+         */
+        explicit VolumeFillModel(VolumeFillParams params = {}, ExecParams exec = {});
+
+        /**
+         * @brief Returns the stable slot index of an instrument (created on first use).
+         */
+        std::size_t slotFor(const domain::Instrument& ins);
+
+        /**
+         * @brief Queues a market order.
+         * @throws std::invalid_argument for non-market orders.
+         */
+        OrderId submit(const Order& order);
+
+        /**
+         * @brief Queues a market order for an existing slot.
+         * @throws std::invalid_argument if @p quantity is not > 0.
+         * @throws std::out_of_range for unknown slots.
+         */
+        OrderId submit(std::size_t slot, Side side, double quantity);
+
+        /**
+         * @brief Cancels the unfilled remainder of an order.
+         * @return True if something was still open.
+         */
+        bool cancel(OrderId id);
+
+        /// @return Quantity still to fill (0 once filled or cancelled).
+        double remaining(OrderId id) const { return records_.at(id).remaining_; }
+
+        /// @return Quantity filled so far.
+        double filled(OrderId id) const { return records_.at(id).filled_; }
+
+        /// @return Volume-weighted fill price so far (0 before the first fill).
+        double averagePrice(OrderId id) const
+        {
+            const auto& r = records_.at(id);
+            return r.filled_ > 0.0 ? r.notional_ / r.filled_ : 0.0;
+        }
+
+        /// @return Orders with a remainder across all instruments.
+        std::size_t openOrders() const noexcept { return open_; }
+
+        /**
+         * @brief Fills queued orders of one instrument against one bar.
+         * @param slot  Instrument slot (from slotFor()).
+         * @param bar   Bar of that instrument.
+         * @param fills Output; fills are appended in execution order.
+         */
+        void onBar(std::size_t slot, const Quote& bar, std::vector<Fill>& fills);
+
+      private:
+        struct Record
+        {
+            std::size_t slot_;
+            Side side_;
+            double remaining_;
+            double filled_ = 0.0;
+            double notional_ = 0.0;
+        };
+
+        struct Queue
+        {
+            std::vector<OrderId> ids_; ///< FIFO of orders with a remainder (some cancelled).
+            std::size_t head_ = 0;     ///< First live position in ids_.
+        };
+
+        VolumeFillParams params_;
+        ExecParams exec_;
+        std::vector<Record> records_;                        ///< Per order id.
+        std::vector<Queue> queues_;                          ///< Per instrument slot.
+        std::unordered_map<std::string, std::size_t> slots_; ///< Instrument key -> slot.
+        std::size_t open_ = 0;
+    };
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,146 @@
+/**
+ * @file WalkForward.hpp
+ * @brief Walk-forward optimisation: in-sample parameter sweeps, out-of-sample evaluation.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "domain/backtest/BarSeries.hpp"
+#include "domain/backtest/Execution.hpp"
+#include "domain/backtest/Result.hpp"
+#include "strategy/IStrategy.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @enum WindowMode
+     * @brief How the training window moves between folds.
+     *
+     * - Rolling: fixed-length window ending where the test window starts.
+     * - Anchored: window always starts at the first bar and grows.
+     */
+    enum class WindowMode
+    {
+        Rolling,
+        Anchored
+    };
+
+    /**
+     * @brief Fold layout and execution settings.
+     */
+    struct WalkForwardParams
+    {
+        std::int64_t train_span_ = 0;           ///< Training window length (timestamp units).
+        std::int64_t test_span_ = 0;            ///< Test window length; folds advance by this much.
+        WindowMode mode_ = WindowMode::Rolling; ///< Rolling or anchored training window.
+        std::size_t threads_ = 0;               ///< Worker threads (0 = hardware concurrency).
+        bool warm_start_ = true;                ///< Warm test runs on training bars (snapshots).
+    };
+
+    /**
+     * @brief One train/test split as half-open bar index ranges.
+     */
+    struct Fold
+    {
+        std::size_t train_begin_ = 0; ///< First training bar.
+        std::size_t train_end_ = 0;   ///< One past the last training bar.
+        std::size_t test_begin_ = 0;  ///< First test bar (== train_end_).
+        std::size_t test_end_ = 0;    ///< One past the last test bar.
+    };
+
+    /**
+     * @brief Outcome of one fold.
+     */
+    struct FoldResult
+    {
+        Fold fold_;                  ///< Bar ranges used.
+        std::size_t best_param_ = 0; ///< Parameter index chosen on the training window.
+        double train_score_ = 0.0;   ///< Objective value of that parameter in-sample.
+        BacktestResult test_;        ///< Out-of-sample result of that parameter.
+    };
+
+    /**
+     * @brief Outcome of a walk-forward run.
+     */
+    struct WalkForwardResult
+    {
+        std::vector<FoldResult> folds_;    ///< Per-fold results in time order.
+        std::vector<std::int64_t> oos_ts_; ///< Timestamps of the stitched curve.
+        std::vector<double> oos_equity_;   ///< Stitched out-of-sample equity curve.
+    };
+
+    /**
+     * @class WalkForward
+     * @brief Splits a series into train/test folds by timestamp and optimises per fold.
+     *
+     * For every fold each candidate parameter set (an index understood by the
+     * strategy factory) is backtested on the training window; the best one by
+     * the objective is then run on the following test window. All
+     * (fold, parameter) training runs and all test runs execute in parallel;
+     * windows are spans over the original bars, so no data is copied.
+     *
+     * Each test window starts flat with the initial equity. With `warm_start_`
+     * the strategy first consumes its fold's training bars (signals ignored,
+     * via WarmupCache and Engine::runFrom()), so its indicators are ready on
+     * the first test bar; the strategy must then implement saveState() /
+     * loadState(). Without it every test run starts from onStart(). The stitched curve
+     * chains the windows additively: every window's P&L is appended to the
+     * equity level where the previous window ended (its close-out value).
+     */
+    class WalkForward
+    {
+      public:
+        /// Creates the strategy for parameter index @p param. Called concurrently.
+        using StrategyFactory =
+            std::function<std::unique_ptr<strategy::IStrategy>(std::size_t param)>;
+
+        /// Scores an in-sample result; higher is better.
+        using Objective = std::function<double(const BacktestResult&)>;
+
+        /**
+         * @brief Constructs the optimiser.
+         * @param initial_equity Starting capital of every window.
+         * @param exec Execution parameters (slippage, commission).
+         * @param params Fold layout and threading.
+         * @throws std::invalid_argument if a window span is not positive.
+         */
+        WalkForward(double initial_equity, ExecParams exec, WalkForwardParams params);
+
+        /**
+         * @brief Computes the folds for @p bars (sorted by timestamp).
+         *
+         * The first test window starts `train_span_` after the first bar; folds
+         * advance by `test_span_` until the data ends. Folds with an empty
+         * training or test window are skipped.
+         */
+        static std::vector<Fold> makeFolds(std::span<const Quote> bars,
+                                           const WalkForwardParams& params);
+
+        /**
+         * @brief Runs the walk-forward optimisation.
+         * @param series Input bars.
+         * @param param_count Number of candidate parameter sets.
+         * @param make_strategy Factory for a parameter index (must be thread-safe).
+         * @param objective In-sample score (default: final equity). Ties pick the lower index.
+         * @return Per-fold choices and the stitched out-of-sample equity curve.
+         * @throws std::invalid_argument if @p param_count is zero.
+         * @throws std::logic_error with `warm_start_` if the strategy does not support snapshots.
+         */
+        WalkForwardResult run(const BarSeries& series, std::size_t param_count,
+                              const StrategyFactory& make_strategy,
+                              const Objective& objective = {}) const;
+
+      private:
+        double initial_equity_;    ///< Starting capital per window.
+        ExecParams exec_;          ///< Execution model.
+        WalkForwardParams params_; ///< Fold layout.
+    };
+
+} // namespace qga::domain::backtest
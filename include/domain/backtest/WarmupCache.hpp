@@ -0,0 +1,114 @@
+/**
+ * @file WarmupCache.hpp
+ * @brief Shared cache of warmed-up strategy state, so repeated runs skip indicator warm-up.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "domain/Quote.hpp"
+#include "strategy/IStrategy.hpp"
+
+namespace qga::domain::backtest
+{
+
+    /**
+     * @brief Identifies one strategy configuration on one series.
+     */
+    struct WarmupKey
+    {
+        std::string strategy_;       ///< Strategy name.
+        std::vector<double> params_; ///< Strategy parameters.
+        std::uint64_t series_ = 0;   ///< Series identity, e.g. seriesFingerprint().
+
+        auto operator<=>(const WarmupKey&) const = default;
+    };
+
+    /**
+     * @brief Hit/miss figures of a WarmupCache.
+     */
+    struct WarmupStats
+    {
+        std::size_t hits_ = 0;     ///< Exact snapshot found.
+        std::size_t extended_ = 0; ///< Continued from an earlier snapshot.
+        std::size_t misses_ = 0;   ///< Warmed up from the first bar.
+        std::size_t bars_fed_ = 0; ///< Bars fed to strategies while warming up.
+    };
+
+    /**
+     * @brief FNV-1a hash over every bar's timestamp and OHLCV bits.
+     *
+     * Cheap relative to a warm-up and computed once per series; two series
+     * with equal fingerprints are treated as the same data.
+     */
+    std::uint64_t seriesFingerprint(std::span<const Quote> bars) noexcept;
+
+    /**
+     * @class WarmupCache
+     * @brief Strategy snapshots per (strategy, params, series, timestamp).
+     *
+     * state() returns the strategy state after onStart() and onBar() over all
+     * bars stamped before a given time, signals ignored. Snapshots of the same
+     * key are kept ordered by timestamp: a request after an existing snapshot
+     * continues from the latest earlier one, so a sequence of walk-forward or
+     * rolling start points costs one pass over the history in total rather than
+     * one per start point.
+     *
+     * Thread-safe. Warm-ups run outside the lock, so two threads asking for the
+     * same missing snapshot may both compute it; the first stored copy wins.
+     * When more than `max_snapshots` are held, the oldest inserted are evicted.
+     */
+    class WarmupCache
+    {
+      public:
+        using State = std::vector<std::uint8_t>;
+
+        explicit WarmupCache(std::size_t max_snapshots = 4096);
+
+        /**
+         * @brief Strategy state at @p at for @p key, computing and caching it if needed.
+         * @param key   Strategy configuration and series identity.
+         * @param bars  The series @p key refers to (sorted by timestamp).
+         * @param at    Snapshot time: bars with `ts_ < at` are fed.
+         * @param strat Scratch strategy of the configuration in @p key; its state
+         *              is overwritten. Must implement saveState()/loadState().
+         * @return Shared, immutable snapshot suitable for Engine::runFrom().
+         * @throws std::logic_error if the strategy does not support snapshots.
+         */
+        std::shared_ptr<const State> state(const WarmupKey& key, std::span<const Quote> bars,
+                                           std::int64_t at, strategy::IStrategy& strat);
+
+        /// @return Cached snapshot at exactly @p at, or null.
+        std::shared_ptr<const State> find(const WarmupKey& key, std::int64_t at) const;
+
+        /// @return Number of cached snapshots.
+        std::size_t size() const;
+
+        /// @return Counters since construction or the last clear().
+        WarmupStats stats() const;
+
+        /// @brief Drops every snapshot and resets the counters.
+        void clear();
+
+      private:
+        using Snapshots = std::map<std::int64_t, std::shared_ptr<const State>>;
+
+        void insert(const WarmupKey& key, std::int64_t at, std::shared_ptr<const State> state);
+
+        std::size_t max_snapshots_;
+        mutable std::mutex mutex_;
+        std::map<WarmupKey, Snapshots> entries_;
+        std::deque<std::pair<WarmupKey, std::int64_t>> order_; ///< Insertion order for eviction.
+        WarmupStats stats_;
+    };
+
+} // namespace qga::domain::backtest
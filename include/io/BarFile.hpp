@@ -0,0 +1,58 @@
+/**
+ * @file BarFile.hpp
+ * @brief Flat binary bar format that worker processes can map instead of parsing CSV.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "domain/Quote.hpp"
+#include "io/MappedFile.hpp"
+
+namespace qga::io
+{
+
+    /**
+     * @brief Writes @p bars as a bar file (header + raw Quote array).
+     *
+     * Layout: 32-byte header (magic "QGBF", version, record size, bar count,
+     * domain::backtest::seriesFingerprint()) followed by the bars in the host's native layout, so a
+     * mapped file is used in place without decoding. Files are meant for
+     * processes of the same build on the same machine.
+     *
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void writeBarFile(const std::filesystem::path& path, std::span<const domain::Quote> bars);
+
+    /**
+     * @class MappedBarFile
+     * @brief Zero-copy read access to a bar file.
+     */
+    class MappedBarFile
+    {
+      public:
+        /**
+         * @brief Maps and validates @p path.
+         * @param path   Bar file.
+         * @param verify Recompute the fingerprint (one pass over the data); skip it
+         *               for files the caller just wrote.
+         * @throws std::runtime_error on a missing, foreign, truncated or corrupt file.
+         */
+        explicit MappedBarFile(const std::filesystem::path& path, bool verify = true);
+
+        /// @return The bars, valid for the lifetime of this object.
+        std::span<const domain::Quote> bars() const noexcept { return bars_; }
+
+        /// @return domain::backtest::seriesFingerprint() of the bars, as stored in the header.
+        std::uint64_t contentHash() const noexcept { return hash_; }
+
+      private:
+        MappedFile file_;
+        std::span<const domain::Quote> bars_;
+        std::uint64_t hash_ = 0;
+    };
+
+} // namespace qga::io
@@ -0,0 +1,95 @@
+/**
+ * @file IndicatorStore.hpp
+ * @brief Persistent, memory-mapped indicator columns stored next to a dataset.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "domain/Quote.hpp"
+#include "strategy/indicators/IndicatorCache.hpp"
+
+namespace qga::io
+{
+
+    /**
+     * @brief Load/compute figures of an IndicatorStore.
+     */
+    struct IndicatorStoreStats
+    {
+        std::size_t loaded_ = 0;      ///< Columns mapped from disk.
+        std::size_t computed_ = 0;    ///< Columns computed and written.
+        std::size_t invalidated_ = 0; ///< Files rejected or removed because the series changed.
+    };
+
+    /**
+     * @class IndicatorStore
+     * @brief Directory of indicator columns that survive across runs.
+     *
+     * Each column lives in its own file named after the indicator, its period
+     * and the content hash of the series (`key.series_`, which must be
+     * domain::backtest::seriesFingerprint() of the bars, e.g.
+     * MappedBarFile::contentHash()). The
+     * file holds a 64-byte header followed by the raw doubles and is mapped,
+     * not parsed, on load. When the dataset changes its hash changes too:
+     * the old files are no longer addressed and are deleted as soon as the
+     * same indicator is written for the new content. A header that does not
+     * match the bars (length, first/last timestamp) is treated as a miss.
+     *
+     * Files are written to a temporary name and renamed into place, so
+     * concurrent processes sharing a store never see partial columns.
+     * Like bar files, columns use the host's native layout.
+     *
+     * Thread-safe; combine with an in-process IndicatorCache through source().
+     */
+    class IndicatorStore
+    {
+      public:
+        /**
+         * @brief Opens (and creates if needed) the store directory @p dir.
+         * @throws std::runtime_error if the directory cannot be created.
+         */
+        explicit IndicatorStore(std::filesystem::path dir);
+
+        /// @return Default store directory of a dataset: `<dataset>.indicators` alongside it.
+        static std::filesystem::path directoryFor(const std::filesystem::path& dataset);
+
+        /**
+         * @brief Column for @p key: mapped from disk, or computed and persisted.
+         * @param key  Indicator key; `key.series_` is the content hash of @p bars.
+         * @param bars The series.
+         * @throws std::invalid_argument if `key.period_` is 0.
+         * @throws std::runtime_error if a computed column cannot be written.
+         */
+        strategy::indicators::IndicatorHandle get(const strategy::indicators::IndicatorKey& key,
+                                                  std::span<const domain::Quote> bars);
+
+        /// @return File that holds the column of @p key.
+        std::filesystem::path pathFor(const strategy::indicators::IndicatorKey& key) const;
+
+        /**
+         * @brief Deletes every column file that does not belong to @p series.
+         * @return Number of files removed.
+         */
+        std::size_t prune(std::uint64_t series);
+
+        /// @return A source reading through this store for an IndicatorCache it must outlive.
+        strategy::indicators::IndicatorCache::ColumnSource source();
+
+        const std::filesystem::path& directory() const noexcept { return dir_; }
+
+        IndicatorStoreStats stats() const noexcept;
+
+      private:
+        std::filesystem::path dir_;
+        std::atomic<std::size_t> loaded_{0};
+        std::atomic<std::size_t> computed_{0};
+        std::atomic<std::size_t> invalidated_{0};
+    };
+
+} // namespace qga::io
@@ -0,0 +1,56 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only memory mapping of a whole file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace qga::io
+{
+
+    /**
+     * @class MappedFile
+     * @brief Maps a file read-only into memory for its lifetime.
+     *
+     * On POSIX systems the file is mmap'ed, so processes mapping the same file
+     * share one copy in the page cache. Elsewhere the contents are read into
+     * an owned buffer, which keeps the interface identical. The mapping starts
+     * page-aligned; an empty file yields an empty span.
+     */
+    class MappedFile
+    {
+      public:
+        /**
+         * @brief Maps @p path.
+         * @throws std::runtime_error if the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// @return The file contents.
+        std::span<const std::uint8_t> bytes() const noexcept { return {data_, size_}; }
+
+        /// @return File size in bytes.
+        std::size_t size() const noexcept { return size_; }
+
+      private:
+        void release() noexcept;
+
+        const std::uint8_t* data_ = nullptr;
+        std::size_t size_ = 0;
+        bool mapped_ = false;              ///< True when data_ is an mmap region.
+        std::vector<std::uint8_t> buffer_; ///< Fallback storage when mapping is unavailable.
+    };
+
+} // namespace qga::io
@@ -38,6 +38,16 @@ public:
      */
     void onFinish() override;
 
+    /**
+     * @brief Serialize rolling state for checkpointing.
+     */
+    void saveState(StateWriter& out) const override;
+
+    /**
+     * @brief Restore state written by saveState().
+     */
+    void loadState(StateReader& in) override;
+
     private:
         bool has_bought_ = false;  ///< Flag to track if a buy has been made.
 };
@@ -0,0 +1,57 @@
+/**
+ * @file CrossSectionalMomentum.hpp
+ * @brief Ranks the universe by trailing return; long the leaders, optionally short the laggards.
+ */
+#pragma once
+#include <cstddef>
+#include "strategy/ICrossSectionalStrategy.hpp"
+
+namespace qga::strategy
+{
+
+    /**
+     * @class CrossSectionalMomentum
+     * @brief Every @p period rows, holds the @p long_k symbols with the best
+     *        return over the last @p lookback rows at +1/long_k each and the
+     *        @p short_k worst at -1/short_k each.
+     *
+     * With @p reversal the ranking is inverted (long the losers, short the
+     * winners), the classic short-horizon mean-reversion portfolio. Symbols
+     * without a close at either end of the lookback are not ranked. If fewer
+     * than `long_k + short_k` symbols are ranked, the longs are picked first and
+     * the shorts come from the rest, so no symbol is on both sides.
+     *
+     * Stateless: every rebalance reads only the cross-section, so the engine may
+     * evaluate rebalances in parallel.
+     *
+     * Implements the @ref ICrossSectionalStrategy interface.
+     */
+    class CrossSectionalMomentum final : public ICrossSectionalStrategy
+    {
+      public:
+        /**
+         * @brief Constructs the strategy.
+         * @param lookback Rows over which the return is measured (>= 1).
+         * @param long_k   Symbols held long.
+         * @param short_k  Symbols held short (0 = long only).
+         * @param period   Rows between rebalances (>= 1).
+         * @param reversal Rank by the negated return (mean reversion).
+         * @throws std::invalid_argument if lookback or period is 0, or both k are 0.
+         */
+        CrossSectionalMomentum(std::size_t lookback, std::size_t long_k, std::size_t short_k = 0,
+                               std::size_t period = 21, bool reversal = false);
+
+        bool targetWeights(const CrossSection& slice, std::span<double> weights,
+                           Ranker& ranker) override;
+
+        bool stateless() const noexcept override { return true; }
+
+      private:
+        std::size_t lookback_; ///< Return horizon in rows.
+        std::size_t long_k_;   ///< Long positions.
+        std::size_t short_k_;  ///< Short positions.
+        std::size_t period_;   ///< Rows between rebalances.
+        bool reversal_;        ///< Invert the ranking.
+    };
+
+} // namespace qga::strategy
@@ -0,0 +1,39 @@
+/**
+ * @file EqualWeight.hpp
+ * @brief Baseline allocation: equal weight across every priced symbol.
+ */
+#pragma once
+#include <cstddef>
+#include "strategy/IWeightStrategy.hpp"
+
+namespace qga::strategy
+{
+
+    /**
+     * @class EqualWeight
+     * @brief Holds 1/k of equity in each of the k symbols that have a price,
+     *        rebalancing every @p period rows.
+     *
+     * Implements the @ref IWeightStrategy interface.
+     */
+    class EqualWeight final : public IWeightStrategy
+    {
+      public:
+        /**
+         * @brief Constructs the strategy.
+         * @param period Rows between rebalances (>= 1).
+         * @throws std::invalid_argument if period is 0.
+         */
+        explicit EqualWeight(std::size_t period = 21);
+
+        void onStart(std::size_t symbols) override;
+
+        bool targetWeights(std::int64_t ts, std::span<const double> prices,
+                           std::span<double> weights) override;
+
+      private:
+        std::size_t period_;  ///< Rows between rebalances.
+        std::size_t row_ = 0; ///< Rows seen so far.
+    };
+
+} // namespace qga::strategy
@@ -0,0 +1,51 @@
+/**
+ * @file IBatchStrategy.hpp
+ * @brief Strategy interface consuming all symbols' bars of one timestamp at once.
+ */
+#pragma once
+#include <cstdint>
+#include <span>
+#include "domain/BarEvent.hpp"
+
+namespace qga::strategy
+{
+
+    /**
+     * @class IBatchStrategy
+     * @brief Contract for multi-symbol strategies driven by an event scheduler.
+     *
+     * Symbols may follow different trading calendars. For every distinct
+     * timestamp the scheduler calls @ref onBatch() once with the bars of all
+     * symbols that traded at that time, ordered by symbol index.
+     *
+     * - @ref onStart(n)       → called once with the universe size.
+     * - @ref onBatch(ts, b)   → called for each timestamp, in ascending order.
+     * - @ref onFinish()       → called once after the last batch.
+     */
+    class IBatchStrategy
+    {
+      public:
+        /**
+         * @brief Virtual destructor.
+         */
+        virtual ~IBatchStrategy() = default;
+
+        /**
+         * @brief Prepare internal state for a universe of @p symbols series.
+         */
+        virtual void onStart(std::size_t /*symbols*/) {}
+
+        /**
+         * @brief Consume every bar stamped @p ts.
+         * @param ts    Common timestamp of the batch (epoch millis).
+         * @param batch Bars of the symbols that traded at @p ts (non-empty).
+         */
+        virtual void onBatch(std::int64_t ts, std::span<const domain::BarEvent> batch) = 0;
+
+        /**
+         * @brief Cleanup or finalize strategy state. Called after the last batch.
+         */
+        virtual void onFinish() {}
+    };
+
+} // namespace qga::strategy
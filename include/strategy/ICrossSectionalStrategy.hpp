@@ -0,0 +1,113 @@
+/**
+ * @file ICrossSectionalStrategy.hpp
+ * @brief Strategy interface ranking a whole universe at one timestamp.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace qga::strategy
+{
+
+    class Ranker;
+
+    /**
+     * @class CrossSection
+     * @brief Read-only view of one timestamp of a multi-symbol panel, with its history.
+     *
+     * Closes are dense arrays indexed by panel column; NaN marks a symbol
+     * without a bar at that row. Earlier rows are reachable through the lag
+     * argument, so a strategy can compute e.g. 12-month momentum without
+     * keeping state of its own. The view points into the panel and copies
+     * nothing.
+     */
+    class CrossSection
+    {
+      public:
+        /**
+         * @param ts      Timestamp of the row (epoch millis).
+         * @param row     Row index in the panel.
+         * @param close0  Close matrix of the panel (row 0).
+         * @param stride  Row stride of the matrix in doubles.
+         * @param symbols Number of real columns.
+         */
+        CrossSection(std::int64_t ts, std::size_t row, const double* close0, std::size_t stride,
+                     std::size_t symbols) noexcept
+            : ts_(ts), row_(row), close0_(close0), stride_(stride), symbols_(symbols)
+        {
+        }
+
+        std::int64_t ts() const noexcept { return ts_; }
+        std::size_t row() const noexcept { return row_; }
+        std::size_t symbols() const noexcept { return symbols_; }
+
+        /**
+         * @return Closes @p lag rows before this one (0 = this row).
+         * @pre `lag <= row()`.
+         */
+        std::span<const double> close(std::size_t lag = 0) const noexcept
+        {
+            return {close0_ + (row_ - lag) * stride_, symbols_};
+        }
+
+      private:
+        std::int64_t ts_;      ///< Timestamp of the row.
+        std::size_t row_;      ///< Row index.
+        const double* close0_; ///< First row of the close matrix.
+        std::size_t stride_;   ///< Row stride in doubles.
+        std::size_t symbols_;  ///< Real columns.
+    };
+
+    /**
+     * @class ICrossSectionalStrategy
+     * @brief Contract for ranking strategies (momentum, mean reversion) run by the rebalancer.
+     *
+     * At every row the strategy sees the cross-section of the universe and may
+     * request target weights, typically by scoring each symbol and selecting
+     * the top / bottom k with the supplied @ref Ranker, whose buffers are reused
+     * across rows.
+     *
+     * - @ref onStart(n)                        → called once with the universe size.
+     * - @ref targetWeights(slice, w, ranker)   → called for every row.
+     * - @ref onFinish()                        → called once after the last row.
+     *
+     * A strategy whose @ref stateless() returns true promises that
+     * targetWeights() depends only on its arguments: the engine may then call it
+     * concurrently from several threads, for rows in any order.
+     */
+    class ICrossSectionalStrategy
+    {
+      public:
+        /**
+         * @brief Virtual destructor.
+         */
+        virtual ~ICrossSectionalStrategy() = default;
+
+        /**
+         * @brief Prepare internal state for a universe of @p symbols columns.
+         */
+        virtual void onStart(std::size_t /*symbols*/) {}
+
+        /**
+         * @brief Optionally request new target weights at one row.
+         * @param slice   The row, with access to earlier rows.
+         * @param weights All zero on entry; fill in the targets (negative = short).
+         * @param ranker  Selection scratch owned by the calling thread.
+         * @return True to rebalance to @p weights at this row, false to keep the holdings.
+         */
+        virtual bool targetWeights(const CrossSection& slice, std::span<double> weights,
+                                   Ranker& ranker) = 0;
+
+        /**
+         * @brief True if targetWeights() keeps no state between rows (see class notes).
+         */
+        virtual bool stateless() const noexcept { return false; }
+
+        /**
+         * @brief Cleanup or finalize strategy state. Called after the last row.
+         */
+        virtual void onFinish() {}
+    };
+
+} // namespace qga::strategy
@@ -0,0 +1,116 @@
+/**
+ * @file IOrderStrategy.hpp
+ * @brief Strategy interface placing resting limit / stop orders instead of signals.
+ */
+#pragma once
+#include <cstdint>
+#include "domain/Quote.hpp"
+#include "domain/backtest/Order.hpp"
+
+namespace qga::strategy
+{
+
+    /// Identifier of a placed order (same value as the engine's OrderBook id).
+    using OrderTicket = std::uint32_t;
+
+    /**
+     * @class OrderSink
+     * @brief Where an IOrderStrategy places and cancels orders for its instrument.
+     *
+     * Orders placed while a bar is being processed rest from the next bar on;
+     * the engine never fills them against a bar the strategy has already seen.
+     */
+    class OrderSink
+    {
+      public:
+        virtual ~OrderSink() = default;
+
+        /**
+         * @brief Places a resting order.
+         * @param side        Buy or sell.
+         * @param type        Limit, Stop or StopLimit.
+         * @param quantity    Positive quantity.
+         * @param limit_price Limit price (Limit, StopLimit).
+         * @param stop_price  Trigger price (Stop, StopLimit).
+         * @return Ticket of the order.
+         * @throws std::invalid_argument for market orders or missing prices.
+         */
+        virtual OrderTicket place(domain::backtest::Side side, domain::backtest::OrderType type,
+                                  double quantity, double limit_price, double stop_price) = 0;
+
+        /**
+         * @brief Cancels an open order.
+         * @return True if the order was still open.
+         */
+        virtual bool cancel(OrderTicket ticket) = 0;
+
+        OrderTicket limit(domain::backtest::Side side, double quantity, double price)
+        {
+            return place(side, domain::backtest::OrderType::Limit, quantity, price, 0.0);
+        }
+
+        OrderTicket stop(domain::backtest::Side side, double quantity, double stop_price)
+        {
+            return place(side, domain::backtest::OrderType::Stop, quantity, 0.0, stop_price);
+        }
+
+        OrderTicket stopLimit(domain::backtest::Side side, double quantity, double stop_price,
+                              double limit_price)
+        {
+            return place(side, domain::backtest::OrderType::StopLimit, quantity, limit_price,
+                         stop_price);
+        }
+    };
+
+    /**
+     * @class IOrderStrategy
+     * @brief Contract for strategies that work resting orders (ladders, grids).
+     *
+     * Instead of returning a @ref Signal per bar, the strategy keeps any number
+     * of limit, stop and stop-limit orders in the engine's order book and is
+     * told about every execution.
+     *
+     * - @ref onStart()          → called once before the first bar.
+     * - @ref onBar(q, orders)   → called for each bar, after that bar's fills.
+     * - @ref onFill(...)        → called for each execution, before @ref onBar() of its bar.
+     * - @ref onFinish()         → called once after the final bar.
+     */
+    class IOrderStrategy
+    {
+      public:
+        /**
+         * @brief Virtual destructor.
+         */
+        virtual ~IOrderStrategy() = default;
+
+        /**
+         * @brief Prepare internal state. Called once before streaming bars.
+         */
+        virtual void onStart() {}
+
+        /**
+         * @brief Consume next market bar; place or cancel orders through @p orders.
+         */
+        virtual void onBar(const domain::Quote& q, OrderSink& orders) = 0;
+
+        /**
+         * @brief An order executed.
+         *
+         * @param ticket   Ticket returned by OrderSink::place().
+         * @param side     Side of the order.
+         * @param price    Execution price.
+         * @param quantity Executed quantity (may be less than ordered, see the engine).
+         * @param orders   Sink for follow-up orders.
+         */
+        virtual void onFill(OrderTicket /*ticket*/, domain::backtest::Side /*side*/,
+                            double /*price*/, double /*quantity*/, OrderSink& /*orders*/)
+        {
+        }
+
+        /**
+         * @brief Cleanup or finalize strategy state. Called after the last bar.
+         */
+        virtual void onFinish() {}
+    };
+
+} // namespace qga::strategy
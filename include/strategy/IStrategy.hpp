@@ -3,10 +3,17 @@
  * @brief Strategy interface returning trading signals per bar.
  */
 #pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
 #include "domain/Quote.hpp"
+#include "strategy/Timeframe.hpp"
 
 namespace qga::strategy {
 
+class StateWriter;
+class StateReader;
+
 /**
  * @enum Signal
  * @brief Possible trading decisions a strategy can emit at a bar.
@@ -29,6 +36,14 @@ enum class Signal { None, Buy, Sell };
  * - @ref onFinish()  → called once after the final bar.
  *
  * Strategies must be stateless across multiple backtests or reset properly.
+ *
+ * Strategies that override @ref saveState() / @ref loadState() can be
+ * checkpointed mid-run and resumed later (see Engine::resume()).
+ *
+ * Strategies that need coarser context (hourly, daily bars next to the
+ * 1-minute stream) list it in @ref timeframes(). The engine resamples the
+ * stream as it goes and calls @ref onTimeframeBar() with each bar once it has
+ * closed, before the @ref onBar() call of the same moment (see TimeframeFeed).
  */
 class IStrategy {
 public:
@@ -54,6 +69,35 @@ public:
      * @brief Cleanup or finalize strategy state. Called after the last bar.
      */
     virtual void onFinish() {}
+
+    /**
+     * @brief Higher timeframes this strategy wants to receive (default: none).
+     */
+    virtual std::vector<Timeframe> timeframes() const { return {}; }
+
+    /**
+     * @brief A bar of `timeframes()[index]` has closed.
+     *
+     * @param index Position of the timeframe in @ref timeframes().
+     * @param bar   The resampled bar (timestamp = period start).
+     */
+    virtual void onTimeframeBar(std::size_t /*index*/, const domain::Quote& /*bar*/) {}
+
+    /**
+     * @brief Serialize everything @ref onBar() depends on.
+     * @throws std::logic_error if the strategy does not support snapshots.
+     */
+    virtual void saveState(StateWriter& /*out*/) const {
+        throw std::logic_error("strategy does not support state snapshots");
+    }
+
+    /**
+     * @brief Restore state written by @ref saveState(); replaces @ref onStart().
+     * @throws std::logic_error if the strategy does not support snapshots.
+     */
+    virtual void loadState(StateReader& /*in*/) {
+        throw std::logic_error("strategy does not support state snapshots");
+    }
 };
 
 } // namespace qga::strategy
@@ -0,0 +1,54 @@
+/**
+ * @file IWeightStrategy.hpp
+ * @brief Strategy interface returning target portfolio weights over a universe.
+ */
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace qga::strategy
+{
+
+    /**
+     * @class IWeightStrategy
+     * @brief Contract for allocation strategies driven by the rebalance engine.
+     *
+     * Instead of per-symbol Buy/Sell signals the strategy sees the whole
+     * universe at once and states the fraction of equity it wants in each
+     * symbol. Prices and weights are dense arrays indexed by panel column.
+     *
+     * - @ref onStart(n)                  → called once with the universe size.
+     * - @ref targetWeights(ts, p, w)     → called for every timestamp, in ascending order.
+     * - @ref onFinish()                  → called once after the last timestamp.
+     */
+    class IWeightStrategy
+    {
+      public:
+        /**
+         * @brief Virtual destructor.
+         */
+        virtual ~IWeightStrategy() = default;
+
+        /**
+         * @brief Prepare internal state for a universe of @p symbols columns.
+         */
+        virtual void onStart(std::size_t /*symbols*/) {}
+
+        /**
+         * @brief Update state and optionally request new target weights.
+         * @param ts      Timestamp of the row (epoch millis).
+         * @param prices  Latest close per symbol, carried over gaps; NaN before its first bar.
+         * @param weights Holds the current targets (all zero initially); overwrite to change them.
+         *                Negative weights are short positions; the sum may differ from 1.
+         * @return True to rebalance to @p weights at this row, false to keep the holdings.
+         */
+        virtual bool targetWeights(std::int64_t ts, std::span<const double> prices,
+                                   std::span<double> weights) = 0;
+
+        /**
+         * @brief Cleanup or finalize strategy state. Called after the last row.
+         */
+        virtual void onFinish() {}
+    };
+
+} // namespace qga::strategy
@@ -3,8 +3,9 @@
  * @brief Simple SMA fast/slow crossover strategy.
  */
 #pragma once
-#include <deque>
 #include "strategy/IStrategy.hpp"
+#include "strategy/indicators/IndicatorCache.hpp"
+#include "strategy/indicators/MovingAverages.hpp"
 
 namespace qga::strategy {
 
@@ -16,7 +17,11 @@ namespace qga::strategy {
  * - `Signal::Buy` when the fast SMA crosses above the slow SMA.
  * - `Signal::Sell` when the fast SMA crosses below the slow SMA.
  *
- * Internally maintains two rolling windows of close prices to compute the averages.
+ * Both averages are indicators::Sma instances: their ring buffers are sized in
+ * onStart(), so onBar() is O(1) and allocation-free. In a sweep the averages
+ * can instead come precomputed from an indicators::IndicatorCache: onBar()
+ * then reads the i-th value of each column for the i-th bar, and checks that
+ * the bar is the i-th bar of the series the columns were computed from.
  *
  * Common use cases:
  * - `fast_period = 10`, `slow_period = 20` (default)
@@ -29,9 +34,34 @@ public:
      * @param slow_period Period of the slow moving average.
      *
      * @note fast_period should be less than slow_period for meaningful signals.
+     * @throws std::invalid_argument if either period is not > 0.
      */
     explicit MACrossover(int fast_period=10, int slow_period=20);
 
+    /**
+     * @brief Construct a strategy that reads precomputed SMA columns.
+     * @param fast_period Period of @p fast_sma (identity for checkpoints).
+     * @param slow_period Period of @p slow_sma.
+     * @param fast_sma    SMA column of @p bars, one value per bar.
+     * @param slow_sma    SMA column of @p bars.
+     * @param bars        Series the columns were computed from; must outlive the strategy.
+     *
+     * @throws std::invalid_argument if a period is not > 0, a handle is empty
+     *         or a column's length differs from @p bars.
+     */
+    MACrossover(int fast_period, int slow_period,
+                indicators::IndicatorHandle fast_sma, indicators::IndicatorHandle slow_sma,
+                std::span<const domain::Quote> bars);
+
+    /**
+     * @brief Construct a strategy over columns fetched from @p cache.
+     * @param cache  Shared indicator cache.
+     * @param series Identity of @p bars in the cache.
+     * @param bars   The series that will be streamed; must outlive the strategy.
+     */
+    MACrossover(indicators::IndicatorCache& cache, std::uint64_t series,
+                std::span<const domain::Quote> bars, int fast_period=10, int slow_period=20);
+
     /**
      * @brief Initializes internal state before streaming bars.
      */
@@ -41,6 +71,8 @@ public:
      * @brief Called for each bar. Emits Buy/Sell/None signals.
      * @param q Incoming market quote (bar).
      * @return Trading decision based on moving average crossover.
+     * @throws std::out_of_range if more bars arrive than the cached columns hold.
+     * @throws std::invalid_argument if @p q is not the next bar of the cached series.
      */
     Signal onBar(const domain::Quote& q) override;
 
@@ -49,15 +81,27 @@ public:
      */
     void onFinish() override;
 
+    /**
+     * @brief Serialize rolling state for checkpointing.
+     */
+    void saveState(StateWriter& out) const override;
+
+    /**
+     * @brief Restore state written by saveState().
+     */
+    void loadState(StateReader& in) override;
+
 private:
-        int fast_period_;   ///< Number of bars for the fast SMA.
+    int fast_period_;   ///< Number of bars for the fast SMA.
     int slow_period_;   ///< Number of bars for the slow SMA.
 
-    std::deque<double> w_fast_;  ///< Rolling window of closing prices for fast SMA.
-    std::deque<double> w_slow_;  ///< Rolling window of closing prices for slow SMA.
+    indicators::Sma sma_fast_;   ///< Fast SMA of closing prices.
+    indicators::Sma sma_slow_;   ///< Slow SMA of closing prices.
 
-    double sum_fast_ = 0.0;      ///< Running sum for fast SMA calculation.
-    double sum_slow_ = 0.0;      ///< Running sum for slow SMA calculation.
+    indicators::IndicatorHandle fast_col_;  ///< Precomputed fast SMA (cached mode only).
+    indicators::IndicatorHandle slow_col_;  ///< Precomputed slow SMA (cached mode only).
+    std::span<const domain::Quote> src_;    ///< Series of the columns (cached mode only).
+    std::size_t bar_ = 0;                   ///< Index of the next bar in cached mode.
 
     double prev_fast_ = 0.0;     ///< Fast SMA value from previous bar.
     double prev_slow_ = 0.0;     ///< Slow SMA value from previous bar.
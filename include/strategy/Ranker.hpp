@@ -0,0 +1,57 @@
+/**
+ * @file Ranker.hpp
+ * @brief Top-k / bottom-k selection over a cross-section of scores, on reused buffers.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace qga::strategy
+{
+
+    /**
+     * @class Ranker
+     * @brief Selects the best or worst k columns of a score vector without a full sort.
+     *
+     * NaN scores (symbols without data) are skipped. Finite scores are
+     * compacted with their column into a contiguous buffer, partitioned with
+     * `std::nth_element` (O(n) on average) and only the k selected entries are
+     * sorted, so ranking 500 symbols to pick 50 does not sort 500.
+     *
+     * All buffers grow to the universe size once and are reused afterwards;
+     * after the first row no call allocates. One Ranker per thread.
+     */
+    class Ranker
+    {
+      public:
+        /**
+         * @brief Columns of the @p k highest finite scores, best first (ties: lower column first).
+         * @return View valid until the next top() call; shorter than @p k if fewer are finite.
+         */
+        std::span<const std::uint32_t> top(std::span<const double> scores, std::size_t k);
+
+        /**
+         * @brief Columns of the @p k lowest finite scores, lowest first (ties: lower column first).
+         * @return View valid until the next bottom() call; shorter than @p k if fewer are finite.
+         */
+        std::span<const std::uint32_t> bottom(std::span<const double> scores, std::size_t k);
+
+      private:
+        struct Scored
+        {
+            double score_;
+            std::uint32_t column_;
+        };
+
+        template <bool HIGH>
+        std::span<const std::uint32_t> select(std::span<const double> scores, std::size_t k,
+                                              std::vector<std::uint32_t>& out);
+
+        std::vector<Scored> scored_;        ///< Finite scores with their column (scratch).
+        std::vector<std::uint32_t> top_;    ///< Result of the last top().
+        std::vector<std::uint32_t> bottom_; ///< Result of the last bottom().
+    };
+
+} // namespace qga::strategy
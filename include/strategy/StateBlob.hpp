@@ -0,0 +1,107 @@
+/**
+ * @file StateBlob.hpp
+ * @brief Minimal binary writer/reader used to snapshot strategy state.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace qga::strategy
+{
+
+    /**
+     * @class StateWriter
+     * @brief Appends trivially copyable values and ranges to a byte buffer.
+     *
+     * The encoding is the host's native layout; snapshots are meant to be
+     * restored by the same build, not exchanged between platforms.
+     */
+    class StateWriter
+    {
+      public:
+        /**
+         * @brief Appends one value.
+         */
+        template <class T> void put(const T& v)
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "StateWriter::put needs a trivially copyable type");
+            const auto* p = reinterpret_cast<const std::uint8_t*>(&v);
+            bytes_.insert(bytes_.end(), p, p + sizeof(T));
+        }
+
+        /**
+         * @brief Appends a length-prefixed sequence (any range of trivially copyable values).
+         */
+        template <class Range> void putRange(const Range& r)
+        {
+            put<std::uint64_t>(static_cast<std::uint64_t>(std::size(r)));
+            for (const auto& v : r)
+                put(v);
+        }
+
+        /// @return Encoded bytes.
+        const std::vector<std::uint8_t>& bytes() const noexcept { return bytes_; }
+
+        /// @return Encoded bytes, moved out of the writer.
+        std::vector<std::uint8_t> release() noexcept { return std::move(bytes_); }
+
+      private:
+        std::vector<std::uint8_t> bytes_; ///< Output buffer.
+    };
+
+    /**
+     * @class StateReader
+     * @brief Reads values back in the order a @ref StateWriter wrote them.
+     * @throws std::runtime_error on truncated input.
+     */
+    class StateReader
+    {
+      public:
+        explicit StateReader(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+        /**
+         * @brief Reads one value.
+         */
+        template <class T> T get()
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "StateReader::get needs a trivially copyable type");
+            if (bytes_.size() - pos_ < sizeof(T))
+                throw std::runtime_error("StateReader: truncated state");
+            T v;
+            std::memcpy(&v, bytes_.data() + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return v;
+        }
+
+        /**
+         * @brief Reads a length-prefixed sequence into @p out (cleared first).
+         * @tparam Container Sequence container with push_back (vector, deque).
+         */
+        template <class Container> void getRange(Container& out)
+        {
+            const auto N = get<std::uint64_t>();
+            if (N > (bytes_.size() - pos_) / sizeof(typename Container::value_type))
+                throw std::runtime_error("StateReader: truncated state");
+            out.clear();
+            for (std::uint64_t i = 0; i < N; ++i)
+                out.push_back(get<typename Container::value_type>());
+        }
+
+        /// @return True once every byte has been consumed.
+        bool done() const noexcept { return pos_ == bytes_.size(); }
+
+      private:
+        std::span<const std::uint8_t> bytes_; ///< Input bytes (non-owning).
+        std::size_t pos_ = 0;                 ///< Read cursor.
+    };
+
+} // namespace qga::strategy
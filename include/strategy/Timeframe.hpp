@@ -0,0 +1,152 @@
+/**
+ * @file Timeframe.hpp
+ * @brief Higher timeframes a strategy can ask for, and the incremental resampler behind them.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "domain/Quote.hpp"
+#include "strategy/StateBlob.hpp"
+
+namespace qga::strategy
+{
+
+    /**
+     * @struct Timeframe
+     * @brief Bar length of a resampled stream, in Quote::ts_ units (epoch millis).
+     *
+     * Bars are aligned to multiples of the period since the epoch, so a
+     * one-day timeframe buckets by UTC day.
+     */
+    struct Timeframe
+    {
+        std::int64_t period_ = 0; ///< Length of one resampled bar, > 0.
+        std::int64_t base_ = 0;   ///< Length of one input bar if known, else 0 (see Resampler).
+
+        static constexpr Timeframe minutes(std::int64_t n, std::int64_t base = 0) noexcept
+        {
+            return {n * 60'000, base};
+        }
+        static constexpr Timeframe hours(std::int64_t n, std::int64_t base = 0) noexcept
+        {
+            return {n * 3'600'000, base};
+        }
+        static constexpr Timeframe days(std::int64_t n, std::int64_t base = 0) noexcept
+        {
+            return {n * 86'400'000, base};
+        }
+
+        auto operator<=>(const Timeframe&) const = default;
+    };
+
+    /**
+     * @class Resampler
+     * @brief Folds a stream of bars into bars of a longer Timeframe, one input at a time.
+     *
+     * update() costs O(1) per input bar and never stores the input: only the
+     * bar being formed is kept. A resampled bar is handed out once it is known
+     * to be closed:
+     * - when the first input bar of a later period arrives (before that bar
+     *   is processed), or
+     * - when `base_` is set, together with the input bar that ends the
+     *   period (`ts_ + base_` reaches the period end), so e.g. an hourly bar
+     *   is available at the close of its 10:59 minute bar, not at 11:00.
+     *
+     * The resampled bar carries the period start as its timestamp, the first
+     * open, the highest high, the lowest low, the last close and the summed
+     * volume. Input bars must arrive in timestamp order.
+     */
+    class Resampler
+    {
+      public:
+        /**
+         * @throws std::invalid_argument if `period_` is not positive or `base_`
+         *         is negative or longer than the period.
+         */
+        explicit Resampler(Timeframe tf) : tf_(tf)
+        {
+            if (tf.period_ <= 0)
+                throw std::invalid_argument("Resampler: period must be > 0");
+            if (tf.base_ < 0 || tf.base_ > tf.period_)
+                throw std::invalid_argument("Resampler: base bar length must be in [0, period]");
+        }
+
+        /// @brief Forgets the bar being formed.
+        void reset() noexcept
+        {
+            open_ = false;
+            end_ = std::numeric_limits<std::int64_t>::min();
+        }
+
+        /**
+         * @brief Adds one input bar; calls `on_close(const domain::Quote&)` for every bar it
+         *        closes (at most two).
+         * @throws std::invalid_argument if @p q belongs to a period already closed via `base_`.
+         */
+        template <class OnClose> void update(const domain::Quote& q, OnClose&& on_close)
+        {
+            if (q.ts_ < end_)
+            {
+                if (!open_)
+                    throw std::invalid_argument(
+                        "Resampler: bar falls into an already closed period");
+                bar_.high_ = std::max(bar_.high_, q.high_);
+                bar_.low_ = std::min(bar_.low_, q.low_);
+                bar_.close_ = q.close_;
+                bar_.volume_ += q.volume_;
+            }
+            else
+            {
+                if (open_)
+                {
+                    open_ = false;
+                    on_close(static_cast<const domain::Quote&>(bar_));
+                }
+                const std::int64_t REM = q.ts_ % tf_.period_;
+                const std::int64_t START = q.ts_ - (REM < 0 ? REM + tf_.period_ : REM);
+                end_ = START + tf_.period_;
+                bar_ = q;
+                bar_.ts_ = START;
+                open_ = true;
+            }
+            if (tf_.base_ > 0 && q.ts_ + tf_.base_ >= end_)
+            {
+                open_ = false;
+                on_close(static_cast<const domain::Quote&>(bar_));
+            }
+        }
+
+        /// @return The bar being formed (not yet closed), or null.
+        const domain::Quote* forming() const noexcept { return open_ ? &bar_ : nullptr; }
+
+        Timeframe timeframe() const noexcept { return tf_; }
+
+        void save(StateWriter& out) const
+        {
+            out.put(open_);
+            out.put(end_);
+            out.put(bar_);
+        }
+
+        void load(StateReader& in)
+        {
+            open_ = in.get<bool>();
+            end_ = in.get<std::int64_t>();
+            bar_ = in.get<domain::Quote>();
+        }
+
+      private:
+        Timeframe tf_;
+        domain::Quote bar_{}; ///< Bar being formed.
+        /// End (exclusive) of the current period.
+        std::int64_t end_ = std::numeric_limits<std::int64_t>::min();
+        bool open_ = false; ///< bar_ holds input not yet handed out.
+    };
+
+} // namespace qga::strategy
@@ -0,0 +1,60 @@
+/**
+ * @file TimeframeFeed.hpp
+ * @brief Adapter that delivers a strategy's declared higher timeframes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "strategy/IStrategy.hpp"
+#include "strategy/Timeframe.hpp"
+
+namespace qga::strategy
+{
+
+    /**
+     * @class TimeframeFeed
+     * @brief Wraps a strategy and resamples the bars it sees into its IStrategy::timeframes().
+     *
+     * onBar() first feeds the bar to one Resampler per timeframe, calling the
+     * inner strategy's onTimeframeBar() for each bar that closes, then
+     * forwards the bar. The coarser series are never materialised: the feed
+     * holds one forming bar per timeframe, and the extra cost is O(1) per
+     * input bar and timeframe.
+     *
+     * The engines wrap any strategy that declares timeframes, so strategies
+     * only implement onTimeframeBar(). Snapshots hold the forming bars
+     * followed by the inner strategy's own state.
+     */
+    class TimeframeFeed final : public IStrategy
+    {
+      public:
+        /**
+         * @param inner Strategy to drive; must outlive the feed.
+         * @throws std::invalid_argument if one of its timeframes is invalid (see Resampler).
+         */
+        explicit TimeframeFeed(IStrategy& inner);
+
+        void onStart() override;
+        Signal onBar(const domain::Quote& q) override;
+        void onFinish() override;
+
+        void saveState(StateWriter& out) const override;
+
+        /// @throws std::invalid_argument if the state was saved for another number of timeframes.
+        void loadState(StateReader& in) override;
+
+        /// @return Bar of timeframe @p index still being formed, or null.
+        const domain::Quote* forming(std::size_t index) const noexcept
+        {
+            return resamplers_[index].forming();
+        }
+
+      private:
+        IStrategy& inner_;
+        std::vector<Resampler> resamplers_; ///< One per inner_.timeframes() entry.
+    };
+
+} // namespace qga::strategy
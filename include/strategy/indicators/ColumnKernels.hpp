@@ -0,0 +1,101 @@
+/**
+ * @file ColumnKernels.hpp
+ * @brief Whole-column (batch) indicator kernels with runtime SIMD dispatch.
+ *
+ * Research code evaluates indicators over entire histories at once. These
+ * kernels take a contiguous column (e.g. closing prices) and fill an output
+ * column of the same length, using the scalar, AVX2 or AVX-512 build picked
+ * by @ref core::activeSimdLevel() (or an explicit, clamped level).
+ *
+ * Output layout matches the streaming indicators of Indicators.hpp value for
+ * value: `out[i]` is what `update(x[i])` returns, NaN during warm-up.
+ * Inputs are expected to be finite.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "core/CpuFeatures.hpp"
+#include "strategy/IStrategy.hpp"
+
+namespace qga::strategy::indicators::columns
+{
+
+    /**
+     * @brief Agreement with the streaming indicators, relative to the input scale.
+     *
+     * The rolling extrema and crossover detection are exact. SMA and EMA
+     * reassociate the sums (lane scans, blocks re-anchored every few thousand
+     * values), so for every output `|batch - streaming| <= COLUMN_TOLERANCE * max|x|`.
+     * The rolling standard deviation meets the bound on the variance scale,
+     * `|var_batch - var_streaming| <= COLUMN_TOLERANCE * max|x|^2`: windows
+     * with almost no dispersion may differ by up to the square root of that.
+     */
+    inline constexpr double COLUMN_TOLERANCE = 1e-9;
+
+    /**
+     * @brief Simple moving average (see Sma).
+     *
+     * Each block starts from a directly summed window, then adds the lane
+     * prefix scan of `x[i] - x[i - period]`.
+     *
+     * @throws std::invalid_argument if @p period is 0 or the spans differ in size.
+     */
+    void sma(std::span<const double> x, std::size_t period, std::span<double> out,
+             core::SimdLevel level = core::activeSimdLevel());
+
+    /**
+     * @brief Exponential moving average seeded with the first SMA (see Ema).
+     *
+     * The recurrence `y = c * y_prev + alpha * x` is solved W values at a
+     * time by a scan with decay factors `c, c^2, c^4`.
+     *
+     * @throws std::invalid_argument if @p period is 0 or the spans differ in size.
+     */
+    void ema(std::span<const double> x, std::size_t period, std::span<double> out,
+             core::SimdLevel level = core::activeSimdLevel());
+
+    /**
+     * @brief Rolling population standard deviation (see RollingStdDev).
+     *
+     * Uses scanned sums and sums of squares of `x - K`, with the shift `K`
+     * taken per block to keep cancellation small.
+     *
+     * @throws std::invalid_argument if @p period is 0 or the spans differ in size.
+     */
+    void rollingStdDev(std::span<const double> x, std::size_t period, std::span<double> out,
+                       core::SimdLevel level = core::activeSimdLevel());
+
+    /**
+     * @brief Rolling maximum (see RollingMax), van Herk / Gil-Werman.
+     *
+     * Block-wise prefix and suffix maxima combined with one vector max per
+     * output: three comparisons per value, independent of @p period.
+     *
+     * @throws std::invalid_argument if @p period is 0 or the spans differ in size.
+     */
+    void rollingMax(std::span<const double> x, std::size_t period, std::span<double> out,
+                    core::SimdLevel level = core::activeSimdLevel());
+
+    /**
+     * @brief Rolling minimum (see RollingMin); same algorithm as rollingMax().
+     * @throws std::invalid_argument if @p period is 0 or the spans differ in size.
+     */
+    void rollingMin(std::span<const double> x, std::size_t period, std::span<double> out,
+                    core::SimdLevel level = core::activeSimdLevel());
+
+    /**
+     * @brief Crossover signals of two columns, as MACrossover emits them.
+     *
+     * The first index where both columns are finite only arms the detector;
+     * afterwards `Buy` marks `fast` crossing above `slow` and `Sell` crossing
+     * below. NaN is expected only in the warm-up prefix.
+     *
+     * @throws std::invalid_argument if the spans differ in size.
+     */
+    void crossover(std::span<const double> fast, std::span<const double> slow,
+                   std::span<Signal> out, core::SimdLevel level = core::activeSimdLevel());
+
+} // namespace qga::strategy::indicators::columns
@@ -0,0 +1,384 @@
+/**
+ * @file FixedWindow.hpp
+ * @brief Indicators whose window length is a compile-time constant.
+ *
+ * `fixed::Sma<20>` behaves exactly like `Sma{20}` (same arithmetic, same
+ * results bit for bit, same snapshot format) but keeps its window inline in
+ * the object: no allocation, no reset() before use, and a period the compiler
+ * can fold into the arithmetic. The ring storage is rounded up to a power of
+ * two so every index wraps with a mask instead of a compare; small windows
+ * can stay entirely in registers or L1.
+ *
+ * Use these when the period is known at build time; the runtime-sized
+ * indicators of Indicators.hpp remain the general-purpose versions.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "strategy/StateBlob.hpp"
+
+namespace qga::strategy::indicators::fixed
+{
+
+    /**
+     * @class RingBuffer
+     * @brief Inline circular buffer holding at most @p N elements; see indicators::RingBuffer.
+     *
+     * Storage is `std::bit_ceil(N)` slots, so positions wrap with `& MASK`.
+     * The logical capacity is still @p N: pushing onto a full buffer evicts the
+     * oldest element. Snapshots use the same format as indicators::RingBuffer.
+     *
+     * @tparam T Element type (trivially copyable).
+     * @tparam N Capacity, > 0.
+     */
+    template <class T, std::size_t N> class RingBuffer
+    {
+        static_assert(N > 0, "fixed::RingBuffer: capacity must be > 0");
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "fixed::RingBuffer: T must be trivially copyable");
+
+      public:
+        static constexpr std::size_t SLOTS = std::bit_ceil(N); ///< Storage slots (power of two).
+        static constexpr std::size_t MASK = SLOTS - 1;         ///< Index mask.
+
+        /// @brief Empties the buffer.
+        void clear() noexcept
+        {
+            head_ = 0;
+            size_ = 0;
+        }
+
+        static constexpr std::size_t capacity() noexcept { return N; }
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        bool full() const noexcept { return size_ == N; }
+
+        /// @return Element @p i, counted from the oldest (unchecked).
+        const T& operator[](std::size_t i) const noexcept { return data_[(head_ + i) & MASK]; }
+        T& operator[](std::size_t i) noexcept { return data_[(head_ + i) & MASK]; }
+
+        /// @return Oldest element (unchecked).
+        const T& front() const noexcept { return data_[head_]; }
+        /// @return Newest element (unchecked).
+        const T& back() const noexcept { return data_[(head_ + size_ - 1) & MASK]; }
+
+        /**
+         * @brief Appends @p v as the newest element.
+         * @return The element it replaced when the buffer was full, else T{}.
+         */
+        T push_back(const T& v) noexcept
+        {
+            if (size_ < N)
+            {
+                data_[(head_ + size_) & MASK] = v;
+                ++size_;
+                return T{};
+            }
+            const T OLD = data_[head_];
+            data_[(head_ + N) & MASK] = v; // == head_ when N is a power of two
+            head_ = (head_ + 1) & MASK;
+            return OLD;
+        }
+
+        /// @brief Drops the oldest element (unchecked).
+        void pop_front() noexcept
+        {
+            head_ = (head_ + 1) & MASK;
+            --size_;
+        }
+
+        /// @brief Drops the newest element (unchecked).
+        void pop_back() noexcept { --size_; }
+
+        /// @brief Writes the elements, oldest first.
+        void save(StateWriter& out) const
+        {
+            out.put<std::uint64_t>(size_);
+            for (std::size_t i = 0; i < size_; ++i)
+                out.put((*this)[i]);
+        }
+
+        /**
+         * @brief Restores elements written by save().
+         * @throws std::runtime_error if they do not fit or the input is truncated.
+         */
+        void load(StateReader& in)
+        {
+            const auto COUNT = in.get<std::uint64_t>();
+            if (COUNT > N)
+                throw std::runtime_error("fixed::RingBuffer::load: state exceeds capacity");
+            clear();
+            for (std::uint64_t i = 0; i < COUNT; ++i)
+                push_back(in.get<T>());
+        }
+
+      private:
+        std::array<T, SLOTS> data_{}; ///< Inline storage.
+        std::size_t head_ = 0;        ///< Slot of the oldest element.
+        std::size_t size_ = 0;        ///< Number of stored elements.
+    };
+
+    /**
+     * @class Sma
+     * @brief Simple moving average over the last @p N values; see indicators::Sma.
+     */
+    template <std::size_t N> class Sma
+    {
+      public:
+        /// @brief Clears all state.
+        void reset() noexcept
+        {
+            window_.clear();
+            sum_ = 0.0;
+        }
+
+        /// @return The average once @p N values were seen, else NaN.
+        double update(double x) noexcept
+        {
+            const bool FULL = window_.full();
+            const double OLD = window_.push_back(x);
+            sum_ += x;
+            if (FULL)
+                sum_ -= OLD;
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            return ready() ? sum_ / static_cast<double>(N)
+                           : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        bool ready() const noexcept { return window_.full(); }
+        static constexpr std::size_t period() noexcept { return N; }
+
+        void save(StateWriter& out) const
+        {
+            window_.save(out);
+            out.put(sum_);
+        }
+
+        void load(StateReader& in)
+        {
+            window_.load(in);
+            sum_ = in.get<double>();
+        }
+
+      private:
+        RingBuffer<double, N> window_; ///< Last N values.
+        double sum_ = 0.0;             ///< Running sum of the window.
+    };
+
+    /**
+     * @class Wma
+     * @brief Linearly weighted moving average over the last @p N values; see indicators::Wma.
+     */
+    template <std::size_t N> class Wma
+    {
+      public:
+        /// @brief Clears all state.
+        void reset() noexcept
+        {
+            window_.clear();
+            sum_ = 0.0;
+            weighted_ = 0.0;
+        }
+
+        /// @return The average once @p N values were seen, else NaN.
+        double update(double x) noexcept
+        {
+            if (window_.full())
+            {
+                weighted_ += static_cast<double>(N) * x - sum_;
+                sum_ += x - window_.push_back(x);
+            }
+            else
+            {
+                window_.push_back(x);
+                weighted_ += static_cast<double>(window_.size()) * x;
+                sum_ += x;
+            }
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            return ready() ? weighted_ / NORM : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        bool ready() const noexcept { return window_.full(); }
+        static constexpr std::size_t period() noexcept { return N; }
+
+        void save(StateWriter& out) const
+        {
+            window_.save(out);
+            out.put(sum_);
+            out.put(weighted_);
+        }
+
+        void load(StateReader& in)
+        {
+            window_.load(in);
+            sum_ = in.get<double>();
+            weighted_ = in.get<double>();
+        }
+
+      private:
+        static constexpr double NORM = static_cast<double>(N) * static_cast<double>(N + 1) / 2.0;
+
+        RingBuffer<double, N> window_; ///< Last N values.
+        double sum_ = 0.0;             ///< Plain sum of the window.
+        double weighted_ = 0.0;        ///< Weighted sum of the window.
+    };
+
+    /**
+     * @class RollingStdDev
+     * @brief Population stddev over the last @p N values; see indicators::RollingStdDev.
+     */
+    template <std::size_t N> class RollingStdDev
+    {
+      public:
+        /// @brief Clears all state.
+        void reset() noexcept
+        {
+            window_.clear();
+            mean_ = 0.0;
+            m2_ = 0.0;
+        }
+
+        /// @return Standard deviation once @p N values were seen, else NaN.
+        double update(double x) noexcept
+        {
+            if (window_.full())
+            {
+                const double OLD = window_.push_back(x);
+                const double DELTA = x - OLD;
+                const double PREV_MEAN = mean_;
+                mean_ += DELTA / static_cast<double>(N);
+                m2_ = std::max(0.0, m2_ + DELTA * (x - mean_ + OLD - PREV_MEAN));
+            }
+            else
+            {
+                window_.push_back(x);
+                const double DELTA = x - mean_;
+                mean_ += DELTA / static_cast<double>(window_.size());
+                m2_ += DELTA * (x - mean_);
+            }
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            return ready() ? std::sqrt(m2_ / static_cast<double>(N))
+                           : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        /// @return Mean of the window, NaN until ready().
+        double mean() const noexcept
+        {
+            return ready() ? mean_ : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        bool ready() const noexcept { return window_.full(); }
+        static constexpr std::size_t period() noexcept { return N; }
+
+        void save(StateWriter& out) const
+        {
+            window_.save(out);
+            out.put(mean_);
+            out.put(m2_);
+        }
+
+        void load(StateReader& in)
+        {
+            window_.load(in);
+            mean_ = in.get<double>();
+            m2_ = in.get<double>();
+        }
+
+      private:
+        RingBuffer<double, N> window_; ///< Last N values.
+        double mean_ = 0.0;            ///< Mean of the stored values.
+        double m2_ = 0.0;              ///< Sum of squared deviations from mean_.
+    };
+
+    /**
+     * @class RollingExtremum
+     * @brief Rolling extremum over the last @p N values; see indicators::RollingExtremum.
+     */
+    template <std::size_t N, class Better> class RollingExtremum
+    {
+      public:
+        /// @brief Clears all state.
+        void reset() noexcept
+        {
+            deque_.clear();
+            count_ = 0;
+        }
+
+        /// @return Extremum of the last @p N values once that many were seen, else NaN.
+        double update(double x) noexcept
+        {
+            if (!deque_.empty() && deque_.front().index_ + N <= count_)
+                deque_.pop_front();
+            while (!deque_.empty() && !Better{}(deque_.back().value_, x))
+                deque_.pop_back();
+            deque_.push_back({count_, x});
+            ++count_;
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            return ready() ? deque_.front().value_ : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        bool ready() const noexcept { return count_ >= N; }
+        static constexpr std::size_t period() noexcept { return N; }
+
+        /// @return Bars since the current extremum was seen (0 = the latest value).
+        std::size_t age() const noexcept
+        {
+            return static_cast<std::size_t>(count_ - 1 - deque_.front().index_);
+        }
+
+        void save(StateWriter& out) const
+        {
+            deque_.save(out);
+            out.put(count_);
+        }
+
+        void load(StateReader& in)
+        {
+            deque_.load(in);
+            count_ = in.get<std::uint64_t>();
+        }
+
+      private:
+        struct Entry
+        {
+            std::uint64_t index_ = 0; ///< Position in the input stream.
+            double value_ = 0.0;      ///< Candidate value.
+        };
+
+        RingBuffer<Entry, N> deque_; ///< Candidates, front = current extremum.
+        std::uint64_t count_ = 0;    ///< Values seen.
+    };
+
+    template <std::size_t N>
+    using RollingMax = RollingExtremum<N, std::greater<>>; ///< Rolling maximum.
+    template <std::size_t N>
+    using RollingMin = RollingExtremum<N, std::less<>>; ///< Rolling minimum.
+
+} // namespace qga::strategy::indicators::fixed
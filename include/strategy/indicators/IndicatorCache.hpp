@@ -0,0 +1,198 @@
+/**
+ * @file IndicatorCache.hpp
+ * @brief Shared cache of materialised indicator columns with an LRU memory budget.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "domain/Quote.hpp"
+
+namespace qga::strategy::indicators
+{
+
+    /**
+     * @enum IndicatorKind
+     * @brief Indicators the cache can materialise (all parameterised by one period).
+     */
+    enum class IndicatorKind
+    {
+        Sma,    ///< Simple moving average of closes.
+        Ema,    ///< Exponential moving average of closes.
+        Wma,    ///< Linearly weighted moving average of closes.
+        Rsi,    ///< Relative strength index of closes.
+        Atr,    ///< Average true range (high, low, close).
+        StdDev, ///< Rolling population standard deviation of closes.
+        Max,    ///< Rolling maximum of closes.
+        Min     ///< Rolling minimum of closes.
+    };
+
+    /// @return Short lower-case name ("sma", "atr", ...).
+    const char* toString(IndicatorKind kind) noexcept;
+
+    /**
+     * @brief Identifies one indicator column of one series.
+     */
+    struct IndicatorKey
+    {
+        std::uint64_t series_ = 0;                ///< Series identity, e.g. seriesFingerprint().
+        IndicatorKind kind_ = IndicatorKind::Sma; ///< Indicator.
+        std::size_t period_ = 0;                  ///< Indicator period.
+
+        auto operator<=>(const IndicatorKey&) const = default;
+    };
+
+    /**
+     * @brief Computes the column of @p kind over @p bars: one value per bar, NaN during warm-up.
+     *
+     * EMA, standard deviation and the extrema use the vectorised
+     * ColumnKernels (within COLUMN_TOLERANCE of the streaming indicators);
+     * SMA, WMA, RSI and ATR run the streaming indicator over the bars. SMA
+     * must match indicators::Sma bit for bit: MACrossover compares cached
+     * averages for crossovers, and on flat stretches the kernel's
+     * re-associated sums flip ties.
+     *
+     * @throws std::invalid_argument if @p period is 0.
+     */
+    std::vector<double> computeIndicator(IndicatorKind kind, std::size_t period,
+                                         std::span<const domain::Quote> bars);
+
+    /**
+     * @class IndicatorHandle
+     * @brief Read-only, shared view of a cached column.
+     *
+     * Keeps the column alive on its own, so eviction from the cache never
+     * invalidates a handle. Copying is cheap (one shared pointer). The owner
+     * may be a vector or any other storage, e.g. a memory-mapped file.
+     */
+    class IndicatorHandle
+    {
+      public:
+        IndicatorHandle() = default;
+
+        explicit IndicatorHandle(std::shared_ptr<const std::vector<double>> column)
+            : data_(column ? column->data() : nullptr), size_(column ? column->size() : 0),
+              owner_(std::move(column))
+        {
+        }
+
+        /// @brief View of @p values, which stay valid as long as @p owner lives.
+        IndicatorHandle(std::shared_ptr<const void> owner, std::span<const double> values)
+            : data_(values.data()), size_(values.size()), owner_(std::move(owner))
+        {
+        }
+
+        /// @return Value at bar @p i (unchecked).
+        double operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        std::size_t size() const noexcept { return size_; }
+        std::span<const double> values() const noexcept { return {data_, size_}; }
+        explicit operator bool() const noexcept { return owner_ != nullptr; }
+
+      private:
+        const double* data_ = nullptr;      ///< First value.
+        std::size_t size_ = 0;              ///< Number of values.
+        std::shared_ptr<const void> owner_; ///< Keeps the values alive.
+    };
+
+    /**
+     * @brief Hit/miss figures of an IndicatorCache.
+     */
+    struct IndicatorCacheStats
+    {
+        std::size_t hits_ = 0;      ///< Requests served from the cache or a computation in flight.
+        std::size_t misses_ = 0;    ///< Columns computed.
+        std::size_t evictions_ = 0; ///< Columns dropped to respect the budget.
+    };
+
+    /**
+     * @class IndicatorCache
+     * @brief Materialises each (series, indicator, period) column once and shares it.
+     *
+     * In a parameter sweep most candidates share indicator columns (a 50 x 50
+     * MA grid needs 100 SMAs, not 5000). Strategies fetch IndicatorHandles
+     * through get() instead of computing the indicator inline.
+     *
+     * Thread-safe. A column is computed exactly once, outside the lock:
+     * concurrent requests for a column in flight wait for it. Completed
+     * columns are kept in least-recently-used order; whenever their total size
+     * exceeds the budget the least recently used ones are dropped (handles
+     * already given out stay valid).
+     *
+     * Columns come from a ColumnSource: computeIndicator() by default, or
+     * e.g. an io::IndicatorStore that persists them next to the dataset.
+     */
+    class IndicatorCache
+    {
+      public:
+        /// Produces the column of a key on a miss; called outside the lock.
+        using ColumnSource =
+            std::function<IndicatorHandle(const IndicatorKey&, std::span<const domain::Quote>)>;
+
+        /**
+         * @param budget_bytes Memory budget for cached columns.
+         * @param source       Column producer (empty = computeIndicator()).
+         * @throws std::invalid_argument if @p budget_bytes is 0.
+         */
+        explicit IndicatorCache(std::size_t budget_bytes = std::size_t{256} << 20,
+                                ColumnSource source = {});
+
+        /**
+         * @brief Column for @p key, computed from @p bars on first use.
+         * @param key  Indicator and series identity.
+         * @param bars The series `key.series_` refers to.
+         * @throws std::invalid_argument if `key.period_` is 0; whatever the source throws.
+         */
+        IndicatorHandle get(const IndicatorKey& key, std::span<const domain::Quote> bars);
+
+        /// @return Cached column for @p key, or an empty handle (does not touch the LRU order).
+        IndicatorHandle find(const IndicatorKey& key) const;
+
+        /// @return Number of completed columns held.
+        std::size_t size() const;
+
+        /// @return Bytes held by completed columns.
+        std::size_t bytes() const;
+
+        std::size_t budget() const noexcept { return budget_; }
+
+        /// @return Counters since construction or the last clear().
+        IndicatorCacheStats stats() const;
+
+        /// @brief Drops every column and resets the counters.
+        void clear();
+
+      private:
+        struct Entry
+        {
+            std::shared_future<IndicatorHandle> column_; ///< Ready once computed.
+            std::list<IndicatorKey>::iterator lru_; ///< Position in lru_ (front = most recent).
+            std::uint64_t id_ = 0;                  ///< Distinguishes re-inserted keys.
+            std::size_t bytes_ = 0;                 ///< Column size once ready.
+            bool ready_ = false;                    ///< False while in flight.
+        };
+
+        void evictOverBudget();
+
+        std::size_t budget_;
+        ColumnSource source_;
+        mutable std::mutex mutex_;
+        std::map<IndicatorKey, Entry> entries_;
+        std::list<IndicatorKey> lru_;
+        std::size_t bytes_ = 0;
+        std::uint64_t next_id_ = 0;
+        IndicatorCacheStats stats_;
+    };
+
+} // namespace qga::strategy::indicators
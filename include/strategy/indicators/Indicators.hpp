@@ -0,0 +1,26 @@
+/**
+ * @file Indicators.hpp
+ * @brief Streaming technical indicators for strategies (umbrella header).
+ *
+ * Every indicator follows the same shape:
+ * - the constructor takes the parameters, validates them and allocates any
+ *   window, so onBar() never allocates and update() is valid right away;
+ * - `reset()` clears the state; strategies call it from IStrategy::onStart();
+ * - `update(x)` consumes one value in O(1) (amortised O(1) for the rolling
+ *   extrema) and returns the current reading, NaN until `ready()`;
+ * - `save()` / `load()` snapshot the state for IStrategy::saveState().
+ *
+ * Indicators are header-only so that update() inlines into onBar().
+ * When a period is fixed at build time, the `fixed::` templates
+ * (FixedWindow.hpp, e.g. `fixed::Sma<20>`) compute the same values with the
+ * window stored inline.
+ */
+
+#pragma once
+
+#include "strategy/indicators/FixedWindow.hpp"
+#include "strategy/indicators/MovingAverages.hpp"
+#include "strategy/indicators/Oscillators.hpp"
+#include "strategy/indicators/RingBuffer.hpp"
+#include "strategy/indicators/RollingExtrema.hpp"
+#include "strategy/indicators/Volatility.hpp"
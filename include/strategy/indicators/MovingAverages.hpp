@@ -0,0 +1,232 @@
+/**
+ * @file MovingAverages.hpp
+ * @brief Streaming simple, exponential and linearly weighted moving averages.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "strategy/StateBlob.hpp"
+#include "strategy/indicators/RingBuffer.hpp"
+
+namespace qga::strategy::indicators
+{
+
+    /**
+     * @class Sma
+     * @brief Simple moving average over the last `period` values, O(1) per update.
+     *
+     * Keeps a running sum: the new value is added, then the value leaving the
+     * window is subtracted. The window lives in a RingBuffer sized by the constructor.
+     */
+    class Sma
+    {
+      public:
+        /**
+         * @param period Window length.
+         * @throws std::invalid_argument if @p period is 0.
+         */
+        explicit Sma(std::size_t period) : period_(period), window_(period)
+        {
+            if (period == 0)
+                throw std::invalid_argument("Sma: period must be > 0");
+        }
+
+        /// @brief Clears all state (call from onStart()).
+        void reset() noexcept
+        {
+            window_.clear();
+            sum_ = 0.0;
+        }
+
+        /**
+         * @brief Adds one value.
+         * @return The average once `period` values were seen, else NaN.
+         */
+        double update(double x) noexcept
+        {
+            const bool FULL = window_.full();
+            const double OLD = window_.push_back(x);
+            sum_ += x;
+            if (FULL)
+                sum_ -= OLD;
+            return value();
+        }
+
+        /// @return Current average, NaN until ready().
+        double value() const noexcept
+        {
+            return ready() ? sum_ / static_cast<double>(period_)
+                           : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        bool ready() const noexcept { return window_.full(); }
+        std::size_t period() const noexcept { return period_; }
+
+        void save(StateWriter& out) const
+        {
+            window_.save(out);
+            out.put(sum_);
+        }
+
+        void load(StateReader& in)
+        {
+            window_.load(in);
+            sum_ = in.get<double>();
+        }
+
+      private:
+        std::size_t period_;        ///< Window length.
+        RingBuffer<double> window_; ///< Last `period` values.
+        double sum_ = 0.0;          ///< Running sum of the window.
+    };
+
+    /**
+     * @class Ema
+     * @brief Exponential moving average, alpha = 2 / (period + 1), O(1) per update.
+     *
+     * Seeded with the simple average of the first `period` values, so it
+     * becomes ready on the same bar as an Sma of equal period.
+     */
+    class Ema
+    {
+      public:
+        /**
+         * @param period Smoothing period.
+         * @throws std::invalid_argument if @p period is 0.
+         */
+        explicit Ema(std::size_t period)
+            : period_(period), alpha_(2.0 / (static_cast<double>(period) + 1.0))
+        {
+            if (period == 0)
+                throw std::invalid_argument("Ema: period must be > 0");
+        }
+
+        /// @brief Clears all state.
+        void reset() noexcept
+        {
+            count_ = 0;
+            value_ = 0.0;
+        }
+
+        /// @return The average once `period` values were seen, else NaN.
+        double update(double x) noexcept
+        {
+            if (count_ >= period_)
+                value_ += alpha_ * (x - value_);
+            else if (++count_ < period_)
+                value_ += x; // seed sum
+            else
+                value_ = (value_ + x) / static_cast<double>(period_);
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            return ready() ? value_ : std::numeric_limits<double>::quiet_NaN();
+        }
+        bool ready() const noexcept { return count_ >= period_; }
+        std::size_t period() const noexcept { return period_; }
+
+        void save(StateWriter& out) const
+        {
+            out.put<std::uint64_t>(count_);
+            out.put(value_);
+        }
+
+        void load(StateReader& in)
+        {
+            count_ = static_cast<std::size_t>(in.get<std::uint64_t>());
+            value_ = in.get<double>();
+        }
+
+      private:
+        std::size_t period_;    ///< Smoothing period.
+        double alpha_;          ///< Smoothing factor.
+        std::size_t count_ = 0; ///< Values seen, saturating at period_.
+        double value_ = 0.0;    ///< Seed sum while warming up, then the average.
+    };
+
+    /**
+     * @class Wma
+     * @brief Linearly weighted moving average (newest weight `period`, oldest 1), O(1) per update.
+     *
+     * Keeps the plain sum S and the weighted sum N of the window; sliding it
+     * by one value x gives N' = N + period * x - S and S' = S + x - oldest.
+     */
+    class Wma
+    {
+      public:
+        /**
+         * @param period Window length.
+         * @throws std::invalid_argument if @p period is 0.
+         */
+        explicit Wma(std::size_t period)
+            : period_(period),
+              norm_(static_cast<double>(period) * static_cast<double>(period + 1) / 2.0),
+              window_(period)
+        {
+            if (period == 0)
+                throw std::invalid_argument("Wma: period must be > 0");
+        }
+
+        /// @brief Clears all state (call from onStart()).
+        void reset() noexcept
+        {
+            window_.clear();
+            sum_ = 0.0;
+            weighted_ = 0.0;
+        }
+
+        /// @return The average once `period` values were seen, else NaN.
+        double update(double x) noexcept
+        {
+            if (window_.full())
+            {
+                weighted_ += static_cast<double>(period_) * x - sum_;
+                sum_ += x - window_.push_back(x);
+            }
+            else
+            {
+                window_.push_back(x);
+                weighted_ += static_cast<double>(window_.size()) * x;
+                sum_ += x;
+            }
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            return ready() ? weighted_ / norm_ : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        bool ready() const noexcept { return window_.full(); }
+        std::size_t period() const noexcept { return period_; }
+
+        void save(StateWriter& out) const
+        {
+            window_.save(out);
+            out.put(sum_);
+            out.put(weighted_);
+        }
+
+        void load(StateReader& in)
+        {
+            window_.load(in);
+            sum_ = in.get<double>();
+            weighted_ = in.get<double>();
+        }
+
+      private:
+        std::size_t period_;        ///< Window length.
+        double norm_;               ///< Sum of the weights, period * (period + 1) / 2.
+        RingBuffer<double> window_; ///< Last `period` values.
+        double sum_ = 0.0;          ///< Plain sum of the window.
+        double weighted_ = 0.0;     ///< Weighted sum of the window.
+    };
+
+} // namespace qga::strategy::indicators
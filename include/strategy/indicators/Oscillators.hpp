@@ -0,0 +1,117 @@
+/**
+ * @file Oscillators.hpp
+ * @brief Streaming momentum oscillators (RSI).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "strategy/StateBlob.hpp"
+
+namespace qga::strategy::indicators
+{
+
+    /**
+     * @class Rsi
+     * @brief Relative strength index with Wilder smoothing, O(1) per update.
+     *
+     * The first average gain/loss is the simple mean over the first `period`
+     * changes; afterwards `avg = (avg * (period - 1) + x) / period`. Ready after
+     * `period + 1` values. A window without losses reads 100, one without any
+     * movement 50.
+     */
+    class Rsi
+    {
+      public:
+        /**
+         * @param period Smoothing period.
+         * @throws std::invalid_argument if @p period is 0.
+         */
+        explicit Rsi(std::size_t period) : period_(period)
+        {
+            if (period == 0)
+                throw std::invalid_argument("Rsi: period must be > 0");
+        }
+
+        /// @brief Clears all state.
+        void reset() noexcept
+        {
+            count_ = 0;
+            prev_ = 0.0;
+            avg_gain_ = 0.0;
+            avg_loss_ = 0.0;
+        }
+
+        /// @return RSI in [0, 100] once ready(), else NaN.
+        double update(double x) noexcept
+        {
+            const double CHANGE = x - prev_;
+            prev_ = x;
+            if (count_ == 0)
+            {
+                count_ = 1;
+                return value();
+            }
+            const double GAIN = std::max(CHANGE, 0.0);
+            const double LOSS = std::max(-CHANGE, 0.0);
+            const auto P = static_cast<double>(period_);
+            if (count_ > period_)
+            {
+                avg_gain_ = (avg_gain_ * (P - 1.0) + GAIN) / P;
+                avg_loss_ = (avg_loss_ * (P - 1.0) + LOSS) / P;
+            }
+            else
+            {
+                avg_gain_ += GAIN;
+                avg_loss_ += LOSS;
+                if (++count_ > period_)
+                {
+                    avg_gain_ /= P;
+                    avg_loss_ /= P;
+                }
+            }
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            if (!ready())
+                return std::numeric_limits<double>::quiet_NaN();
+            if (avg_loss_ == 0.0)
+                return avg_gain_ == 0.0 ? 50.0 : 100.0;
+            return 100.0 - 100.0 / (1.0 + avg_gain_ / avg_loss_);
+        }
+
+        bool ready() const noexcept { return count_ > period_; }
+        std::size_t period() const noexcept { return period_; }
+
+        void save(StateWriter& out) const
+        {
+            out.put<std::uint64_t>(count_);
+            out.put(prev_);
+            out.put(avg_gain_);
+            out.put(avg_loss_);
+        }
+
+        void load(StateReader& in)
+        {
+            count_ = static_cast<std::size_t>(in.get<std::uint64_t>());
+            prev_ = in.get<double>();
+            avg_gain_ = in.get<double>();
+            avg_loss_ = in.get<double>();
+        }
+
+      private:
+        std::size_t period_;    ///< Smoothing period.
+        std::size_t count_ = 0; ///< Values seen, saturating at period_ + 1.
+        double prev_ = 0.0;     ///< Previous value.
+        double avg_gain_ = 0.0; ///< Seed sum, then smoothed average gain.
+        double avg_loss_ = 0.0; ///< Seed sum, then smoothed average loss.
+    };
+
+} // namespace qga::strategy::indicators
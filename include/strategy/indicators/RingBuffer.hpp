@@ -0,0 +1,131 @@
+/**
+ * @file RingBuffer.hpp
+ * @brief Fixed-capacity circular buffer backing the streaming indicators.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "strategy/StateBlob.hpp"
+
+namespace qga::strategy::indicators
+{
+
+    /**
+     * @class RingBuffer
+     * @brief Contiguous circular buffer with deque-like ends and no allocation after reset().
+     *
+     * Storage is one vector sized once by reset(); pushing onto a full buffer
+     * overwrites the oldest element. Index 0 is the oldest element, `size() - 1`
+     * the newest. Capacity 0 means "not configured": pushes are not allowed.
+     *
+     * @tparam T Element type (trivially copyable when snapshots are used).
+     */
+    template <class T> class RingBuffer
+    {
+      public:
+        RingBuffer() = default;
+
+        /// @brief Allocates room for @p capacity elements.
+        explicit RingBuffer(std::size_t capacity) { reset(capacity); }
+
+        /**
+         * @brief Empties the buffer and sets its capacity.
+         *
+         * Memory is only reallocated when @p capacity grows beyond any earlier
+         * capacity, so calling this from every onStart() is cheap.
+         */
+        void reset(std::size_t capacity)
+        {
+            data_.assign(capacity, T{});
+            head_ = 0;
+            size_ = 0;
+        }
+
+        /// @brief Empties the buffer, keeping its capacity.
+        void clear() noexcept
+        {
+            head_ = 0;
+            size_ = 0;
+        }
+
+        std::size_t capacity() const noexcept { return data_.size(); }
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        bool full() const noexcept { return size_ == data_.size(); }
+
+        /// @return Element @p i, counted from the oldest (unchecked).
+        const T& operator[](std::size_t i) const noexcept { return data_[wrap(head_ + i)]; }
+        T& operator[](std::size_t i) noexcept { return data_[wrap(head_ + i)]; }
+
+        /// @return Oldest element (unchecked).
+        const T& front() const noexcept { return data_[head_]; }
+        /// @return Newest element (unchecked).
+        const T& back() const noexcept { return data_[wrap(head_ + size_ - 1)]; }
+
+        /**
+         * @brief Appends @p v as the newest element.
+         * @return The element it replaced when the buffer was full, else T{}.
+         */
+        T push_back(const T& v) noexcept
+        {
+            if (size_ < data_.size())
+            {
+                data_[wrap(head_ + size_)] = v;
+                ++size_;
+                return T{};
+            }
+            const T OLD = data_[head_];
+            data_[head_] = v;
+            head_ = wrap(head_ + 1);
+            return OLD;
+        }
+
+        /// @brief Drops the oldest element (unchecked).
+        void pop_front() noexcept
+        {
+            head_ = wrap(head_ + 1);
+            --size_;
+        }
+
+        /// @brief Drops the newest element (unchecked).
+        void pop_back() noexcept { --size_; }
+
+        /// @brief Writes the elements, oldest first.
+        void save(StateWriter& out) const
+        {
+            out.put<std::uint64_t>(size_);
+            for (std::size_t i = 0; i < size_; ++i)
+                out.put((*this)[i]);
+        }
+
+        /**
+         * @brief Restores elements written by save(); the capacity is kept.
+         * @throws std::runtime_error if they do not fit or the input is truncated.
+         */
+        void load(StateReader& in)
+        {
+            const auto N = in.get<std::uint64_t>();
+            if (N > data_.size())
+                throw std::runtime_error("RingBuffer::load: state exceeds capacity");
+            clear();
+            for (std::uint64_t i = 0; i < N; ++i)
+                push_back(in.get<T>());
+        }
+
+      private:
+        std::size_t wrap(std::size_t i) const noexcept
+        {
+            return i >= data_.size() ? i - data_.size() : i;
+        }
+
+        std::vector<T> data_;  ///< Storage, capacity() slots.
+        std::size_t head_ = 0; ///< Slot of the oldest element.
+        std::size_t size_ = 0; ///< Number of stored elements.
+    };
+
+} // namespace qga::strategy::indicators
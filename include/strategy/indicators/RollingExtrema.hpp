@@ -0,0 +1,106 @@
+/**
+ * @file RollingExtrema.hpp
+ * @brief Rolling minimum / maximum over a window, amortised O(1) per update.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "strategy/StateBlob.hpp"
+#include "strategy/indicators/RingBuffer.hpp"
+
+namespace qga::strategy::indicators
+{
+
+    /**
+     * @class RollingExtremum
+     * @brief Monotonic-deque rolling extremum.
+     *
+     * The deque keeps the candidates that can still become the extremum:
+     * values ordered by `Better`, each newer than the one before it. A new
+     * value evicts every candidate it beats from the back; the front leaves
+     * once it falls out of the window. Every value enters and leaves at most
+     * once, and the deque never holds more than `period` entries, so it lives
+     * in a RingBuffer of that capacity.
+     *
+     * @tparam Better Strict ordering; std::greater<> tracks the maximum, std::less<> the minimum.
+     */
+    template <class Better> class RollingExtremum
+    {
+      public:
+        /**
+         * @param period Window length.
+         * @throws std::invalid_argument if @p period is 0.
+         */
+        explicit RollingExtremum(std::size_t period) : period_(period), deque_(period)
+        {
+            if (period == 0)
+                throw std::invalid_argument("RollingExtremum: period must be > 0");
+        }
+
+        /// @brief Clears all state (call from onStart()).
+        void reset() noexcept
+        {
+            deque_.clear();
+            count_ = 0;
+        }
+
+        /// @return Extremum of the last `period` values once that many were seen, else NaN.
+        double update(double x) noexcept
+        {
+            if (!deque_.empty() && deque_.front().index_ + period_ <= count_)
+                deque_.pop_front();
+            while (!deque_.empty() && !Better{}(deque_.back().value_, x))
+                deque_.pop_back();
+            deque_.push_back({count_, x});
+            ++count_;
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            return ready() ? deque_.front().value_ : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        bool ready() const noexcept { return count_ >= period_; }
+        std::size_t period() const noexcept { return period_; }
+
+        /// @return Bars since the current extremum was seen (0 = the latest value).
+        std::size_t age() const noexcept
+        {
+            return static_cast<std::size_t>(count_ - 1 - deque_.front().index_);
+        }
+
+        void save(StateWriter& out) const
+        {
+            deque_.save(out);
+            out.put(count_);
+        }
+
+        void load(StateReader& in)
+        {
+            deque_.load(in);
+            count_ = in.get<std::uint64_t>();
+        }
+
+      private:
+        struct Entry
+        {
+            std::uint64_t index_ = 0; ///< Position in the input stream.
+            double value_ = 0.0;      ///< Candidate value.
+        };
+
+        std::size_t period_;      ///< Window length.
+        RingBuffer<Entry> deque_; ///< Candidates, front = current extremum.
+        std::uint64_t count_ = 0; ///< Values seen.
+    };
+
+    using RollingMax = RollingExtremum<std::greater<>>; ///< Rolling maximum.
+    using RollingMin = RollingExtremum<std::less<>>;    ///< Rolling minimum.
+
+} // namespace qga::strategy::indicators
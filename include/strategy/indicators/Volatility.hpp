@@ -0,0 +1,242 @@
+/**
+ * @file Volatility.hpp
+ * @brief Streaming volatility indicators: ATR, rolling standard deviation, Bollinger bands.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "domain/Quote.hpp"
+#include "strategy/StateBlob.hpp"
+#include "strategy/indicators/RingBuffer.hpp"
+
+namespace qga::strategy::indicators
+{
+
+    /**
+     * @class Atr
+     * @brief Average true range with Wilder smoothing, O(1) per update.
+     *
+     * True range is `max(high - low, |high - prev close|, |low - prev close|)`,
+     * just `high - low` on the first bar. The first ATR is the mean of the
+     * first `period` true ranges.
+     */
+    class Atr
+    {
+      public:
+        /**
+         * @param period Smoothing period.
+         * @throws std::invalid_argument if @p period is 0.
+         */
+        explicit Atr(std::size_t period) : period_(period)
+        {
+            if (period == 0)
+                throw std::invalid_argument("Atr: period must be > 0");
+        }
+
+        /// @brief Clears all state.
+        void reset() noexcept
+        {
+            count_ = 0;
+            prev_close_ = 0.0;
+            value_ = 0.0;
+        }
+
+        /// @return ATR once `period` bars were seen, else NaN.
+        double update(double high, double low, double close) noexcept
+        {
+            double tr = high - low;
+            if (count_ > 0)
+                tr = std::max({tr, std::abs(high - prev_close_), std::abs(low - prev_close_)});
+            prev_close_ = close;
+            const auto P = static_cast<double>(period_);
+            if (count_ >= period_)
+                value_ = (value_ * (P - 1.0) + tr) / P;
+            else if (++count_ < period_)
+                value_ += tr;
+            else
+                value_ = (value_ + tr) / P;
+            return value();
+        }
+
+        double update(const domain::Quote& q) noexcept { return update(q.high_, q.low_, q.close_); }
+
+        double value() const noexcept
+        {
+            return ready() ? value_ : std::numeric_limits<double>::quiet_NaN();
+        }
+        bool ready() const noexcept { return count_ >= period_; }
+        std::size_t period() const noexcept { return period_; }
+
+        void save(StateWriter& out) const
+        {
+            out.put<std::uint64_t>(count_);
+            out.put(prev_close_);
+            out.put(value_);
+        }
+
+        void load(StateReader& in)
+        {
+            count_ = static_cast<std::size_t>(in.get<std::uint64_t>());
+            prev_close_ = in.get<double>();
+            value_ = in.get<double>();
+        }
+
+      private:
+        std::size_t period_;      ///< Smoothing period.
+        std::size_t count_ = 0;   ///< Bars seen, saturating at period_.
+        double prev_close_ = 0.0; ///< Close of the previous bar.
+        double value_ = 0.0;      ///< Seed sum while warming up, then the ATR.
+    };
+
+    /**
+     * @class RollingStdDev
+     * @brief Population standard deviation over the last `period` values, O(1) per update.
+     *
+     * Welford's update, extended to a sliding window: replacing the oldest
+     * value `o` by `x` moves the mean by `(x - o) / period` and the sum of
+     * squared deviations by `(x - o) * (x - mean' + o - mean)`. This avoids the
+     * cancellation of the sum / sum-of-squares form on large price levels.
+     */
+    class RollingStdDev
+    {
+      public:
+        /**
+         * @param period Window length.
+         * @throws std::invalid_argument if @p period is 0.
+         */
+        explicit RollingStdDev(std::size_t period) : period_(period), window_(period)
+        {
+            if (period == 0)
+                throw std::invalid_argument("RollingStdDev: period must be > 0");
+        }
+
+        /// @brief Clears all state (call from onStart()).
+        void reset() noexcept
+        {
+            window_.clear();
+            mean_ = 0.0;
+            m2_ = 0.0;
+        }
+
+        /// @return Standard deviation once `period` values were seen, else NaN.
+        double update(double x) noexcept
+        {
+            if (window_.full())
+            {
+                const double OLD = window_.push_back(x);
+                const double DELTA = x - OLD;
+                const double PREV_MEAN = mean_;
+                mean_ += DELTA / static_cast<double>(period_);
+                m2_ = std::max(0.0, m2_ + DELTA * (x - mean_ + OLD - PREV_MEAN));
+            }
+            else
+            {
+                window_.push_back(x);
+                const double DELTA = x - mean_;
+                mean_ += DELTA / static_cast<double>(window_.size());
+                m2_ += DELTA * (x - mean_);
+            }
+            return value();
+        }
+
+        double value() const noexcept
+        {
+            return ready() ? std::sqrt(m2_ / static_cast<double>(period_))
+                           : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        /// @return Mean of the window, NaN until ready().
+        double mean() const noexcept
+        {
+            return ready() ? mean_ : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        bool ready() const noexcept { return window_.full(); }
+        std::size_t period() const noexcept { return period_; }
+
+        void save(StateWriter& out) const
+        {
+            window_.save(out);
+            out.put(mean_);
+            out.put(m2_);
+        }
+
+        void load(StateReader& in)
+        {
+            window_.load(in);
+            mean_ = in.get<double>();
+            m2_ = in.get<double>();
+        }
+
+      private:
+        std::size_t period_;        ///< Window length.
+        RingBuffer<double> window_; ///< Last `period` values.
+        double mean_ = 0.0;         ///< Mean of the stored values.
+        double m2_ = 0.0;           ///< Sum of squared deviations from mean_.
+    };
+
+    /**
+     * @brief One reading of Bollinger bands (all NaN until the window is full).
+     */
+    struct Bands
+    {
+        double lower_ = std::numeric_limits<double>::quiet_NaN();  ///< middle - k * stddev.
+        double middle_ = std::numeric_limits<double>::quiet_NaN(); ///< Rolling mean.
+        double upper_ = std::numeric_limits<double>::quiet_NaN();  ///< middle + k * stddev.
+    };
+
+    /**
+     * @class Bollinger
+     * @brief Bollinger bands: rolling mean +/- k population standard deviations.
+     */
+    class Bollinger
+    {
+      public:
+        /**
+         * @param period Window length.
+         * @param k Band width in standard deviations.
+         * @throws std::invalid_argument if @p period is 0 or @p k is negative.
+         */
+        explicit Bollinger(std::size_t period, double k = 2.0) : sd_(period), k_(k)
+        {
+            if (!(k >= 0.0))
+                throw std::invalid_argument("Bollinger: k must be >= 0");
+        }
+
+        /// @brief Clears all state (call from onStart()).
+        void reset() noexcept { sd_.reset(); }
+
+        Bands update(double x) noexcept
+        {
+            sd_.update(x);
+            return value();
+        }
+
+        Bands value() const noexcept
+        {
+            if (!ready())
+                return {};
+            const double MID = sd_.mean();
+            const double WIDTH = k_ * sd_.value();
+            return {MID - WIDTH, MID, MID + WIDTH};
+        }
+
+        bool ready() const noexcept { return sd_.ready(); }
+        std::size_t period() const noexcept { return sd_.period(); }
+
+        void save(StateWriter& out) const { sd_.save(out); }
+        void load(StateReader& in) { sd_.load(in); }
+
+      private:
+        RollingStdDev sd_; ///< Window mean and deviation.
+        double k_;         ///< Band width in standard deviations.
+    };
+
+} // namespace qga::strategy::indicators
@@ -0,0 +1,261 @@
+/**
+ * @file Rule.hpp
+ * @brief Trading rules written as expressions, compiled to a DAG and evaluated block-wise.
+ *
+ * Grammar (case-sensitive, whitespace-insensitive):
+ *
+ *     rule    := or
+ *     or      := and { ("or" | "||") and }
+ *     and     := not { ("and" | "&&") not }
+ *     not     := ("not" | "!") not | compare
+ *     compare := sum [ ("<" | "<=" | ">" | ">=" | "==" | "!=") sum
+ *                    | "crosses" ("above" | "below") sum ]
+ *     sum     := product { ("+" | "-") product }
+ *     product := unary { ("*" | "/") unary }
+ *     unary   := "-" unary | primary
+ *     primary := number | field | call | "(" or ")"
+ *     field   := "open" | "high" | "low" | "close" | "volume"
+ *     call    := sma(x, n) | ema(x, n) | wma(x, n) | stddev(x, n)
+ *              | highest(x, n) | lowest(x, n) | lag(x, n) | abs(x)
+ *              | rsi(n) | rsi(x, n) | atr(n)
+ *
+ * Periods `n` must be positive integer constants (constant arithmetic is
+ * folded, so `sma(close, 2 * 10)` is fine). Numeric and boolean
+ * subexpressions are type-checked. Every window function is the streaming
+ * indicator of the same name (see Indicators.hpp), so a rule reproduces the
+ * hand-written strategies bit for bit; values are NaN during warm-up, and any
+ * comparison involving NaN is false.
+ *
+ * `a crosses above b` holds at a bar when `a <= b` held at the previous bar
+ * and `a > b` holds now (below: mirrored), as in MACrossover.
+ */
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "domain/Quote.hpp"
+#include "strategy/IStrategy.hpp"
+#include "strategy/indicators/Indicators.hpp"
+
+namespace qga::strategy::rules
+{
+
+    /**
+     * @enum Op
+     * @brief Operation of a rule DAG node.
+     */
+    enum class Op : std::uint8_t
+    {
+        Const,      ///< Constant `value_`.
+        Open,       ///< Bar field.
+        High,       ///< Bar field.
+        Low,        ///< Bar field.
+        Close,      ///< Bar field.
+        Volume,     ///< Bar field.
+        Neg,        ///< -a
+        Abs,        ///< |a|
+        Add,        ///< a + b
+        Sub,        ///< a - b
+        Mul,        ///< a * b
+        Div,        ///< a / b
+        Lt,         ///< a < b (`>` is stored swapped)
+        Le,         ///< a <= b (`>=` is stored swapped)
+        Eq,         ///< a == b
+        Ne,         ///< a != b
+        And,        ///< a and b
+        Or,         ///< a or b
+        Not,        ///< not a
+        CrossAbove, ///< a crosses above b
+        CrossBelow, ///< a crosses below b
+        Lag,        ///< a, `period_` bars ago
+        Sma,        ///< sma(a, period_)
+        Ema,        ///< ema(a, period_)
+        Wma,        ///< wma(a, period_)
+        StdDev,     ///< stddev(a, period_)
+        Highest,    ///< highest(a, period_)
+        Lowest,     ///< lowest(a, period_)
+        Rsi,        ///< rsi(a, period_)
+        Atr         ///< atr(period_) over high, low and close
+    };
+
+    /**
+     * @brief One node of a compiled rule; operands refer to earlier nodes.
+     */
+    struct Node
+    {
+        Op op_ = Op::Const;
+        std::uint32_t a_ = 0;    ///< First operand (node index), if any.
+        std::uint32_t b_ = 0;    ///< Second operand (node index), if any.
+        std::size_t period_ = 0; ///< Window length of window operations.
+        double value_ = 0.0;     ///< Value of Const nodes.
+
+        auto operator<=>(const Node&) const = default;
+    };
+
+    class Rule;
+
+    /**
+     * @class RuleState
+     * @brief Mutable evaluation state of one Rule: indicator windows and block buffers.
+     *
+     * A Rule is immutable and can be shared; every evaluation (one backtest,
+     * one thread) owns a RuleState.
+     */
+    class RuleState
+    {
+      public:
+        /// @brief Allocates the state for @p rule (which must outlive it).
+        explicit RuleState(const Rule& rule);
+
+        /// @brief Forgets all history; the next bar is the first.
+        void reset();
+
+        /// @brief Serialises the indicator windows (see IStrategy::saveState()).
+        void save(StateWriter& out) const;
+
+        /**
+         * @brief Restores state written by save() for the same rule.
+         * @throws std::invalid_argument if the state belongs to a different rule.
+         */
+        void load(StateReader& in);
+
+      private:
+        friend class Rule;
+
+        /// Value of the operands at the previous bar.
+        struct Cross
+        {
+            double a_ = 0.0;
+            double b_ = 0.0;
+        };
+
+        using Window =
+            std::variant<std::monostate, indicators::Sma, indicators::Ema, indicators::Wma,
+                         indicators::RollingStdDev, indicators::RollingMax, indicators::RollingMin,
+                         indicators::Rsi, indicators::Atr, indicators::RingBuffer<double>, Cross>;
+
+        const Rule* rule_;
+        std::vector<Window> windows_; ///< Per node; monostate for stateless nodes.
+        std::vector<double> values_;  ///< Per node, one block of values each.
+    };
+
+    /**
+     * @class Rule
+     * @brief A compiled buy/sell rule emitting engine Signals.
+     *
+     * compile() parses both expressions into one DAG: structurally equal
+     * subexpressions become one node (comparisons and commutative operators
+     * are normalised first), constants are folded and unused nodes dropped.
+     * `sma(close, 10)` in the buy and the sell rule is computed once.
+     *
+     * Evaluation walks the nodes in topological order over blocks of BLOCK
+     * bars: each node runs one tight loop over its block, reading its
+     * operands' blocks, so intermediate columns stay in cache instead of
+     * being materialised for the whole history.
+     *
+     * A bar signals Buy when only the buy expression holds, Sell when only
+     * the sell expression holds, None otherwise.
+     */
+    class Rule
+    {
+      public:
+        /// Bars evaluated per block.
+        static constexpr std::size_t BLOCK = 256;
+
+        /**
+         * @brief Compiles a rule.
+         * @param buy  Boolean expression for Buy signals (empty: never).
+         * @param sell Boolean expression for Sell signals (empty: never).
+         * @throws std::invalid_argument on syntax or type errors (with the offending column).
+         */
+        static Rule compile(std::string_view buy, std::string_view sell = {});
+
+        /// @return Nodes of the DAG in evaluation order.
+        std::span<const Node> nodes() const noexcept { return nodes_; }
+
+        /// @return Node computing the buy / sell condition.
+        std::uint32_t buyNode() const noexcept { return buy_; }
+        std::uint32_t sellNode() const noexcept { return sell_; }
+
+        /// @return One line per node, e.g. `n3 = sma(n2, 10)`.
+        std::string toString() const;
+
+        /**
+         * @brief Continues an evaluation: signals for the @p bars that follow those already fed
+         *        to @p state.
+         * @throws std::invalid_argument if the spans differ in size or @p state belongs to
+         *         another rule.
+         */
+        void run(RuleState& state, std::span<const domain::Quote> bars,
+                 std::span<Signal> out) const;
+
+        /// @brief Signals for a whole series, from a fresh state.
+        std::vector<Signal> evaluate(std::span<const domain::Quote> bars) const;
+
+      private:
+        friend class RuleState;
+
+        Rule() = default;
+
+        std::vector<Node> nodes_;
+        std::uint32_t buy_ = 0;
+        std::uint32_t sell_ = 0;
+    };
+
+    /**
+     * @class RuleStrategy
+     * @brief Runs a Rule inside the backtest engine.
+     *
+     * By default the rule is evaluated bar by bar. Given the series up front
+     * (the sweep case), all signals are computed once block-wise at
+     * construction and onBar() replays them for the i-th bar.
+     */
+    class RuleStrategy final : public IStrategy
+    {
+      public:
+        /// @brief Streaming evaluation of @p rule.
+        explicit RuleStrategy(std::shared_ptr<const Rule> rule);
+
+        /// @brief Compiles and streams @p buy / @p sell (see Rule::compile()).
+        RuleStrategy(std::string_view buy, std::string_view sell);
+
+        /**
+         * @brief Precomputed signals of @p rule over @p bars, the series that will be streamed.
+         *
+         * @p bars must outlive the strategy; onBar() checks each bar against it.
+         */
+        RuleStrategy(std::shared_ptr<const Rule> rule, std::span<const domain::Quote> bars);
+
+        void onStart() override;
+
+        /**
+         * @throws std::out_of_range in precomputed mode when more bars arrive than were given.
+         * @throws std::invalid_argument in precomputed mode when @p q is not the next bar of
+         *         the series given at construction.
+         */
+        Signal onBar(const domain::Quote& q) override;
+
+        void saveState(StateWriter& out) const override;
+        void loadState(StateReader& in) override;
+
+        const Rule& rule() const noexcept { return *rule_; }
+
+      private:
+        std::shared_ptr<const Rule> rule_;
+        RuleState state_;                    ///< Streaming mode.
+        std::vector<Signal> signals_;        ///< Precomputed mode.
+        std::span<const domain::Quote> src_; ///< Series the signals were computed over.
+        bool precomputed_ = false;           ///< Which of the two modes is in use.
+        std::size_t bar_ = 0;                ///< Next bar in precomputed mode.
+    };
+
+} // namespace qga::strategy::rules
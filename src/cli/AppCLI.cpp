@@ -7,26 +7,206 @@
 namespace po = boost::program_options;
 #endif
 
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
 #include <fmt/core.h>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "Version.hpp"
 #include "common/LogLevel.hpp"
 #include "core/Config.hpp"
+#include "core/WorkerPool.hpp"
 
 #include "utils/ILogger.hpp"
 #include "utils/LoggerFactory.hpp"
 
 #include "domain/backtest/Engine.hpp"
+#include "domain/backtest/WarmupCache.hpp"
 #include "ingest/DataIngest.hpp"
+#include "io/BarFile.hpp"
 #include "io/DataExporter.hpp"
+#include "io/IndicatorStore.hpp"
 #include "strategy/BuyHold.hpp"
 #include "strategy/MACrossover.hpp"
 
 namespace qga::cli
 {
 
+    namespace
+    {
+        // -----------------------------------------------------
+        // Cluster sweep: MA crossover grid over local workers
+        // (one series; tasks are parameter pairs, not symbols)
+        // -----------------------------------------------------
+        constexpr double SWEEP_EQUITY = 10000.0;
+
+        /// Parses "min:max:step" into the values it spans.
+        std::vector<int> parseRange(const std::string& spec)
+        {
+            int lo = 0, hi = 0, step = 0;
+            if (std::sscanf(spec.c_str(), "%d:%d:%d", &lo, &hi, &step) != 3 || lo <= 0 || hi < lo
+                || step <= 0)
+                throw std::invalid_argument("invalid range '" + spec + "' (expected min:max:step)");
+            std::vector<int> out;
+            for (int v = lo;; v += step)
+            {
+                out.push_back(v);
+                if (v > hi - step) // next step would pass hi (or overflow int)
+                    break;
+            }
+            return out;
+        }
+
+        /// (fast, slow) pairs with fast < slow, in a fixed order shared by coordinator and workers.
+        std::vector<std::pair<int, int>> sweepGrid(const std::string& fast, const std::string& slow)
+        {
+            std::vector<std::pair<int, int>> grid;
+            const auto SLOW = parseRange(slow);
+            for (int f : parseRange(fast))
+                for (int sl : SLOW)
+                    if (f < sl)
+                        grid.emplace_back(f, sl);
+            return grid;
+        }
+
+        /// Worker mode: backtests tasks [first, first + count) of the grid on a mapped bar file
+        /// and streams one line per task: "<task> <final_equity> <trades> <max_dd> <sharpe>".
+        /// SMA columns are mapped from (or persisted to) the indicator store @p indicators, if any.
+        int runWorker(const std::string& dataset, const std::string& tasks, const std::string& fast,
+                      const std::string& slow, const std::string& indicators)
+        {
+            try
+            {
+                const qga::io::MappedBarFile DATA{dataset, /*verify=*/false};
+                const auto GRID = sweepGrid(fast, slow);
+                std::size_t first = 0, count = 0;
+                if (std::sscanf(tasks.c_str(), "%zu:%zu", &first, &count) != 2
+                    || count > GRID.size() || first > GRID.size() - count)
+                    throw std::invalid_argument("invalid task range '" + tasks + "'");
+
+                std::unique_ptr<qga::io::IndicatorStore> store;
+                std::unique_ptr<qga::strategy::indicators::IndicatorCache> cache;
+                if (!indicators.empty())
+                {
+                    store = std::make_unique<qga::io::IndicatorStore>(indicators);
+                    cache = std::make_unique<qga::strategy::indicators::IndicatorCache>(
+                        std::size_t{256} << 20, store->source());
+                }
+
+                for (std::size_t t = first; t < first + count; ++t)
+                {
+                    auto ma =
+                        cache ? qga::strategy::MACrossover{*cache, DATA.contentHash(), DATA.bars(),
+                                                           GRID[t].first, GRID[t].second}
+                              : qga::strategy::MACrossover{GRID[t].first, GRID[t].second};
+                    const auto R = qga::domain::backtest::Engine{SWEEP_EQUITY}.run(
+                        DATA.bars(), ma, qga::domain::backtest::CaptureLevel::Summary);
+                    std::fputs(fmt::format("{} {:.17g} {} {:.17g} {:.17g}\n", t, R.final_equity_,
+                                           R.trades_executed_, R.max_drawdown_, R.sharpe_)
+                                   .c_str(),
+                               stdout);
+                    std::fflush(stdout); // stream results as they finish
+                }
+                return 0;
+            }
+            catch (const std::exception& ex)
+            {
+                std::cerr << "ERROR: worker: " << ex.what() << "\n";
+                return 1;
+            }
+        }
+
+        /// Coordinator: writes the dataset once as a bar file and fans the grid out to worker
+        /// processes. A non-empty @p indicators directory is handed to the workers as their
+        /// indicator store.
+        void runCluster(const qga::domain::backtest::BarSeries& series, std::size_t workers,
+                        const std::string& fast, const std::string& slow,
+                        const std::filesystem::path& indicators, const char* argv0)
+        {
+            std::error_code ec;
+            auto self = std::filesystem::read_symlink("/proc/self/exe", ec);
+            if (ec)
+                self = argv0;
+
+            const auto GRID = sweepGrid(fast, slow);
+            const auto DATASET =
+                std::filesystem::temp_directory_path()
+                / fmt::format("qga_cluster_{}.qgb",
+                              std::chrono::steady_clock::now().time_since_epoch().count());
+            qga::io::writeBarFile(DATASET, series.data());
+
+            struct Row
+            {
+                double final_equity_ = 0.0;
+                int trades_ = 0;
+                double max_dd_ = 0.0;
+                double sharpe_ = 0.0;
+            };
+            std::vector<Row> rows(GRID.size());
+
+            qga::core::WorkerPoolStats stats;
+            try
+            {
+                stats = qga::core::WorkerPool{{workers}}.run(
+                    GRID.size(),
+                    [&](std::size_t first, std::size_t count)
+                    {
+                        std::vector<std::string> args{self.string(),
+                                                      "--worker-dataset",
+                                                      DATASET.string(),
+                                                      "--worker-tasks",
+                                                      fmt::format("{}:{}", first, count),
+                                                      "--fast",
+                                                      fast,
+                                                      "--slow",
+                                                      slow};
+                        if (!indicators.empty())
+                        {
+                            args.emplace_back("--worker-indicators");
+                            args.push_back(indicators.string());
+                        }
+                        return args;
+                    },
+                    [&](std::size_t task, std::string_view payload)
+                    {
+                        auto& r = rows[task];
+                        const std::string LINE{payload};
+                        if (std::sscanf(LINE.c_str(), "%lf %d %lf %lf", &r.final_equity_,
+                                        &r.trades_, &r.max_dd_, &r.sharpe_)
+                            != 4)
+                            throw std::runtime_error("malformed worker result: " + LINE);
+                    });
+            }
+            catch (...)
+            {
+                std::filesystem::remove(DATASET, ec);
+                throw;
+            }
+            std::filesystem::remove(DATASET, ec);
+
+            std::size_t best = 0;
+            for (std::size_t i = 1; i < rows.size(); ++i)
+                if (rows[i].final_equity_ > rows[best].final_equity_)
+                    best = i;
+            std::cout << fmt::format(
+                "Cluster sweep: {} runs on {} workers ({} launches, {} failed, {} tasks "
+                "retried)\n",
+                GRID.size(), workers, stats.launched_, stats.failed_, stats.retried_tasks_);
+            if (!rows.empty())
+                std::cout << fmt::format(
+                    "  best MA({}, {}): final equity={:.2f} trades={} max_dd={:.4f} "
+                    "sharpe={:.4f}\n",
+                    GRID[best].first, GRID[best].second, rows[best].final_equity_,
+                    rows[best].trades_, rows[best].max_dd_, rows[best].sharpe_);
+        }
+    } // namespace
+
     AppCLI::AppCLI() = default;
     AppCLI::~AppCLI() = default;
 
@@ -39,8 +219,30 @@ namespace qga::cli
         std::string cli_input;
         std::string cli_output;
         bool show_version = false;
+        bool show_perf = false;
 
         app.add_flag("--version", show_version, "Show version information");
+        app.add_flag("--perf", show_perf, "Print engine hot-path counters after the backtest");
+
+        std::size_t workers = 0;
+        std::string fast_range = "5:50:5";
+        std::string slow_range = "20:200:20";
+        std::string worker_dataset;
+        std::string worker_tasks;
+        std::string worker_indicators;
+        bool indicator_store = false;
+        app.add_option(
+            "--workers", workers,
+            "Run an MA crossover sweep across N local worker processes instead of the default "
+            "backtest and export");
+        app.add_option("--fast", fast_range, "Sweep range of the fast period (min:max:step)");
+        app.add_option("--slow", slow_range, "Sweep range of the slow period (min:max:step)");
+        app.add_flag(
+            "--indicator-store", indicator_store,
+            "Persist sweep indicator columns next to the input file and reuse them across runs");
+        app.add_option("--worker-dataset", worker_dataset)->group(""); // internal: worker mode
+        app.add_option("--worker-tasks", worker_tasks)->group("");
+        app.add_option("--worker-indicators", worker_indicators)->group("");
         app.add_option("--config", config_path, "Path to configuration file");
 
         app.add_option("--input", cli_input, "Override input data file (CSV)");
@@ -54,6 +256,10 @@ namespace qga::cli
             return 0;
         }
 
+        if (!worker_dataset.empty())
+            return runWorker(worker_dataset, worker_tasks, fast_range, slow_range,
+                             worker_indicators);
+
         if (config_path.empty())
         {
             std::cerr << "ERROR: --config is required\n";
@@ -64,7 +270,18 @@ namespace qga::cli
         desc.add_options()("help,h", "Show help")("version,v", "Version")(
             "config,c", po::value<std::string>(),
             "Config file")("input,i", po::value<std::string>(),
-                           "Input CSV")("output,o", po::value<std::string>(), "Output CSV");
+                           "Input CSV")("output,o", po::value<std::string>(), "Output CSV")(
+            "perf", "Print engine hot-path counters after the backtest")(
+            "workers", po::value<std::size_t>(),
+            "Run an MA crossover sweep across N local worker processes instead of the default "
+            "backtest and export")("fast", po::value<std::string>()->default_value("5:50:5"),
+                                   "Sweep range of the fast period")(
+            "slow", po::value<std::string>()->default_value("20:200:20"),
+            "Sweep range of the slow period")(
+            "indicator-store", "Persist sweep indicator columns next to the input file")(
+            "worker-dataset", po::value<std::string>(), "Internal: worker mode dataset")(
+            "worker-tasks", po::value<std::string>(), "Internal: worker mode task range")(
+            "worker-indicators", po::value<std::string>(), "Internal: worker mode indicator store");
 
         po::variables_map vm;
         po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -82,6 +299,16 @@ namespace qga::cli
             return 0;
         }
 
+        const std::size_t workers = vm.count("workers") ? vm["workers"].as<std::size_t>() : 0;
+        const std::string fast_range = vm["fast"].as<std::string>();
+        const std::string slow_range = vm["slow"].as<std::string>();
+        if (vm.count("worker-dataset"))
+            return runWorker(
+                vm["worker-dataset"].as<std::string>(),
+                vm.count("worker-tasks") ? vm["worker-tasks"].as<std::string>() : "", fast_range,
+                slow_range,
+                vm.count("worker-indicators") ? vm["worker-indicators"].as<std::string>() : "");
+
         if (!vm.count("config"))
         {
             std::cerr << "ERROR: --config is required\n";
@@ -91,6 +318,8 @@ namespace qga::cli
         std::string config_path = vm["config"].as<std::string>();
         std::string cli_input = vm.count("input") ? vm["input"].as<std::string>() : "";
         std::string cli_output = vm.count("output") ? vm["output"].as<std::string>() : "";
+        bool show_perf = vm.count("perf") > 0;
+        const bool indicator_store = vm.count("indicator-store") > 0;
 #endif
 
         // -----------------------------------------------------
@@ -156,12 +385,50 @@ namespace qga::cli
         // -----------------------------------------------------
         // Run strategy + engine
         // -----------------------------------------------------
+        if (workers > 0)
+        {
+            try
+            {
+                std::filesystem::path indicators;
+                if (indicator_store)
+                {
+                    // Columns of an older version of the input are stale: drop them up front.
+                    qga::io::IndicatorStore store{
+                        qga::io::IndicatorStore::directoryFor(config.inputPath())};
+                    store.prune(qga::domain::backtest::seriesFingerprint(series.data()));
+                    indicators = store.directory();
+                }
+                runCluster(series, workers, fast_range, slow_range, indicators, argv[0]);
+            }
+            catch (const std::exception& ex)
+            {
+                std::cerr << "ERROR: Cluster sweep failed: " << ex.what() << "\n";
+                return 1;
+            }
+            return 0; // the sweep replaces the default backtest and export
+        }
+
         qga::strategy::BuyHold strat{};
         qga::domain::backtest::Engine engine(10000.0);
 
-        auto result = engine.run(series, strat);
+        qga::domain::backtest::EngineCounters counters;
+        auto result = engine.run(series, strat, qga::domain::backtest::CaptureLevel::None,
+                                 show_perf ? &counters : nullptr);
         logger->info(fmt::format("Backtest finished. Final equity={}", result.final_equity_));
 
+        if (show_perf)
+        {
+            std::cout << fmt::format("Engine: {} bars, {:.1f} ns/bar, wall {:.3f} ms\n",
+                                     counters.bars_, counters.nsPerBar(),
+                                     static_cast<double>(counters.wall_ns_) / 1e6)
+                      << fmt::format("  onBar {:.3f} ms ({:.1f}%), engine {:.3f} ms\n",
+                                     static_cast<double>(counters.strategy_ns_) / 1e6,
+                                     100.0 * counters.strategyShare(),
+                                     static_cast<double>(counters.engineNs()) / 1e6)
+                      << fmt::format("  signals {}, fills {}\n", counters.signals_,
+                                     counters.fills_);
+        }
+
         // -----------------------------------------------------
         // Export results
         // -----------------------------------------------------
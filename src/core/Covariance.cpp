@@ -0,0 +1,461 @@
+#include "core/Covariance.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "core/Parallel.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define QGA_COVARIANCE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace qga::core::stats
+{
+
+    namespace
+    {
+        constexpr std::size_t PANEL = 8; // symbols per packed panel / output tile
+        constexpr std::size_t KC = 256;  // periods per chunk: a pair of panel chunks fits in L1
+        constexpr std::size_t NC = 32;   // column panels per block: a block of chunks fits in L2
+
+        // ============================================================
+        // Scalar fallback
+        // ============================================================
+        namespace scalar
+        {
+            struct Ops
+            {
+                using V = double;
+                static constexpr std::size_t W = 1;
+                static constexpr std::size_t MR = 4;
+
+                static V set1(double v) { return v; }
+                static V loadu(const double* p) { return *p; }
+                static void storeu(double* p, V v) { *p = v; }
+                static V add(V a, V b) { return a + b; }
+                static V sub(V a, V b) { return a - b; }
+                static V mul(V a, V b) { return a * b; }
+                static V mulAdd(V a, V b, V c) { return a * b + c; }
+            };
+
+#include "CovarianceKernel.inl"
+        } // namespace scalar
+
+#if defined(QGA_COVARIANCE_X86)
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+        // ============================================================
+        // AVX2: 4 x 8 tile = 8 accumulators
+        // ============================================================
+        namespace avx2
+        {
+            struct Ops
+            {
+                using V = __m256d;
+                static constexpr std::size_t W = 4;
+                static constexpr std::size_t MR = 4;
+
+                static V set1(double v) { return _mm256_set1_pd(v); }
+                static V loadu(const double* p) { return _mm256_loadu_pd(p); }
+                static void storeu(double* p, V v) { _mm256_storeu_pd(p, v); }
+                static V add(V a, V b) { return _mm256_add_pd(a, b); }
+                static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+                static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+                // No FMA: CpuFeatures only guarantees AVX2.
+                static V mulAdd(V a, V b, V c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+            };
+
+#include "CovarianceKernel.inl"
+        } // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+        // ============================================================
+        // AVX-512: 8 x 8 tile = 8 accumulators, fused multiply-add
+        // ============================================================
+        namespace avx512
+        {
+            struct Ops
+            {
+                using V = __m512d;
+                static constexpr std::size_t W = 8;
+                static constexpr std::size_t MR = 8;
+
+                static V set1(double v) { return _mm512_set1_pd(v); }
+                static V loadu(const double* p) { return _mm512_loadu_pd(p); }
+                static void storeu(double* p, V v) { _mm512_storeu_pd(p, v); }
+                static V add(V a, V b) { return _mm512_add_pd(a, b); }
+                static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+                static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+                static V mulAdd(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+            };
+
+#include "CovarianceKernel.inl"
+        } // namespace avx512
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // QGA_COVARIANCE_X86
+
+        using SyrkFn = void (*)(const double*, std::size_t, std::size_t, std::size_t, std::size_t,
+                                double*, std::size_t);
+        using RankFn = void (*)(double*, std::size_t, std::size_t, const double*, const double*,
+                                std::size_t, std::size_t);
+
+        /// Kernels compiled for one instruction set.
+        struct KernelSet
+        {
+            SyrkFn syrk_;
+            RankFn rank_update_;
+        };
+
+        const KernelSet& kernelsFor(SimdLevel level) noexcept
+        {
+            static const KernelSet SCALAR{&scalar::syrkRows, &scalar::rankUpdateRows};
+#if defined(QGA_COVARIANCE_X86)
+            static const KernelSet AVX2{&avx2::syrkRows, &avx2::rankUpdateRows};
+            static const KernelSet AVX512{&avx512::syrkRows, &avx512::rankUpdateRows};
+            switch (clampSimdLevel(level))
+            {
+            case SimdLevel::Avx512:
+                return AVX512;
+            case SimdLevel::Avx2:
+                return AVX2;
+            default:
+                break;
+            }
+#else
+            (void) level;
+#endif
+            return SCALAR;
+        }
+
+        std::size_t checkedRows(std::span<const double> x, std::size_t symbols, std::size_t& stride,
+                                const char* who)
+        {
+            if (stride == 0)
+                stride = symbols;
+            if (symbols == 0 || symbols > stride)
+                throw std::invalid_argument(std::string(who) + ": symbols must be in [1, stride]");
+            if (x.size() % stride != 0)
+                throw std::invalid_argument(std::string(who)
+                                            + ": size is not a multiple of the stride");
+            const std::size_t ROWS = x.size() / stride;
+            if (ROWS < 2)
+                throw std::invalid_argument(std::string(who) + ": at least 2 rows are required");
+            return ROWS;
+        }
+
+        std::vector<double> columnMeans(const double* x, std::size_t rows, std::size_t symbols,
+                                        std::size_t stride)
+        {
+            std::vector<double> mean(symbols, 0.0);
+            for (std::size_t t = 0; t < rows; ++t)
+                for (std::size_t s = 0; s < symbols; ++s)
+                    mean[s] += x[t * stride + s];
+            for (auto& m : mean)
+                m /= static_cast<double>(rows);
+            return mean;
+        }
+
+        /**
+         * Upper panel tiles of (X - shift)^T (X - shift) into @p c (ldc = padded
+         * symbols, at least as many rows); @p shift may be null.
+         */
+        void crossProducts(const double* x, std::size_t rows, std::size_t symbols,
+                           std::size_t stride, const double* shift, double* c, std::size_t ldc,
+                           const CovarianceOptions& options)
+        {
+            const std::size_t PANELS = (symbols + PANEL - 1) / PANEL;
+            const std::size_t THREADS = options.threads_ == 0 ? defaultThreads() : options.threads_;
+
+            // Pack once: panel p holds symbols [8p, 8p + 8) of every row, zero-padded.
+            std::vector<double> packed(PANELS * rows * PANEL);
+            parallelFor(
+                PANELS,
+                [&](std::size_t p, std::size_t)
+                {
+                    const std::size_t S0 = p * PANEL;
+                    const std::size_t WIDTH = std::min(PANEL, symbols - S0);
+                    double* out = packed.data() + p * rows * PANEL;
+                    for (std::size_t t = 0; t < rows; ++t)
+                    {
+                        const double* in = x + t * stride + S0;
+                        for (std::size_t k = 0; k < PANEL; ++k)
+                            out[t * PANEL + k] =
+                                k < WIDTH ? in[k] - (shift ? shift[S0 + k] : 0.0) : 0.0;
+                    }
+                },
+                THREADS);
+
+            // Bands of row panels: up to 8 per task, at least a few tasks per thread.
+            const std::size_t BAND = std::clamp<std::size_t>(PANELS / (4 * THREADS), 1, 8);
+            const std::size_t TASKS = (PANELS + BAND - 1) / BAND;
+            const SyrkFn SYRK = kernelsFor(options.level_).syrk_;
+            parallelFor(
+                TASKS,
+                [&](std::size_t task, std::size_t)
+                {
+                    const std::size_t P0 = task * BAND;
+                    SYRK(packed.data(), rows, PANELS, P0, std::min(PANELS, P0 + BAND), c, ldc);
+                },
+                THREADS);
+        }
+
+        /// Copies the upper triangle of @p m into the lower one.
+        void mirror(SymmetricMatrix& m)
+        {
+            for (std::size_t i = 0; i < m.size(); ++i)
+                for (std::size_t j = 0; j < i; ++j)
+                    m(i, j) = m(j, i);
+        }
+
+        void checkIntensity(double intensity, const char* who)
+        {
+            if (!(intensity >= 0.0 && intensity <= 1.0))
+                throw std::invalid_argument(std::string(who) + ": intensity must be in [0, 1]");
+        }
+    } // namespace
+
+    SymmetricMatrix covariance(std::span<const double> returns, std::size_t symbols,
+                               std::size_t stride, const CovarianceOptions& options)
+    {
+        const std::size_t ROWS = checkedRows(returns, symbols, stride, "covariance");
+        const auto MEAN = columnMeans(returns.data(), ROWS, symbols, stride);
+
+        SymmetricMatrix cov{symbols};
+        crossProducts(returns.data(), ROWS, symbols, stride, MEAN.data(), cov.data(), cov.stride(),
+                      options);
+        const double SCALE = 1.0 / static_cast<double>(ROWS - 1);
+        for (std::size_t i = 0; i < symbols; ++i)
+            for (std::size_t j = i; j < symbols; ++j)
+                cov(i, j) *= SCALE;
+        mirror(cov);
+        return cov;
+    }
+
+    SymmetricMatrix correlation(const SymmetricMatrix& cov)
+    {
+        const std::size_t N = cov.size();
+        std::vector<double> inv_sd(N);
+        for (std::size_t i = 0; i < N; ++i)
+            inv_sd[i] = cov(i, i) > 0.0 ? 1.0 / std::sqrt(cov(i, i)) : 0.0;
+
+        SymmetricMatrix corr{N};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j < N; ++j)
+                corr(i, j) = cov(i, j) * inv_sd[i] * inv_sd[j];
+            corr(i, i) = 1.0;
+        }
+        return corr;
+    }
+
+    ShrunkCovariance ledoitWolf(std::span<const double> returns, std::size_t symbols,
+                                std::size_t stride, const CovarianceOptions& options)
+    {
+        const std::size_t ROWS = checkedRows(returns, symbols, stride, "ledoitWolf");
+        const double T = static_cast<double>(ROWS);
+        const double N = static_cast<double>(symbols);
+        const auto MEAN = columnMeans(returns.data(), ROWS, symbols, stride);
+
+        // S = X'X / T of the centred returns (Ledoit-Wolf use the divisor T).
+        ShrunkCovariance out{SymmetricMatrix{symbols}, 0.0};
+        SymmetricMatrix& s = out.matrix_;
+        crossProducts(returns.data(), ROWS, symbols, stride, MEAN.data(), s.data(), s.stride(),
+                      options);
+        for (std::size_t i = 0; i < symbols; ++i)
+            for (std::size_t j = i; j < symbols; ++j)
+                s(i, j) /= T;
+        mirror(s);
+
+        double trace = 0.0;
+        double frob2 = 0.0; // ||S||_F^2
+        for (std::size_t i = 0; i < symbols; ++i)
+        {
+            trace += s(i, i);
+            for (std::size_t j = 0; j < symbols; ++j)
+                frob2 += s(i, j) * s(i, j);
+        }
+        const double MU = trace / N;
+        const double D2 = (frob2 - 2.0 * MU * trace + MU * MU * N) / N; // ||S - mu I||^2 / N
+
+        // sum_t ||x_t x_t' - S||_F^2 = sum_t ||x_t||^4 - T ||S||_F^2, so b^2 costs O(T N).
+        double norm4 = 0.0;
+        for (std::size_t t = 0; t < ROWS; ++t)
+        {
+            double n2 = 0.0;
+            const double* row = returns.data() + t * stride;
+            for (std::size_t k = 0; k < symbols; ++k)
+            {
+                const double D = row[k] - MEAN[k];
+                n2 += D * D;
+            }
+            norm4 += n2 * n2;
+        }
+        const double B2_BAR = std::max(0.0, (norm4 - T * frob2) / (T * T * N));
+        const double B2 = std::min(B2_BAR, D2);
+        out.intensity_ = D2 > 0.0 ? B2 / D2 : 0.0;
+
+        // Apply the intensity to the unbiased sample covariance.
+        const double RESCALE = T / (T - 1.0);
+        const double KEEP = 1.0 - out.intensity_;
+        for (std::size_t i = 0; i < symbols; ++i)
+        {
+            for (std::size_t j = 0; j < symbols; ++j)
+                s(i, j) *= KEEP * RESCALE;
+            s(i, i) += out.intensity_ * MU * RESCALE;
+        }
+        return out;
+    }
+
+    SymmetricMatrix shrinkToIdentity(const SymmetricMatrix& cov, double intensity)
+    {
+        checkIntensity(intensity, "shrinkToIdentity");
+        const std::size_t N = cov.size();
+        double trace = 0.0;
+        for (std::size_t i = 0; i < N; ++i)
+            trace += cov(i, i);
+        const double MU = N > 0 ? trace / static_cast<double>(N) : 0.0;
+
+        SymmetricMatrix out{N};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j < N; ++j)
+                out(i, j) = (1.0 - intensity) * cov(i, j);
+            out(i, i) += intensity * MU;
+        }
+        return out;
+    }
+
+    SymmetricMatrix shrinkToConstantCorrelation(const SymmetricMatrix& cov, double intensity)
+    {
+        checkIntensity(intensity, "shrinkToConstantCorrelation");
+        const std::size_t N = cov.size();
+        std::vector<double> sd(N);
+        for (std::size_t i = 0; i < N; ++i)
+            sd[i] = std::sqrt(std::max(0.0, cov(i, i)));
+
+        double sum = 0.0;
+        std::size_t pairs = 0;
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = i + 1; j < N; ++j)
+                if (sd[i] > 0.0 && sd[j] > 0.0)
+                {
+                    sum += cov(i, j) / (sd[i] * sd[j]);
+                    ++pairs;
+                }
+        const double R_BAR = pairs > 0 ? sum / static_cast<double>(pairs) : 0.0;
+
+        SymmetricMatrix out{N};
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                const double TARGET = i == j ? cov(i, i) : R_BAR * sd[i] * sd[j];
+                out(i, j) = (1.0 - intensity) * cov(i, j) + intensity * TARGET;
+            }
+        return out;
+    }
+
+    RollingCovariance::RollingCovariance(std::size_t symbols, std::size_t window,
+                                         const CovarianceOptions& options)
+        : n_(symbols), stride_((symbols + PANEL - 1) / PANEL * PANEL), window_(window),
+          options_(options)
+    {
+        if (symbols == 0)
+            throw std::invalid_argument("RollingCovariance: symbols must be > 0");
+        if (window < 2)
+            throw std::invalid_argument("RollingCovariance: window must be >= 2");
+        rows_.assign(window_ * stride_, 0.0);
+        sum_.assign(stride_, 0.0);
+        cross_.assign(stride_ * stride_, 0.0);
+        next_.assign(stride_, 0.0);
+        zero_.assign(stride_, 0.0);
+    }
+
+    void RollingCovariance::push(std::span<const double> row)
+    {
+        if (row.size() != n_)
+            throw std::invalid_argument("RollingCovariance::push: row size differs from symbols()");
+        std::copy(row.begin(), row.end(), next_.begin());
+
+        double* slot = rows_.data() + (count_ % window_) * stride_;
+        const double* old = ready() ? slot : zero_.data();
+        for (std::size_t s = 0; s < n_; ++s)
+            sum_[s] += next_[s] - old[s];
+
+        // cross += next next' - old old', rows split across threads for large universes.
+        const RankFn RANK = kernelsFor(options_.level_).rank_update_;
+        const std::size_t THREADS =
+            n_ >= 1024 ? (options_.threads_ == 0 ? defaultThreads() : options_.threads_) : 1;
+        const std::size_t ROWS_PER_TASK =
+            std::max<std::size_t>(PANEL, n_ / (4 * THREADS) / PANEL * PANEL);
+        const std::size_t TASKS = (n_ + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+        parallelFor(
+            TASKS,
+            [&](std::size_t task, std::size_t)
+            {
+                const std::size_t R0 = task * ROWS_PER_TASK;
+                RANK(cross_.data(), stride_, stride_, next_.data(), old, R0,
+                     std::min(n_, R0 + ROWS_PER_TASK));
+            },
+            THREADS);
+
+        std::copy(next_.begin(), next_.end(), slot);
+        ++count_;
+        if (ready() && ++since_rebase_ >= window_)
+            rebase();
+    }
+
+    void RollingCovariance::rebase()
+    {
+        std::fill(cross_.begin(), cross_.end(), 0.0);
+        crossProducts(rows_.data(), window_, n_, stride_, nullptr, cross_.data(), stride_,
+                      options_);
+        std::fill(sum_.begin(), sum_.end(), 0.0);
+        for (std::size_t t = 0; t < window_; ++t)
+            for (std::size_t s = 0; s < n_; ++s)
+                sum_[s] += rows_[t * stride_ + s];
+        since_rebase_ = 0;
+    }
+
+    SymmetricMatrix RollingCovariance::covariance() const
+    {
+        const std::size_t ROWS = std::min(count_, window_);
+        if (ROWS < 2)
+            throw std::logic_error("RollingCovariance::covariance: fewer than 2 rows");
+        const double R = static_cast<double>(ROWS);
+
+        SymmetricMatrix cov{n_};
+        for (std::size_t i = 0; i < n_; ++i)
+            for (std::size_t j = i; j < n_; ++j)
+                cov(i, j) = (cross_[i * stride_ + j] - sum_[i] * sum_[j] / R) / (R - 1.0);
+        mirror(cov);
+        return cov;
+    }
+
+} // namespace qga::core::stats
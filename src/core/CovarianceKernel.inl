@@ -0,0 +1,96 @@
+// CovarianceKernel.inl — bodies of the covariance kernels.
+//
+// Included once per instruction set by Covariance.cpp, inside a namespace
+// that defines `Ops` (vector width W, rows per micro-tile MR and primitive
+// operations) and, for SIMD targets, inside a `#pragma ... target(...)`
+// region. Matrices are stored in panels of PANEL = 8 columns.
+
+/**
+ * C[MR x PANEL] += A^T B over @p kc packed rows, where A is @p a (MR columns
+ * of a panel, row stride PANEL) and B the panel @p b. The MR x PANEL block
+ * of accumulators stays in registers for the whole chunk.
+ */
+inline void microKernel(const double* a, const double* b, std::size_t kc, double* c, std::size_t ldc)
+{
+    using V = Ops::V;
+    constexpr std::size_t W = Ops::W;
+    constexpr std::size_t MR = Ops::MR;
+    constexpr std::size_t NV = PANEL / W;
+
+    V acc[MR][NV];
+    for (std::size_t r = 0; r < MR; ++r)
+        for (std::size_t v = 0; v < NV; ++v)
+            acc[r][v] = Ops::set1(0.0);
+
+    for (std::size_t t = 0; t < kc; ++t)
+    {
+        const double* at = a + t * PANEL;
+        const double* bt = b + t * PANEL;
+        V bv[NV];
+        for (std::size_t v = 0; v < NV; ++v)
+            bv[v] = Ops::loadu(bt + v * W);
+        for (std::size_t r = 0; r < MR; ++r)
+        {
+            const V AR = Ops::set1(at[r]);
+            for (std::size_t v = 0; v < NV; ++v)
+                acc[r][v] = Ops::mulAdd(AR, bv[v], acc[r][v]);
+        }
+    }
+
+    for (std::size_t r = 0; r < MR; ++r)
+        for (std::size_t v = 0; v < NV; ++v)
+        {
+            double* p = c + r * ldc + v * W;
+            Ops::storeu(p, Ops::add(Ops::loadu(p), acc[r][v]));
+        }
+}
+
+/**
+ * Upper-triangle panel tiles of C += X^T X for the row panels [p0, p1),
+ * where @p packed holds `panels` panels of @p rows packed rows each.
+ */
+inline void syrkRows(const double* packed, std::size_t rows, std::size_t panels, std::size_t p0, std::size_t p1,
+                     double* c, std::size_t ldc)
+{
+    for (std::size_t t0 = 0; t0 < rows; t0 += KC)
+    {
+        const std::size_t KN = std::min(KC, rows - t0);
+        for (std::size_t jb = p0; jb < panels; jb += NC)
+        {
+            const std::size_t JE = std::min(panels, jb + NC);
+            for (std::size_t pi = p0; pi < p1; ++pi)
+            {
+                const double* a = packed + (pi * rows + t0) * PANEL;
+                for (std::size_t pj = std::max(pi, jb); pj < JE; ++pj)
+                {
+                    const double* b = packed + (pj * rows + t0) * PANEL;
+                    double* tile = c + pi * PANEL * ldc + pj * PANEL;
+                    for (std::size_t r = 0; r < PANEL; r += Ops::MR)
+                        microKernel(a + r, b, KN, tile + r * ldc, ldc);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Rows [r0, r1) of the upper triangle of S += x x^T - o o^T (panel-aligned
+ * columns from the row's own panel to @p width).
+ */
+inline void rankUpdateRows(double* s, std::size_t lds, std::size_t width, const double* x, const double* o,
+                           std::size_t r0, std::size_t r1)
+{
+    using V = Ops::V;
+    constexpr std::size_t W = Ops::W;
+    for (std::size_t i = r0; i < r1; ++i)
+    {
+        const V XI = Ops::set1(x[i]);
+        const V OI = Ops::set1(o[i]);
+        double* row = s + i * lds;
+        for (std::size_t j = i / PANEL * PANEL; j < width; j += W)
+        {
+            const V UPD = Ops::sub(Ops::mul(XI, Ops::loadu(x + j)), Ops::mul(OI, Ops::loadu(o + j)));
+            Ops::storeu(row + j, Ops::add(Ops::loadu(row + j), UPD));
+        }
+    }
+}
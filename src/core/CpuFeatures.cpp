@@ -0,0 +1,108 @@
+#include "core/CpuFeatures.hpp"
+
+#include <cstdlib>
+#include <string_view>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace qga::core
+{
+
+    namespace
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        SimdLevel detectMsvc() noexcept
+        {
+            int regs[4]{};
+            __cpuid(regs, 0);
+            if (regs[0] < 7)
+                return SimdLevel::Scalar;
+
+            __cpuid(regs, 1);
+            const bool OSXSAVE = (regs[2] & (1 << 27)) != 0;
+            const bool AVX = (regs[2] & (1 << 28)) != 0;
+            if (!OSXSAVE || !AVX)
+                return SimdLevel::Scalar;
+
+            // XCR0: bits 1-2 = SSE/AVX state, bits 5-7 = AVX-512 state
+            const unsigned long long XCR0 = _xgetbv(0);
+            if ((XCR0 & 0x6) != 0x6)
+                return SimdLevel::Scalar;
+
+            __cpuidex(regs, 7, 0);
+            const bool AVX2 = (regs[1] & (1 << 5)) != 0;
+            const bool AVX512F = (regs[1] & (1 << 16)) != 0;
+
+            if (AVX512F && (XCR0 & 0xE6) == 0xE6)
+                return SimdLevel::Avx512;
+            if (AVX2)
+                return SimdLevel::Avx2;
+            return SimdLevel::Scalar;
+        }
+#endif
+
+        SimdLevel parseOverride(std::string_view v, SimdLevel fallback) noexcept
+        {
+            if (v == "scalar")
+                return SimdLevel::Scalar;
+            if (v == "avx2")
+                return SimdLevel::Avx2;
+            if (v == "avx512")
+                return SimdLevel::Avx512;
+            return fallback;
+        }
+    } // namespace
+
+    SimdLevel detectSimdLevel() noexcept
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return SimdLevel::Avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::Avx2;
+        return SimdLevel::Scalar;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return detectMsvc();
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    SimdLevel clampSimdLevel(SimdLevel requested) noexcept
+    {
+        const SimdLevel HOST = detectSimdLevel();
+        return static_cast<int>(requested) < static_cast<int>(HOST) ? requested : HOST;
+    }
+
+    SimdLevel activeSimdLevel() noexcept
+    {
+        static const SimdLevel LEVEL = []
+        {
+            const SimdLevel HOST = detectSimdLevel();
+            const char* env = std::getenv("QGA_SIMD");
+            if (env == nullptr)
+                return HOST;
+            return clampSimdLevel(parseOverride(env, HOST));
+        }();
+        return LEVEL;
+    }
+
+    const char* toString(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+        case SimdLevel::Avx512:
+            return "avx512";
+        case SimdLevel::Avx2:
+            return "avx2";
+        case SimdLevel::Scalar:
+        default:
+            return "scalar";
+        }
+    }
+
+} // namespace qga::core
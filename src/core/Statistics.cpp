@@ -1,4 +1,5 @@
 #include "core/Statistics.hpp"
+#include "core/StatisticsKernels.hpp"
 #include "common/LogLevel.hpp"
 #include "utils/ILogger.hpp"
 #include "utils/LoggerFactory.hpp"
@@ -123,15 +124,7 @@ namespace qga::core
         if (equity.size() < 2)
             return 0.0;
 
-        double peak = equity[0];
-        double max_dd = 0.0;
-
-        for (double v : equity)
-        {
-            peak = std::max(peak, v);
-            double dd = (peak - v) / peak;
-            max_dd = std::max(max_dd, dd);
-        }
+        const double max_dd = stats::maxDrawdown(equity);
 
         s_logger->log(LogLevel::Info, "[Statistics] MaxDrawdown calculated: " +
                                           std::to_string(max_dd));
@@ -158,14 +151,7 @@ namespace qga::core
                         "[Statistics] Invalid periods_per_year in CAGR");
             return 0.0;
         }
-        double start = equity.front();
-        double end = equity.back();
-        double years = (equity.size() - 1) / periods_per_year;
-
-        if (start <= 0.0 || years <= 0.0)
-            return 0.0;
-
-        double result = std::pow(end / start, 1.0 / years) - 1.0;
+        double result = stats::cagr(equity, periods_per_year);
 
         s_logger->log(LogLevel::Info, "[Statistics] CAGR calculated: " +
                                           std::to_string(result));
@@ -195,21 +181,7 @@ namespace qga::core
             return 0.0;
         }
 
-        // Convert annual risk-free to per-period
-        double rf = risk_free_annual / periods_per_year;
-
-        double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-
-        // stddev
-        double sumsq = 0.0;
-        for (double r : returns)
-            sumsq += (r - mean) * (r - mean);
-        double stddev = std::sqrt(sumsq / (returns.size() - 1));
-
-        if (stddev == 0.0)
-            return 0.0;
-
-        double sharpe = (mean - rf) / stddev;
+        double sharpe = stats::sharpeRatio(returns, risk_free_annual, periods_per_year);
 
         s_logger->log(LogLevel::Info,
                       "[Statistics] Sharpe Ratio calculated: " + std::to_string(sharpe));
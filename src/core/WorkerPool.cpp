@@ -0,0 +1,243 @@
+#include "core/WorkerPool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <stdexcept>
+
+#include "core/Parallel.hpp"
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace qga::core
+{
+
+    WorkerPool::WorkerPool(WorkerPoolParams params) : params_(params)
+    {
+        if (params_.max_attempts_ == 0)
+            throw std::invalid_argument("WorkerPool: max_attempts_ must be > 0");
+    }
+
+#if defined(_WIN32)
+
+    WorkerPoolStats WorkerPool::run(std::size_t, const Command&, const OnResult&) const
+    {
+        throw std::runtime_error("WorkerPool: worker processes are not supported on this platform");
+    }
+
+#else
+
+    namespace
+    {
+        struct Chunk
+        {
+            std::size_t first_;
+            std::size_t count_;
+            std::size_t attempt_;
+        };
+
+        struct Worker
+        {
+            pid_t pid_;
+            int fd_;
+            Chunk chunk_;
+            std::string pending_;   // partial line
+            std::vector<bool> got_; // per task of the chunk
+        };
+
+        pid_t spawn(const std::vector<std::string>& args, int& read_fd)
+        {
+            if (args.empty())
+                throw std::invalid_argument("WorkerPool: empty command");
+            int fds[2];
+            // pipe() + FD_CLOEXEC rather than Linux-only pipe2(); the pool spawns from one thread.
+            if (::pipe(fds) != 0)
+                throw std::runtime_error("WorkerPool: pipe failed");
+            ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+            ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+            std::vector<char*> argv;
+            argv.reserve(args.size() + 1);
+            for (const auto& a : args)
+                argv.push_back(const_cast<char*>(a.c_str()));
+            argv.push_back(nullptr);
+
+            posix_spawn_file_actions_t fa;
+            posix_spawn_file_actions_init(&fa);
+            posix_spawn_file_actions_adddup2(&fa, fds[1], STDOUT_FILENO);
+            pid_t pid = -1;
+            const int RC = ::posix_spawnp(&pid, argv[0], &fa, nullptr, argv.data(), environ);
+            posix_spawn_file_actions_destroy(&fa);
+            ::close(fds[1]);
+            if (RC != 0)
+            {
+                ::close(fds[0]);
+                return -1;
+            }
+            read_fd = fds[0];
+            return pid;
+        }
+    } // namespace
+
+    WorkerPoolStats WorkerPool::run(std::size_t tasks, const Command& command,
+                                    const OnResult& on_result) const
+    {
+        WorkerPoolStats stats;
+        const std::size_t WORKERS = params_.workers_ > 0 ? params_.workers_ : defaultThreads();
+        const std::size_t CHUNK =
+            params_.chunk_ > 0
+                ? params_.chunk_
+                : std::max<std::size_t>(1, (tasks + 4 * WORKERS - 1) / (4 * WORKERS));
+
+        std::deque<Chunk> queue;
+        for (std::size_t first = 0; first < tasks; first += CHUNK)
+            queue.push_back({first, std::min(CHUNK, tasks - first), 1});
+
+        std::vector<Worker> active;
+        const auto KILL_ALL = [&]
+        {
+            for (auto& w : active)
+            {
+                ::kill(w.pid_, SIGKILL);
+                ::close(w.fd_);
+                int status = 0;
+                ::waitpid(w.pid_, &status, 0);
+            }
+            active.clear();
+        };
+
+        // Requeues the unreported tasks of a failed chunk as contiguous runs.
+        const auto REQUEUE = [&](const Chunk& c, const std::vector<bool>& got)
+        {
+            for (std::size_t i = 0; i < c.count_;)
+            {
+                if (got[i])
+                {
+                    ++i;
+                    continue;
+                }
+                std::size_t j = i;
+                while (j < c.count_ && !got[j])
+                    ++j;
+                if (c.attempt_ >= params_.max_attempts_)
+                    throw std::runtime_error("WorkerPool: task " + std::to_string(c.first_ + i)
+                                             + " failed " + std::to_string(c.attempt_) + " times");
+                queue.push_back({c.first_ + i, j - i, c.attempt_ + 1});
+                stats.retried_tasks_ += j - i;
+                i = j;
+            }
+        };
+
+        const auto CONSUME = [&](Worker& w, std::string_view data)
+        {
+            w.pending_.append(data);
+            std::size_t start = 0;
+            for (std::size_t nl; (nl = w.pending_.find('\n', start)) != std::string::npos;
+                 start = nl + 1)
+            {
+                const std::string_view LINE{w.pending_.data() + start, nl - start};
+                std::size_t task = 0;
+                const auto [end, ec] =
+                    std::from_chars(LINE.data(), LINE.data() + LINE.size(), task);
+                if (ec != std::errc{} || task < w.chunk_.first_
+                    || task >= w.chunk_.first_ + w.chunk_.count_)
+                    continue;
+                const std::size_t I = task - w.chunk_.first_;
+                if (w.got_[I])
+                    continue;
+                w.got_[I] = true;
+                std::string_view payload{end,
+                                         static_cast<std::size_t>(LINE.data() + LINE.size() - end)};
+                if (!payload.empty() && (payload.front() == ' ' || payload.front() == '\t'))
+                    payload.remove_prefix(1);
+                on_result(task, payload);
+            }
+            w.pending_.erase(0, start);
+        };
+
+        try
+        {
+            std::vector<pollfd> polls;
+            char buf[1 << 16];
+            while (!queue.empty() || !active.empty())
+            {
+                while (active.size() < WORKERS && !queue.empty())
+                {
+                    const Chunk C = queue.front();
+                    queue.pop_front();
+                    int fd = -1;
+                    const pid_t PID = spawn(command(C.first_, C.count_), fd);
+                    ++stats.launched_;
+                    if (PID < 0)
+                    {
+                        ++stats.failed_;
+                        REQUEUE(C, std::vector<bool>(C.count_, false));
+                        continue;
+                    }
+                    active.push_back({PID, fd, C, {}, std::vector<bool>(C.count_, false)});
+                }
+                if (active.empty())
+                    continue;
+
+                polls.clear();
+                for (const auto& w : active)
+                    polls.push_back({w.fd_, POLLIN, 0});
+                if (::poll(polls.data(), polls.size(), -1) < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::runtime_error("WorkerPool: poll failed");
+                }
+
+                for (std::size_t k = active.size(); k-- > 0;)
+                {
+                    if (polls[k].revents == 0)
+                        continue;
+                    auto& w = active[k];
+                    const ssize_t N = ::read(w.fd_, buf, sizeof(buf));
+                    if (N > 0)
+                    {
+                        CONSUME(w, {buf, static_cast<std::size_t>(N)});
+                        continue;
+                    }
+                    if (N < 0 && errno == EINTR)
+                        continue;
+
+                    // EOF (or read error): reap the worker and settle its chunk.
+                    ::close(w.fd_);
+                    int status = 0;
+                    ::waitpid(w.pid_, &status, 0);
+                    Worker done = std::move(w);
+                    active.erase(active.begin() + static_cast<std::ptrdiff_t>(k));
+
+                    const bool CLEAN = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+                    const bool COMPLETE = std::ranges::all_of(done.got_, [](bool b) { return b; });
+                    if (!CLEAN || !COMPLETE)
+                    {
+                        ++stats.failed_;
+                        REQUEUE(done.chunk_, done.got_);
+                    }
+                }
+            }
+        }
+        catch (...)
+        {
+            KILL_ALL();
+            throw;
+        }
+        return stats;
+    }
+
+#endif
+
+} // namespace qga::core
@@ -0,0 +1,75 @@
+#include "domain/backtest/BarPanel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace qga::domain::backtest
+{
+
+    BarPanel::BarPanel(const std::vector<BarSeries>& series)
+    {
+        series_.reserve(series.size());
+        bars_.reserve(series.size());
+        std::size_t total = 0;
+        for (const auto& s : series)
+        {
+            series_.push_back(&s);
+            bars_.push_back(s.data().data());
+            total += s.size();
+        }
+        if (total >= MISSING)
+            throw std::length_error("BarPanel: too many bars for 32-bit row map");
+
+        timestamps_.reserve(total);
+        for (const auto& s : series)
+            for (const auto& q : s.data())
+                timestamps_.push_back(q.ts_);
+        std::sort(timestamps_.begin(), timestamps_.end());
+        timestamps_.erase(std::unique(timestamps_.begin(), timestamps_.end()), timestamps_.end());
+
+        stride_ = (series.size() + LANE_PAD - 1) / LANE_PAD * LANE_PAD;
+        close_.assign(timestamps_.size() * stride_, std::numeric_limits<double>::quiet_NaN());
+        rows_.assign(timestamps_.size() * stride_, MISSING);
+
+        for (std::size_t s = 0; s < series.size(); ++s)
+        {
+            const auto& bars = series[s].data();
+            std::size_t t = 0;
+            for (std::size_t i = 0; i < bars.size(); ++i)
+            {
+                // Both sequences are sorted: advance the row cursor to the bar's timestamp.
+                while (t < timestamps_.size() && timestamps_[t] < bars[i].ts_)
+                    ++t;
+                if (t == timestamps_.size() || rows_[t * stride_ + s] != MISSING)
+                    continue; // duplicate timestamp within a series: keep the first bar
+                close_[t * stride_ + s] = bars[i].close_;
+                rows_[t * stride_ + s] = static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+
+    std::vector<double> BarPanel::returns() const
+    {
+        if (size() < 2)
+            return {};
+        std::vector<double> out((size() - 1) * stride_, 0.0);
+        std::vector<double> last(close_.begin(),
+                                 close_.begin() + static_cast<std::ptrdiff_t>(stride_));
+        for (std::size_t t = 1; t < size(); ++t)
+        {
+            const double* row = closeRow(t);
+            double* ret = out.data() + (t - 1) * stride_;
+            for (std::size_t s = 0; s < series_.size(); ++s)
+            {
+                if (std::isnan(row[s]))
+                    continue; // no bar: price carried forward, zero return
+                if (!std::isnan(last[s]) && last[s] != 0.0)
+                    ret[s] = row[s] / last[s] - 1.0;
+                last[s] = row[s];
+            }
+        }
+        return out;
+    }
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,78 @@
+#include "domain/backtest/Checkpoint.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "strategy/StateBlob.hpp"
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        constexpr std::uint32_t MAGIC = 0x4B434751; // "QGCK"
+        constexpr std::uint32_t VERSION = 1;
+    } // namespace
+
+    std::vector<std::uint8_t> EngineCheckpoint::serialize() const
+    {
+        strategy::StateWriter out;
+        out.put(MAGIC);
+        out.put(VERSION);
+        out.put(initial_equity_);
+        out.put(cash_);
+        out.put(qty_);
+        out.put(has_pos_);
+        out.put(trades_executed_);
+        out.put(bars_processed_);
+        out.put(last_ts_);
+        out.put(last_close_);
+        out.putRange(strategy_state_);
+        return out.release();
+    }
+
+    EngineCheckpoint EngineCheckpoint::deserialize(std::span<const std::uint8_t> bytes)
+    {
+        strategy::StateReader in{bytes};
+        if (in.get<std::uint32_t>() != MAGIC)
+            throw std::runtime_error("EngineCheckpoint: not a checkpoint");
+        if (in.get<std::uint32_t>() != VERSION)
+            throw std::runtime_error("EngineCheckpoint: unsupported version");
+
+        EngineCheckpoint cp;
+        cp.initial_equity_ = in.get<double>();
+        cp.cash_ = in.get<double>();
+        cp.qty_ = in.get<double>();
+        cp.has_pos_ = in.get<bool>();
+        cp.trades_executed_ = in.get<int>();
+        cp.bars_processed_ = in.get<std::uint64_t>();
+        cp.last_ts_ = in.get<std::int64_t>();
+        cp.last_close_ = in.get<double>();
+        in.getRange(cp.strategy_state_);
+        if (!in.done())
+            throw std::runtime_error("EngineCheckpoint: trailing bytes");
+        return cp;
+    }
+
+    void EngineCheckpoint::save(const std::filesystem::path& path) const
+    {
+        const auto BYTES = serialize();
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write(reinterpret_cast<const char*>(BYTES.data()),
+                static_cast<std::streamsize>(BYTES.size()));
+        if (!f)
+            throw std::runtime_error("EngineCheckpoint: cannot write " + path.string());
+    }
+
+    EngineCheckpoint EngineCheckpoint::load(const std::filesystem::path& path)
+    {
+        std::ifstream f(path, std::ios::binary);
+        if (!f)
+            throw std::runtime_error("EngineCheckpoint: cannot open " + path.string());
+        const std::vector<std::uint8_t> BYTES{std::istreambuf_iterator<char>(f),
+                                              std::istreambuf_iterator<char>()};
+        return deserialize(BYTES);
+    }
+
+} // namespace qga::domain::backtest
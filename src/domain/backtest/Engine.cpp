@@ -1,62 +1,320 @@
 #include "domain/backtest/Engine.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+
+#include "strategy/StateBlob.hpp"
+#include "strategy/TimeframeFeed.hpp"
+
 namespace qga::domain::backtest{
 
-  BacktestResult Engine::run(BarSeries const& s, strategy::IStrategy& strat) {
-    BacktestResult r;
-    r.initial_equity_ = initial_equity_;
-    r.final_equity_   = initial_equity_;
+  namespace {
 
     // Simple account state: all-in 1 item; without leverage
-    bool has_pos  = false;
-   // double entry  = 0.0;  never used, safe to delete
-    double cash   = initial_equity_;
-    double qty    = 0.0;
+    struct Account {
+      bool   has_pos = false;
+      double cash    = 0.0;
+      double qty     = 0.0;
+      int    trades  = 0;
+    };
 
-    strat.onStart();
+    inline void execute(const Quote& q, strategy::Signal sig, const ExecParams& exec, Account& a) {
+      if (sig == strategy::Signal::Buy && !a.has_pos) {
+        // Execution with delay
+        const double PX_EXEC  = applySlippage(q.close_, exec.slippage_bps_, /*is_buy=*/true);
+        const double FEE      = commissionCost(PX_EXEC, 1.0, exec.commission_fixed_,
+                                               exec.commission_bps_);
 
-    for (std::size_t i = 0; i < s.size(); ++i) {
-      const auto& q = s.at(i);
-      const auto SIG = strat.onBar(q);
+        if(PX_EXEC > 0.0 && a.cash >= (PX_EXEC + FEE)) {
+          a.has_pos = true;
+          a.qty     = 1.0;
+          a.cash    -= (PX_EXEC + FEE);
+          a.trades  += 1;
+        }
 
-      if (SIG == strategy::Signal::Buy && !has_pos) {
-        // Execution with delay
-        const double PX_EXEC  = applySlippage(q.close_, exec_.slippage_bps_, /*is_buy=*/true);
-        const double FEE      = commissionCost(PX_EXEC, 1.0, exec_.commission_fixed_, exec_.commission_bps_);
-
-        if(PX_EXEC > 0.0 && cash >= (PX_EXEC + FEE)) {
-          has_pos = true;
-         // entry   = PX_EXEC;    // never used safe to remove
-          qty     = 1.0;
-          cash    -= (PX_EXEC + FEE);
-          r.trades_executed_ += 1;
+      } else if (sig == strategy::Signal::Sell && a.has_pos) {
+        const double PX_EXEC  = applySlippage(q.close_, exec.slippage_bps_, /*is_buy=*/false);
+        const double FEE      = commissionCost(PX_EXEC, a.qty, exec.commission_fixed_,
+                                               exec.commission_bps_);
+
+        a.has_pos = false;
+        a.cash    += PX_EXEC * a.qty;   // income from sell
+        a.cash    -= FEE;               // minus commission
+        a.qty     = 0.0;
+      }
+    }
+
+    // Equity after closing any open position at the last close.
+    inline double closeOut(Account a, double last_close, const ExecParams& exec) {
+      if (!a.has_pos) return a.cash;
+      const double PX_EXEC  = applySlippage(last_close, exec.slippage_bps_, /*is_buy=*/false);
+      const double FEE      = commissionCost(PX_EXEC, a.qty, exec.commission_fixed_,
+                                             exec.commission_bps_);
+      a.cash                += PX_EXEC * a.qty;
+      a.cash                -= FEE;
+      return a.cash;
+    }
+
+    // Streaming metrics and, at CaptureLevel::Full, the per-bar series and trade log.
+    struct Recorder {
+      bool   full     = false;
+      double prev     = 0.0;   // equity after the previous bar
+      double peak     = 0.0;
+      double max_dd   = 0.0;
+      double mean     = 0.0;   // Welford accumulators over per-bar returns
+      double m2       = 0.0;
+      std::size_t n   = 0;
+      std::size_t wins = 0;
+      std::size_t trips = 0;
+      TradeRecord open{};      // entry of the open position
+      double open_cost = 0.0;  // cash paid for it, fee included
+      BacktestResult* r = nullptr;
+
+      Recorder(CaptureLevel level, double initial, std::size_t bars, BacktestResult& res)
+        : full(level == CaptureLevel::Full), prev(initial), peak(initial), r(&res) {
+        if (full) {
+          r->equity_curve_.reserve(bars);
+          r->returns_.reserve(bars);
+          // a round trip spans two bars (the last one closes out)
+          r->trades_.reserve((bars + 1) / 2);
+        }
+      }
+
+      void onEntry(const Quote& q, double cost, double qty, const ExecParams& exec) {
+        open.entry_ts_    = q.ts_;
+        open.entry_price_ = applySlippage(q.close_, exec.slippage_bps_, /*is_buy=*/true);
+        open.quantity_    = qty;
+        open_cost         = cost;
+      }
+
+      void onExit(std::int64_t ts, double close, double proceeds, const ExecParams& exec) {
+        const double PNL = proceeds - open_cost;
+        ++trips;
+        if (PNL > 0.0) ++wins;
+        if (full) {
+          TradeRecord t = open;
+          t.exit_ts_    = ts;
+          t.exit_price_ = applySlippage(close, exec.slippage_bps_, /*is_buy=*/false);
+          t.pnl_        = PNL;
+          t.return_     = open_cost > 0.0 ? PNL / open_cost : 0.0;
+          r->trades_.push_back(t);
+        }
+      }
+
+      void onBar(double mtm) {
+        const double RET = prev != 0.0 ? mtm / prev - 1.0 : 0.0;
+        prev = mtm;
+        ++n;
+        const double DELTA = RET - mean;
+        mean += DELTA / static_cast<double>(n);
+        m2   += DELTA * (RET - mean);
+        peak = std::max(peak, mtm);
+        if (peak > 0.0) max_dd = std::max(max_dd, (peak - mtm) / peak);
+        if (full) {
+          r->equity_curve_.push_back(mtm);
+          r->returns_.push_back(RET);
+        }
+      }
+
+      void finish() {
+        r->max_drawdown_ = max_dd;
+        r->round_trips_  = trips;
+        r->hit_ratio_    = trips > 0 ? static_cast<double>(wins) / static_cast<double>(trips) : 0.0;
+        const double SD  = n > 1 ? std::sqrt(m2 / static_cast<double>(n - 1)) : 0.0;
+        r->sharpe_       = SD > 0.0 ? mean / SD : 0.0;
+      }
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    inline std::int64_t nanosSince(Clock::time_point t0) {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+    }
+
+    // Calls fn(std::bool_constant<flag>{}), turning a runtime flag into a template argument.
+    template <class Fn>
+    decltype(auto) dispatch(bool flag, Fn&& fn) {
+      return flag ? fn(std::true_type{}) : fn(std::false_type{});
+    }
+
+    // Calls fn(strategy), behind a TimeframeFeed when the strategy declares timeframes.
+    template <class Fn>
+    decltype(auto) withTimeframes(strategy::IStrategy& strat, Fn&& fn) {
+      if (strat.timeframes().empty()) return fn(strat);
+      strategy::TimeframeFeed feed{strat};
+      return fn(static_cast<strategy::IStrategy&>(feed));
+    }
+
+    // Feeds bars until the end or until a stop rule fires; returns the number of bars processed.
+    // Each disabled flag compiles its code out of the loop: CHECK the stop rules,
+    // CAPTURE the recorder, PROFILE the counters.
+    template <bool CHECK, bool CAPTURE, bool PROFILE>
+    std::size_t simulate(std::span<const Quote> bars, strategy::IStrategy& strat,
+                         const ExecParams& exec, const StopRules& rules, Recorder& rec,
+                         EngineCounters* pc, Account& acct, BacktestResult& r) {
+      double peak = acct.cash;
+      for (std::size_t i = 0; i < bars.size(); ++i) {
+        const auto& q = bars[i];
+        [[maybe_unused]] const bool   HAD  = acct.has_pos;
+        [[maybe_unused]] const double CASH = acct.cash;
+        if constexpr (PROFILE) {
+          const auto T0 = Clock::now();
+          const auto SIG = strat.onBar(q);
+          pc->strategy_ns_ += nanosSince(T0);
+          ++pc->bars_;
+          if (SIG != strategy::Signal::None) ++pc->signals_;
+          execute(q, SIG, exec, acct);
+          if (HAD != acct.has_pos) ++pc->fills_;
+        } else {
+          execute(q, strat.onBar(q), exec, acct);
         }
 
-      } else if (SIG == strategy::Signal::Sell && has_pos) {
-        const double PX_EXEC  = applySlippage(q.close_, exec_.slippage_bps_, /*is_buy=*/false);
-        const double FEE      = commissionCost(PX_EXEC, qty, exec_.commission_fixed_, exec_.commission_bps_);
+        if constexpr (CHECK || CAPTURE) {
+          const double MTM = acct.cash + (acct.has_pos ? q.close_ * acct.qty : 0.0);
 
-        has_pos = false;
-        cash    += PX_EXEC * qty;   // income from sell
-        cash    -= FEE;             // minus commission
-        qty     = 0.0;
+          if constexpr (CAPTURE) {
+            if (HAD != acct.has_pos) {
+              if (acct.has_pos) rec.onEntry(q, CASH - acct.cash, acct.qty, exec);
+              else              rec.onExit(q.ts_, q.close_, acct.cash - CASH, exec);
+            }
+            rec.onBar(MTM);
+          }
+
+          if constexpr (CHECK) {
+            peak = std::max(peak, MTM);
+            StopReason why = StopReason::None;
+            if (rules.equity_floor_ > 0.0 && MTM < rules.equity_floor_)
+              why = StopReason::EquityFloor;
+            else if (rules.max_drawdown_ > 0.0 && peak > 0.0 &&
+                     (peak - MTM) / peak > rules.max_drawdown_)
+              why = StopReason::MaxDrawdown;
+            else if (i + 1 == rules.checkpoint_bar_) {
+              r.checkpoint_equity_ = MTM;
+              if (MTM < rules.checkpoint_floor_) why = StopReason::BehindBest;
+            }
+            if (why != StopReason::None) {
+              r.aborted_     = true;
+              r.stop_reason_ = why;
+              return i + 1;
+            }
+          }
+        }
       }
+      return bars.size();
+    }
+
+  } // namespace
 
-      r.final_equity_ = cash + (has_pos ? q.close_ * qty : 0.0);
+  BacktestResult Engine::run(BarSeries const& s, strategy::IStrategy& strat, CaptureLevel capture,
+                             EngineCounters* counters) {
+    return run(std::span<const Quote>{s.data()}, strat, capture, counters);
+  }
+
+  BacktestResult Engine::run(std::span<const Quote> bars, strategy::IStrategy& strat,
+                             CaptureLevel capture, EngineCounters* counters) {
+    return withTimeframes(strat, [&](strategy::IStrategy& s) {
+      s.onStart();
+      return simulateFrom(bars, s, capture, counters);
+    });
+  }
+
+  BacktestResult Engine::runFrom(std::span<const Quote> bars, strategy::IStrategy& strat,
+                                 std::span<const std::uint8_t> state, CaptureLevel capture,
+                                 EngineCounters* counters) {
+    return withTimeframes(strat, [&](strategy::IStrategy& s) {
+      strategy::StateReader in{state};
+      s.loadState(in);
+      return simulateFrom(bars, s, capture, counters);
+    });
+  }
+
+  BacktestResult Engine::simulateFrom(std::span<const Quote> bars, strategy::IStrategy& strat,
+                                      CaptureLevel capture, EngineCounters* counters) {
+    BacktestResult r;
+    r.initial_equity_ = initial_equity_;
+    r.final_equity_   = initial_equity_;
+
+    Account acct;
+    acct.cash = initial_equity_;
+    Recorder rec{capture, initial_equity_, bars.size(), r};
+    const bool CAPTURE = capture != CaptureLevel::None;
+
+    const auto T0 = Clock::now();
+    const std::size_t DONE = dispatch(rules_.active(), [&](auto check) {
+      return dispatch(CAPTURE, [&](auto capture_on) {
+        return dispatch(counters != nullptr, [&](auto profile) {
+          return simulate<decltype(check)::value, decltype(capture_on)::value,
+                          decltype(profile)::value>(bars, strat, exec_, rules_, rec, counters,
+                                                    acct, r);
+        });
+      });
+    });
+    if (counters) {
+      counters->wall_ns_ += nanosSince(T0);
+      if (DONE > 0 && acct.has_pos) ++counters->fills_;   // final close-out
     }
     strat.onFinish();
 
-    if (has_pos) { //
-      const auto& last      = s.end();
-      const double PX_EXEC  = applySlippage(last.close_, exec_.slippage_bps_, /*is_buy=*/false);
-      const double FEE      = commissionCost(PX_EXEC, qty, exec_.commission_fixed_, exec_.commission_bps_);
-      cash                  += PX_EXEC * qty;
-      cash                  -= FEE;
-      // qty                   = 0.0; never read val, safe to del
-      // has_pos               = false; never read read, safe to del
-      r.final_equity_ = cash;
+    r.bars_processed_  = DONE;
+    r.trades_executed_ = acct.trades;
+    if (DONE > 0) {
+      const auto& last = bars[DONE - 1];
+      r.final_equity_ = closeOut(acct, last.close_, exec_);
+      if (CAPTURE && acct.has_pos)
+        rec.onExit(last.ts_, last.close_, r.final_equity_ - acct.cash, exec_);
     }
+    if (CAPTURE) rec.finish();
+    return r;
+  }
+
+  BacktestResult Engine::resume(BarSeries const& s, strategy::IStrategy& strat,
+                                EngineCheckpoint& cp) {
+    return withTimeframes(strat, [&](strategy::IStrategy& st) { return resumeWith(s, st, cp); });
+  }
 
+  BacktestResult Engine::resumeWith(BarSeries const& s, strategy::IStrategy& strat,
+                                    EngineCheckpoint& cp) {
+    Account acct;
+    if (cp.empty()) {
+      cp = EngineCheckpoint{};
+      cp.initial_equity_ = initial_equity_;
+      acct.cash = initial_equity_;
+      strat.onStart();
+    } else {
+      acct = {cp.has_pos_, cp.cash_, cp.qty_, cp.trades_executed_};
+      strategy::StateReader in{cp.strategy_state_};
+      strat.loadState(in);
+    }
+
+    // Bars up to the checkpoint were already consumed: accept either the
+    // grown full series or a series holding only the new bars.
+    const auto& bars = s.data();
+    const auto FIRST = std::upper_bound(bars.begin(), bars.end(), cp.last_ts_,
+        [](std::int64_t ts, const Quote& q) { return ts < q.ts_; });
+
+    for (auto it = FIRST; it != bars.end(); ++it) {
+      execute(*it, strat.onBar(*it), exec_, acct);
+      cp.last_ts_    = it->ts_;
+      cp.last_close_ = it->close_;
+      ++cp.bars_processed_;
+    }
+    strat.onFinish();
+
+    cp.has_pos_         = acct.has_pos;
+    cp.cash_            = acct.cash;
+    cp.qty_             = acct.qty;
+    cp.trades_executed_ = acct.trades;
+    strategy::StateWriter out;
+    strat.saveState(out);
+    cp.strategy_state_ = out.release();
+
+    BacktestResult r;
+    r.initial_equity_  = cp.initial_equity_;
+    r.trades_executed_ = acct.trades;
+    r.bars_processed_  = static_cast<std::size_t>(cp.bars_processed_);
+    r.final_equity_    = closeOut(acct, cp.last_close_, exec_);
     return r;
   }
 
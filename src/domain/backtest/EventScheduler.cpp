@@ -0,0 +1,102 @@
+#include "domain/backtest/EventScheduler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace qga::domain::backtest
+{
+
+    EventScheduler::EventScheduler(const std::vector<BarSeries>& series)
+    {
+        if (series.size() >= std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("EventScheduler: too many series");
+
+        bars_.reserve(series.size());
+        sizes_.reserve(series.size());
+        for (const auto& s : series)
+        {
+            bars_.push_back(s.data().data());
+            sizes_.push_back(s.size());
+            total_ += s.size();
+        }
+        leaves_ = std::bit_ceil(std::max<std::size_t>(series.size(), 1));
+        pos_.assign(series.size(), 0);
+        keys_.assign(leaves_, EXHAUSTED);
+        tree_.assign(leaves_, 0);
+        batch_.reserve(series.size());
+        build();
+    }
+
+    void EventScheduler::reset()
+    {
+        std::fill(pos_.begin(), pos_.end(), 0);
+        build();
+    }
+
+    void EventScheduler::build()
+    {
+        for (std::size_t s = 0; s < bars_.size(); ++s)
+            keys_[s] = sizes_[s] ? bars_[s][0].ts_ : EXHAUSTED;
+
+        // Bottom-up tournament: winners bubble up, each internal node keeps the loser.
+        std::vector<std::uint32_t> win(2 * leaves_);
+        for (std::size_t i = 0; i < leaves_; ++i)
+            win[leaves_ + i] = static_cast<std::uint32_t>(i);
+        for (std::size_t node = leaves_ - 1; node >= 1; --node)
+        {
+            const auto L = win[2 * node];
+            const auto R = win[2 * node + 1];
+            const bool LEFT_WINS = less(L, R);
+            win[node] = LEFT_WINS ? L : R;
+            tree_[node] = LEFT_WINS ? R : L;
+        }
+        tree_[0] = win[1];
+    }
+
+    void EventScheduler::replay(std::uint32_t leaf) noexcept
+    {
+        auto winner = leaf;
+        for (std::size_t node = (leaves_ + leaf) >> 1; node >= 1; node >>= 1)
+        {
+            const auto CHALLENGER = tree_[node];
+            if (less(CHALLENGER, winner))
+            {
+                tree_[node] = winner;
+                winner = CHALLENGER;
+            }
+        }
+        tree_[0] = winner;
+    }
+
+    bool EventScheduler::next(std::int64_t& ts, std::span<const BarEvent>& batch)
+    {
+        auto w = tree_[0];
+        if (keys_[w] == EXHAUSTED)
+            return false;
+
+        ts = keys_[w];
+        batch_.clear();
+        do
+        {
+            const std::size_t P = pos_[w]++;
+            batch_.push_back({w, bars_[w] + P});
+            keys_[w] = pos_[w] < sizes_[w] ? bars_[w][pos_[w]].ts_ : EXHAUSTED;
+            replay(w);
+            w = tree_[0];
+        } while (keys_[w] == ts);
+
+        batch = batch_;
+        return true;
+    }
+
+    std::size_t EventScheduler::run(strategy::IBatchStrategy& strat)
+    {
+        strat.onStart(symbols());
+        const std::size_t EVENTS =
+            run([&](std::int64_t ts, std::span<const BarEvent> b) { strat.onBatch(ts, b); });
+        strat.onFinish();
+        return EVENTS;
+    }
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,294 @@
+#include "domain/backtest/LaneEngine.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define QGA_LANE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        /// Arguments shared by every kernel instantiation.
+        struct LaneArgs
+        {
+            const double* close_ = nullptr; ///< Panel close matrix (time-major).
+            std::size_t rows_ = 0;          ///< Number of panel rows.
+            std::size_t stride_ = 0;        ///< Panel row stride.
+            std::size_t fast_ = 0;          ///< Fast SMA period.
+            std::size_t slow_ = 0;          ///< Slow SMA period.
+            double initial_equity_ = 0.0;   ///< Starting cash per lane.
+            double buy_factor_ = 1.0;       ///< 1 + slippage (see applySlippage).
+            double sell_factor_ = 1.0;      ///< 1 - slippage.
+            double commission_fixed_ = 0.0; ///< Fixed commission per trade.
+            double commission_rate_ = 0.0;  ///< Proportional commission (bps / 10000).
+        };
+
+        // ============================================================
+        // Scalar fallback (one symbol per step)
+        // ============================================================
+        namespace scalar
+        {
+            struct Ops
+            {
+                using V = double;
+                using M = bool;
+                static constexpr std::size_t W = 1;
+
+                static V set1(double v) { return v; }
+                static V loadu(const double* p) { return *p; }
+                static void storeu(double* p, V v) { *p = v; }
+                static V add(V a, V b) { return a + b; }
+                static V sub(V a, V b) { return a - b; }
+                static V mul(V a, V b) { return a * b; }
+                static V div(V a, V b) { return a / b; }
+                static M cmpLt(V a, V b) { return a < b; }
+                static M cmpLe(V a, V b) { return a <= b; }
+                static M cmpGt(V a, V b) { return a > b; }
+                static M cmpGe(V a, V b) { return a >= b; }
+                static M cmpEq(V a, V b) { return a == b; }
+                static M ordered(V a) { return a == a; }
+                static M noneMask() { return false; }
+                static M mAnd(M a, M b) { return a && b; }
+                static M mOr(M a, M b) { return a || b; }
+                static M mAndNot(M a, M b) { return a && !b; }
+                static V select(M m, V t, V f) { return m ? t : f; }
+                static V gather(const double* base, V idx)
+                {
+                    return base[static_cast<std::size_t>(idx)];
+                }
+                static void scatter(double* base, V idx, V v, M m)
+                {
+                    if (m)
+                        base[static_cast<std::size_t>(idx)] = v;
+                }
+            };
+
+#include "LaneKernel.inl"
+        } // namespace scalar
+
+#if defined(QGA_LANE_X86)
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+        // ============================================================
+        // AVX2 (4 symbols per step)
+        // ============================================================
+        namespace avx2
+        {
+            struct Ops
+            {
+                using V = __m256d;
+                using M = __m256d;
+                static constexpr std::size_t W = 4;
+
+                static V set1(double v) { return _mm256_set1_pd(v); }
+                static V loadu(const double* p) { return _mm256_loadu_pd(p); }
+                static void storeu(double* p, V v) { _mm256_storeu_pd(p, v); }
+                static V add(V a, V b) { return _mm256_add_pd(a, b); }
+                static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+                static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+                static V div(V a, V b) { return _mm256_div_pd(a, b); }
+                static M cmpLt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+                static M cmpLe(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+                static M cmpGt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+                static M cmpGe(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+                static M cmpEq(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+                static M ordered(V a) { return _mm256_cmp_pd(a, a, _CMP_ORD_Q); }
+                static M noneMask() { return _mm256_setzero_pd(); }
+                static M mAnd(M a, M b) { return _mm256_and_pd(a, b); }
+                static M mOr(M a, M b) { return _mm256_or_pd(a, b); }
+                static M mAndNot(M a, M b) { return _mm256_andnot_pd(b, a); }
+                static V select(M m, V t, V f) { return _mm256_blendv_pd(f, t, m); }
+                static V gather(const double* base, V idx)
+                {
+                    const __m256d ALL = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+                    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base,
+                                                    _mm256_cvttpd_epi32(idx), ALL, 8);
+                }
+                static void scatter(double* base, V idx, V v, M m)
+                {
+                    // AVX2 has no scatter; masked lanes are written one by one.
+                    alignas(32) double vi[W];
+                    alignas(32) double vv[W];
+                    _mm256_store_pd(vi, idx);
+                    _mm256_store_pd(vv, v);
+                    const int BITS = _mm256_movemask_pd(m);
+                    for (std::size_t l = 0; l < W; ++l)
+                        if (BITS & (1 << l))
+                            base[static_cast<std::size_t>(vi[l])] = vv[l];
+                }
+            };
+
+#include "LaneKernel.inl"
+        } // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+        // ============================================================
+        // AVX-512 (8 symbols per step, native masks and scatter)
+        // ============================================================
+        namespace avx512
+        {
+            struct Ops
+            {
+                using V = __m512d;
+                using M = __mmask8;
+                static constexpr std::size_t W = 8;
+
+                static V set1(double v) { return _mm512_set1_pd(v); }
+                static V loadu(const double* p) { return _mm512_loadu_pd(p); }
+                static void storeu(double* p, V v) { _mm512_storeu_pd(p, v); }
+                static V add(V a, V b) { return _mm512_add_pd(a, b); }
+                static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+                static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+                static V div(V a, V b) { return _mm512_div_pd(a, b); }
+                static M cmpLt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+                static M cmpLe(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+                static M cmpGt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+                static M cmpGe(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+                static M cmpEq(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+                static M ordered(V a) { return _mm512_cmp_pd_mask(a, a, _CMP_ORD_Q); }
+                static M noneMask() { return 0; }
+                static M mAnd(M a, M b) { return static_cast<M>(a & b); }
+                static M mOr(M a, M b) { return static_cast<M>(a | b); }
+                static M mAndNot(M a, M b) { return static_cast<M>(a & ~b); }
+                static V select(M m, V t, V f) { return _mm512_mask_blend_pd(m, f, t); }
+                static V gather(const double* base, V idx)
+                {
+                    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, index(idx), base, 8);
+                }
+                static void scatter(double* base, V idx, V v, M m)
+                {
+                    _mm512_mask_i32scatter_pd(base, m, index(idx), v, 8);
+                }
+                static __m256i index(V idx) { return _mm512_maskz_cvttpd_epi32(0xFF, idx); }
+            };
+
+#include "LaneKernel.inl"
+        } // namespace avx512
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // QGA_LANE_X86
+
+        using KernelFn = void (*)(const LaneArgs&, std::size_t, double*, double*, double*, double*);
+
+        KernelFn kernelFor(core::SimdLevel level) noexcept
+        {
+#if defined(QGA_LANE_X86)
+            switch (level)
+            {
+            case core::SimdLevel::Avx512:
+                return &avx512::laneKernel;
+            case core::SimdLevel::Avx2:
+                return &avx2::laneKernel;
+            default:
+                break;
+            }
+#else
+            (void) level;
+#endif
+            return &scalar::laneKernel;
+        }
+    } // namespace
+
+    std::size_t LaneEngine::laneWidth(core::SimdLevel level) noexcept
+    {
+#if defined(QGA_LANE_X86)
+        switch (level)
+        {
+        case core::SimdLevel::Avx512:
+            return avx512::Ops::W;
+        case core::SimdLevel::Avx2:
+            return avx2::Ops::W;
+        default:
+            break;
+        }
+#else
+        (void) level;
+#endif
+        return scalar::Ops::W;
+    }
+
+    std::vector<BacktestResult> LaneEngine::runMACrossover(const BarPanel& panel, int fast_period,
+                                                           int slow_period) const
+    {
+        return runMACrossover(panel, fast_period, slow_period, core::activeSimdLevel());
+    }
+
+    std::vector<BacktestResult> LaneEngine::runMACrossover(const BarPanel& panel, int fast_period,
+                                                           int slow_period,
+                                                           core::SimdLevel level) const
+    {
+        if (fast_period <= 0 || slow_period <= 0)
+            throw std::invalid_argument("LaneEngine: SMA periods must be > 0");
+
+        const core::SimdLevel LEVEL = core::clampSimdLevel(level);
+        const KernelFn KERNEL = kernelFor(LEVEL);
+        const std::size_t W = laneWidth(LEVEL);
+
+        LaneArgs args;
+        args.rows_ = panel.size();
+        args.stride_ = panel.stride();
+        args.close_ = args.rows_ > 0 ? panel.closeRow(0) : nullptr;
+        args.fast_ = static_cast<std::size_t>(fast_period);
+        args.slow_ = static_cast<std::size_t>(slow_period);
+        args.initial_equity_ = initial_equity_;
+        args.buy_factor_ = 1.0 + exec_.slippage_bps_ / 10000.0;
+        args.sell_factor_ = 1.0 - exec_.slippage_bps_ / 10000.0;
+        args.commission_fixed_ = exec_.commission_fixed_;
+        args.commission_rate_ = exec_.commission_bps_ / 10000.0;
+
+        std::vector<BacktestResult> out(panel.symbols());
+        for (auto& r : out)
+        {
+            r.initial_equity_ = initial_equity_;
+            r.final_equity_ = initial_equity_;
+        }
+        if (args.rows_ == 0)
+            return out;
+
+        // Scratch is allocated once and reused by every block
+        std::vector<double> ring_f(W * args.fast_, 0.0);
+        std::vector<double> ring_s(W * args.slow_, 0.0);
+        double equity[BarPanel::LANE_PAD];
+        double trades[BarPanel::LANE_PAD];
+
+        for (std::size_t s0 = 0; s0 < panel.symbols(); s0 += W)
+        {
+            KERNEL(args, s0, ring_f.data(), ring_s.data(), equity, trades);
+            for (std::size_t l = 0; l < W && s0 + l < out.size(); ++l)
+            {
+                out[s0 + l].final_equity_ = equity[l];
+                out[s0 + l].trades_executed_ = static_cast<int>(trades[l]);
+            }
+        }
+        return out;
+    }
+
+} // namespace qga::domain::backtest
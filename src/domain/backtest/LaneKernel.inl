@@ -0,0 +1,123 @@
+// LaneKernel.inl — body of the lane-parallel MA-crossover kernel.
+//
+// Included once per instruction set by LaneEngine.cpp, inside a namespace that
+// defines `Ops` (vector width, register/mask types and primitive operations)
+// and, for SIMD targets, inside a `#pragma ... target(...)` region. Every
+// arithmetic step mirrors MACrossover::onBar + Engine::run operation for
+// operation, so each lane reproduces the scalar result bit for bit.
+
+/**
+ * @brief Runs one block of `Ops::W` symbols starting at column @p s0.
+ * @param a      Shared kernel arguments (panel, periods, execution model).
+ * @param s0     First panel column of the block.
+ * @param ring_f Scratch ring for the fast window (`W * fast` doubles).
+ * @param ring_s Scratch ring for the slow window (`W * slow` doubles).
+ * @param equity Output: final equity per lane (`W` doubles).
+ * @param trades Output: executed buy count per lane (`W` doubles).
+ */
+inline void laneKernel(const LaneArgs& a, std::size_t s0, double* ring_f, double* ring_s,
+                       double* equity, double* trades)
+{
+    using V = Ops::V;
+    using M = Ops::M;
+    constexpr std::size_t W = Ops::W;
+
+    const V ZERO = Ops::set1(0.0);
+    const V ONE = Ops::set1(1.0);
+    const V FAST = Ops::set1(static_cast<double>(a.fast_));
+    const V SLOW = Ops::set1(static_cast<double>(a.slow_));
+    const V BUY_FACTOR = Ops::set1(a.buy_factor_);
+    const V SELL_FACTOR = Ops::set1(a.sell_factor_);
+    const V FIXED = Ops::set1(a.commission_fixed_);
+    const V CBPS = Ops::set1(a.commission_rate_);
+
+    // Each lane owns a contiguous ring segment: index = lane * period + pos
+    double base_f[W];
+    double base_s[W];
+    for (std::size_t l = 0; l < W; ++l)
+    {
+        base_f[l] = static_cast<double>(l * a.fast_);
+        base_s[l] = static_cast<double>(l * a.slow_);
+    }
+    const V LANE_F = Ops::loadu(base_f);
+    const V LANE_S = Ops::loadu(base_s);
+
+    V sum_f = ZERO, sum_s = ZERO;
+    V pos_f = ZERO, pos_s = ZERO;
+    V n = ZERO;
+    V prev_f = ZERO, prev_s = ZERO;
+    V cash = Ops::set1(a.initial_equity_);
+    V qty = ZERO;
+    V buys = ZERO;
+    V last = ZERO;
+    M ready = Ops::noneMask();
+    M has_pos = Ops::noneMask();
+
+    const double* col = a.close_ + s0;
+    for (std::size_t t = 0; t < a.rows_; ++t, col += a.stride_)
+    {
+        const V C = Ops::loadu(col);
+        const M VALID = Ops::ordered(C);
+
+        // --- Rolling windows: sum += px; if full, sum -= evicted --------------------
+        const V IDX_F = Ops::add(LANE_F, pos_f);
+        const V OLD_F = Ops::gather(ring_f, IDX_F);
+        const V ADD_F = Ops::add(sum_f, C);
+        sum_f = Ops::select(VALID, Ops::select(Ops::cmpGe(n, FAST), Ops::sub(ADD_F, OLD_F), ADD_F),
+                            sum_f);
+        Ops::scatter(ring_f, IDX_F, C, VALID);
+        const V NEXT_F = Ops::add(pos_f, ONE);
+        pos_f = Ops::select(VALID, Ops::select(Ops::cmpEq(NEXT_F, FAST), ZERO, NEXT_F), pos_f);
+
+        const V IDX_S = Ops::add(LANE_S, pos_s);
+        const V OLD_S = Ops::gather(ring_s, IDX_S);
+        const V ADD_S = Ops::add(sum_s, C);
+        sum_s = Ops::select(VALID, Ops::select(Ops::cmpGe(n, SLOW), Ops::sub(ADD_S, OLD_S), ADD_S),
+                            sum_s);
+        Ops::scatter(ring_s, IDX_S, C, VALID);
+        const V NEXT_S = Ops::add(pos_s, ONE);
+        pos_s = Ops::select(VALID, Ops::select(Ops::cmpEq(NEXT_S, SLOW), ZERO, NEXT_S), pos_s);
+
+        n = Ops::select(VALID, Ops::add(n, ONE), n);
+
+        // --- Crossover signal --------------------------------------------------------
+        const M BOTH = Ops::mAnd(VALID, Ops::mAnd(Ops::cmpGe(n, FAST), Ops::cmpGe(n, SLOW)));
+        const V SMA_F = Ops::div(sum_f, FAST);
+        const V SMA_S = Ops::div(sum_s, SLOW);
+
+        const M ACTIVE = Ops::mAnd(BOTH, ready);
+        const M UP = Ops::mAnd(ACTIVE, Ops::mAnd(Ops::cmpLe(prev_f, prev_s), Ops::cmpGt(SMA_F, SMA_S)));
+        const M DOWN = Ops::mAndNot(
+            Ops::mAnd(ACTIVE, Ops::mAnd(Ops::cmpGe(prev_f, prev_s), Ops::cmpLt(SMA_F, SMA_S))), UP);
+
+        prev_f = Ops::select(BOTH, SMA_F, prev_f);
+        prev_s = Ops::select(BOTH, SMA_S, prev_s);
+        ready = Ops::mOr(ready, BOTH);
+
+        // --- Execution: buy one unit / sell everything at the close ------------------
+        const V PX_BUY = Ops::mul(C, BUY_FACTOR);
+        const V FEE_BUY = Ops::add(FIXED, Ops::mul(CBPS, Ops::mul(PX_BUY, ONE)));
+        const V COST_BUY = Ops::add(PX_BUY, FEE_BUY);
+        const M BUY = Ops::mAnd(Ops::mAndNot(UP, has_pos),
+                                Ops::mAnd(Ops::cmpGt(PX_BUY, ZERO), Ops::cmpGe(cash, COST_BUY)));
+
+        const M SELL = Ops::mAnd(DOWN, has_pos);
+        const V PX_SELL = Ops::mul(C, SELL_FACTOR);
+        const V FEE_SELL = Ops::add(FIXED, Ops::mul(CBPS, Ops::mul(PX_SELL, qty)));
+        const V CASH_SELL = Ops::sub(Ops::add(cash, Ops::mul(PX_SELL, qty)), FEE_SELL);
+
+        cash = Ops::select(BUY, Ops::sub(cash, COST_BUY), Ops::select(SELL, CASH_SELL, cash));
+        qty = Ops::select(BUY, ONE, Ops::select(SELL, ZERO, qty));
+        buys = Ops::select(BUY, Ops::add(buys, ONE), buys);
+        has_pos = Ops::mAndNot(Ops::mOr(has_pos, BUY), SELL);
+        last = Ops::select(VALID, C, last);
+    }
+
+    // --- Close any open position at the symbol's last close ---------------------------
+    const V PX_LAST = Ops::mul(last, SELL_FACTOR);
+    const V FEE_LAST = Ops::add(FIXED, Ops::mul(CBPS, Ops::mul(PX_LAST, qty)));
+    cash = Ops::select(has_pos, Ops::sub(Ops::add(cash, Ops::mul(PX_LAST, qty)), FEE_LAST), cash);
+
+    Ops::storeu(equity, cash);
+    Ops::storeu(trades, buys);
+}
@@ -0,0 +1,139 @@
+#include "domain/backtest/MonteCarlo.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "core/Parallel.hpp"
+#include "core/Random.hpp"
+#include "core/StatisticsKernels.hpp"
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        void summarize(MetricDistribution& d)
+        {
+            auto& v = d.values_;
+            std::sort(v.begin(), v.end());
+            double sum = 0.0;
+            for (double x : v)
+                sum += x;
+            d.mean_ = sum / static_cast<double>(v.size());
+            double sumsq = 0.0;
+            for (double x : v)
+                sumsq += (x - d.mean_) * (x - d.mean_);
+            d.stddev_ = v.size() > 1 ? std::sqrt(sumsq / static_cast<double>(v.size() - 1)) : 0.0;
+        }
+
+        struct WorkerBuffers
+        {
+            std::vector<double> returns_;
+            std::vector<double> equity_;
+        };
+    } // namespace
+
+    double MetricDistribution::quantile(double q) const noexcept
+    {
+        if (values_.empty())
+            return 0.0;
+        const double POS = std::clamp(q, 0.0, 1.0) * static_cast<double>(values_.size() - 1);
+        const auto LO = static_cast<std::size_t>(POS);
+        const auto HI = std::min(LO + 1, values_.size() - 1);
+        const double W = POS - static_cast<double>(LO);
+        return values_[LO] + (values_[HI] - values_[LO]) * W;
+    }
+
+    MonteCarlo::MonteCarlo(MonteCarloParams params) : params_(params)
+    {
+        if (params_.paths_ == 0)
+            throw std::invalid_argument("MonteCarlo: paths must be > 0");
+        if (params_.block_size_ == 0)
+            throw std::invalid_argument("MonteCarlo: block size must be > 0");
+    }
+
+    std::vector<double> MonteCarlo::returnsFromEquity(std::span<const double> equity)
+    {
+        std::vector<double> out;
+        if (equity.size() < 2)
+            return out;
+        out.reserve(equity.size() - 1);
+        for (std::size_t i = 1; i < equity.size(); ++i)
+            out.push_back(equity[i] / equity[i - 1] - 1.0);
+        return out;
+    }
+
+    MonteCarloResult MonteCarlo::run(std::span<const double> returns, double initial_equity) const
+    {
+        if (returns.size() < 2)
+            throw std::invalid_argument("MonteCarlo: need at least 2 returns");
+        if (returns.size() >= (std::size_t{1} << 32))
+            throw std::length_error("MonteCarlo: return series too long");
+
+        const std::size_t N = returns.size();
+        const std::size_t BLOCK = std::min(params_.block_size_, N);
+        const auto STARTS = static_cast<std::uint32_t>(N - BLOCK + 1);
+
+        MonteCarloResult res;
+        res.sharpe_.values_.resize(params_.paths_);
+        res.max_drawdown_.values_.resize(params_.paths_);
+        res.cagr_.values_.resize(params_.paths_);
+        res.final_equity_.values_.resize(params_.paths_);
+
+        const std::size_t THREADS =
+            std::min(params_.threads_ ? params_.threads_ : core::defaultThreads(), params_.paths_);
+        std::vector<WorkerBuffers> buffers(THREADS);
+        for (auto& b : buffers)
+        {
+            b.returns_.resize(N);
+            b.equity_.resize(N + 1);
+        }
+
+        core::parallelFor(
+            params_.paths_,
+            [&](std::size_t path, std::size_t worker)
+            {
+                core::Xoshiro256 rng{params_.seed_, path};
+                auto& r = buffers[worker].returns_;
+                auto& eq = buffers[worker].equity_;
+
+                if (params_.method_ == ResampleMethod::BlockBootstrap)
+                {
+                    for (std::size_t filled = 0; filled < N;)
+                    {
+                        const std::size_t FROM = rng.below(STARTS);
+                        const std::size_t LEN = std::min(BLOCK, N - filled);
+                        std::copy_n(returns.begin() + static_cast<std::ptrdiff_t>(FROM), LEN,
+                                    r.begin() + static_cast<std::ptrdiff_t>(filled));
+                        filled += LEN;
+                    }
+                }
+                else
+                {
+                    // Fisher-Yates shuffle of the observed trades.
+                    std::copy(returns.begin(), returns.end(), r.begin());
+                    for (std::size_t i = N - 1; i > 0; --i)
+                        std::swap(r[i], r[rng.below(static_cast<std::uint32_t>(i + 1))]);
+                }
+
+                eq[0] = initial_equity;
+                for (std::size_t i = 0; i < N; ++i)
+                    eq[i + 1] = eq[i] * (1.0 + r[i]);
+
+                res.sharpe_.values_[path] = core::stats::sharpeRatio(r, params_.risk_free_annual_,
+                                                                     params_.periods_per_year_);
+                res.max_drawdown_.values_[path] = core::stats::maxDrawdown(eq);
+                res.cagr_.values_[path] = core::stats::cagr(eq, params_.periods_per_year_);
+                res.final_equity_.values_[path] = eq[N];
+            },
+            THREADS);
+
+        summarize(res.sharpe_);
+        summarize(res.max_drawdown_);
+        summarize(res.cagr_);
+        summarize(res.final_equity_);
+        return res;
+    }
+
+} // namespace qga::domain::backtest
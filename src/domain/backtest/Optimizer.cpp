@@ -0,0 +1,319 @@
+#include "domain/backtest/Optimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <set>
+#include <span>
+#include <stdexcept>
+
+#include "core/Parallel.hpp"
+#include "core/Random.hpp"
+#include "domain/backtest/Engine.hpp"
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        using Genes = std::vector<std::uint32_t>; // grid index per dimension
+
+        std::size_t gridSize(const ParamSpace& space)
+        {
+            if (space.empty())
+                throw std::invalid_argument("Optimizer: empty parameter space");
+            std::size_t total = 1;
+            for (const auto& r : space)
+            {
+                if (r.step_ <= 0 || r.max_ < r.min_)
+                    throw std::invalid_argument("Optimizer: invalid range for parameter '" + r.name_
+                                                + "'");
+                const auto C = r.count();
+                total = total > SIZE_MAX / C ? SIZE_MAX : total * C;
+            }
+            return total;
+        }
+
+        ParamSet decode(const ParamSpace& space, const Genes& g)
+        {
+            ParamSet p(space.size());
+            for (std::size_t d = 0; d < space.size(); ++d)
+                p[d] = space[d].value(g[d]);
+            return p;
+        }
+
+        Genes randomGenes(const ParamSpace& space, core::Xoshiro256& rng)
+        {
+            Genes g(space.size());
+            for (std::size_t d = 0; d < space.size(); ++d)
+                g[d] = rng.below(static_cast<std::uint32_t>(space[d].count()));
+            return g;
+        }
+
+        Genes nthGenes(const ParamSpace& space, std::size_t n)
+        {
+            Genes g(space.size());
+            for (std::size_t d = space.size(); d-- > 0;)
+            {
+                g[d] = static_cast<std::uint32_t>(n % space[d].count());
+                n /= space[d].count();
+            }
+            return g;
+        }
+
+        /// @p count distinct candidates: the whole grid if small enough, else a uniform sample.
+        std::vector<Genes> sampleDistinct(const ParamSpace& space, std::size_t count,
+                                          core::Xoshiro256& rng)
+        {
+            const std::size_t GRID = gridSize(space);
+            std::vector<Genes> out;
+            if (count >= GRID)
+            {
+                out.reserve(GRID);
+                for (std::size_t n = 0; n < GRID; ++n)
+                    out.push_back(nthGenes(space, n));
+                return out;
+            }
+            std::set<Genes> seen;
+            out.reserve(count);
+            while (out.size() < count)
+            {
+                auto g = randomGenes(space, rng);
+                if (seen.insert(g).second)
+                    out.push_back(std::move(g));
+            }
+            return out;
+        }
+
+        /// Backtests every candidate on the first @p bars bars, in parallel.
+        std::vector<double> evaluate(const std::vector<ParamSet>& cands,
+                                     std::span<const Quote> bars, double initial_equity,
+                                     const ExecParams& exec, const ParamStrategyFactory& make,
+                                     const ResultObjective& objective, std::size_t threads)
+        {
+            std::vector<double> scores(cands.size());
+            core::parallelFor(
+                cands.size(),
+                [&](std::size_t i, std::size_t)
+                {
+                    auto strat = make(cands[i]);
+                    Engine engine{initial_equity, exec};
+                    const auto R = engine.run(bars, *strat);
+                    scores[i] = objective ? objective(R) : R.final_equity_;
+                },
+                threads);
+            return scores;
+        }
+
+        void record(OptimizerResult& res, const std::vector<ParamSet>& cands,
+                    const std::vector<double>& scores, std::size_t bars, std::size_t series_len)
+        {
+            for (std::size_t i = 0; i < cands.size(); ++i)
+                res.trials_.push_back({cands[i], scores[i], bars});
+            res.backtests_ += cands.size();
+            res.full_runs_ +=
+                static_cast<double>(cands.size() * bars) / static_cast<double>(series_len);
+        }
+    } // namespace
+
+    // ------------------------------------------------------------
+    // Successive halving
+    // ------------------------------------------------------------
+
+    SuccessiveHalving::SuccessiveHalving(double initial_equity, ExecParams exec,
+                                         HalvingParams params)
+        : initial_equity_(initial_equity), exec_(exec), params_(params)
+    {
+        if (params_.eta_ < 2)
+            throw std::invalid_argument("SuccessiveHalving: eta must be >= 2");
+        if (!(params_.budget_ > 0.0))
+            throw std::invalid_argument("SuccessiveHalving: budget must be > 0");
+    }
+
+    OptimizerResult SuccessiveHalving::run(const BarSeries& series, const ParamSpace& space,
+                                           const ParamStrategyFactory& make,
+                                           const ResultObjective& objective) const
+    {
+        if (series.empty())
+            throw std::invalid_argument("SuccessiveHalving: empty series");
+
+        const std::span<const Quote> BARS{series.data()};
+        const std::size_t N = BARS.size();
+        const auto ETA = static_cast<double>(params_.eta_);
+        const auto R = params_.rungs_;
+
+        const auto N0 = static_cast<std::size_t>(std::max(
+            1.0, std::floor(params_.budget_ * std::pow(ETA, static_cast<double>(R)) / (R + 1.0))));
+        core::Xoshiro256 rng{params_.seed_};
+        std::vector<ParamSet> cands;
+        for (const auto& g : sampleDistinct(space, N0, rng))
+            cands.push_back(decode(space, g));
+
+        OptimizerResult res;
+        std::vector<double> scores;
+        for (std::size_t r = 0; r <= R; ++r)
+        {
+            const double FRACTION = std::pow(ETA, static_cast<double>(r) - static_cast<double>(R));
+            const auto LEN =
+                std::clamp<std::size_t>(static_cast<std::size_t>(std::ceil(N * FRACTION)), 1, N);
+            scores = evaluate(cands, BARS.first(LEN), initial_equity_, exec_, make, objective,
+                              params_.threads_);
+            record(res, cands, scores, LEN, N);
+            if (r == R || cands.size() == 1)
+            {
+                if (LEN != N) // promote the survivor to the full series
+                {
+                    cands.resize(1);
+                    scores = evaluate(cands, BARS, initial_equity_, exec_, make, objective,
+                                      params_.threads_);
+                    record(res, cands, scores, N, N);
+                }
+                break;
+            }
+
+            // Keep the best 1/eta (stable: ties keep the earlier candidate).
+            std::vector<std::size_t> order(cands.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::stable_sort(order.begin(), order.end(),
+                             [&](std::size_t a, std::size_t b) { return scores[a] > scores[b]; });
+            const std::size_t KEEP = std::max<std::size_t>(1, cands.size() / params_.eta_);
+            std::vector<ParamSet> next;
+            next.reserve(KEEP);
+            for (std::size_t k = 0; k < KEEP; ++k)
+                next.push_back(std::move(cands[order[k]]));
+            cands = std::move(next);
+        }
+
+        const auto BEST = static_cast<std::size_t>(std::max_element(scores.begin(), scores.end())
+                                                   - scores.begin());
+        res.best_ = cands[BEST];
+        res.best_score_ = scores[BEST];
+        return res;
+    }
+
+    // ------------------------------------------------------------
+    // Evolutionary search
+    // ------------------------------------------------------------
+
+    EvolutionarySearch::EvolutionarySearch(double initial_equity, ExecParams exec,
+                                           EvolutionParams params)
+        : initial_equity_(initial_equity), exec_(exec), params_(params)
+    {
+        if (params_.budget_ == 0 || params_.population_ == 0)
+            throw std::invalid_argument("EvolutionarySearch: budget and population must be > 0");
+    }
+
+    OptimizerResult EvolutionarySearch::run(const BarSeries& series, const ParamSpace& space,
+                                            const ParamStrategyFactory& make,
+                                            const ResultObjective& objective) const
+    {
+        if (series.empty())
+            throw std::invalid_argument("EvolutionarySearch: empty series");
+
+        const std::span<const Quote> BARS{series.data()};
+        const std::size_t P = params_.population_;
+        std::map<Genes, double> cache;
+
+        core::Xoshiro256 init_rng{params_.seed_};
+        std::vector<Genes> population = sampleDistinct(space, P, init_rng);
+
+        OptimizerResult res;
+        Genes best;
+        double best_score = 0.0;
+        for (std::uint64_t gen = 1;; ++gen)
+        {
+            // Evaluate unseen members within the remaining budget.
+            std::vector<Genes> fresh;
+            for (const auto& g : population)
+                if (!cache.contains(g) && std::find(fresh.begin(), fresh.end(), g) == fresh.end())
+                    fresh.push_back(g);
+            fresh.resize(std::min(fresh.size(), params_.budget_ - res.backtests_));
+            if (fresh.empty())
+                break;
+
+            std::vector<ParamSet> cands;
+            for (const auto& g : fresh)
+                cands.push_back(decode(space, g));
+            const auto SCORES =
+                evaluate(cands, BARS, initial_equity_, exec_, make, objective, params_.threads_);
+            record(res, cands, SCORES, BARS.size(), BARS.size());
+            for (std::size_t i = 0; i < fresh.size(); ++i)
+            {
+                cache.emplace(fresh[i], SCORES[i]);
+                if (best.empty() || SCORES[i] > best_score)
+                {
+                    best = fresh[i];
+                    best_score = SCORES[i];
+                }
+            }
+            if (res.backtests_ >= params_.budget_)
+                break;
+
+            // Rank evaluated members (unevaluated ones were cut by the budget).
+            std::erase_if(population, [&](const Genes& g) { return !cache.contains(g); });
+            std::stable_sort(population.begin(), population.end(),
+                             [&](const Genes& a, const Genes& b)
+                             { return cache.at(a) > cache.at(b); });
+
+            core::Xoshiro256 rng{params_.seed_, gen};
+            const auto PICK = [&]() -> const Genes&
+            {
+                std::size_t winner = rng.below(static_cast<std::uint32_t>(population.size()));
+                for (std::size_t t = 1; t < params_.tournament_; ++t)
+                    winner = std::min<std::size_t>(
+                        winner, rng.below(static_cast<std::uint32_t>(population.size())));
+                return population[winner]; // sorted: lower index = better
+            };
+
+            std::vector<Genes> next(
+                population.begin(),
+                population.begin()
+                    + static_cast<std::ptrdiff_t>(std::min(params_.elite_, population.size())));
+            const auto BREED = [&]
+            {
+                const Genes& a = PICK();
+                const Genes& b = PICK();
+                Genes child(space.size());
+                for (std::size_t d = 0; d < space.size(); ++d)
+                {
+                    child[d] = (rng() & 1) ? a[d] : b[d];
+                    if (rng.uniform() < params_.mutation_rate_)
+                    {
+                        const auto COUNT = static_cast<std::int64_t>(space[d].count());
+                        const auto REACH = std::max<std::int64_t>(1, COUNT / 10);
+                        const auto SHIFT =
+                            static_cast<std::int64_t>(rng.below(static_cast<std::uint32_t>(REACH)))
+                            + 1;
+                        const std::int64_t MOVED = child[d] + ((rng() & 1) ? SHIFT : -SHIFT);
+                        child[d] = static_cast<std::uint32_t>(
+                            std::clamp<std::int64_t>(MOVED, 0, COUNT - 1));
+                    }
+                }
+                return child;
+            };
+
+            constexpr int RETRIES = 8;
+            while (next.size() < P)
+            {
+                // Prefer unseen children; fall back to a random immigrant to keep exploring.
+                const auto SEEN = [&](const Genes& g) {
+                    return cache.contains(g)
+                           || std::find(next.begin(), next.end(), g) != next.end();
+                };
+                Genes child = BREED();
+                for (int attempt = 0; attempt < RETRIES && SEEN(child); ++attempt)
+                    child = BREED();
+                if (SEEN(child))
+                    child = randomGenes(space, rng);
+                next.push_back(std::move(child));
+            }
+            population = std::move(next);
+        }
+
+        res.best_ = decode(space, best);
+        res.best_score_ = best_score;
+        return res;
+    }
+
+} // namespace qga::domain::backtest
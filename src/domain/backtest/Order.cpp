@@ -19,5 +19,37 @@ namespace qga::domain::backtest {
         if (quantity_ <= 0.0) {
             throw std::invalid_argument("Order quantity must be > 0");
         }
+        if (type_ != OrderType::Market) {
+            throw std::invalid_argument("Order: limit/stop orders need a price");
+        }
+    }
+
+    Order::Order(Instrument instrument,
+        Side side,
+        double quantity,
+        OrderType type,
+        double limit_price,
+        double stop_price,
+        std::chrono::system_clock::time_point ts)
+
+        : instrument_(std::move(instrument)),
+        side_(side),
+        type_(type),
+        quantity_(quantity),
+        limit_price_(limit_price),
+        stop_price_(stop_price),
+        ts_(ts)
+    {
+        if (quantity_ <= 0.0) {
+            throw std::invalid_argument("Order quantity must be > 0");
+        }
+        const bool NEEDS_LIMIT = type_ == OrderType::Limit || type_ == OrderType::StopLimit;
+        const bool NEEDS_STOP  = type_ == OrderType::Stop  || type_ == OrderType::StopLimit;
+        if (NEEDS_LIMIT && !(limit_price_ > 0.0)) {
+            throw std::invalid_argument("Order: limit price must be > 0");
+        }
+        if (NEEDS_STOP && !(stop_price_ > 0.0)) {
+            throw std::invalid_argument("Order: stop price must be > 0");
+        }
     }
 }   // namespace qga::domain::backtest
@@ -0,0 +1,188 @@
+#include "domain/backtest/OrderBook.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        // Heap comparators (std::*_heap keeps the "largest" element on top);
+        // ties favour the earlier order.
+        struct HighFirst
+        {
+            template <class L> bool operator()(const L& a, const L& b) const noexcept
+            {
+                return a.price_ < b.price_ || (a.price_ == b.price_ && a.id_ > b.id_);
+            }
+        };
+
+        struct LowFirst
+        {
+            template <class L> bool operator()(const L& a, const L& b) const noexcept
+            {
+                return a.price_ > b.price_ || (a.price_ == b.price_ && a.id_ > b.id_);
+            }
+        };
+
+        template <class Cmp, class L> void pushLevel(std::vector<L>& heap, L level)
+        {
+            heap.push_back(level);
+            std::push_heap(heap.begin(), heap.end(), Cmp{});
+        }
+
+        template <class Cmp, class L> L popLevel(std::vector<L>& heap)
+        {
+            std::pop_heap(heap.begin(), heap.end(), Cmp{});
+            const L TOP = heap.back();
+            heap.pop_back();
+            return TOP;
+        }
+
+        constexpr std::size_t COMPACT_MIN_STALE = 64;
+    } // namespace
+
+    std::size_t OrderBook::slotFor(const domain::Instrument& ins)
+    {
+        auto [it, inserted] =
+            slots_.try_emplace(ins.symbol() + "@" + ins.exchangeMic(), books_.size());
+        if (inserted)
+            books_.emplace_back();
+        return it->second;
+    }
+
+    OrderId OrderBook::submit(Order order)
+    {
+        if (order.type() == OrderType::Market)
+            throw std::invalid_argument("OrderBook: market orders do not rest");
+
+        const std::size_t SLOT = slotFor(order.instrument());
+        const auto ID = static_cast<OrderId>(orders_.size());
+        orders_.push_back(std::move(order));
+        records_.push_back({SLOT, OrderStatus::Pending});
+        ++open_;
+        rest(books_[SLOT], ID, orders_[ID].type() == OrderType::Limit);
+        return ID;
+    }
+
+    bool OrderBook::cancel(OrderId id)
+    {
+        if (id >= records_.size() || !isOpen(id))
+            return false;
+        auto& rec = records_[id];
+        rec.status_ = OrderStatus::Cancelled;
+        --open_;
+        auto& book = books_[rec.slot_];
+        if (++book.stale_ >= COMPACT_MIN_STALE
+            && 2 * book.stale_ > book.buy_limit_.size() + book.sell_limit_.size()
+                                     + book.buy_stop_.size() + book.sell_stop_.size())
+            compact(book);
+        return true;
+    }
+
+    void OrderBook::rest(Book& book, OrderId id, bool as_limit)
+    {
+        const auto& o = orders_[id];
+        const bool BUY = o.side() == Side::Buy;
+        if (as_limit)
+        {
+            if (BUY)
+                pushLevel<HighFirst>(book.buy_limit_, Level{o.limitPrice(), id});
+            else
+                pushLevel<LowFirst>(book.sell_limit_, Level{o.limitPrice(), id});
+        }
+        else
+        {
+            if (BUY)
+                pushLevel<LowFirst>(book.buy_stop_, Level{o.stopPrice(), id});
+            else
+                pushLevel<HighFirst>(book.sell_stop_, Level{o.stopPrice(), id});
+        }
+    }
+
+    void OrderBook::fill(OrderId id, double price, std::int64_t ts, std::vector<Fill>& fills)
+    {
+        const auto& o = orders_[id];
+        auto& rec = records_[id];
+        rec.status_ = OrderStatus::Filled;
+        --open_;
+        fills.push_back({id, rec.slot_, o.side(), o.type(), price, o.quantity(), ts});
+    }
+
+    void OrderBook::compact(Book& book)
+    {
+        const auto DEAD = [this](const Level& l) { return !isOpen(l.id_); };
+        std::erase_if(book.buy_limit_, DEAD);
+        std::erase_if(book.sell_limit_, DEAD);
+        std::erase_if(book.buy_stop_, DEAD);
+        std::erase_if(book.sell_stop_, DEAD);
+        std::make_heap(book.buy_limit_.begin(), book.buy_limit_.end(), HighFirst{});
+        std::make_heap(book.sell_limit_.begin(), book.sell_limit_.end(), LowFirst{});
+        std::make_heap(book.buy_stop_.begin(), book.buy_stop_.end(), LowFirst{});
+        std::make_heap(book.sell_stop_.begin(), book.sell_stop_.end(), HighFirst{});
+        book.stale_ = 0;
+    }
+
+    void OrderBook::onBar(std::size_t slot, const Quote& bar, std::vector<Fill>& fills)
+    {
+        auto& book = books_.at(slot);
+        activated_.clear();
+
+        // Pops every open order on top of the heap whose price the bar reached;
+        // cancelled entries surfacing on the way are discarded.
+        const auto DRAIN = [&](auto& heap, auto cmp, auto reached, auto on_trigger)
+        {
+            using Cmp = decltype(cmp);
+            while (!heap.empty() && reached(heap.front().price_))
+            {
+                const auto TOP = popLevel<Cmp>(heap);
+                if (!isOpen(TOP.id_))
+                {
+                    --book.stale_;
+                    continue;
+                }
+                on_trigger(TOP.id_);
+            }
+        };
+
+        const auto STOP_HIT = [&](OrderId id, bool buy)
+        {
+            const auto& o = orders_[id];
+            const double TRIGGER =
+                buy ? std::max(bar.open_, o.stopPrice()) : std::min(bar.open_, o.stopPrice());
+            if (o.type() == OrderType::Stop)
+            {
+                fill(id, applySlippage(TRIGGER, exec_.slippage_bps_, buy), bar.ts_, fills);
+                return;
+            }
+            const bool MARKETABLE = buy ? TRIGGER <= o.limitPrice() : TRIGGER >= o.limitPrice();
+            if (MARKETABLE)
+            {
+                fill(id, TRIGGER, bar.ts_, fills);
+                return;
+            }
+            records_[id].status_ = OrderStatus::Active;
+            activated_.push_back(id);
+        };
+
+        DRAIN(
+            book.buy_stop_, LowFirst{}, [&](double px) { return px <= bar.high_; },
+            [&](OrderId id) { STOP_HIT(id, true); });
+        DRAIN(
+            book.sell_stop_, HighFirst{}, [&](double px) { return px >= bar.low_; },
+            [&](OrderId id) { STOP_HIT(id, false); });
+        DRAIN(
+            book.buy_limit_, HighFirst{}, [&](double px) { return px >= bar.low_; },
+            [&](OrderId id)
+            { fill(id, std::min(bar.open_, orders_[id].limitPrice()), bar.ts_, fills); });
+        DRAIN(
+            book.sell_limit_, LowFirst{}, [&](double px) { return px <= bar.high_; },
+            [&](OrderId id)
+            { fill(id, std::max(bar.open_, orders_[id].limitPrice()), bar.ts_, fills); });
+
+        for (const OrderId ID : activated_)
+            rest(book, ID, /*as_limit=*/true);
+    }
+
+} // namespace qga::domain::backtest
@@ -7,36 +7,38 @@ namespace qga::domain::backtest {
         return ins.symbol() + "@" + ins.exchangeMic();
     }
 
-    Position& Portfolio::getOrCreate(const domain::Instrument& ins) {
-        auto k = keyFor(ins);
-        auto it = positions_.find(k);
-        if(it == positions_.end()) {
-            it = positions_.emplace(k, Position{ins}).first;
+    std::size_t Portfolio::slotFor(const domain::Instrument& ins) {
+        auto [it, inserted] = slots_.try_emplace(keyFor(ins), positions_.size());
+        if(inserted) {
+            positions_.emplace_back(ins);
         }
         return it->second;
     }
 
+    Position& Portfolio::getOrCreate(const domain::Instrument& ins) {
+        return positions_[slotFor(ins)];
+    }
+
     void Portfolio::applyTrade(const Trade& t) {
-        cash_ += t.signedCash(); // Buy -> cash down, Sell -> cash up
-        auto& pos = getOrCreate(t.order().instrument());
+        applyTrade(t, slotFor(t.order().instrument()));
+    }
+
+    void Portfolio::applyTrade(const Trade& t, std::size_t slot) {
+        auto& pos = positions_[slot];
+        const double REALIZED_BEFORE = pos.realizedPnl();
         pos.applyFill(t.price(), t.quantity(), t.side() == Side::Buy);
-        realized_pnl_ = aggregateRealized();
+        cash_ += t.signedCash(); // Buy -> cash down, Sell -> cash up
+        realized_pnl_ += pos.realizedPnl() - REALIZED_BEFORE;
     }
 
     double Portfolio::navFor(const domain::Instrument& ins, double mark_price) const {
         const auto K = keyFor(ins);
         double pos_val = 0.0;
-        if(auto it = positions_.find(K); it != positions_.end()) {
-            const auto& p = it ->second;
+        if(auto it = slots_.find(K); it != slots_.end()) {
+            const auto& p = positions_[it->second];
             pos_val = p.qty() * p.avgPrice() + p.unrealizedPnl(mark_price);
         }
         return cash_ + pos_val;
     }
 
-    double Portfolio::aggregateRealized() const {
-        double sum = 0.0;
-        for(auto const& kv : positions_) sum += kv.second.realizedPnl();
-        return sum;
-    }
-
 }   // namespace qga::domain::backtest
@@ -0,0 +1,365 @@
+#include "domain/backtest/PortfolioEngine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "domain/backtest/OrderBook.hpp"
+#include "domain/backtest/Portfolio.hpp"
+#include "strategy/TimeframeFeed.hpp"
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        std::chrono::system_clock::time_point toTimePoint(std::int64_t ts_ms)
+        {
+            return std::chrono::system_clock::time_point{std::chrono::milliseconds{ts_ms}};
+        }
+
+        /// Largest lot-rounded quantity whose notional plus commission fits in @p budget.
+        double affordableQty(double budget, double px, double lot, const ExecParams& exec)
+        {
+            const double UNIT_COST = px * (1.0 + exec.commission_bps_ / 10000.0);
+            const double QTY =
+                std::floor((budget - exec.commission_fixed_) / UNIT_COST / lot) * lot;
+            return QTY > 0.0 ? QTY : 0.0;
+        }
+
+        static_assert(std::is_same_v<strategy::OrderTicket, OrderId>, "tickets are OrderBook ids");
+
+        /// Routes one strategy's orders into the shared book.
+        class BookSink final : public strategy::OrderSink
+        {
+          public:
+            BookSink(OrderBook& book, const domain::Instrument& ins) : book_(book), ins_(ins) {}
+
+            void at(std::int64_t ts) noexcept { ts_ = ts; }
+
+            strategy::OrderTicket place(Side side, OrderType type, double quantity,
+                                        double limit_price, double stop_price) override
+            {
+                return book_.submit(
+                    Order{ins_, side, quantity, type, limit_price, stop_price, toTimePoint(ts_)});
+            }
+
+            bool cancel(strategy::OrderTicket ticket) override { return book_.cancel(ticket); }
+
+          private:
+            OrderBook& book_;
+            const domain::Instrument& ins_;
+            std::int64_t ts_ = 0;
+        };
+    } // namespace
+
+    PortfolioResult PortfolioEngine::run(const BarPanel& panel,
+                                         const std::vector<domain::Instrument>& instruments,
+                                         const StrategyFactory& make_strategy) const
+    {
+        const std::size_t N = panel.symbols();
+        if (instruments.size() != N)
+            throw std::invalid_argument(
+                "PortfolioEngine: one instrument per panel column required");
+
+        PortfolioResult res;
+        res.summary_.initial_equity_ = initial_equity_;
+        res.trades_.reserve(N * sizing_.trades_per_symbol_);
+
+        // --- Setup: everything that allocates happens before the bar loop ---------------
+        Portfolio pf{initial_equity_};
+        std::vector<std::size_t> slots(N);
+        std::vector<double> held(N, 0.0); // mirror of position qty, avoids slot lookups per bar
+        std::vector<double> mark(N, 0.0);
+        std::vector<std::int64_t> last_ts(N, 0);
+        for (std::size_t s = 0; s < N; ++s)
+            slots[s] = pf.slotFor(instruments[s]);
+
+        // --- Pass 1: signals, symbol-major ------------------------------------------------
+        // Strategies never observe the account, so each one can consume its whole
+        // history while its window state is hot in cache. Signals land in a
+        // time-major matrix laid out like the panel rows.
+        const std::size_t STRIDE = panel.stride();
+        std::vector<strategy::Signal> signals(panel.size() * STRIDE, strategy::Signal::None);
+        for (std::size_t s = 0; s < N; ++s)
+        {
+            auto made = make_strategy(s);
+            std::optional<strategy::TimeframeFeed> feed;
+            if (!made->timeframes().empty())
+                feed.emplace(*made);
+            strategy::IStrategy* strat = feed ? &*feed : made.get();
+            strat->onStart();
+            for (std::size_t t = 0; t < panel.size(); ++t)
+                if (const Quote* q = panel.quote(t, s))
+                    signals[t * STRIDE + s] = strat->onBar(*q);
+            strat->onFinish();
+        }
+
+        double market_value = 0.0; // Σ qty * last close, maintained incrementally
+
+        auto sell_all = [&](std::size_t s, std::int64_t ts)
+        {
+            const double QTY = held[s];
+            const double PX_EXEC = applySlippage(mark[s], exec_.slippage_bps_, /*is_buy=*/false);
+            if (PX_EXEC <= 0.0)
+                return;
+            const double FEE =
+                commissionCost(PX_EXEC, QTY, exec_.commission_fixed_, exec_.commission_bps_);
+
+            const auto TP = toTimePoint(ts);
+            res.trades_.emplace_back(Order{instruments[s], Side::Sell, QTY, OrderType::Market, TP},
+                                     PX_EXEC, QTY, TP);
+            pf.applyTrade(res.trades_.back(), slots[s]);
+            pf.chargeFee(FEE);
+            market_value -= QTY * mark[s];
+            held[s] = pf.position(slots[s]).qty();
+        };
+
+        // --- Optional volume-limited execution: orders work over later bars -------------
+        constexpr OrderId NO_ORDER = std::numeric_limits<OrderId>::max();
+        std::optional<VolumeFillModel> vol;
+        std::vector<std::size_t> vol_slots;
+        std::vector<OrderId> working; // open order per symbol (NO_ORDER if none)
+        std::vector<Side> working_side;
+        std::vector<Fill> fills;
+        if (volume_fill_)
+        {
+            vol.emplace(*volume_fill_, exec_);
+            vol_slots.resize(N);
+            working.assign(N, NO_ORDER);
+            working_side.assign(N, Side::Buy);
+            for (std::size_t s = 0; s < N; ++s)
+                vol_slots[s] = vol->slotFor(instruments[s]);
+        }
+
+        auto apply_slice = [&](std::size_t s, const Fill& f)
+        {
+            const bool BUY = f.side_ == Side::Buy;
+            double qty = f.quantity_;
+            if (BUY)
+            {
+                const double LOT = static_cast<double>(instruments[s].lotSize());
+                qty = std::min(qty, affordableQty(pf.cash(), f.price_, LOT, exec_));
+                if (qty < f.quantity_)
+                    vol->cancel(f.id_);
+            }
+            else
+            {
+                qty = std::min(qty, held[s]);
+            }
+            if (qty > 0.0)
+            {
+                const double FEE =
+                    commissionCost(f.price_, qty, exec_.commission_fixed_, exec_.commission_bps_);
+                const auto TP = toTimePoint(f.ts_);
+                res.trades_.emplace_back(Order{instruments[s], f.side_, qty, OrderType::Market, TP},
+                                         f.price_, qty, TP);
+                pf.applyTrade(res.trades_.back(), slots[s]);
+                pf.chargeFee(FEE);
+                market_value += (BUY ? qty : -qty) * mark[s];
+                held[s] = pf.position(slots[s]).qty();
+                if (BUY && vol->filled(f.id_) == f.quantity_) // first slice of the entry
+                    res.summary_.trades_executed_ += 1;
+            }
+            if (vol->remaining(f.id_) <= 0.0)
+                working[s] = NO_ORDER;
+        };
+
+        // --- Pass 2: accounting, time-major -----------------------------------------------
+        for (std::size_t t = 0; t < panel.size(); ++t)
+        {
+            const std::int64_t TS = panel.timestamp(t);
+            const double* close = panel.closeRow(t);
+            const strategy::Signal* sig = signals.data() + t * STRIDE;
+            for (std::size_t s = 0; s < N; ++s)
+            {
+                const double CLOSE = close[s];
+                if (CLOSE != CLOSE) // NaN: no bar for this symbol
+                    continue;
+
+                if (held[s] != 0.0)
+                    market_value += held[s] * (CLOSE - mark[s]);
+                mark[s] = CLOSE;
+                last_ts[s] = TS;
+
+                if (vol && working[s] != NO_ORDER)
+                {
+                    fills.clear();
+                    vol->onBar(vol_slots[s], *panel.quote(t, s), fills);
+                    for (const Fill& f : fills)
+                        apply_slice(s, f);
+                }
+
+                const double HELD = held[s];
+                if (sig[s] == strategy::Signal::Buy && HELD == 0.0
+                    && (!vol || working[s] == NO_ORDER))
+                {
+                    const double PX_EXEC =
+                        applySlippage(CLOSE, exec_.slippage_bps_, /*is_buy=*/true);
+                    if (PX_EXEC <= 0.0)
+                        continue;
+
+                    const double LOT = static_cast<double>(instruments[s].lotSize());
+                    const double EQUITY = pf.cash() + market_value;
+                    const double TARGET =
+                        std::floor(EQUITY * sizing_.equity_fraction_ / PX_EXEC / LOT) * LOT;
+                    const double QTY =
+                        std::min(TARGET, affordableQty(pf.cash(), PX_EXEC, LOT, exec_));
+                    if (QTY <= 0.0)
+                        continue;
+
+                    if (vol)
+                    {
+                        working[s] = vol->submit(vol_slots[s], Side::Buy, QTY);
+                        working_side[s] = Side::Buy;
+                        continue;
+                    }
+
+                    const double FEE = commissionCost(PX_EXEC, QTY, exec_.commission_fixed_,
+                                                      exec_.commission_bps_);
+                    const auto TP = toTimePoint(TS);
+                    res.trades_.emplace_back(
+                        Order{instruments[s], Side::Buy, QTY, OrderType::Market, TP}, PX_EXEC, QTY,
+                        TP);
+                    pf.applyTrade(res.trades_.back(), slots[s]);
+                    pf.chargeFee(FEE);
+                    held[s] = pf.position(slots[s]).qty();
+                    market_value += held[s] * CLOSE;
+                    res.summary_.trades_executed_ += 1;
+                }
+                else if (sig[s] == strategy::Signal::Sell && vol)
+                {
+                    if (working[s] != NO_ORDER && working_side[s] == Side::Sell)
+                        continue;
+                    if (working[s] != NO_ORDER)
+                        vol->cancel(working[s]);
+                    working[s] = NO_ORDER;
+                    if (HELD > 0.0)
+                    {
+                        working[s] = vol->submit(vol_slots[s], Side::Sell, HELD);
+                        working_side[s] = Side::Sell;
+                    }
+                }
+                else if (sig[s] == strategy::Signal::Sell && HELD > 0.0)
+                {
+                    sell_all(s, TS);
+                }
+            }
+        }
+
+        // --- Close out remaining positions at each instrument's last close ---------------
+        for (std::size_t s = 0; s < N; ++s)
+            if (held[s] > 0.0)
+                sell_all(s, last_ts[s]);
+
+        res.summary_.final_equity_ = pf.cash(); // book is flat after the close-out
+        return res;
+    }
+
+    PortfolioResult PortfolioEngine::run(const BarPanel& panel,
+                                         const std::vector<domain::Instrument>& instruments,
+                                         const OrderStrategyFactory& make_strategy) const
+    {
+        const std::size_t N = panel.symbols();
+        if (instruments.size() != N)
+            throw std::invalid_argument(
+                "PortfolioEngine: one instrument per panel column required");
+
+        PortfolioResult res;
+        res.summary_.initial_equity_ = initial_equity_;
+        res.trades_.reserve(N * sizing_.trades_per_symbol_);
+
+        Portfolio pf{initial_equity_};
+        OrderBook book{exec_};
+        std::vector<std::size_t> slots(N);
+        std::vector<std::size_t> book_slots(N);
+        std::vector<double> held(N, 0.0);
+        std::vector<double> mark(N, 0.0);
+        std::vector<std::int64_t> last_ts(N, 0);
+        std::vector<std::unique_ptr<strategy::IOrderStrategy>> strats(N);
+        std::vector<BookSink> sinks;
+        sinks.reserve(N);
+        for (std::size_t s = 0; s < N; ++s)
+        {
+            slots[s] = pf.slotFor(instruments[s]);
+            book_slots[s] = book.slotFor(instruments[s]);
+            sinks.emplace_back(book, instruments[s]);
+            strats[s] = make_strategy(s);
+            strats[s]->onStart();
+        }
+
+        std::vector<Fill> fills;
+
+        // Books one execution of @p order (trimmed to cash / holdings); returns the traded qty.
+        auto execute =
+            [&](std::size_t s, const Order& order, double px, double qty, std::int64_t ts)
+        {
+            const bool BUY = order.side() == Side::Buy;
+            if (BUY)
+            {
+                const double LOT = static_cast<double>(instruments[s].lotSize());
+                qty = std::min(qty, affordableQty(pf.cash(), px, LOT, exec_));
+            }
+            else
+            {
+                qty = std::min(qty, held[s]);
+            }
+            if (qty <= 0.0 || px <= 0.0)
+                return 0.0;
+
+            const double FEE =
+                commissionCost(px, qty, exec_.commission_fixed_, exec_.commission_bps_);
+            res.trades_.emplace_back(order, px, qty, toTimePoint(ts));
+            pf.applyTrade(res.trades_.back(), slots[s]);
+            pf.chargeFee(FEE);
+            held[s] = pf.position(slots[s]).qty();
+            if (BUY)
+                res.summary_.trades_executed_ += 1;
+            return qty;
+        };
+
+        for (std::size_t t = 0; t < panel.size(); ++t)
+        {
+            const std::int64_t TS = panel.timestamp(t);
+            for (std::size_t s = 0; s < N; ++s)
+            {
+                const Quote* q = panel.quote(t, s);
+                if (!q)
+                    continue;
+
+                mark[s] = q->close_;
+                last_ts[s] = TS;
+                sinks[s].at(TS);
+
+                fills.clear();
+                book.onBar(book_slots[s], *q, fills);
+                for (const Fill& f : fills)
+                {
+                    const double QTY = execute(s, book.order(f.id_), f.price_, f.quantity_, f.ts_);
+                    if (QTY > 0.0)
+                        strats[s]->onFill(f.id_, f.side_, f.price_, QTY, sinks[s]);
+                }
+                strats[s]->onBar(*q, sinks[s]);
+            }
+        }
+
+        for (std::size_t s = 0; s < N; ++s)
+        {
+            strats[s]->onFinish();
+            if (held[s] > 0.0)
+                execute(s,
+                        Order{instruments[s], Side::Sell, held[s], OrderType::Market,
+                              toTimePoint(last_ts[s])},
+                        applySlippage(mark[s], exec_.slippage_bps_, /*is_buy=*/false), held[s],
+                        last_ts[s]);
+        }
+
+        res.summary_.final_equity_ = pf.cash(); // book is flat after the close-out
+        return res;
+    }
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,244 @@
+#include "domain/backtest/RebalanceEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "core/Parallel.hpp"
+#include "core/StatisticsKernels.hpp"
+#include "strategy/Ranker.hpp"
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        strategy::CrossSection slice(const BarPanel& panel, std::size_t t)
+        {
+            return {panel.timestamp(t), t, panel.closeRow(0), panel.stride(), panel.symbols()};
+        }
+
+        // Asks a cross-sectional strategy row by row.
+        class SequentialRanking final : public strategy::IWeightStrategy
+        {
+          public:
+            SequentialRanking(const BarPanel& panel, strategy::ICrossSectionalStrategy& strat)
+                : panel_(panel), strat_(strat)
+            {
+            }
+
+            bool targetWeights(std::int64_t, std::span<const double>,
+                               std::span<double> weights) override
+            {
+                std::fill(weights.begin(), weights.end(), 0.0);
+                return strat_.targetWeights(slice(panel_, row_++), weights, ranker_);
+            }
+
+          private:
+            const BarPanel& panel_;
+            strategy::ICrossSectionalStrategy& strat_;
+            strategy::Ranker ranker_;
+            std::size_t row_ = 0;
+        };
+
+        // Targets of the rebalancing rows of one block of rows.
+        struct RankedBlock
+        {
+            std::vector<std::uint32_t> rows_; ///< Rows that rebalance, ascending.
+            std::vector<double> weights_;     ///< symbols() targets per entry of rows_.
+        };
+
+        // Replays targets precomputed in parallel.
+        class ReplayRanking final : public strategy::IWeightStrategy
+        {
+          public:
+            explicit ReplayRanking(const std::vector<RankedBlock>& blocks) : blocks_(blocks) {}
+
+            bool targetWeights(std::int64_t, std::span<const double>,
+                               std::span<double> weights) override
+            {
+                const std::size_t ROW = row_++;
+                while (block_ < blocks_.size() && next_ == blocks_[block_].rows_.size())
+                {
+                    ++block_;
+                    next_ = 0;
+                }
+                if (block_ == blocks_.size() || blocks_[block_].rows_[next_] != ROW)
+                    return false;
+                const double* w = blocks_[block_].weights_.data() + next_ * weights.size();
+                std::copy(w, w + weights.size(), weights.begin());
+                ++next_;
+                return true;
+            }
+
+          private:
+            const std::vector<RankedBlock>& blocks_;
+            std::size_t block_ = 0; ///< Block holding the next rebalance.
+            std::size_t next_ = 0;  ///< Entry of that block.
+            std::size_t row_ = 0;
+        };
+    } // namespace
+
+    RebalanceResult RebalanceEngine::run(const BarPanel& panel,
+                                         strategy::IWeightStrategy& strat) const
+    {
+        const std::size_t N = panel.symbols();
+        const std::size_t W = panel.stride(); // padded columns are NaN forever and never trade
+        const std::size_t ROWS = panel.size();
+        constexpr double NAN_PX = std::numeric_limits<double>::quiet_NaN();
+
+        RebalanceResult res;
+        auto& sum = res.summary_;
+        sum.initial_equity_ = initial_equity_;
+        sum.equity_curve_.reserve(ROWS);
+        sum.returns_.reserve(ROWS);
+
+        // Flat per-symbol state; sized once, reused every row.
+        std::vector<double> price(W, NAN_PX); // latest close, NaN until the first bar (strategy)
+        std::vector<double> mark(W, 0.0);     // latest close, 0 until the first bar (valuation)
+        std::vector<double> held(W, 0.0);     // units
+        std::vector<double> weight(W, 0.0);   // current targets
+
+        const double SLIP = exec_.slippage_bps_ / 10000.0;
+        const double COMM = exec_.commission_bps_ / 10000.0;
+        const double FIXED = exec_.commission_fixed_;
+        double cash = initial_equity_;
+        double prev_equity = initial_equity_;
+
+        strat.onStart(N);
+        for (std::size_t t = 0; t < ROWS; ++t)
+        {
+            const double* close = panel.closeRow(t);
+
+            // Carry prices forward; value the book at the new marks.
+            double market = 0.0;
+            for (std::size_t s = 0; s < W; ++s)
+            {
+                const double C = close[s];
+                const bool LIVE = C == C;
+                price[s] = LIVE ? C : price[s];
+                mark[s] = LIVE ? C : mark[s];
+                market += held[s] * mark[s];
+            }
+            const double EQUITY = cash + market;
+
+            if (strat.targetWeights(panel.timestamp(t), std::span<const double>{price.data(), N},
+                                    std::span<double>{weight.data(), N}))
+            {
+                ++res.rebalances_;
+                const double BAND = params_.min_trade_weight_ * std::abs(EQUITY);
+                double flow = 0.0; // cash paid for units (negative for net sales)
+                double costs = 0.0;
+                double traded = 0.0;
+                std::size_t trades = 0;
+                for (std::size_t s = 0; s < N; ++s)
+                {
+                    const double C = close[s];
+                    const bool LIVE = C == C;
+                    const double PX = LIVE ? C : 1.0;
+                    const double DELTA = weight[s] * EQUITY / PX - held[s];
+                    const double NOTIONAL = std::abs(DELTA) * PX;
+                    const bool TRADE = LIVE && NOTIONAL > BAND && DELTA != 0.0;
+                    const double D = TRADE ? DELTA : 0.0;
+                    const double N_D = TRADE ? NOTIONAL : 0.0;
+                    const double COST = N_D * (SLIP + COMM * (1.0 + (D > 0.0 ? SLIP : -SLIP)))
+                                        + (TRADE ? FIXED : 0.0);
+                    held[s] += D;
+                    flow += D * PX;
+                    costs += COST;
+                    traded += N_D;
+                    trades += TRADE;
+                }
+                cash -= flow + costs;
+                res.costs_ += costs;
+                sum.trades_executed_ += static_cast<int>(trades);
+                if (EQUITY != 0.0)
+                    res.turnover_ += traded / std::abs(EQUITY);
+            }
+
+            double post = cash;
+            for (std::size_t s = 0; s < W; ++s)
+                post += held[s] * mark[s];
+            sum.equity_curve_.push_back(post);
+            sum.returns_.push_back(prev_equity != 0.0 ? post / prev_equity - 1.0 : 0.0);
+            prev_equity = post;
+        }
+        strat.onFinish();
+
+        // Liquidate at the last marks.
+        double final_cash = cash;
+        for (std::size_t s = 0; s < N; ++s)
+        {
+            const double Q = held[s];
+            if (Q == 0.0 || mark[s] <= 0.0)
+                continue;
+            const double PX_EXEC = applySlippage(mark[s], exec_.slippage_bps_, /*is_buy=*/Q < 0.0);
+            final_cash +=
+                Q * PX_EXEC - commissionCost(PX_EXEC, std::abs(Q), FIXED, exec_.commission_bps_);
+        }
+        res.holdings_.assign(held.begin(), held.begin() + static_cast<std::ptrdiff_t>(N));
+        sum.final_equity_ = final_cash;
+        sum.bars_processed_ = ROWS;
+
+        std::vector<double> curve;
+        curve.reserve(ROWS + 1);
+        curve.push_back(initial_equity_);
+        curve.insert(curve.end(), sum.equity_curve_.begin(), sum.equity_curve_.end());
+        sum.max_drawdown_ = core::stats::maxDrawdown(curve);
+        sum.sharpe_ = core::stats::sharpeRatio(sum.returns_, 0.0, 1.0);
+        return res;
+    }
+
+    RebalanceResult RebalanceEngine::run(const BarPanel& panel,
+                                         strategy::ICrossSectionalStrategy& strat,
+                                         std::size_t threads) const
+    {
+        if (!strat.stateless() || panel.size() == 0)
+        {
+            SequentialRanking seq{panel, strat};
+            strat.onStart(panel.symbols());
+            auto res = run(panel, static_cast<strategy::IWeightStrategy&>(seq));
+            strat.onFinish();
+            return res;
+        }
+
+        // Rows are independent: evaluate them in blocks (several per worker so
+        // uneven rebalance density balances out), each block into its own buffers.
+        const std::size_t N = panel.symbols();
+        if (threads == 0)
+            threads = core::defaultThreads();
+        const std::size_t BLOCKS = std::min(panel.size(), threads * 8);
+        const std::size_t PER_BLOCK = (panel.size() + BLOCKS - 1) / BLOCKS;
+        std::vector<RankedBlock> blocks(BLOCKS);
+        std::vector<strategy::Ranker> rankers(std::min(threads, BLOCKS));
+
+        strat.onStart(N);
+        core::parallelFor(
+            BLOCKS,
+            [&](std::size_t b, std::size_t worker)
+            {
+                auto& out = blocks[b];
+                const std::size_t END = std::min(panel.size(), (b + 1) * PER_BLOCK);
+                for (std::size_t t = b * PER_BLOCK; t < END; ++t)
+                {
+                    const std::size_t AT = out.weights_.size();
+                    out.weights_.resize(AT + N, 0.0);
+                    if (strat.targetWeights(slice(panel, t),
+                                            std::span<double>{out.weights_.data() + AT, N},
+                                            rankers[worker]))
+                        out.rows_.push_back(static_cast<std::uint32_t>(t));
+                    else
+                        out.weights_.resize(AT);
+                }
+            },
+            rankers.size());
+
+        ReplayRanking replay{blocks};
+        auto res = run(panel, static_cast<strategy::IWeightStrategy&>(replay));
+        strat.onFinish();
+        return res;
+    }
+
+} // namespace qga::domain::backtest
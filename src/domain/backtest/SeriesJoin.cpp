@@ -0,0 +1,241 @@
+#include "domain/backtest/SeriesJoin.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "core/Parallel.hpp"
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        constexpr std::uint32_t NO_MATCH = AlignedRows::NO_MATCH;
+
+        /// Right columns this many times longer than the left one are searched, not merged.
+        constexpr std::size_t SEARCH_RATIO = 16;
+
+        /**
+         * First index in [0, n) whose value is not before @p key (`<` for a lower
+         * bound, `<=` for an upper bound). The halving step is a conditional
+         * move, so the loop runs exactly ceil(log2 n) iterations.
+         */
+        template <bool UPPER>
+        std::size_t branchlessBound(const std::int64_t* base, std::size_t n, std::int64_t key)
+        {
+            if (n == 0)
+                return 0;
+            const std::int64_t* b = base;
+            while (n > 1)
+            {
+                const std::size_t HALF = n / 2;
+                const bool RIGHT = UPPER ? b[HALF] <= key : b[HALF] < key;
+                b = RIGHT ? b + HALF : b;
+                n -= HALF;
+            }
+            const bool PAST = UPPER ? *b <= key : *b < key;
+            return static_cast<std::size_t>(b - base) + PAST;
+        }
+
+        // ---------- merge path: one pass, cursors advanced by comparison results ----------
+
+        void mergeInner(std::span<const std::int64_t> l, std::span<const std::int64_t> r,
+                        AlignedRows& out)
+        {
+            // Unconditional writes: slot k is committed only when the timestamps match.
+            out.left_.resize(l.size() + 1);
+            out.right_.resize(l.size() + 1);
+            std::size_t i = 0, j = 0, k = 0;
+            while (i < l.size() && j < r.size())
+            {
+                const std::int64_t A = l[i];
+                const std::int64_t B = r[j];
+                out.left_[k] = static_cast<std::uint32_t>(i);
+                out.right_[k] = static_cast<std::uint32_t>(j);
+                k += A == B;
+                i += A <= B;
+                j += B < A;
+            }
+            out.left_.resize(k);
+            out.right_.resize(k);
+        }
+
+        void mergeLeft(std::span<const std::int64_t> l, std::span<const std::int64_t> r,
+                       AlignedRows& out)
+        {
+            // The last write to right_[i] happens in the step that advances i.
+            std::size_t i = 0, j = 0;
+            while (i < l.size() && j < r.size())
+            {
+                const std::int64_t A = l[i];
+                const std::int64_t B = r[j];
+                out.right_[i] = A == B ? static_cast<std::uint32_t>(j) : NO_MATCH;
+                i += A <= B;
+                j += B < A;
+            }
+        }
+
+        void mergeAsOf(std::span<const std::int64_t> l, std::span<const std::int64_t> r,
+                       std::int64_t tolerance, AlignedRows& out)
+        {
+            // j counts the right rows at or before l[i]; the candidate is j - 1.
+            std::size_t i = 0, j = 0;
+            while (i < l.size() && j < r.size())
+            {
+                const std::int64_t A = l[i];
+                const bool TAKE = r[j] <= A;
+                const std::size_t PREV = j - (j > 0);
+                const bool FRESH = j > 0 && A - r[PREV] <= tolerance;
+                out.right_[i] = FRESH ? static_cast<std::uint32_t>(PREV) : NO_MATCH;
+                i += !TAKE;
+                j += TAKE;
+            }
+            for (; i < l.size() && j > 0; ++i)
+                out.right_[i] =
+                    l[i] - r[j - 1] <= tolerance ? static_cast<std::uint32_t>(j - 1) : NO_MATCH;
+        }
+
+        // ---------- search path: branchless binary search from the previous position ----------
+
+        void searchExact(std::span<const std::int64_t> l, std::span<const std::int64_t> r,
+                         AlignedRows& out)
+        {
+            std::size_t j = 0;
+            for (std::size_t i = 0; i < l.size(); ++i)
+            {
+                j += branchlessBound<false>(r.data() + j, r.size() - j, l[i]);
+                out.right_[i] =
+                    j < r.size() && r[j] == l[i] ? static_cast<std::uint32_t>(j) : NO_MATCH;
+            }
+        }
+
+        void searchAsOf(std::span<const std::int64_t> l, std::span<const std::int64_t> r,
+                        std::int64_t tolerance, AlignedRows& out)
+        {
+            std::size_t j = 0;
+            for (std::size_t i = 0; i < l.size(); ++i)
+            {
+                j += branchlessBound<true>(r.data() + j, r.size() - j, l[i]);
+                out.right_[i] = j > 0 && l[i] - r[j - 1] <= tolerance
+                                    ? static_cast<std::uint32_t>(j - 1)
+                                    : NO_MATCH;
+            }
+        }
+
+        /// Keeps only the matched rows of a left join.
+        void dropUnmatched(AlignedRows& out)
+        {
+            std::size_t k = 0;
+            for (std::size_t i = 0; i < out.right_.size(); ++i)
+            {
+                out.left_[k] = out.left_[i];
+                out.right_[k] = out.right_[i];
+                k += out.right_[i] != NO_MATCH;
+            }
+            out.left_.resize(k);
+            out.right_.resize(k);
+        }
+
+        void checkOptions(const JoinOptions& options)
+        {
+            if (options.kind_ == JoinKind::AsOf && options.tolerance_ < 0)
+                throw std::invalid_argument("joinTimestamps: as-of tolerance must be >= 0");
+        }
+
+        std::vector<std::int64_t> timestampColumn(const BarSeries& series)
+        {
+            std::vector<std::int64_t> ts(series.size());
+            for (std::size_t i = 0; i < series.size(); ++i)
+                ts[i] = series[i].ts_;
+            return ts;
+        }
+    } // namespace
+
+    AlignedRows joinTimestamps(std::span<const std::int64_t> left,
+                               std::span<const std::int64_t> right, const JoinOptions& options)
+    {
+        checkOptions(options);
+        if (left.size() >= NO_MATCH || right.size() >= NO_MATCH)
+            throw std::length_error("joinTimestamps: too many rows for 32-bit indices");
+
+        AlignedRows out;
+        const bool SEARCH = right.size() > SEARCH_RATIO * left.size();
+        if (options.kind_ == JoinKind::Inner && !SEARCH)
+        {
+            mergeInner(left, right, out);
+            return out;
+        }
+
+        out.left_.resize(left.size());
+        std::iota(out.left_.begin(), out.left_.end(), std::uint32_t{0});
+        out.right_.assign(left.size(), NO_MATCH);
+        if (options.kind_ == JoinKind::AsOf)
+        {
+            if (SEARCH)
+                searchAsOf(left, right, options.tolerance_, out);
+            else
+                mergeAsOf(left, right, options.tolerance_, out);
+            return out;
+        }
+        if (SEARCH)
+            searchExact(left, right, out);
+        else
+            mergeLeft(left, right, out);
+        if (options.kind_ == JoinKind::Inner)
+            dropUnmatched(out);
+        return out;
+    }
+
+    AlignedRows join(const BarSeries& left, const BarSeries& right, const JoinOptions& options)
+    {
+        const auto L = timestampColumn(left);
+        const auto R = timestampColumn(right);
+        return joinTimestamps(L, R, options);
+    }
+
+    std::vector<AlignedRows> joinPairs(const std::vector<BarSeries>& universe,
+                                       std::span<const SeriesPair> pairs,
+                                       const JoinOptions& options, std::size_t threads)
+    {
+        checkOptions(options);
+        std::vector<char> used(universe.size(), 0);
+        for (const auto& p : pairs)
+        {
+            if (p.left_ >= universe.size() || p.right_ >= universe.size())
+                throw std::out_of_range("joinPairs: pair refers outside the universe");
+            used[p.left_] = used[p.right_] = 1;
+        }
+
+        // Dense timestamp columns, once per series (the bars themselves are 48-byte records).
+        std::vector<std::vector<std::int64_t>> ts(universe.size());
+        core::parallelFor(
+            universe.size(),
+            [&](std::size_t s, std::size_t)
+            {
+                if (used[s])
+                    ts[s] = timestampColumn(universe[s]);
+            },
+            threads);
+
+        std::vector<AlignedRows> out(pairs.size());
+        core::parallelFor(
+            pairs.size(),
+            [&](std::size_t k, std::size_t)
+            { out[k] = joinTimestamps(ts[pairs[k].left_], ts[pairs[k].right_], options); },
+            threads);
+        return out;
+    }
+
+    std::vector<double> alignedColumn(const BarSeries& series, std::span<const std::uint32_t> rows,
+                                      double Quote::*field)
+    {
+        const auto& bars = series.data();
+        std::vector<double> out(rows.size());
+        for (std::size_t k = 0; k < rows.size(); ++k)
+            out[k] = rows[k] == NO_MATCH ? std::nan("") : bars[rows[k]].*field;
+        return out;
+    }
+
+} // namespace qga::domain::backtest
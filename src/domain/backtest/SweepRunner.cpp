@@ -0,0 +1,75 @@
+#include "domain/backtest/SweepRunner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+#include "core/Parallel.hpp"
+#include "domain/backtest/Engine.hpp"
+
+namespace qga::domain::backtest
+{
+
+    SweepRunner::SweepRunner(double initial_equity, ExecParams exec, SweepParams params)
+        : initial_equity_(initial_equity), exec_(exec), params_(params)
+    {
+        if (params_.behind_best_ > 0.0 && params_.rules_.checkpoint_bar_ == 0)
+            throw std::invalid_argument("SweepRunner: behind_best_ needs rules_.checkpoint_bar_");
+    }
+
+    SweepResult SweepRunner::run(std::span<const Quote> bars, std::size_t count,
+                                 const StrategyFactory& make) const
+    {
+        SweepResult out;
+        out.results_.resize(count);
+
+        std::mutex best_mutex;
+        bool have_best = false;
+        double best_final = 0.0;
+        double floor = params_.rules_.checkpoint_floor_;
+
+        core::parallelFor(
+            count,
+            [&](std::size_t i, std::size_t)
+            {
+                StopRules rules = params_.rules_;
+                {
+                    std::lock_guard lock{best_mutex};
+                    rules.checkpoint_floor_ = floor;
+                }
+
+                auto strat = make(i);
+                Engine engine{initial_equity_, exec_, rules};
+                const auto R = engine.run(bars, *strat);
+                out.results_[i] = R;
+
+                if (R.aborted_ || params_.behind_best_ <= 0.0)
+                    return;
+                std::lock_guard lock{best_mutex};
+                if (!have_best || R.final_equity_ > best_final)
+                {
+                    have_best = true;
+                    best_final = R.final_equity_;
+                    if (std::isfinite(R.checkpoint_equity_))
+                        floor = std::max(floor, R.checkpoint_equity_ - params_.behind_best_);
+                }
+            },
+            params_.threads_);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& r = out.results_[i];
+            out.bars_processed_ += r.bars_processed_;
+            if (r.aborted_)
+            {
+                ++out.aborted_;
+                continue;
+            }
+            if (!out.best_ || r.final_equity_ > out.results_[*out.best_].final_equity_)
+                out.best_ = i;
+        }
+        return out;
+    }
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,117 @@
+#include "domain/backtest/VolumeFillModel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        constexpr std::size_t COMPACT_MIN_HEAD = 32;
+    } // namespace
+
+    VolumeFillModel::VolumeFillModel(VolumeFillParams params, ExecParams exec)
+        : params_(params), exec_(exec)
+    {
+        if (!(params_.max_participation_ > 0.0 && params_.max_participation_ <= 1.0))
+            throw std::invalid_argument("VolumeFillModel: max_participation_ must be in (0, 1]");
+        if (params_.impact_coef_ < 0.0 || params_.volatility_ < 0.0)
+            throw std::invalid_argument(
+                "VolumeFillModel: impact_coef_ and volatility_ must be >= 0");
+    }
+
+    std::size_t VolumeFillModel::slotFor(const domain::Instrument& ins)
+    {
+        auto [it, inserted] =
+            slots_.try_emplace(ins.symbol() + "@" + ins.exchangeMic(), queues_.size());
+        if (inserted)
+            queues_.emplace_back();
+        return it->second;
+    }
+
+    OrderId VolumeFillModel::submit(const Order& order)
+    {
+        if (order.type() != OrderType::Market)
+            throw std::invalid_argument("VolumeFillModel: only market orders are supported");
+        return submit(slotFor(order.instrument()), order.side(), order.quantity());
+    }
+
+    OrderId VolumeFillModel::submit(std::size_t slot, Side side, double quantity)
+    {
+        if (!(quantity > 0.0))
+            throw std::invalid_argument("VolumeFillModel: quantity must be > 0");
+        auto& q = queues_.at(slot);
+        const auto ID = static_cast<OrderId>(records_.size());
+        records_.push_back({slot, side, quantity});
+        q.ids_.push_back(ID);
+        ++open_;
+        return ID;
+    }
+
+    bool VolumeFillModel::cancel(OrderId id)
+    {
+        if (id >= records_.size() || records_[id].remaining_ <= 0.0)
+            return false;
+        records_[id].remaining_ = 0.0; // dropped from the queue when it reaches the head
+        --open_;
+        return true;
+    }
+
+    void VolumeFillModel::onBar(std::size_t slot, const Quote& bar, std::vector<Fill>& fills)
+    {
+        auto& q = queues_.at(slot);
+        const double VOLUME = bar.volume_;
+        double budget = params_.max_participation_ * VOLUME;
+        const double PX = (bar.high_ + bar.low_ + bar.close_) / 3.0;
+        const double SIGMA = params_.volatility_ > 0.0 ? params_.volatility_
+                             : PX > 0.0                ? (bar.high_ - bar.low_) / PX
+                                                       : 0.0;
+        const double SCALE = params_.impact_coef_ * SIGMA;
+        double taken = 0.0;
+
+        while (q.head_ < q.ids_.size())
+        {
+            auto& rec = records_[q.ids_[q.head_]];
+            if (rec.remaining_ <= 0.0)
+            {
+                ++q.head_; // cancelled
+                continue;
+            }
+            if (budget <= 0.0)
+                break;
+
+            const double QTY = std::min(rec.remaining_, budget);
+            budget -= QTY;
+            taken += QTY;
+            const bool BUY = rec.side_ == Side::Buy;
+            const double IMPACT = SCALE * std::sqrt(taken / VOLUME);
+            const double PRICE =
+                applySlippage(PX * (BUY ? 1.0 + IMPACT : 1.0 - IMPACT), exec_.slippage_bps_, BUY);
+
+            rec.remaining_ -= QTY;
+            rec.filled_ += QTY;
+            rec.notional_ += QTY * PRICE;
+            fills.push_back(
+                {q.ids_[q.head_], slot, rec.side_, OrderType::Market, PRICE, QTY, bar.ts_});
+            if (rec.remaining_ > 0.0)
+                break; // budget exhausted mid-order: it keeps the head
+            rec.remaining_ = 0.0;
+            --open_;
+            ++q.head_;
+        }
+
+        if (q.head_ == q.ids_.size())
+        {
+            q.ids_.clear();
+            q.head_ = 0;
+        }
+        else if (q.head_ >= COMPACT_MIN_HEAD && 2 * q.head_ > q.ids_.size())
+        {
+            q.ids_.erase(q.ids_.begin(), q.ids_.begin() + static_cast<std::ptrdiff_t>(q.head_));
+            q.head_ = 0;
+        }
+    }
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,143 @@
+#include "domain/backtest/WalkForward.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/Parallel.hpp"
+#include "domain/backtest/Engine.hpp"
+#include "domain/backtest/WarmupCache.hpp"
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        std::size_t firstAtOrAfter(std::span<const Quote> bars, std::int64_t ts)
+        {
+            const auto IT =
+                std::lower_bound(bars.begin(), bars.end(), ts,
+                                 [](const Quote& q, std::int64_t t) { return q.ts_ < t; });
+            return static_cast<std::size_t>(IT - bars.begin());
+        }
+    } // namespace
+
+    WalkForward::WalkForward(double initial_equity, ExecParams exec, WalkForwardParams params)
+        : initial_equity_(initial_equity), exec_(exec), params_(params)
+    {
+        if (params_.train_span_ <= 0 || params_.test_span_ <= 0)
+            throw std::invalid_argument("WalkForward: train and test spans must be > 0");
+    }
+
+    std::vector<Fold> WalkForward::makeFolds(std::span<const Quote> bars,
+                                             const WalkForwardParams& params)
+    {
+        std::vector<Fold> folds;
+        if (bars.empty() || params.train_span_ <= 0 || params.test_span_ <= 0)
+            return folds;
+
+        const std::int64_t FIRST = bars.front().ts_;
+        const std::int64_t LAST = bars.back().ts_;
+        for (std::int64_t test_start = FIRST + params.train_span_; test_start <= LAST;
+             test_start += params.test_span_)
+        {
+            Fold f;
+            f.train_begin_ = params.mode_ == WindowMode::Anchored
+                                 ? 0
+                                 : firstAtOrAfter(bars, test_start - params.train_span_);
+            f.train_end_ = firstAtOrAfter(bars, test_start);
+            f.test_begin_ = f.train_end_;
+            f.test_end_ = firstAtOrAfter(bars, test_start + params.test_span_);
+            if (f.train_begin_ < f.train_end_ && f.test_begin_ < f.test_end_)
+                folds.push_back(f);
+        }
+        return folds;
+    }
+
+    WalkForwardResult WalkForward::run(const BarSeries& series, std::size_t param_count,
+                                       const StrategyFactory& make_strategy,
+                                       const Objective& objective) const
+    {
+        if (param_count == 0)
+            throw std::invalid_argument("WalkForward: no parameter sets to evaluate");
+
+        const std::span<const Quote> BARS{series.data()};
+        const auto FOLDS = makeFolds(BARS, params_);
+        const Engine ENGINE{initial_equity_, exec_};
+
+        // In-sample sweep: every (fold, parameter) pair is an independent task.
+        std::vector<double> scores(FOLDS.size() * param_count);
+        core::parallelFor(
+            scores.size(),
+            [&](std::size_t task, std::size_t)
+            {
+                const auto& f = FOLDS[task / param_count];
+                auto strat = make_strategy(task % param_count);
+                Engine engine = ENGINE;
+                const auto R =
+                    engine.run(BARS.subspan(f.train_begin_, f.train_end_ - f.train_begin_), *strat);
+                scores[task] = objective ? objective(R) : R.final_equity_;
+            },
+            params_.threads_);
+
+        WalkForwardResult out;
+        out.folds_.resize(FOLDS.size());
+        for (std::size_t k = 0; k < FOLDS.size(); ++k)
+        {
+            const auto ROW = std::span<const double>{scores}.subspan(k * param_count, param_count);
+            const auto BEST =
+                static_cast<std::size_t>(std::max_element(ROW.begin(), ROW.end()) - ROW.begin());
+            out.folds_[k].fold_ = FOLDS[k];
+            out.folds_[k].best_param_ = BEST;
+            out.folds_[k].train_score_ = ROW[BEST];
+        }
+
+        // Out-of-sample runs of the chosen parameters, warmed up on their training window.
+        // Anchored folds share a training start, so their warm-ups extend each other.
+        WarmupCache warmups;
+        core::parallelFor(
+            FOLDS.size(),
+            [&](std::size_t k, std::size_t)
+            {
+                auto& fr = out.folds_[k];
+                const auto& f = fr.fold_;
+                const auto TEST = BARS.subspan(f.test_begin_, f.test_end_ - f.test_begin_);
+                auto strat = make_strategy(fr.best_param_);
+                Engine engine = ENGINE;
+                if (!params_.warm_start_)
+                {
+                    fr.test_ = engine.run(TEST, *strat, CaptureLevel::Full);
+                    return;
+                }
+                const WarmupKey KEY{
+                    "WalkForward",
+                    {static_cast<double>(fr.best_param_), static_cast<double>(f.train_begin_)}};
+                const auto STATE =
+                    warmups.state(KEY, BARS.subspan(f.train_begin_), TEST.front().ts_, *strat);
+                fr.test_ = engine.runFrom(TEST, *strat, *STATE, CaptureLevel::Full);
+            },
+            params_.threads_);
+
+        // Stitch: each window's P&L continues from where the previous one closed.
+        std::size_t points = 0;
+        for (const auto& fr : out.folds_)
+            points += fr.test_.equity_curve_.size();
+        out.oos_ts_.reserve(points);
+        out.oos_equity_.reserve(points);
+        double level = initial_equity_;
+        for (std::size_t k = 0; k < FOLDS.size(); ++k)
+        {
+            const double OFFSET = level - initial_equity_;
+            const auto& f = out.folds_[k].fold_;
+            const auto& curve = out.folds_[k].test_.equity_curve_;
+            for (std::size_t i = 0; i < curve.size(); ++i)
+            {
+                out.oos_ts_.push_back(BARS[f.test_begin_ + i].ts_);
+                out.oos_equity_.push_back(curve[i] + OFFSET);
+            }
+            level = out.folds_[k].test_.final_equity_ + OFFSET;
+            out.oos_equity_.back() = level; // window closes out its position
+        }
+        return out;
+    }
+
+} // namespace qga::domain::backtest
@@ -0,0 +1,162 @@
+#include "domain/backtest/WarmupCache.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <stdexcept>
+
+#include "strategy/StateBlob.hpp"
+#include "strategy/TimeframeFeed.hpp"
+
+namespace qga::domain::backtest
+{
+
+    namespace
+    {
+        constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+        constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+        inline void mix(std::uint64_t& h, std::uint64_t v) noexcept
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                h ^= (v >> (8 * i)) & 0xFFu;
+                h *= FNV_PRIME;
+            }
+        }
+    } // namespace
+
+    std::uint64_t seriesFingerprint(std::span<const Quote> bars) noexcept
+    {
+        std::uint64_t h = FNV_OFFSET;
+        mix(h, bars.size());
+        for (const auto& q : bars)
+        {
+            mix(h, static_cast<std::uint64_t>(q.ts_));
+            mix(h, std::bit_cast<std::uint64_t>(q.open_));
+            mix(h, std::bit_cast<std::uint64_t>(q.high_));
+            mix(h, std::bit_cast<std::uint64_t>(q.low_));
+            mix(h, std::bit_cast<std::uint64_t>(q.close_));
+            mix(h, std::bit_cast<std::uint64_t>(q.volume_));
+        }
+        return h;
+    }
+
+    WarmupCache::WarmupCache(std::size_t max_snapshots) : max_snapshots_(max_snapshots)
+    {
+        if (max_snapshots_ == 0)
+            throw std::invalid_argument("WarmupCache: max_snapshots must be > 0");
+    }
+
+    std::shared_ptr<const WarmupCache::State> WarmupCache::state(const WarmupKey& key,
+                                                                 std::span<const Quote> bars,
+                                                                 std::int64_t at,
+                                                                 strategy::IStrategy& strat)
+    {
+        // Latest snapshot at or before `at`.
+        std::shared_ptr<const State> base;
+        std::int64_t base_ts = 0;
+        {
+            std::lock_guard lock{mutex_};
+            if (auto e = entries_.find(key); e != entries_.end())
+            {
+                auto it = e->second.upper_bound(at);
+                if (it != e->second.begin())
+                {
+                    --it;
+                    if (it->first == at)
+                    {
+                        ++stats_.hits_;
+                        return it->second;
+                    }
+                    base_ts = it->first;
+                    base = it->second;
+                }
+            }
+        }
+
+        // Wrapped as in Engine::runFrom() so snapshots include forming higher-timeframe bars.
+        std::optional<strategy::TimeframeFeed> feed;
+        if (!strat.timeframes().empty())
+            feed.emplace(strat);
+        strategy::IStrategy& fed = feed ? static_cast<strategy::IStrategy&>(*feed) : strat;
+
+        const auto BY_TS = [](const Quote& q, std::int64_t ts) { return q.ts_ < ts; };
+        auto first = bars.begin();
+        if (base)
+        {
+            strategy::StateReader in{*base};
+            fed.loadState(in);
+            first = std::lower_bound(bars.begin(), bars.end(), base_ts, BY_TS);
+        }
+        else
+        {
+            fed.onStart();
+        }
+        const auto LAST = std::lower_bound(first, bars.end(), at, BY_TS);
+        for (auto it = first; it != LAST; ++it)
+            (void) fed.onBar(*it);
+
+        strategy::StateWriter out;
+        fed.saveState(out);
+        auto snap = std::make_shared<const State>(out.release());
+
+        std::lock_guard lock{mutex_};
+        ++(base ? stats_.extended_ : stats_.misses_);
+        stats_.bars_fed_ += static_cast<std::size_t>(LAST - first);
+        auto& snaps = entries_[key];
+        if (auto it = snaps.find(at); it != snaps.end())
+            return it->second;
+        insert(key, at, snap);
+        return snap;
+    }
+
+    void WarmupCache::insert(const WarmupKey& key, std::int64_t at,
+                             std::shared_ptr<const State> state)
+    {
+        entries_[key].emplace(at, std::move(state));
+        order_.emplace_back(key, at);
+        while (order_.size() > max_snapshots_)
+        {
+            const auto& [old_key, old_ts] = order_.front();
+            if (auto e = entries_.find(old_key); e != entries_.end())
+            {
+                e->second.erase(old_ts);
+                if (e->second.empty())
+                    entries_.erase(e);
+            }
+            order_.pop_front();
+        }
+    }
+
+    std::shared_ptr<const WarmupCache::State> WarmupCache::find(const WarmupKey& key,
+                                                                std::int64_t at) const
+    {
+        std::lock_guard lock{mutex_};
+        if (auto e = entries_.find(key); e != entries_.end())
+            if (auto it = e->second.find(at); it != e->second.end())
+                return it->second;
+        return nullptr;
+    }
+
+    std::size_t WarmupCache::size() const
+    {
+        std::lock_guard lock{mutex_};
+        return order_.size();
+    }
+
+    WarmupStats WarmupCache::stats() const
+    {
+        std::lock_guard lock{mutex_};
+        return stats_;
+    }
+
+    void WarmupCache::clear()
+    {
+        std::lock_guard lock{mutex_};
+        entries_.clear();
+        order_.clear();
+        stats_ = {};
+    }
+
+} // namespace qga::domain::backtest
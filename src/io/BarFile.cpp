@@ -0,0 +1,67 @@
+#include "io/BarFile.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "domain/backtest/WarmupCache.hpp"
+
+namespace qga::io
+{
+
+    namespace
+    {
+        static_assert(std::is_trivially_copyable_v<domain::Quote>);
+
+        constexpr std::uint32_t MAGIC = 0x46424751; // "QGBF"
+        constexpr std::uint32_t VERSION = 2;        // 2: header hash is seriesFingerprint()
+
+        struct Header
+        {
+            std::uint32_t magic_;
+            std::uint32_t version_;
+            std::uint32_t record_size_;
+            std::uint32_t reserved_;
+            std::uint64_t count_;
+            std::uint64_t hash_;
+        };
+        static_assert(sizeof(Header) == 32);
+    } // namespace
+
+    void writeBarFile(const std::filesystem::path& path, std::span<const domain::Quote> bars)
+    {
+        const Header H{MAGIC, VERSION,     sizeof(domain::Quote),
+                       0,     bars.size(), domain::backtest::seriesFingerprint(bars)};
+
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write(reinterpret_cast<const char*>(&H), sizeof(H));
+        f.write(reinterpret_cast<const char*>(bars.data()),
+                static_cast<std::streamsize>(bars.size_bytes()));
+        if (!f)
+            throw std::runtime_error("writeBarFile: cannot write " + path.string());
+    }
+
+    MappedBarFile::MappedBarFile(const std::filesystem::path& path, bool verify) : file_(path)
+    {
+        const auto BYTES = file_.bytes();
+        Header h{};
+        if (BYTES.size() < sizeof(h))
+            throw std::runtime_error("MappedBarFile: truncated header in " + path.string());
+        std::memcpy(&h, BYTES.data(), sizeof(h));
+        if (h.magic_ != MAGIC)
+            throw std::runtime_error("MappedBarFile: not a bar file: " + path.string());
+        if (h.version_ != VERSION || h.record_size_ != sizeof(domain::Quote))
+            throw std::runtime_error("MappedBarFile: incompatible bar file: " + path.string());
+        if ((BYTES.size() - sizeof(h)) / sizeof(domain::Quote) < h.count_)
+            throw std::runtime_error("MappedBarFile: truncated bar data in " + path.string());
+
+        // The header is 32 bytes and mappings are page-aligned, so the records are aligned.
+        const auto* first = BYTES.data() + sizeof(h);
+        bars_ = {reinterpret_cast<const domain::Quote*>(first), static_cast<std::size_t>(h.count_)};
+        if (verify && domain::backtest::seriesFingerprint(bars_) != h.hash_)
+            throw std::runtime_error("MappedBarFile: checksum mismatch in " + path.string());
+        hash_ = h.hash_;
+    }
+
+} // namespace qga::io
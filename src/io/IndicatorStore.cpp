@@ -0,0 +1,212 @@
+#include "io/IndicatorStore.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "io/MappedFile.hpp"
+
+namespace qga::io
+{
+
+    namespace
+    {
+        using strategy::indicators::IndicatorHandle;
+        using strategy::indicators::IndicatorKey;
+
+        constexpr std::uint32_t MAGIC = 0x43494751; // "QGIC"
+        // 2: SMA columns from the streaming Sma (bit-exact)
+        // 3: series keyed by seriesFingerprint() instead of a byte hash
+        constexpr std::uint32_t VERSION = 3;
+        constexpr const char* EXTENSION = ".qgi";
+
+        struct Header
+        {
+            std::uint32_t magic_;
+            std::uint32_t version_;
+            std::uint32_t kind_;
+            std::uint32_t reserved_;
+            std::uint64_t period_;
+            std::uint64_t count_;
+            std::uint64_t series_;
+            std::int64_t first_ts_;
+            std::int64_t last_ts_;
+            std::uint64_t reserved2_;
+        };
+        static_assert(sizeof(Header) == 64);
+
+        Header headerFor(const IndicatorKey& key, std::span<const domain::Quote> bars) noexcept
+        {
+            return {MAGIC,
+                    VERSION,
+                    static_cast<std::uint32_t>(key.kind_),
+                    0,
+                    key.period_,
+                    bars.size(),
+                    key.series_,
+                    bars.empty() ? 0 : bars.front().ts_,
+                    bars.empty() ? 0 : bars.back().ts_,
+                    0};
+        }
+
+        /// "<kind>-p<period>-" shared by every version of one column.
+        std::string columnPrefix(const IndicatorKey& key)
+        {
+            return fmt::format("{}-p{}-", strategy::indicators::toString(key.kind_), key.period_);
+        }
+
+        bool isColumnFile(const std::filesystem::directory_entry& e)
+        {
+            return e.is_regular_file() && e.path().extension() == EXTENSION;
+        }
+
+        /// Maps @p path if it holds the column described by @p expected; empty handle otherwise.
+        IndicatorHandle tryMap(const std::filesystem::path& path, const Header& expected)
+        {
+            auto file = std::make_shared<MappedFile>(path);
+            const auto BYTES = file->bytes();
+            Header h{};
+            if (BYTES.size() < sizeof(h))
+                return {};
+            std::memcpy(&h, BYTES.data(), sizeof(h));
+            if (std::memcmp(&h, &expected, sizeof(h)) != 0
+                || (BYTES.size() - sizeof(h)) / sizeof(double) < h.count_)
+                return {};
+            // 64-byte header on a page-aligned mapping: the values are aligned.
+            const auto* values = reinterpret_cast<const double*>(BYTES.data() + sizeof(h));
+            return IndicatorHandle{std::shared_ptr<const void>{file, values},
+                                   {values, static_cast<std::size_t>(h.count_)}};
+        }
+
+        void writeColumn(const std::filesystem::path& path, const Header& h,
+                         const std::vector<double>& values)
+        {
+            // Unique temporary name, then an atomic rename: readers never see a partial file.
+            thread_local std::mt19937_64 rng{
+                std::random_device{}()
+                ^ static_cast<std::uint64_t>(
+                    std::chrono::steady_clock::now().time_since_epoch().count())};
+            auto tmp = path;
+            tmp += fmt::format(".{:016x}.tmp", rng());
+            {
+                std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+                f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+                f.write(reinterpret_cast<const char*>(values.data()),
+                        static_cast<std::streamsize>(values.size() * sizeof(double)));
+                if (!f)
+                {
+                    std::error_code ec;
+                    f.close();
+                    std::filesystem::remove(tmp, ec);
+                    throw std::runtime_error("IndicatorStore: cannot write " + path.string());
+                }
+            }
+            std::error_code ec;
+            std::filesystem::rename(tmp, path, ec);
+            if (ec)
+            {
+                std::filesystem::remove(tmp, ec);
+                throw std::runtime_error("IndicatorStore: cannot write " + path.string());
+            }
+        }
+    } // namespace
+
+    IndicatorStore::IndicatorStore(std::filesystem::path dir) : dir_(std::move(dir))
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(dir_, ec);
+        if (ec || !std::filesystem::is_directory(dir_))
+            throw std::runtime_error("IndicatorStore: cannot create " + dir_.string());
+    }
+
+    std::filesystem::path IndicatorStore::directoryFor(const std::filesystem::path& dataset)
+    {
+        auto dir = dataset;
+        dir += ".indicators";
+        return dir;
+    }
+
+    std::filesystem::path IndicatorStore::pathFor(const IndicatorKey& key) const
+    {
+        return dir_ / fmt::format("{}{:016x}{}", columnPrefix(key), key.series_, EXTENSION);
+    }
+
+    IndicatorHandle IndicatorStore::get(const IndicatorKey& key,
+                                        std::span<const domain::Quote> bars)
+    {
+        if (key.period_ == 0)
+            throw std::invalid_argument("IndicatorStore: period must be > 0");
+
+        const auto PATH = pathFor(key);
+        const Header H = headerFor(key, bars);
+        std::error_code ec;
+        if (std::filesystem::exists(PATH, ec))
+        {
+            try
+            {
+                if (auto mapped = tryMap(PATH, H))
+                {
+                    ++loaded_;
+                    return mapped;
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                // Unreadable file: recompute and replace it.
+            }
+            ++invalidated_;
+        }
+
+        auto values = std::make_shared<const std::vector<double>>(
+            strategy::indicators::computeIndicator(key.kind_, key.period_, bars));
+        writeColumn(PATH, H, *values);
+        ++computed_;
+
+        // Versions of this column for other content are stale now.
+        const auto PREFIX = columnPrefix(key);
+        for (const auto& e : std::filesystem::directory_iterator(dir_, ec))
+        {
+            const auto NAME = e.path().filename().string();
+            if (isColumnFile(e) && e.path() != PATH && NAME.starts_with(PREFIX)
+                && std::filesystem::remove(e.path(), ec))
+                ++invalidated_;
+        }
+        return IndicatorHandle{std::move(values)};
+    }
+
+    std::size_t IndicatorStore::prune(std::uint64_t series)
+    {
+        const auto SUFFIX = fmt::format("-{:016x}{}", series, EXTENSION);
+        std::size_t removed = 0;
+        std::error_code ec;
+        for (const auto& e : std::filesystem::directory_iterator(dir_, ec))
+        {
+            if (isColumnFile(e) && !e.path().filename().string().ends_with(SUFFIX)
+                && std::filesystem::remove(e.path(), ec))
+                ++removed;
+        }
+        invalidated_ += removed;
+        return removed;
+    }
+
+    strategy::indicators::IndicatorCache::ColumnSource IndicatorStore::source()
+    {
+        return [this](const IndicatorKey& key, std::span<const domain::Quote> bars)
+        { return get(key, bars); };
+    }
+
+    IndicatorStoreStats IndicatorStore::stats() const noexcept
+    {
+        return {loaded_.load(), computed_.load(), invalidated_.load()};
+    }
+
+} // namespace qga::io
@@ -0,0 +1,90 @@
+#include "io/MappedFile.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace qga::io
+{
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+#if !defined(_WIN32)
+        const int FD = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (FD < 0)
+            throw std::runtime_error("MappedFile: cannot open " + path.string());
+        struct stat st = {};
+        if (::fstat(FD, &st) != 0)
+        {
+            ::close(FD);
+            throw std::runtime_error("MappedFile: cannot stat " + path.string());
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0)
+        {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, FD, 0);
+            if (p == MAP_FAILED)
+            {
+                ::close(FD);
+                throw std::runtime_error("MappedFile: cannot map " + path.string());
+            }
+            data_ = static_cast<const std::uint8_t*>(p);
+            mapped_ = true;
+        }
+        ::close(FD); // the mapping keeps the file referenced
+#else
+        std::ifstream f(path, std::ios::binary);
+        if (!f)
+            throw std::runtime_error("MappedFile: cannot open " + path.string());
+        buffer_.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+    }
+
+    MappedFile::~MappedFile() { release(); }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+          mapped_(std::exchange(other.mapped_, false)), buffer_(std::move(other.buffer_))
+    {
+        if (!mapped_ && !buffer_.empty())
+            data_ = buffer_.data();
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            mapped_ = std::exchange(other.mapped_, false);
+            buffer_ = std::move(other.buffer_);
+            if (!mapped_ && !buffer_.empty())
+                data_ = buffer_.data();
+        }
+        return *this;
+    }
+
+    void MappedFile::release() noexcept
+    {
+#if !defined(_WIN32)
+        if (mapped_)
+            ::munmap(const_cast<std::uint8_t*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        buffer_.clear();
+    }
+
+} // namespace qga::io
@@ -1,4 +1,5 @@
 #include "strategy/BuyHold.hpp"
+#include "strategy/StateBlob.hpp"
 
 
 namespace qga::strategy {
@@ -15,4 +16,8 @@ namespace qga::strategy {
 
   void BuyHold::onFinish() {}
 
+  void BuyHold::saveState(StateWriter& out) const { out.put(has_bought_); }
+
+  void BuyHold::loadState(StateReader& in) { has_bought_ = in.get<bool>(); }
+
 } // namespace qga::strategy
@@ -0,0 +1,54 @@
+#include "strategy/CrossSectionalMomentum.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+#include "strategy/Ranker.hpp"
+
+namespace qga::strategy
+{
+
+    CrossSectionalMomentum::CrossSectionalMomentum(std::size_t lookback, std::size_t long_k,
+                                                   std::size_t short_k, std::size_t period,
+                                                   bool reversal)
+        : lookback_(lookback), long_k_(long_k), short_k_(short_k), period_(period),
+          reversal_(reversal)
+    {
+        if (lookback_ == 0)
+            throw std::invalid_argument("CrossSectionalMomentum: lookback must be >= 1");
+        if (period_ == 0)
+            throw std::invalid_argument("CrossSectionalMomentum: period must be >= 1");
+        if (long_k_ == 0 && short_k_ == 0)
+            throw std::invalid_argument("CrossSectionalMomentum: nothing to hold");
+    }
+
+    bool CrossSectionalMomentum::targetWeights(const CrossSection& slice, std::span<double> weights,
+                                               Ranker& ranker)
+    {
+        const std::size_t ROW = slice.row();
+        if (ROW < lookback_ || (ROW - lookback_) % period_ != 0)
+            return false;
+
+        // Scores live in the output span until the selection is made; NaN marks unranked symbols.
+        const auto NOW = slice.close();
+        const auto THEN = slice.close(lookback_);
+        const double SIGN = reversal_ ? -1.0 : 1.0;
+        for (std::size_t s = 0; s < weights.size(); ++s)
+            weights[s] = SIGN * (NOW[s] / THEN[s] - 1.0);
+
+        const auto LONG = ranker.top(weights, long_k_);
+        // A symbol is long or short, never both: when fewer than long_k + short_k are ranked
+        // the shorts take what the longs left.
+        for (const auto S : LONG)
+            weights[S] = std::numeric_limits<double>::quiet_NaN();
+        const auto SHORT = ranker.bottom(weights, short_k_);
+        for (double& w : weights)
+            w = 0.0;
+        for (const auto S : LONG)
+            weights[S] += 1.0 / static_cast<double>(LONG.size());
+        for (const auto S : SHORT)
+            weights[S] -= 1.0 / static_cast<double>(SHORT.size());
+        return true;
+    }
+
+} // namespace qga::strategy
@@ -0,0 +1,31 @@
+#include "strategy/EqualWeight.hpp"
+
+#include <stdexcept>
+
+namespace qga::strategy
+{
+
+    EqualWeight::EqualWeight(std::size_t period) : period_(period)
+    {
+        if (period_ == 0)
+            throw std::invalid_argument("EqualWeight: period must be >= 1");
+    }
+
+    void EqualWeight::onStart(std::size_t) { row_ = 0; }
+
+    bool EqualWeight::targetWeights(std::int64_t, std::span<const double> prices,
+                                    std::span<double> weights)
+    {
+        if (row_++ % period_ != 0)
+            return false;
+
+        std::size_t priced = 0;
+        for (double p : prices)
+            priced += (p == p);
+        const double W = priced > 0 ? 1.0 / static_cast<double>(priced) : 0.0;
+        for (std::size_t s = 0; s < prices.size(); ++s)
+            weights[s] = prices[s] == prices[s] ? W : 0.0;
+        return true;
+    }
+
+} // namespace qga::strategy
@@ -1,32 +1,57 @@
 #include "strategy/MACrossover.hpp"
-#include <limits>
+#include "strategy/StateBlob.hpp"
 #include <cmath>
+#include <stdexcept>
+#include <utility>
 
 namespace qga::strategy {
 
-  static double updateWindow(std::deque<double>& w, double& sum, int win, double px) {
-    w.push_back(px);
-    sum += px;
-    if ((int)w.size() > win) { sum -= w.front(); w.pop_front(); }
-    if ((int)w.size() == win) return sum / win;
-    return std::numeric_limits<double>::quiet_NaN();
+  static std::size_t checkedPeriod(int period) {
+    if (period <= 0) throw std::invalid_argument("MACrossover: periods must be > 0");
+    return static_cast<std::size_t>(period);
   }
 
   qga::strategy::MACrossover::MACrossover(int fast, int slow)
-    : fast_period_(fast), slow_period_(slow) {}
+    : fast_period_(fast), slow_period_(slow),
+      sma_fast_(checkedPeriod(fast)), sma_slow_(checkedPeriod(slow)) {}
+
+  MACrossover::MACrossover(int fast, int slow,
+                           indicators::IndicatorHandle fast_sma,
+                           indicators::IndicatorHandle slow_sma,
+                           std::span<const domain::Quote> bars)
+    : MACrossover(fast, slow) {
+    if (!fast_sma || !slow_sma) throw std::invalid_argument("MACrossover: empty indicator handle");
+    if (fast_sma.size() != bars.size() || slow_sma.size() != bars.size())
+      throw std::invalid_argument("MACrossover: indicator columns do not match the series length");
+    fast_col_ = std::move(fast_sma);
+    slow_col_ = std::move(slow_sma);
+    src_ = bars;
+  }
+
+  MACrossover::MACrossover(indicators::IndicatorCache& cache, std::uint64_t series,
+                           std::span<const domain::Quote> bars, int fast, int slow)
+    : MACrossover(fast, slow,
+                  cache.get({series, indicators::IndicatorKind::Sma, checkedPeriod(fast)}, bars),
+                  cache.get({series, indicators::IndicatorKind::Sma, checkedPeriod(slow)}, bars),
+                  bars) {}
 
   void MACrossover::MACrossover::onStart() {
-    w_fast_.clear(); w_slow_.clear();
-    sum_fast_ = sum_slow_ = 0.0;
+    sma_fast_.reset(); sma_slow_.reset();
     prev_fast_ = prev_slow_ = 0.0;
     ready_ = false;
+    bar_ = 0;
   }
 
   qga::strategy::Signal MACrossover::onBar(const domain::Quote& q) {
-    const double CLOSE = q.close_;
+    const bool CACHED = static_cast<bool>(fast_col_);
+    if (CACHED && bar_ >= fast_col_.size())
+      throw std::out_of_range("MACrossover: more bars than cached indicator values");
+    if (CACHED && q.ts_ != src_[bar_].ts_)
+      throw std::invalid_argument(
+          "MACrossover: bar is not from the series of the cached indicators");
 
-    const double SMA_F = updateWindow(w_fast_, sum_fast_, fast_period_, CLOSE);
-    const double SMA_S = updateWindow(w_slow_, sum_slow_, slow_period_, CLOSE);
+    const double SMA_F = CACHED ? fast_col_[bar_]   : sma_fast_.update(q.close_);
+    const double SMA_S = CACHED ? slow_col_[bar_++] : sma_slow_.update(q.close_);
 
     if (!std::isfinite(SMA_F) || !std::isfinite(SMA_S)) return Signal::None;
 
@@ -50,4 +75,28 @@ namespace qga::strategy {
 
   void MACrossover::onFinish() {}
 
+  void MACrossover::saveState(StateWriter& out) const {
+    out.put(fast_period_);
+    out.put(slow_period_);
+    sma_fast_.save(out);
+    sma_slow_.save(out);
+    out.put(prev_fast_);
+    out.put(prev_slow_);
+    out.put(ready_);
+    if (fast_col_) out.put(static_cast<std::uint64_t>(bar_));
+  }
+
+  void MACrossover::loadState(StateReader& in) {
+    const int FAST = in.get<int>();
+    const int SLOW = in.get<int>();
+    if (FAST != fast_period_ || SLOW != slow_period_)
+      throw std::invalid_argument("MACrossover::loadState: period mismatch");
+    sma_fast_.load(in);
+    sma_slow_.load(in);
+    prev_fast_ = in.get<double>();
+    prev_slow_ = in.get<double>();
+    ready_     = in.get<bool>();
+    if (fast_col_) bar_ = static_cast<std::size_t>(in.get<std::uint64_t>());
+  }
+
 } // namespace qga::strategy
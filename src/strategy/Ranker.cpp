@@ -0,0 +1,52 @@
+#include "strategy/Ranker.hpp"
+
+#include <algorithm>
+
+namespace qga::strategy
+{
+
+    template <bool HIGH>
+    std::span<const std::uint32_t> Ranker::select(std::span<const double> scores, std::size_t k,
+                                                  std::vector<std::uint32_t>& out)
+    {
+        // Compact the finite scores without branching on the data.
+        if (scored_.size() < scores.size())
+            scored_.resize(scores.size());
+        std::size_t m = 0;
+        for (std::size_t i = 0; i < scores.size(); ++i)
+        {
+            const double S = scores[i];
+            scored_[m] = {S, static_cast<std::uint32_t>(i)};
+            m += (S == S);
+        }
+
+        const auto BETTER = [](const Scored& a, const Scored& b)
+        {
+            if (a.score_ != b.score_)
+                return HIGH ? a.score_ > b.score_ : a.score_ < b.score_;
+            return a.column_ < b.column_;
+        };
+        k = std::min(k, m);
+        const auto FIRST = scored_.begin();
+        if (k < m)
+            std::nth_element(FIRST, FIRST + static_cast<std::ptrdiff_t>(k),
+                             FIRST + static_cast<std::ptrdiff_t>(m), BETTER);
+        std::sort(FIRST, FIRST + static_cast<std::ptrdiff_t>(k), BETTER);
+
+        out.resize(k);
+        for (std::size_t i = 0; i < k; ++i)
+            out[i] = scored_[i].column_;
+        return out;
+    }
+
+    std::span<const std::uint32_t> Ranker::top(std::span<const double> scores, std::size_t k)
+    {
+        return select<true>(scores, k, top_);
+    }
+
+    std::span<const std::uint32_t> Ranker::bottom(std::span<const double> scores, std::size_t k)
+    {
+        return select<false>(scores, k, bottom_);
+    }
+
+} // namespace qga::strategy
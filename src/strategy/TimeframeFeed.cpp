@@ -0,0 +1,52 @@
+#include "strategy/TimeframeFeed.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "strategy/StateBlob.hpp"
+
+namespace qga::strategy
+{
+
+    TimeframeFeed::TimeframeFeed(IStrategy& inner) : inner_(inner)
+    {
+        for (const Timeframe& tf : inner.timeframes())
+            resamplers_.emplace_back(tf);
+    }
+
+    void TimeframeFeed::onStart()
+    {
+        for (auto& r : resamplers_)
+            r.reset();
+        inner_.onStart();
+    }
+
+    Signal TimeframeFeed::onBar(const domain::Quote& q)
+    {
+        for (std::size_t i = 0; i < resamplers_.size(); ++i)
+            resamplers_[i].update(q,
+                                  [&](const domain::Quote& bar) { inner_.onTimeframeBar(i, bar); });
+        return inner_.onBar(q);
+    }
+
+    void TimeframeFeed::onFinish() { inner_.onFinish(); }
+
+    void TimeframeFeed::saveState(StateWriter& out) const
+    {
+        out.put<std::uint64_t>(resamplers_.size());
+        for (const auto& r : resamplers_)
+            r.save(out);
+        inner_.saveState(out);
+    }
+
+    void TimeframeFeed::loadState(StateReader& in)
+    {
+        if (in.get<std::uint64_t>() != resamplers_.size())
+            throw std::invalid_argument(
+                "TimeframeFeed::loadState: state has a different number of timeframes");
+        for (auto& r : resamplers_)
+            r.load(in);
+        inner_.loadState(in);
+    }
+
+} // namespace qga::strategy
@@ -0,0 +1,247 @@
+// ColumnKernel.inl — bodies of the whole-column indicator kernels.
+//
+// Included once per instruction set by ColumnKernels.cpp, inside a namespace
+// that defines `Ops` (vector width, register/mask types and primitive
+// operations) and, for SIMD targets, inside a `#pragma ... target(...)`
+// region. The scalar tail of every loop continues the same recurrence.
+
+/// Inclusive prefix sum across the lanes of @p v.
+inline Ops::V scanAdd(Ops::V v)
+{
+    if constexpr (Ops::W >= 2)
+        v = Ops::add(v, Ops::shift1(v));
+    if constexpr (Ops::W >= 4)
+        v = Ops::add(v, Ops::shift2(v));
+    if constexpr (Ops::W >= 8)
+        v = Ops::add(v, Ops::shift4(v));
+    return v;
+}
+
+/// Number of outputs between two directly summed anchors.
+inline std::size_t blockSize(std::size_t period)
+{
+    return std::max<std::size_t>(4096, 8 * period);
+}
+
+inline void smaKernel(const double* x, std::size_t n, std::size_t p, double* out)
+{
+    using V = Ops::V;
+    constexpr std::size_t W = Ops::W;
+    const double P = static_cast<double>(p);
+    const V PV = Ops::set1(P);
+
+    for (std::size_t i = 0; i + 1 < p && i < n; ++i)
+        out[i] = std::numeric_limits<double>::quiet_NaN();
+
+    const std::size_t BLOCK = blockSize(p);
+    for (std::size_t b = p - 1; b < n; b += BLOCK)
+    {
+        const std::size_t END = std::min(n, b + BLOCK);
+        double s = 0.0;
+        for (std::size_t k = b + 1 - p; k <= b; ++k)
+            s += x[k];
+        out[b] = s / P;
+
+        std::size_t i = b + 1;
+        V run = Ops::set1(s);
+        for (; i + W <= END; i += W)
+        {
+            const V D = Ops::sub(Ops::loadu(x + i), Ops::loadu(x + i - p));
+            run = Ops::add(scanAdd(D), Ops::broadcastLast(run));
+            Ops::storeu(out + i, Ops::div(run, PV));
+        }
+        s = Ops::last(run);
+        for (; i < END; ++i)
+        {
+            s += x[i] - x[i - p];
+            out[i] = s / P;
+        }
+    }
+}
+
+inline void emaKernel(const double* x, std::size_t n, std::size_t p, double* out)
+{
+    using V = Ops::V;
+    constexpr std::size_t W = Ops::W;
+    const double ALPHA = 2.0 / (static_cast<double>(p) + 1.0);
+    const double C = 1.0 - ALPHA;
+
+    // Seed exactly as Ema does: running sum, divided on the period-th value.
+    double y = 0.0;
+    for (std::size_t i = 0; i < p && i < n; ++i)
+    {
+        if (i + 1 < p)
+        {
+            y += x[i];
+            out[i] = std::numeric_limits<double>::quiet_NaN();
+        }
+        else
+        {
+            y = (y + x[i]) / static_cast<double>(p);
+            out[i] = y;
+        }
+    }
+    if (n <= p)
+        return;
+
+    // Lane k of a step holds C^(k+1), the weight of the previous output.
+    double pow[W];
+    double c = C;
+    for (std::size_t k = 0; k < W; ++k, c *= C)
+        pow[k] = c;
+    const V POW = Ops::loadu(pow);
+    const V A = Ops::set1(ALPHA);
+    const V C1 = Ops::set1(C);
+    const V C2 = Ops::set1(C * C);
+    const V C4 = Ops::set1(C * C * C * C);
+
+    std::size_t i = p;
+    V prev = Ops::set1(y);
+    for (; i + W <= n; i += W)
+    {
+        V u = Ops::mul(A, Ops::loadu(x + i));
+        if constexpr (W >= 2)
+            u = Ops::add(u, Ops::mul(C1, Ops::shift1(u)));
+        if constexpr (W >= 4)
+            u = Ops::add(u, Ops::mul(C2, Ops::shift2(u)));
+        if constexpr (W >= 8)
+            u = Ops::add(u, Ops::mul(C4, Ops::shift4(u)));
+        const V Y = Ops::add(u, Ops::mul(POW, prev));
+        Ops::storeu(out + i, Y);
+        prev = Ops::broadcastLast(Y);
+    }
+    y = Ops::last(prev);
+    for (; i < n; ++i)
+    {
+        y += ALPHA * (x[i] - y);
+        out[i] = y;
+    }
+}
+
+inline void stdDevKernel(const double* x, std::size_t n, std::size_t p, double* out)
+{
+    using V = Ops::V;
+    constexpr std::size_t W = Ops::W;
+    const double P = static_cast<double>(p);
+    const V PV = Ops::set1(P);
+    const V ZERO = Ops::set1(0.0);
+    const auto SD = [P](double s, double q) { return std::sqrt(std::max(0.0, (q - s * s / P) / P)); };
+
+    for (std::size_t i = 0; i + 1 < p && i < n; ++i)
+        out[i] = std::numeric_limits<double>::quiet_NaN();
+
+    const std::size_t BLOCK = blockSize(p);
+    for (std::size_t b = p - 1; b < n; b += BLOCK)
+    {
+        const std::size_t END = std::min(n, b + BLOCK);
+        const double K = x[b];
+        double s = 0.0;
+        double q = 0.0;
+        for (std::size_t k = b + 1 - p; k <= b; ++k)
+        {
+            const double D = x[k] - K;
+            s += D;
+            q += D * D;
+        }
+        out[b] = SD(s, q);
+
+        const V KV = Ops::set1(K);
+        V run_s = Ops::set1(s);
+        V run_q = Ops::set1(q);
+        std::size_t i = b + 1;
+        for (; i + W <= END; i += W)
+        {
+            const V IN = Ops::sub(Ops::loadu(x + i), KV);
+            const V OUT = Ops::sub(Ops::loadu(x + i - p), KV);
+            const V DS = Ops::sub(IN, OUT);
+            const V DQ = Ops::mul(DS, Ops::add(IN, OUT));
+            run_s = Ops::add(scanAdd(DS), Ops::broadcastLast(run_s));
+            run_q = Ops::add(scanAdd(DQ), Ops::broadcastLast(run_q));
+            const V VAR = Ops::div(Ops::sub(run_q, Ops::div(Ops::mul(run_s, run_s), PV)), PV);
+            Ops::storeu(out + i, Ops::sqrt(Ops::max(ZERO, VAR)));
+        }
+        s = Ops::last(run_s);
+        q = Ops::last(run_q);
+        for (; i < END; ++i)
+        {
+            const double IN = x[i] - K;
+            const double OUT = x[i - p] - K;
+            s += IN - OUT;
+            q += (IN - OUT) * (IN + OUT);
+            out[i] = SD(s, q);
+        }
+    }
+}
+
+/// van Herk / Gil-Werman over period-aligned blocks. @p suffix holds `period + 1` doubles.
+template <bool MAX>
+void extremumKernel(const double* x, std::size_t n, std::size_t p, double* out, double* suffix)
+{
+    using V = Ops::V;
+    constexpr std::size_t W = Ops::W;
+    const auto BEST = [](double a, double b) { return MAX ? std::max(a, b) : std::min(a, b); };
+
+    // Prefix extrema of the first block; its last one covers the first full window.
+    for (std::size_t i = 0; i < std::min(n, p); ++i)
+        out[i] = i == 0 ? x[0] : BEST(out[i - 1], x[i]);
+
+    // Window [i - p + 1, i] = tail of the previous block (suffix extremum)
+    // + head of the current block (prefix extremum). The slot past the
+    // suffix is neutral, for the window that is exactly the current block.
+    suffix[p] = MAX ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+    for (std::size_t b = p; b < n; b += p)
+    {
+        const std::size_t END = std::min(n, b + p);
+        suffix[p - 1] = x[b - 1];
+        for (std::size_t j = p - 1; j > 0; --j)
+            suffix[j - 1] = BEST(suffix[j], x[b - p + j - 1]);
+        out[b] = x[b];
+        for (std::size_t i = b + 1; i < END; ++i)
+            out[i] = BEST(out[i - 1], x[i]);
+
+        const double* tail = suffix + 1;  // tail[i - b] = extremum of x[i - p + 1, b)
+        std::size_t i = b;
+        for (; i + W <= END; i += W)
+        {
+            const V H = Ops::loadu(tail + (i - b));
+            const V G = Ops::loadu(out + i);
+            Ops::storeu(out + i, MAX ? Ops::max(H, G) : Ops::min(H, G));
+        }
+        for (; i < END; ++i)
+            out[i] = BEST(tail[i - b], out[i]);
+    }
+    for (std::size_t k = 0; k + 1 < p && k < n; ++k)
+        out[k] = std::numeric_limits<double>::quiet_NaN();
+}
+
+/// Signals from index @p first + 1 on; both columns are finite from @p first.
+inline void crossoverKernel(const double* f, const double* s, std::size_t first, std::size_t n, Signal* out)
+{
+    using V = Ops::V;
+    using M = Ops::M;
+    constexpr std::size_t W = Ops::W;
+    const V NONE = Ops::set1(static_cast<double>(static_cast<int>(Signal::None)));
+    const V BUY = Ops::set1(static_cast<double>(static_cast<int>(Signal::Buy)));
+    const V SELL = Ops::set1(static_cast<double>(static_cast<int>(Signal::Sell)));
+
+    std::size_t i = first + 1;
+    for (; i + W <= n; i += W)
+    {
+        const V PF = Ops::loadu(f + i - 1);
+        const V PS = Ops::loadu(s + i - 1);
+        const V CF = Ops::loadu(f + i);
+        const V CS = Ops::loadu(s + i);
+        const M UP = Ops::mAnd(Ops::cmpLe(PF, PS), Ops::cmpGt(CF, CS));
+        const M DOWN = Ops::mAnd(Ops::cmpGe(PF, PS), Ops::cmpLt(CF, CS));
+        Ops::storeSignals(out + i, Ops::select(UP, BUY, Ops::select(DOWN, SELL, NONE)));
+    }
+    for (; i < n; ++i)
+    {
+        if (f[i - 1] <= s[i - 1] && f[i] > s[i])
+            out[i] = Signal::Buy;
+        else if (f[i - 1] >= s[i - 1] && f[i] < s[i])
+            out[i] = Signal::Sell;
+        else
+            out[i] = Signal::None;
+    }
+}
@@ -0,0 +1,330 @@
+#include "strategy/indicators/ColumnKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define QGA_COLUMN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace qga::strategy::indicators::columns
+{
+
+    namespace
+    {
+        static_assert(sizeof(Signal) == sizeof(std::int32_t), "signals are stored as 32-bit lanes");
+
+        // ============================================================
+        // Scalar fallback
+        // ============================================================
+        namespace scalar
+        {
+            struct Ops
+            {
+                using V = double;
+                using M = bool;
+                static constexpr std::size_t W = 1;
+
+                static V set1(double v) { return v; }
+                static V loadu(const double* p) { return *p; }
+                static void storeu(double* p, V v) { *p = v; }
+                static V add(V a, V b) { return a + b; }
+                static V sub(V a, V b) { return a - b; }
+                static V mul(V a, V b) { return a * b; }
+                static V div(V a, V b) { return a / b; }
+                static V max(V a, V b) { return std::max(a, b); }
+                static V min(V a, V b) { return std::min(a, b); }
+                static V sqrt(V a) { return std::sqrt(a); }
+                static M cmpLt(V a, V b) { return a < b; }
+                static M cmpLe(V a, V b) { return a <= b; }
+                static M cmpGt(V a, V b) { return a > b; }
+                static M cmpGe(V a, V b) { return a >= b; }
+                static M mAnd(M a, M b) { return a && b; }
+                static V select(M m, V t, V f) { return m ? t : f; }
+                // Lane shifts towards higher lanes; a single lane has nothing to shift in.
+                static V shift1(V) { return 0.0; }
+                static V shift2(V) { return 0.0; }
+                static V shift4(V) { return 0.0; }
+                static V broadcastLast(V v) { return v; }
+                static double last(V v) { return v; }
+                static void storeSignals(Signal* p, V code)
+                {
+                    *p = static_cast<Signal>(static_cast<int>(code));
+                }
+            };
+
+#include "ColumnKernel.inl"
+        } // namespace scalar
+
+#if defined(QGA_COLUMN_X86)
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+        // ============================================================
+        // AVX2 (4 values per step)
+        // ============================================================
+        namespace avx2
+        {
+            struct Ops
+            {
+                using V = __m256d;
+                using M = __m256d;
+                static constexpr std::size_t W = 4;
+
+                static V set1(double v) { return _mm256_set1_pd(v); }
+                static V loadu(const double* p) { return _mm256_loadu_pd(p); }
+                static void storeu(double* p, V v) { _mm256_storeu_pd(p, v); }
+                static V add(V a, V b) { return _mm256_add_pd(a, b); }
+                static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+                static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+                static V div(V a, V b) { return _mm256_div_pd(a, b); }
+                static V max(V a, V b) { return _mm256_max_pd(a, b); }
+                static V min(V a, V b) { return _mm256_min_pd(a, b); }
+                static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+                static M cmpLt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+                static M cmpLe(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+                static M cmpGt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+                static M cmpGe(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+                static M mAnd(M a, M b) { return _mm256_and_pd(a, b); }
+                static V select(M m, V t, V f) { return _mm256_blendv_pd(f, t, m); }
+                static V shift1(V v)
+                {
+                    return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)),
+                                           _mm256_setzero_pd(), 0b0001);
+                }
+                static V shift2(V v)
+                {
+                    return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)),
+                                           _mm256_setzero_pd(), 0b0011);
+                }
+                static V shift4(V) { return _mm256_setzero_pd(); }
+                static V broadcastLast(V v)
+                {
+                    return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3));
+                }
+                static double last(V v) { return _mm256_cvtsd_f64(broadcastLast(v)); }
+                static void storeSignals(Signal* p, V code)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtpd_epi32(code));
+                }
+            };
+
+#include "ColumnKernel.inl"
+        } // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+        // ============================================================
+        // AVX-512 (8 values per step)
+        // ============================================================
+        namespace avx512
+        {
+            // Zero-masked forms where GCC 12 would otherwise warn about the undefined
+            // pass-through operand of the unmasked intrinsic (-Wmaybe-uninitialized).
+            struct Ops
+            {
+                using V = __m512d;
+                using M = __mmask8;
+                static constexpr std::size_t W = 8;
+
+                static V set1(double v) { return _mm512_set1_pd(v); }
+                static V loadu(const double* p) { return _mm512_loadu_pd(p); }
+                static void storeu(double* p, V v) { _mm512_storeu_pd(p, v); }
+                static V add(V a, V b) { return _mm512_add_pd(a, b); }
+                static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+                static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+                static V div(V a, V b) { return _mm512_div_pd(a, b); }
+                static V max(V a, V b) { return _mm512_maskz_max_pd(0xFF, a, b); }
+                static V min(V a, V b) { return _mm512_maskz_min_pd(0xFF, a, b); }
+                static V sqrt(V a) { return _mm512_maskz_sqrt_pd(0xFF, a); }
+                static M cmpLt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+                static M cmpLe(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+                static M cmpGt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+                static M cmpGe(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+                static M mAnd(M a, M b) { return static_cast<M>(a & b); }
+                static V select(M m, V t, V f) { return _mm512_mask_blend_pd(m, f, t); }
+                static V shift1(V v)
+                {
+                    return _mm512_maskz_permutexvar_pd(0xFE,
+                                                       _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0), v);
+                }
+                static V shift2(V v)
+                {
+                    return _mm512_maskz_permutexvar_pd(0xFC,
+                                                       _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0), v);
+                }
+                static V shift4(V v)
+                {
+                    return _mm512_maskz_permutexvar_pd(0xF0,
+                                                       _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0), v);
+                }
+                static V broadcastLast(V v)
+                {
+                    return _mm512_maskz_permutexvar_pd(0xFF, _mm512_set1_epi64(7), v);
+                }
+                static double last(V v) { return _mm512_cvtsd_f64(broadcastLast(v)); }
+                static void storeSignals(Signal* p, V code)
+                {
+                    // exact integer codes
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),
+                                        _mm512_maskz_cvttpd_epi32(0xFF, code));
+                }
+            };
+
+#include "ColumnKernel.inl"
+        } // namespace avx512
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // QGA_COLUMN_X86
+
+        using WindowFn = void (*)(const double*, std::size_t, std::size_t, double*);
+        using ExtremumFn = void (*)(const double*, std::size_t, std::size_t, double*, double*);
+        using CrossFn = void (*)(const double*, const double*, std::size_t, std::size_t, Signal*);
+
+        /// Kernels compiled for one instruction set.
+        struct KernelSet
+        {
+            WindowFn sma_;
+            WindowFn ema_;
+            WindowFn std_dev_;
+            ExtremumFn max_;
+            ExtremumFn min_;
+            CrossFn crossover_;
+        };
+
+        const KernelSet& kernelsFor(core::SimdLevel level) noexcept
+        {
+            static const KernelSet SCALAR{&scalar::smaKernel,
+                                          &scalar::emaKernel,
+                                          &scalar::stdDevKernel,
+                                          &scalar::extremumKernel<true>,
+                                          &scalar::extremumKernel<false>,
+                                          &scalar::crossoverKernel};
+#if defined(QGA_COLUMN_X86)
+            static const KernelSet AVX2{&avx2::smaKernel,
+                                        &avx2::emaKernel,
+                                        &avx2::stdDevKernel,
+                                        &avx2::extremumKernel<true>,
+                                        &avx2::extremumKernel<false>,
+                                        &avx2::crossoverKernel};
+            static const KernelSet AVX512{&avx512::smaKernel,
+                                          &avx512::emaKernel,
+                                          &avx512::stdDevKernel,
+                                          &avx512::extremumKernel<true>,
+                                          &avx512::extremumKernel<false>,
+                                          &avx512::crossoverKernel};
+            switch (core::clampSimdLevel(level))
+            {
+            case core::SimdLevel::Avx512:
+                return AVX512;
+            case core::SimdLevel::Avx2:
+                return AVX2;
+            default:
+                break;
+            }
+#else
+            (void) level;
+#endif
+            return SCALAR;
+        }
+
+        void checkArgs(std::size_t in, std::size_t out, std::size_t period, const char* who)
+        {
+            if (period == 0)
+                throw std::invalid_argument(std::string(who) + ": period must be > 0");
+            if (in != out)
+                throw std::invalid_argument(std::string(who) + ": input and output sizes differ");
+        }
+
+        void extremum(std::span<const double> x, std::size_t period, std::span<double> out,
+                      ExtremumFn fn)
+        {
+            std::vector<double> suffix(period + 1);
+            fn(x.data(), x.size(), period, out.data(), suffix.data());
+        }
+    } // namespace
+
+    void sma(std::span<const double> x, std::size_t period, std::span<double> out,
+             core::SimdLevel level)
+    {
+        checkArgs(x.size(), out.size(), period, "columns::sma");
+        kernelsFor(level).sma_(x.data(), x.size(), period, out.data());
+    }
+
+    void ema(std::span<const double> x, std::size_t period, std::span<double> out,
+             core::SimdLevel level)
+    {
+        checkArgs(x.size(), out.size(), period, "columns::ema");
+        kernelsFor(level).ema_(x.data(), x.size(), period, out.data());
+    }
+
+    void rollingStdDev(std::span<const double> x, std::size_t period, std::span<double> out,
+                       core::SimdLevel level)
+    {
+        checkArgs(x.size(), out.size(), period, "columns::rollingStdDev");
+        if (period == 1)
+        {
+            std::fill(out.begin(), out.end(), 0.0); // the scanned moments would only add noise
+            return;
+        }
+        kernelsFor(level).std_dev_(x.data(), x.size(), period, out.data());
+    }
+
+    void rollingMax(std::span<const double> x, std::size_t period, std::span<double> out,
+                    core::SimdLevel level)
+    {
+        checkArgs(x.size(), out.size(), period, "columns::rollingMax");
+        extremum(x, period, out, kernelsFor(level).max_);
+    }
+
+    void rollingMin(std::span<const double> x, std::size_t period, std::span<double> out,
+                    core::SimdLevel level)
+    {
+        checkArgs(x.size(), out.size(), period, "columns::rollingMin");
+        extremum(x, period, out, kernelsFor(level).min_);
+    }
+
+    void crossover(std::span<const double> fast, std::span<const double> slow,
+                   std::span<Signal> out, core::SimdLevel level)
+    {
+        if (fast.size() != slow.size() || fast.size() != out.size())
+            throw std::invalid_argument("columns::crossover: column sizes differ");
+
+        std::size_t first = 0;
+        while (first < fast.size() && !(std::isfinite(fast[first]) && std::isfinite(slow[first])))
+            ++first;
+        std::fill(out.begin(),
+                  out.begin() + static_cast<std::ptrdiff_t>(std::min(first + 1, out.size())),
+                  Signal::None);
+        if (first < fast.size())
+            kernelsFor(level).crossover_(fast.data(), slow.data(), first, fast.size(), out.data());
+    }
+
+} // namespace qga::strategy::indicators::columns
@@ -0,0 +1,227 @@
+#include "strategy/indicators/IndicatorCache.hpp"
+
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include "strategy/indicators/ColumnKernels.hpp"
+#include "strategy/indicators/Indicators.hpp"
+
+namespace qga::strategy::indicators
+{
+
+    namespace
+    {
+        /// Feeds every close to a streaming indicator.
+        template <class Ind>
+        std::vector<double> streamCloses(Ind ind, std::span<const domain::Quote> bars)
+        {
+            ind.reset();
+            std::vector<double> out;
+            out.reserve(bars.size());
+            for (const auto& q : bars)
+                out.push_back(ind.update(q.close_));
+            return out;
+        }
+    } // namespace
+
+    const char* toString(IndicatorKind kind) noexcept
+    {
+        switch (kind)
+        {
+        case IndicatorKind::Sma:
+            return "sma";
+        case IndicatorKind::Ema:
+            return "ema";
+        case IndicatorKind::Wma:
+            return "wma";
+        case IndicatorKind::Rsi:
+            return "rsi";
+        case IndicatorKind::Atr:
+            return "atr";
+        case IndicatorKind::StdDev:
+            return "stddev";
+        case IndicatorKind::Max:
+            return "max";
+        case IndicatorKind::Min:
+            return "min";
+        }
+        return "unknown";
+    }
+
+    std::vector<double> computeIndicator(IndicatorKind kind, std::size_t period,
+                                         std::span<const domain::Quote> bars)
+    {
+        if (period == 0)
+            throw std::invalid_argument("computeIndicator: period must be > 0");
+
+        switch (kind)
+        {
+        case IndicatorKind::Sma:
+            return streamCloses(Sma{period}, bars);
+        case IndicatorKind::Wma:
+            return streamCloses(Wma{period}, bars);
+        case IndicatorKind::Rsi:
+            return streamCloses(Rsi{period}, bars);
+        case IndicatorKind::Atr:
+        {
+            Atr atr{period};
+            atr.reset();
+            std::vector<double> out;
+            out.reserve(bars.size());
+            for (const auto& q : bars)
+                out.push_back(atr.update(q));
+            return out;
+        }
+        default:
+            break;
+        }
+
+        std::vector<double> closes(bars.size());
+        for (std::size_t i = 0; i < bars.size(); ++i)
+            closes[i] = bars[i].close_;
+        std::vector<double> out(bars.size());
+        switch (kind)
+        {
+        case IndicatorKind::Ema:
+            columns::ema(closes, period, out);
+            break;
+        case IndicatorKind::StdDev:
+            columns::rollingStdDev(closes, period, out);
+            break;
+        case IndicatorKind::Max:
+            columns::rollingMax(closes, period, out);
+            break;
+        case IndicatorKind::Min:
+            columns::rollingMin(closes, period, out);
+            break;
+        default:
+            throw std::invalid_argument("computeIndicator: unknown indicator");
+        }
+        return out;
+    }
+
+    IndicatorCache::IndicatorCache(std::size_t budget_bytes, ColumnSource source)
+        : budget_(budget_bytes), source_(std::move(source))
+    {
+        if (budget_ == 0)
+            throw std::invalid_argument("IndicatorCache: budget must be > 0");
+        if (!source_)
+            source_ = [](const IndicatorKey& key, std::span<const domain::Quote> bars)
+            {
+                return IndicatorHandle{std::make_shared<const std::vector<double>>(
+                    computeIndicator(key.kind_, key.period_, bars))};
+            };
+    }
+
+    IndicatorHandle IndicatorCache::get(const IndicatorKey& key,
+                                        std::span<const domain::Quote> bars)
+    {
+        std::promise<IndicatorHandle> promise;
+        std::uint64_t id = 0;
+        {
+            std::unique_lock lock{mutex_};
+            if (auto it = entries_.find(key); it != entries_.end())
+            {
+                ++stats_.hits_;
+                lru_.splice(lru_.begin(), lru_, it->second.lru_);
+                auto pending = it->second.column_;
+                lock.unlock();
+                return pending.get(); // waits while the column is in flight
+            }
+            ++stats_.misses_;
+            id = ++next_id_;
+            lru_.push_front(key);
+            entries_.emplace(key, Entry{promise.get_future().share(), lru_.begin(), id, 0, false});
+        }
+
+        IndicatorHandle column;
+        try
+        {
+            column = source_(key, bars);
+            if (!column)
+                throw std::runtime_error("IndicatorCache: source returned no column");
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard lock{mutex_};
+                if (auto it = entries_.find(key); it != entries_.end() && it->second.id_ == id)
+                {
+                    lru_.erase(it->second.lru_);
+                    entries_.erase(it);
+                }
+            }
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+        promise.set_value(column);
+
+        std::lock_guard lock{mutex_};
+        if (auto it = entries_.find(key); it != entries_.end() && it->second.id_ == id)
+        {
+            it->second.bytes_ = column.size() * sizeof(double);
+            it->second.ready_ = true;
+            bytes_ += it->second.bytes_;
+            evictOverBudget();
+        }
+        return column;
+    }
+
+    void IndicatorCache::evictOverBudget()
+    {
+        // Oldest first; columns in flight are skipped.
+        auto it = lru_.end();
+        while (bytes_ > budget_ && it != lru_.begin())
+        {
+            --it;
+            const auto E = entries_.find(*it);
+            if (!E->second.ready_)
+                continue;
+            bytes_ -= E->second.bytes_;
+            ++stats_.evictions_;
+            entries_.erase(E);
+            it = lru_.erase(it);
+        }
+    }
+
+    IndicatorHandle IndicatorCache::find(const IndicatorKey& key) const
+    {
+        std::lock_guard lock{mutex_};
+        const auto IT = entries_.find(key);
+        if (IT == entries_.end() || !IT->second.ready_)
+            return {};
+        return IT->second.column_.get();
+    }
+
+    std::size_t IndicatorCache::size() const
+    {
+        std::lock_guard lock{mutex_};
+        std::size_t n = 0;
+        for (const auto& [key, e] : entries_)
+            n += e.ready_ ? 1 : 0;
+        return n;
+    }
+
+    std::size_t IndicatorCache::bytes() const
+    {
+        std::lock_guard lock{mutex_};
+        return bytes_;
+    }
+
+    IndicatorCacheStats IndicatorCache::stats() const
+    {
+        std::lock_guard lock{mutex_};
+        return stats_;
+    }
+
+    void IndicatorCache::clear()
+    {
+        std::lock_guard lock{mutex_};
+        entries_.clear();
+        lru_.clear();
+        bytes_ = 0;
+        stats_ = {};
+    }
+
+} // namespace qga::strategy::indicators
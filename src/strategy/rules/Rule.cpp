@@ -0,0 +1,872 @@
+#include "strategy/rules/Rule.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "strategy/StateBlob.hpp"
+
+namespace qga::strategy::rules
+{
+
+    namespace
+    {
+        constexpr std::uint32_t NONE = 0; ///< Placeholder operand of nodes with fewer operands.
+
+        bool isWindow(Op op) noexcept { return op >= Op::Lag; }
+
+        const char* opName(Op op) noexcept
+        {
+            switch (op)
+            {
+            case Op::Const:
+                return "const";
+            case Op::Open:
+                return "open";
+            case Op::High:
+                return "high";
+            case Op::Low:
+                return "low";
+            case Op::Close:
+                return "close";
+            case Op::Volume:
+                return "volume";
+            case Op::Neg:
+                return "neg";
+            case Op::Abs:
+                return "abs";
+            case Op::Add:
+                return "add";
+            case Op::Sub:
+                return "sub";
+            case Op::Mul:
+                return "mul";
+            case Op::Div:
+                return "div";
+            case Op::Lt:
+                return "lt";
+            case Op::Le:
+                return "le";
+            case Op::Eq:
+                return "eq";
+            case Op::Ne:
+                return "ne";
+            case Op::And:
+                return "and";
+            case Op::Or:
+                return "or";
+            case Op::Not:
+                return "not";
+            case Op::CrossAbove:
+                return "crosses_above";
+            case Op::CrossBelow:
+                return "crosses_below";
+            case Op::Lag:
+                return "lag";
+            case Op::Sma:
+                return "sma";
+            case Op::Ema:
+                return "ema";
+            case Op::Wma:
+                return "wma";
+            case Op::StdDev:
+                return "stddev";
+            case Op::Highest:
+                return "highest";
+            case Op::Lowest:
+                return "lowest";
+            case Op::Rsi:
+                return "rsi";
+            case Op::Atr:
+                return "atr";
+            }
+            return "?";
+        }
+
+        /// Number of node operands of @p op.
+        int arity(Op op) noexcept
+        {
+            if (op <= Op::Volume || op == Op::Atr)
+                return 0;
+            if (op == Op::Neg || op == Op::Abs || op == Op::Not || isWindow(op))
+                return 1;
+            return 2;
+        }
+
+        // ------------------------------------------------------------
+        // DAG construction: hash-consing, normalisation, folding
+        // ------------------------------------------------------------
+        class Builder
+        {
+          public:
+            std::uint32_t add(Node n, bool boolean)
+            {
+                switch (n.op_)
+                {
+                case Op::Add:
+                case Op::Mul:
+                case Op::Eq:
+                case Op::Ne:
+                case Op::And:
+                case Op::Or:
+                    if (n.a_ > n.b_)
+                        std::swap(n.a_, n.b_);
+                    break;
+                default:
+                    break;
+                }
+                if (auto it = index_.find(n); it != index_.end())
+                    return it->second;
+                const auto ID = static_cast<std::uint32_t>(nodes_.size());
+                nodes_.push_back(n);
+                boolean_.push_back(boolean);
+                index_.emplace(n, ID);
+                return ID;
+            }
+
+            std::uint32_t constant(double v) { return add({Op::Const, NONE, NONE, 0, v}, false); }
+
+            const Node& operator[](std::uint32_t id) const noexcept { return nodes_[id]; }
+            bool isBool(std::uint32_t id) const noexcept { return boolean_[id]; }
+            bool isConst(std::uint32_t id) const noexcept { return nodes_[id].op_ == Op::Const; }
+
+            /// Reachable nodes, renumbered densely in topological order.
+            std::vector<Node> compact(std::uint32_t& buy, std::uint32_t& sell) const
+            {
+                std::vector<char> live(nodes_.size(), 0);
+                live[buy] = live[sell] = 1;
+                for (std::size_t i = nodes_.size(); i-- > 0;)
+                {
+                    if (!live[i])
+                        continue;
+                    const int N = arity(nodes_[i].op_);
+                    if (N >= 1)
+                        live[nodes_[i].a_] = 1;
+                    if (N >= 2)
+                        live[nodes_[i].b_] = 1;
+                }
+                std::vector<std::uint32_t> remap(nodes_.size(), 0);
+                std::vector<Node> out;
+                for (std::size_t i = 0; i < nodes_.size(); ++i)
+                {
+                    if (!live[i])
+                        continue;
+                    Node n = nodes_[i];
+                    const int N = arity(n.op_);
+                    n.a_ = N >= 1 ? remap[n.a_] : NONE;
+                    n.b_ = N >= 2 ? remap[n.b_] : NONE;
+                    remap[i] = static_cast<std::uint32_t>(out.size());
+                    out.push_back(n);
+                }
+                buy = remap[buy];
+                sell = remap[sell];
+                return out;
+            }
+
+          private:
+            std::vector<Node> nodes_;
+            std::vector<bool> boolean_;
+            std::map<Node, std::uint32_t> index_;
+        };
+
+        // ------------------------------------------------------------
+        // Recursive-descent parser
+        // ------------------------------------------------------------
+        class Parser
+        {
+          public:
+            Parser(std::string_view text, Builder& b) : text_(text), b_(b) {}
+
+            /// Parses the whole text as a boolean expression.
+            std::uint32_t rule()
+            {
+                const std::size_t START = skip();
+                const auto ID = orExpr();
+                if (skip() != text_.size())
+                    fail("unexpected '" + std::string{text_.substr(pos_, 1)} + "'");
+                if (!b_.isBool(ID))
+                    fail("rule must be a condition, not a number", START);
+                return ID;
+            }
+
+          private:
+            [[noreturn]] void fail(const std::string& what, std::size_t at) const
+            {
+                throw std::invalid_argument(fmt::format("rule: {} at column {}", what, at + 1));
+            }
+            [[noreturn]] void fail(const std::string& what) const { fail(what, pos_); }
+
+            std::size_t skip() noexcept
+            {
+                while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_])))
+                    ++pos_;
+                return pos_;
+            }
+
+            static bool identChar(char c) noexcept
+            {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+            }
+
+            /// Consumes @p sym if it comes next (keywords must end at a word boundary).
+            bool accept(std::string_view sym)
+            {
+                skip();
+                if (text_.substr(pos_, sym.size()) != sym)
+                    return false;
+                const std::size_t END = pos_ + sym.size();
+                if (identChar(sym.back()) && END < text_.size() && identChar(text_[END]))
+                    return false;
+                pos_ = END;
+                return true;
+            }
+
+            void expect(std::string_view sym)
+            {
+                if (!accept(sym))
+                    fail("expected '" + std::string{sym} + "'");
+            }
+
+            std::uint32_t numeric(std::uint32_t id, std::size_t at)
+            {
+                if (b_.isBool(id))
+                    fail("expected a number, found a condition", at);
+                return id;
+            }
+
+            std::uint32_t boolean(std::uint32_t id, std::size_t at)
+            {
+                if (!b_.isBool(id))
+                    fail("expected a condition, found a number", at);
+                return id;
+            }
+
+            std::uint32_t orExpr()
+            {
+                const std::size_t AT = skip();
+                auto lhs = andExpr();
+                while (accept("or") || accept("||"))
+                {
+                    const std::size_t RHS_AT = skip();
+                    const auto RHS = andExpr();
+                    lhs = b_.add({Op::Or, boolean(lhs, AT), boolean(RHS, RHS_AT)}, true);
+                }
+                return lhs;
+            }
+
+            std::uint32_t andExpr()
+            {
+                const std::size_t AT = skip();
+                auto lhs = notExpr();
+                while (accept("and") || accept("&&"))
+                {
+                    const std::size_t RHS_AT = skip();
+                    const auto RHS = notExpr();
+                    lhs = b_.add({Op::And, boolean(lhs, AT), boolean(RHS, RHS_AT)}, true);
+                }
+                return lhs;
+            }
+
+            std::uint32_t notExpr()
+            {
+                if (accept("not") || (!lookingAt("!=") && accept("!")))
+                {
+                    const std::size_t AT = skip();
+                    return b_.add({Op::Not, boolean(notExpr(), AT)}, true);
+                }
+                return compare();
+            }
+
+            bool lookingAt(std::string_view sym)
+            {
+                skip();
+                return text_.substr(pos_, sym.size()) == sym;
+            }
+
+            std::uint32_t compare()
+            {
+                const std::size_t AT = skip();
+                const auto LHS = sum();
+                Op op;
+                bool swap = false;
+                if (accept("crosses"))
+                {
+                    if (accept("above"))
+                        op = Op::CrossAbove;
+                    else if (accept("below"))
+                        op = Op::CrossBelow;
+                    else
+                        fail("expected 'above' or 'below'");
+                }
+                else if (accept("<="))
+                    op = Op::Le;
+                else if (accept(">="))
+                    op = Op::Le, swap = true;
+                else if (accept("=="))
+                    op = Op::Eq;
+                else if (accept("!="))
+                    op = Op::Ne;
+                else if (accept("<"))
+                    op = Op::Lt;
+                else if (accept(">"))
+                    op = Op::Lt, swap = true;
+                else
+                    return LHS;
+
+                const std::size_t RHS_AT = skip();
+                auto a = numeric(LHS, AT);
+                auto b = numeric(sum(), RHS_AT);
+                if (swap)
+                    std::swap(a, b);
+                return b_.add({op, a, b}, true);
+            }
+
+            std::uint32_t sum()
+            {
+                const std::size_t AT = skip();
+                auto lhs = product();
+                for (;;)
+                {
+                    Op op;
+                    if (accept("+"))
+                        op = Op::Add;
+                    else if (accept("-"))
+                        op = Op::Sub;
+                    else
+                        return lhs;
+                    const std::size_t RHS_AT = skip();
+                    lhs = arithmetic(op, numeric(lhs, AT), numeric(product(), RHS_AT));
+                }
+            }
+
+            std::uint32_t product()
+            {
+                const std::size_t AT = skip();
+                auto lhs = unary();
+                for (;;)
+                {
+                    Op op;
+                    if (accept("*"))
+                        op = Op::Mul;
+                    else if (accept("/"))
+                        op = Op::Div;
+                    else
+                        return lhs;
+                    const std::size_t RHS_AT = skip();
+                    lhs = arithmetic(op, numeric(lhs, AT), numeric(unary(), RHS_AT));
+                }
+            }
+
+            std::uint32_t arithmetic(Op op, std::uint32_t a, std::uint32_t b)
+            {
+                if (b_.isConst(a) && b_.isConst(b))
+                {
+                    const double X = b_[a].value_, Y = b_[b].value_;
+                    switch (op)
+                    {
+                    case Op::Add:
+                        return b_.constant(X + Y);
+                    case Op::Sub:
+                        return b_.constant(X - Y);
+                    case Op::Mul:
+                        return b_.constant(X * Y);
+                    default:
+                        if (Y != 0.0)
+                            return b_.constant(X / Y);
+                    }
+                }
+                return b_.add({op, a, b}, false);
+            }
+
+            std::uint32_t unary()
+            {
+                if (accept("-"))
+                {
+                    const std::size_t AT = skip();
+                    const auto A = numeric(unary(), AT);
+                    return b_.isConst(A) ? b_.constant(-b_[A].value_) : b_.add({Op::Neg, A}, false);
+                }
+                return primary();
+            }
+
+            std::uint32_t primary()
+            {
+                const std::size_t AT = skip();
+                if (pos_ == text_.size())
+                    fail("unexpected end of rule");
+                if (accept("("))
+                {
+                    const auto ID = orExpr();
+                    expect(")");
+                    return ID;
+                }
+
+                const char C = text_[pos_];
+                if (std::isdigit(static_cast<unsigned char>(C)) || C == '.')
+                {
+                    double v = 0.0;
+                    const auto [END, EC] =
+                        std::from_chars(text_.data() + pos_, text_.data() + text_.size(), v);
+                    if (EC != std::errc{})
+                        fail("malformed number");
+                    pos_ = static_cast<std::size_t>(END - text_.data());
+                    return b_.constant(v);
+                }
+                if (!identChar(C))
+                    fail("unexpected '" + std::string(1, C) + "'");
+
+                std::size_t end = pos_;
+                while (end < text_.size() && identChar(text_[end]))
+                    ++end;
+                const std::string_view NAME = text_.substr(pos_, end - pos_);
+                pos_ = end;
+
+                static const std::map<std::string_view, Op> FIELDS{{"open", Op::Open},
+                                                                   {"high", Op::High},
+                                                                   {"low", Op::Low},
+                                                                   {"close", Op::Close},
+                                                                   {"volume", Op::Volume}};
+                if (const auto IT = FIELDS.find(NAME); IT != FIELDS.end())
+                    return b_.add({IT->second}, false);
+                return call(NAME, AT);
+            }
+
+            /// Parses "(args)" after a function name.
+            std::uint32_t call(std::string_view name, std::size_t at)
+            {
+                static const std::map<std::string_view, Op> WINDOWS{
+                    {"sma", Op::Sma},       {"ema", Op::Ema},         {"wma", Op::Wma},
+                    {"stddev", Op::StdDev}, {"highest", Op::Highest}, {"lowest", Op::Lowest},
+                    {"lag", Op::Lag},       {"rsi", Op::Rsi},         {"atr", Op::Atr},
+                    {"abs", Op::Abs}};
+                const auto IT = WINDOWS.find(name);
+                if (IT == WINDOWS.end())
+                    fail("unknown name '" + std::string{name} + "'", at);
+                const Op OP = IT->second;
+
+                expect("(");
+                std::vector<std::pair<std::uint32_t, std::size_t>> args;
+                if (!accept(")"))
+                {
+                    do
+                    {
+                        const std::size_t ARG_AT = skip();
+                        args.emplace_back(numeric(orExpr(), ARG_AT), ARG_AT);
+                    } while (accept(","));
+                    expect(")");
+                }
+
+                if (OP == Op::Abs)
+                {
+                    if (args.size() != 1)
+                        fail("abs takes one argument", at);
+                    const auto A = args[0].first;
+                    return b_.isConst(A) ? b_.constant(std::abs(b_[A].value_))
+                                         : b_.add({Op::Abs, A}, false);
+                }
+                if (OP == Op::Atr)
+                {
+                    if (args.size() != 1)
+                        fail("atr takes one argument: atr(n)", at);
+                    return b_.add({Op::Atr, NONE, NONE, period(args[0])}, false);
+                }
+                if (OP == Op::Rsi && args.size() == 1)
+                    args.insert(args.begin(), {b_.add({Op::Close}, false), at});
+                if (args.size() != 2)
+                    fail(fmt::format("{} takes two arguments: {}(x, n)", name, name), at);
+                return b_.add({OP, args[0].first, NONE, period(args[1])}, false);
+            }
+
+            std::size_t period(const std::pair<std::uint32_t, std::size_t>& arg)
+            {
+                const double V = b_.isConst(arg.first) ? b_[arg.first].value_ : 0.0;
+                if (!b_.isConst(arg.first) || V < 1.0 || V != std::floor(V) || V > 1e9)
+                    fail("period must be a positive integer constant", arg.second);
+                return static_cast<std::size_t>(V);
+            }
+
+            std::string_view text_;
+            Builder& b_;
+            std::size_t pos_ = 0;
+        };
+
+        bool blank(std::string_view text) noexcept
+        {
+            return text.find_first_not_of(" \t\r\n") == std::string_view::npos;
+        }
+
+        // ------------------------------------------------------------
+        // Block kernels
+        // ------------------------------------------------------------
+        template <class Fn>
+        void binary(double* y, const double* a, const double* b, std::size_t n, Fn fn) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                y[i] = fn(a[i], b[i]);
+        }
+
+        /// Runs a streaming indicator over a block. The indicator is moved into a local for
+        /// the loop so its scalars stay in registers instead of being reloaded after each store.
+        template <class Ind>
+        void window(Ind& ind, double* y, const double* a, std::size_t n) noexcept
+        {
+            if (n == 1)
+            {
+                y[0] = ind.update(a[0]); // streaming: not worth the moves
+                return;
+            }
+            Ind local = std::move(ind);
+            for (std::size_t i = 0; i < n; ++i)
+                y[i] = local.update(a[i]);
+            ind = std::move(local);
+        }
+
+        double truth(bool v) noexcept { return v ? 1.0 : 0.0; }
+    } // namespace
+
+    // ------------------------------------------------------------
+    // Rule
+    // ------------------------------------------------------------
+    Rule Rule::compile(std::string_view buy, std::string_view sell)
+    {
+        Builder b;
+        Rule r;
+        r.buy_ = blank(buy) ? 0 : Parser{buy, b}.rule();
+        r.sell_ = blank(sell) ? 0 : Parser{sell, b}.rule();
+        // An empty side never fires. Added last, so the constant's type cannot leak into parsing.
+        const auto NEVER = b.constant(0.0);
+        if (blank(buy))
+            r.buy_ = NEVER;
+        if (blank(sell))
+            r.sell_ = NEVER;
+        r.nodes_ = b.compact(r.buy_, r.sell_);
+        return r;
+    }
+
+    std::string Rule::toString() const
+    {
+        std::string out;
+        for (std::size_t i = 0; i < nodes_.size(); ++i)
+        {
+            const Node& n = nodes_[i];
+            out += fmt::format("n{} = ", i);
+            const int N = arity(n.op_);
+            if (n.op_ == Op::Const)
+                out += fmt::format("{}", n.value_);
+            else if (n.op_ == Op::Atr)
+                out += fmt::format("atr({})", n.period_);
+            else if (N == 0)
+                out += opName(n.op_);
+            else if (isWindow(n.op_))
+                out += fmt::format("{}(n{}, {})", opName(n.op_), n.a_, n.period_);
+            else if (N == 1)
+                out += fmt::format("{}(n{})", opName(n.op_), n.a_);
+            else
+                out += fmt::format("{}(n{}, n{})", opName(n.op_), n.a_, n.b_);
+            if (i == buy_)
+                out += "  ; buy";
+            if (i == sell_)
+                out += "  ; sell";
+            out += '\n';
+        }
+        return out;
+    }
+
+    void Rule::run(RuleState& state, std::span<const domain::Quote> bars,
+                   std::span<Signal> out) const
+    {
+        if (state.rule_ != this)
+            throw std::invalid_argument("Rule::run: state belongs to another rule");
+        if (bars.size() != out.size())
+            throw std::invalid_argument("Rule::run: bars and signals differ in size");
+
+        double* const values = state.values_.data();
+        const auto COL = [values](std::uint32_t id) noexcept
+        { return values + std::size_t{id} * BLOCK; };
+
+        for (std::size_t first = 0; first < bars.size(); first += BLOCK)
+        {
+            const std::size_t N = std::min(BLOCK, bars.size() - first);
+            const domain::Quote* q = bars.data() + first;
+
+            for (std::size_t id = 0; id < nodes_.size(); ++id)
+            {
+                const Node& node = nodes_[id];
+                double* y = COL(static_cast<std::uint32_t>(id));
+                const double* a = COL(node.a_);
+                const double* b = COL(node.b_);
+                auto& w = state.windows_[id];
+
+                switch (node.op_)
+                {
+                case Op::Const:
+                    break; // filled once by RuleState
+                case Op::Open:
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = q[i].open_;
+                    break;
+                case Op::High:
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = q[i].high_;
+                    break;
+                case Op::Low:
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = q[i].low_;
+                    break;
+                case Op::Close:
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = q[i].close_;
+                    break;
+                case Op::Volume:
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = q[i].volume_;
+                    break;
+                case Op::Neg:
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = -a[i];
+                    break;
+                case Op::Abs:
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = std::abs(a[i]);
+                    break;
+                case Op::Not:
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = truth(a[i] == 0.0);
+                    break;
+                case Op::Add:
+                    binary(y, a, b, N, [](double x, double z) { return x + z; });
+                    break;
+                case Op::Sub:
+                    binary(y, a, b, N, [](double x, double z) { return x - z; });
+                    break;
+                case Op::Mul:
+                    binary(y, a, b, N, [](double x, double z) { return x * z; });
+                    break;
+                case Op::Div:
+                    binary(y, a, b, N, [](double x, double z) { return x / z; });
+                    break;
+                case Op::Lt:
+                    binary(y, a, b, N, [](double x, double z) { return truth(x < z); });
+                    break;
+                case Op::Le:
+                    binary(y, a, b, N, [](double x, double z) { return truth(x <= z); });
+                    break;
+                case Op::Eq:
+                    binary(y, a, b, N, [](double x, double z) { return truth(x == z); });
+                    break;
+                case Op::Ne:
+                    binary(y, a, b, N, [](double x, double z) { return truth(x != z); });
+                    break;
+                case Op::And:
+                    binary(y, a, b, N,
+                           [](double x, double z) { return truth(x != 0.0 && z != 0.0); });
+                    break;
+                case Op::Or:
+                    binary(y, a, b, N,
+                           [](double x, double z) { return truth(x != 0.0 || z != 0.0); });
+                    break;
+                case Op::CrossAbove:
+                case Op::CrossBelow:
+                {
+                    // Previous values live in registers across the block, not in the state.
+                    auto& prev = std::get<RuleState::Cross>(w);
+                    double pa = prev.a_, pb = prev.b_;
+                    if (node.op_ == Op::CrossAbove)
+                        for (std::size_t i = 0; i < N; ++i)
+                        {
+                            const double A = a[i], B = b[i];
+                            y[i] = truth(pa <= pb && A > B);
+                            pa = A;
+                            pb = B;
+                        }
+                    else
+                        for (std::size_t i = 0; i < N; ++i)
+                        {
+                            const double A = a[i], B = b[i];
+                            y[i] = truth(pa >= pb && A < B);
+                            pa = A;
+                            pb = B;
+                        }
+                    prev = {pa, pb};
+                    break;
+                }
+                case Op::Lag:
+                {
+                    auto& ring = std::get<indicators::RingBuffer<double>>(w);
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        const bool FULL = ring.full();
+                        const double OLD = ring.push_back(a[i]);
+                        y[i] = FULL ? OLD : std::nan("");
+                    }
+                    break;
+                }
+                case Op::Sma:
+                    window(std::get<indicators::Sma>(w), y, a, N);
+                    break;
+                case Op::Ema:
+                    window(std::get<indicators::Ema>(w), y, a, N);
+                    break;
+                case Op::Wma:
+                    window(std::get<indicators::Wma>(w), y, a, N);
+                    break;
+                case Op::StdDev:
+                    window(std::get<indicators::RollingStdDev>(w), y, a, N);
+                    break;
+                case Op::Highest:
+                    window(std::get<indicators::RollingMax>(w), y, a, N);
+                    break;
+                case Op::Lowest:
+                    window(std::get<indicators::RollingMin>(w), y, a, N);
+                    break;
+                case Op::Rsi:
+                    window(std::get<indicators::Rsi>(w), y, a, N);
+                    break;
+                case Op::Atr:
+                {
+                    auto& atr = std::get<indicators::Atr>(w);
+                    for (std::size_t i = 0; i < N; ++i)
+                        y[i] = atr.update(q[i]);
+                    break;
+                }
+                }
+            }
+
+            const double* buy = COL(buy_);
+            const double* sell = COL(sell_);
+            Signal* s = out.data() + first;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                const bool B = buy[i] != 0.0, S = sell[i] != 0.0;
+                s[i] = B == S ? Signal::None : (B ? Signal::Buy : Signal::Sell);
+            }
+        }
+    }
+
+    std::vector<Signal> Rule::evaluate(std::span<const domain::Quote> bars) const
+    {
+        RuleState state{*this};
+        std::vector<Signal> out(bars.size());
+        run(state, bars, out);
+        return out;
+    }
+
+    // ------------------------------------------------------------
+    // RuleState
+    // ------------------------------------------------------------
+    RuleState::RuleState(const Rule& rule)
+        : rule_(&rule), values_(rule.nodes_.size() * Rule::BLOCK, 0.0)
+    {
+        windows_.reserve(rule.nodes_.size());
+        for (std::size_t id = 0; id < rule.nodes_.size(); ++id)
+        {
+            const Node& n = rule.nodes_[id];
+            switch (n.op_)
+            {
+            case Op::Const:
+                std::fill_n(values_.data() + id * Rule::BLOCK, Rule::BLOCK, n.value_);
+                windows_.emplace_back();
+                break;
+            case Op::CrossAbove:
+            case Op::CrossBelow:
+                windows_.emplace_back(Cross{});
+                break;
+            case Op::Lag:
+                windows_.emplace_back(indicators::RingBuffer<double>{});
+                break;
+            case Op::Sma:
+                windows_.emplace_back(indicators::Sma{n.period_});
+                break;
+            case Op::Ema:
+                windows_.emplace_back(indicators::Ema{n.period_});
+                break;
+            case Op::Wma:
+                windows_.emplace_back(indicators::Wma{n.period_});
+                break;
+            case Op::StdDev:
+                windows_.emplace_back(indicators::RollingStdDev{n.period_});
+                break;
+            case Op::Highest:
+                windows_.emplace_back(indicators::RollingMax{n.period_});
+                break;
+            case Op::Lowest:
+                windows_.emplace_back(indicators::RollingMin{n.period_});
+                break;
+            case Op::Rsi:
+                windows_.emplace_back(indicators::Rsi{n.period_});
+                break;
+            case Op::Atr:
+                windows_.emplace_back(indicators::Atr{n.period_});
+                break;
+            default:
+                windows_.emplace_back();
+                break;
+            }
+        }
+        reset();
+    }
+
+    void RuleState::reset()
+    {
+        for (std::size_t id = 0; id < windows_.size(); ++id)
+        {
+            std::visit(
+                [&](auto& w)
+                {
+                    using W = std::decay_t<decltype(w)>;
+                    if constexpr (std::is_same_v<W, Cross>)
+                        w = {std::nan(""), std::nan("")}; // nothing crosses at the first bar
+                    else if constexpr (std::is_same_v<W, indicators::RingBuffer<double>>)
+                        w.reset(rule_->nodes_[id].period_);
+                    else if constexpr (!std::is_same_v<W, std::monostate>)
+                        w.reset();
+                },
+                windows_[id]);
+        }
+    }
+
+    void RuleState::save(StateWriter& out) const
+    {
+        out.put<std::uint64_t>(windows_.size());
+        for (const auto& window : windows_)
+        {
+            std::visit(
+                [&](const auto& w)
+                {
+                    using W = std::decay_t<decltype(w)>;
+                    if constexpr (std::is_same_v<W, Cross>)
+                        out.put(w);
+                    else if constexpr (!std::is_same_v<W, std::monostate>)
+                        w.save(out);
+                },
+                window);
+        }
+    }
+
+    void RuleState::load(StateReader& in)
+    {
+        if (in.get<std::uint64_t>() != windows_.size())
+            throw std::invalid_argument("RuleState::load: state of a different rule");
+        for (auto& window : windows_)
+        {
+            std::visit(
+                [&](auto& w)
+                {
+                    using W = std::decay_t<decltype(w)>;
+                    if constexpr (std::is_same_v<W, Cross>)
+                        w = in.get<Cross>();
+                    else if constexpr (!std::is_same_v<W, std::monostate>)
+                        w.load(in);
+                },
+                window);
+        }
+    }
+
+} // namespace qga::strategy::rules
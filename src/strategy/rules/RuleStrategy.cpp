@@ -0,0 +1,78 @@
+#include "strategy/rules/Rule.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "strategy/StateBlob.hpp"
+
+namespace qga::strategy::rules
+{
+
+    namespace
+    {
+        std::shared_ptr<const Rule> checkedRule(std::shared_ptr<const Rule> rule)
+        {
+            if (!rule)
+                throw std::invalid_argument("RuleStrategy: rule is null");
+            return rule;
+        }
+    } // namespace
+
+    RuleStrategy::RuleStrategy(std::shared_ptr<const Rule> rule)
+        : rule_(checkedRule(std::move(rule))), state_(*rule_)
+    {
+    }
+
+    RuleStrategy::RuleStrategy(std::string_view buy, std::string_view sell)
+        : RuleStrategy(std::make_shared<const Rule>(Rule::compile(buy, sell)))
+    {
+    }
+
+    RuleStrategy::RuleStrategy(std::shared_ptr<const Rule> rule,
+                               std::span<const domain::Quote> bars)
+        : RuleStrategy(std::move(rule))
+    {
+        signals_ = rule_->evaluate(bars);
+        src_ = bars;
+        precomputed_ = true;
+    }
+
+    void RuleStrategy::onStart()
+    {
+        state_.reset();
+        bar_ = 0;
+    }
+
+    Signal RuleStrategy::onBar(const domain::Quote& q)
+    {
+        if (precomputed_)
+        {
+            if (bar_ >= signals_.size())
+                throw std::out_of_range("RuleStrategy: more bars than precomputed signals");
+            if (q.ts_ != src_[bar_].ts_)
+                throw std::invalid_argument(
+                    "RuleStrategy: bar is not from the series of the precomputed signals");
+            return signals_[bar_++];
+        }
+        Signal s = Signal::None;
+        rule_->run(state_, {&q, 1}, {&s, 1});
+        return s;
+    }
+
+    void RuleStrategy::saveState(StateWriter& out) const
+    {
+        if (precomputed_)
+            out.put(static_cast<std::uint64_t>(bar_));
+        else
+            state_.save(out);
+    }
+
+    void RuleStrategy::loadState(StateReader& in)
+    {
+        if (precomputed_)
+            bar_ = static_cast<std::size_t>(in.get<std::uint64_t>());
+        else
+            state_.load(in);
+    }
+
+} // namespace qga::strategy::rules
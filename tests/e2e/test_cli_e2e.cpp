@@ -1,4 +1,10 @@
 #include "doctest.h"
+#include "domain/Quote.hpp"
+#include "io/BarFile.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
@@ -280,3 +286,49 @@ TEST_CASE("E2E: running CLI without --config produces error")
 
     CHECK_MESSAGE(contains_error, "Missing expected error about --config:\n" << out);
 }
+
+TEST_CASE("E2E: cluster worker results do not depend on the indicator store")
+{
+    const auto ROOT = projectRoot();
+    const auto CLI = cliBinaryPath();
+    REQUIRE_MESSAGE(fs::exists(CLI), "CLI binary not found: " << CLI);
+
+    fs::path temp_dir = ROOT / "build" / "e2e_tmp_worker";
+    fs::remove_all(temp_dir);
+    fs::create_directories(temp_dir);
+
+    // Random walk that stalls for 500 bars every 2'000: on flat stretches the averages
+    // tie, so any cached column that is not bit-exact flips crossover signals.
+    std::vector<qga::domain::Quote> bars;
+    const auto CLOSES = testlib::randomWalk(20'000, 7, 0.02);
+    for (std::size_t i = 0; i < CLOSES.size(); ++i)
+    {
+        const double PX = CLOSES[i % 2'000 < 500 ? i - i % 2'000 : i];
+        bars.push_back({static_cast<std::int64_t>(i) * 60'000, PX, PX, PX, PX, 1.0});
+    }
+    const fs::path DATASET = temp_dir / "bars.qgb";
+    qga::io::writeBarFile(DATASET, bars);
+
+    // 19 (fast, slow) pairs
+    const std::string WORKER = "\"" + CLI.string() + "\" --worker-dataset \"" + DATASET.string()
+                               + "\" --worker-tasks 0:19 --fast 5:20:5 --slow 20:100:20";
+    const std::string STORE = " --worker-indicators \"" + (temp_dir / "indicators").string() + "\"";
+
+    int plain_code = 0, cold_code = 0, warm_code = 0;
+    const std::string PLAIN = runCliAndCapture(WORKER, plain_code);
+    // The first run computes and persists the columns, the second maps them.
+    const std::string COLD = runCliAndCapture(WORKER + STORE, cold_code);
+    const std::string WARM = runCliAndCapture(WORKER + STORE, warm_code);
+
+    for (const int CODE : {plain_code, cold_code, warm_code})
+    {
+#ifdef _WIN32
+        CHECK(CODE == 0);
+#else
+        CHECK(WEXITSTATUS(CODE) == 0);
+#endif
+    }
+    CHECK(std::count(PLAIN.begin(), PLAIN.end(), '\n') == 19);
+    CHECK(COLD == PLAIN);
+    CHECK(WARM == PLAIN);
+}
@@ -0,0 +1,72 @@
+#include "doctest.h"
+#include "domain/backtest/WarmupCache.hpp"
+#include "io/BarFile.hpp"
+#include "test_helpers.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace qga::io;
+
+TEST_SUITE("IO/BarFile")
+{
+    TEST_CASE("Bars round-trip through a mapped file")
+    {
+        const auto PATH = std::filesystem::temp_directory_path() / "qga_test_bars.qgb";
+        const auto S = testlib::makeSeries({10.0, 11.5, 9.25, 12.0}, 1'000);
+        writeBarFile(PATH, S.data());
+
+        const MappedBarFile F{PATH};
+        REQUIRE(F.bars().size() == 4);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            CHECK(F.bars()[i].ts_ == S.data()[i].ts_);
+            CHECK(F.bars()[i].close_ == S.data()[i].close_);
+        }
+        CHECK(F.contentHash() == qga::domain::backtest::seriesFingerprint(S.data()));
+
+        MappedFile moved{PATH};
+        const auto SIZE = moved.size();
+        MappedFile other = std::move(moved);
+        CHECK(other.size() == SIZE);
+        CHECK(moved.size() == 0);
+        std::filesystem::remove(PATH);
+    }
+
+    TEST_CASE("Empty series map to an empty span")
+    {
+        const auto PATH = std::filesystem::temp_directory_path() / "qga_test_empty.qgb";
+        writeBarFile(PATH, {});
+        CHECK(MappedBarFile{PATH}.bars().empty());
+        std::filesystem::remove(PATH);
+    }
+
+    TEST_CASE("Foreign, truncated and corrupt files are rejected")
+    {
+        const auto DIR = std::filesystem::temp_directory_path();
+        CHECK_THROWS_AS(MappedBarFile{DIR / "qga_no_such_file.qgb"}, std::runtime_error);
+
+        const auto FOREIGN = DIR / "qga_test_foreign.qgb";
+        std::ofstream(FOREIGN) << "ts,open,high,low,close,volume\n1,2,3,4,5,6\n";
+        CHECK_THROWS_AS(MappedBarFile{FOREIGN}, std::runtime_error);
+
+        const auto PATH = DIR / "qga_test_cut.qgb";
+        writeBarFile(PATH, testlib::makeSeries({1.0, 2.0, 3.0}).data());
+        const auto FULL = std::filesystem::file_size(PATH);
+        std::filesystem::resize_file(PATH, FULL - 8);
+        CHECK_THROWS_AS(MappedBarFile{PATH}, std::runtime_error);
+
+        writeBarFile(PATH, testlib::makeSeries({1.0, 2.0, 3.0}).data());
+        {
+            std::fstream f(PATH, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp(static_cast<std::streamoff>(FULL - 1));
+            f.put('\x7f');
+        }
+        CHECK_THROWS_AS(MappedBarFile{PATH}, std::runtime_error);
+        CHECK_NOTHROW(MappedBarFile(PATH, /*verify=*/false));
+
+        std::filesystem::remove(FOREIGN);
+        std::filesystem::remove(PATH);
+    }
+}
@@ -0,0 +1,158 @@
+#include "doctest.h"
+#include "core/StatisticsKernels.hpp"
+#include "domain/backtest/Engine.hpp"
+#include "strategy/BuyHold.hpp"
+#include "strategy/MACrossover.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace qga::domain::backtest;
+using qga::strategy::Signal;
+
+namespace
+{
+    BarSeries fromCloses(const std::vector<double>& closes)
+    {
+        BarSeries s;
+        for (std::size_t i = 0; i < closes.size(); ++i)
+            s.add({static_cast<std::int64_t>(i), closes[i], closes[i], closes[i], closes[i], 1.0});
+        return s;
+    }
+
+    // Emits a fixed signal per bar.
+    class Scripted final : public qga::strategy::IStrategy
+    {
+      public:
+        explicit Scripted(std::vector<Signal> script) : script_(std::move(script)) {}
+        void onStart() override { bar_ = 0; }
+        Signal onBar(const qga::domain::Quote&) override
+        {
+            return bar_ < script_.size() ? script_[bar_++] : Signal::None;
+        }
+
+      private:
+        std::vector<Signal> script_;
+        std::size_t bar_ = 0;
+    };
+} // namespace
+
+TEST_SUITE("Backtest/Capture")
+{
+    const std::vector<double> CLOSES{100, 110, 105, 90, 95, 120, 130};
+    const std::vector<Signal> SCRIPT{Signal::Buy,  Signal::None, Signal::Sell, Signal::Buy,
+                                     Signal::None, Signal::Sell, Signal::Buy};
+
+    TEST_CASE("None records nothing beyond the summary fields")
+    {
+        Scripted s{SCRIPT};
+        const auto R = Engine{1'000.0}.run(fromCloses(CLOSES), s);
+        CHECK(R.equity_curve_.empty());
+        CHECK(R.returns_.empty());
+        CHECK(R.trades_.empty());
+        CHECK(R.round_trips_ == 0);
+        CHECK(R.sharpe_ == 0.0);
+    }
+
+    TEST_CASE("Capture level does not change the simulation")
+    {
+        const auto S = fromCloses(CLOSES);
+        for (auto level : {CaptureLevel::None, CaptureLevel::Summary, CaptureLevel::Full})
+        {
+            Scripted s{SCRIPT};
+            const auto R = Engine{1'000.0, {2.0, 1.0, 5.0}}.run(S, s, level);
+            Scripted ref{SCRIPT};
+            const auto P = Engine{1'000.0, {2.0, 1.0, 5.0}}.run(S, ref);
+            CHECK(R.final_equity_ == P.final_equity_);
+            CHECK(R.trades_executed_ == P.trades_executed_);
+        }
+    }
+
+    TEST_CASE("Full capture fills per-bar series and the trade log")
+    {
+        Scripted s{SCRIPT};
+        const auto R = Engine{1'000.0}.run(fromCloses(CLOSES), s, CaptureLevel::Full);
+
+        REQUIRE(R.equity_curve_.size() == CLOSES.size());
+        REQUIRE(R.returns_.size() == CLOSES.size());
+        CHECK(R.equity_curve_[1] == doctest::Approx(1'010.0));
+        CHECK(R.returns_[0] == doctest::Approx(0.0));
+        CHECK(R.returns_[1] == doctest::Approx(0.01));
+        for (std::size_t i = 1; i < R.returns_.size(); ++i)
+            CHECK(R.returns_[i]
+                  == doctest::Approx(R.equity_curve_[i] / R.equity_curve_[i - 1] - 1.0));
+
+        // Two closed round trips plus the final close-out of the last entry.
+        REQUIRE(R.trades_.size() == 3);
+        CHECK(R.round_trips_ == 3);
+        CHECK(R.trades_[0].entry_ts_ == 0);
+        CHECK(R.trades_[0].exit_ts_ == 2);
+        CHECK(R.trades_[0].pnl_ == doctest::Approx(5.0));
+        CHECK(R.trades_[1].entry_price_ == doctest::Approx(90.0));
+        CHECK(R.trades_[1].exit_price_ == doctest::Approx(120.0));
+        CHECK(R.trades_[1].return_ == doctest::Approx(30.0 / 90.0));
+        CHECK(R.trades_[2].entry_ts_ == 6);
+        CHECK(R.trades_[2].exit_ts_ == 6);
+        CHECK(R.trades_[2].pnl_ == doctest::Approx(0.0));
+        CHECK(R.hit_ratio_ == doctest::Approx(2.0 / 3.0));
+    }
+
+    TEST_CASE("Full capture preallocates its buffers from the series length")
+    {
+        Scripted s{{}};
+        const auto R = Engine{1'000.0}.run(fromCloses(CLOSES), s, CaptureLevel::Full);
+        CHECK(R.trades_.empty());
+        CHECK(R.equity_curve_.capacity() >= CLOSES.size());
+        CHECK(R.trades_.capacity() >= (CLOSES.size() + 1) / 2);
+    }
+
+    TEST_CASE("Trade P&L includes slippage and both commissions")
+    {
+        const ExecParams EXEC{10.0, 0.5, 20.0};
+        Scripted s{{Signal::Buy, Signal::None, Signal::Sell}};
+        const auto R =
+            Engine{1'000.0, EXEC}.run(fromCloses({100, 105, 110}), s, CaptureLevel::Full);
+        REQUIRE(R.trades_.size() == 1);
+        CHECK(R.trades_[0].pnl_ == doctest::Approx(R.final_equity_ - R.initial_equity_));
+    }
+
+    TEST_CASE("Summary metrics match the statistics kernels on the full series")
+    {
+        std::vector<double> closes;
+        for (int i = 0; i < 400; ++i)
+            closes.push_back(100.0 + 10.0 * std::sin(i * 0.07) + 0.05 * i);
+        const auto S = fromCloses(closes);
+
+        qga::strategy::MACrossover a{5, 20}, b{5, 20};
+        const auto SUM = Engine{10'000.0}.run(S, a, CaptureLevel::Summary);
+        const auto FULL = Engine{10'000.0}.run(S, b, CaptureLevel::Full);
+        CHECK(SUM.equity_curve_.empty());
+        CHECK(SUM.trades_.empty());
+        CHECK(SUM.round_trips_ == FULL.trades_.size());
+        CHECK(SUM.sharpe_ == doctest::Approx(FULL.sharpe_));
+        CHECK(SUM.max_drawdown_ == doctest::Approx(FULL.max_drawdown_));
+        CHECK(SUM.hit_ratio_ == doctest::Approx(FULL.hit_ratio_));
+
+        // Series start at the initial equity, as the streaming pass does.
+        std::vector<double> curve{10'000.0};
+        curve.insert(curve.end(), FULL.equity_curve_.begin(), FULL.equity_curve_.end());
+        CHECK(FULL.max_drawdown_ == doctest::Approx(qga::core::stats::maxDrawdown(curve)));
+        CHECK(FULL.max_drawdown_ > 0.0);
+        CHECK(FULL.sharpe_
+              == doctest::Approx(qga::core::stats::sharpeRatio(FULL.returns_, 0.0, 1.0)));
+    }
+
+    TEST_CASE("Capture respects early termination")
+    {
+        qga::strategy::BuyHold bh;
+        StopRules dd;
+        dd.max_drawdown_ = 0.1;
+        const auto R =
+            Engine{200.0, {}, dd}.run(fromCloses({100, 100, 70, 120, 130}), bh, CaptureLevel::Full);
+        CHECK(R.aborted_);
+        CHECK(R.equity_curve_.size() == R.bars_processed_);
+        REQUIRE(R.trades_.size() == 1);
+        CHECK(R.trades_[0].exit_ts_ == 2);
+    }
+}
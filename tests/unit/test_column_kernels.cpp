@@ -0,0 +1,134 @@
+#include "doctest.h"
+#include "core/CpuFeatures.hpp"
+#include "strategy/MACrossover.hpp"
+#include "strategy/indicators/ColumnKernels.hpp"
+#include "strategy/indicators/Indicators.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::strategy::indicators;
+using qga::core::SimdLevel;
+using qga::strategy::Signal;
+
+namespace
+{
+    /// Runs a streaming indicator over @p x, one output per value.
+    template <class Ind> std::vector<double> streamed(Ind ind, const std::vector<double>& x)
+    {
+        ind.reset();
+        std::vector<double> out;
+        for (double v : x)
+            out.push_back(ind.update(v));
+        return out;
+    }
+
+    /// Every output within COLUMN_TOLERANCE * max|x| (squared values: within the variance bound).
+    void checkClose(std::vector<double> got, std::vector<double> ref, const std::vector<double>& x,
+                    bool squared = false)
+    {
+        double scale = *std::max_element(x.begin(), x.end());
+        if (squared)
+        {
+            scale *= scale;
+            for (std::size_t i = 0; i < got.size(); ++i)
+            {
+                got[i] *= got[i];
+                ref[i] *= ref[i];
+            }
+        }
+        REQUIRE(got.size() == ref.size());
+        std::size_t bad = 0;
+        for (std::size_t i = 0; i < got.size(); ++i)
+        {
+            if (std::isnan(ref[i]))
+                bad += std::isnan(got[i]) ? 0 : 1;
+            else if (!(std::abs(got[i] - ref[i]) <= columns::COLUMN_TOLERANCE * scale))
+                ++bad;
+        }
+        CHECK(bad == 0);
+    }
+} // namespace
+
+TEST_SUITE("Strategy/ColumnKernels")
+{
+    const SimdLevel LEVELS[] = {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512};
+
+    TEST_CASE("Column kernels match the streaming indicators at every SIMD level")
+    {
+        // Several anchor blocks plus a ragged tail.
+        const auto X = testlib::randomWalk(10'007, 7, 0.02, 1.0e4);
+        std::vector<double> out(X.size());
+        for (const auto LEVEL : LEVELS)
+        {
+            CAPTURE(qga::core::toString(qga::core::clampSimdLevel(LEVEL)));
+            for (const std::size_t P : {1u, 3u, 50u, 700u})
+            {
+                CAPTURE(P);
+                columns::sma(X, P, out, LEVEL);
+                checkClose(out, streamed(Sma{P}, X), X);
+                columns::ema(X, P, out, LEVEL);
+                checkClose(out, streamed(Ema{P}, X), X);
+                columns::rollingStdDev(X, P, out, LEVEL);
+                checkClose(out, streamed(RollingStdDev{P}, X), X, true);
+
+                // Extrema select existing values: exact.
+                const auto MAX_REF = streamed(RollingMax{P}, X);
+                columns::rollingMax(X, P, out, LEVEL);
+                CHECK(std::equal(out.begin() + P - 1, out.end(), MAX_REF.begin() + P - 1));
+                const auto MIN_REF = streamed(RollingMin{P}, X);
+                columns::rollingMin(X, P, out, LEVEL);
+                CHECK(std::equal(out.begin() + P - 1, out.end(), MIN_REF.begin() + P - 1));
+                CHECK(std::isnan(out[0]) == (P > 1));
+            }
+        }
+    }
+
+    TEST_CASE("Short columns are all warm-up")
+    {
+        const std::vector<double> X{1.0, 2.0, 3.0};
+        std::vector<double> out(X.size());
+        for (const auto LEVEL : LEVELS)
+        {
+            columns::sma(X, 5, out, LEVEL);
+            CHECK(std::all_of(out.begin(), out.end(), [](double v) { return std::isnan(v); }));
+            columns::rollingMax(X, 5, out, LEVEL);
+            CHECK(std::all_of(out.begin(), out.end(), [](double v) { return std::isnan(v); }));
+        }
+    }
+
+    TEST_CASE("Crossover of SMA columns reproduces MACrossover signals")
+    {
+        const auto X = testlib::randomWalk(5'003, 7, 0.02);
+        std::vector<Signal> ref;
+        qga::strategy::MACrossover ma{5, 20};
+        ma.onStart();
+        for (double px : X)
+            ref.push_back(ma.onBar({0, px, px, px, px, 0.0}));
+
+        std::vector<double> fast(X.size()), slow(X.size());
+        std::vector<Signal> got(X.size());
+        for (const auto LEVEL : LEVELS)
+        {
+            CAPTURE(qga::core::toString(qga::core::clampSimdLevel(LEVEL)));
+            columns::sma(X, 5, fast, LEVEL);
+            columns::sma(X, 20, slow, LEVEL);
+            columns::crossover(fast, slow, got, LEVEL);
+            CHECK(got == ref);
+        }
+        CHECK(std::count(ref.begin(), ref.end(), Signal::Buy) > 10);
+    }
+
+    TEST_CASE("Invalid arguments are rejected")
+    {
+        std::vector<double> x(10), out(9);
+        std::vector<Signal> sig(10);
+        CHECK_THROWS_AS(columns::sma(x, 0, x), std::invalid_argument);
+        CHECK_THROWS_AS(columns::ema(x, 3, out), std::invalid_argument);
+        CHECK_THROWS_AS(columns::crossover(x, out, sig), std::invalid_argument);
+    }
+}
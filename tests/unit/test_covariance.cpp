@@ -0,0 +1,215 @@
+#include "doctest.h"
+#include "core/Covariance.hpp"
+#include "core/CpuFeatures.hpp"
+#include "domain/backtest/BarPanel.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::core::stats;
+using qga::core::SimdLevel;
+
+namespace
+{
+    /// Correlated returns: a common factor plus noise, @p stride >= @p symbols.
+    std::vector<double> randomReturns(std::size_t rows, std::size_t symbols, std::size_t stride)
+    {
+        std::vector<double> out(rows * stride, 0.0);
+        testlib::Lcg rng{11};
+        auto next = [&] { return rng.centered(); };
+        for (std::size_t t = 0; t < rows; ++t)
+        {
+            const double MARKET = next() * 0.02;
+            for (std::size_t s = 0; s < symbols; ++s)
+                out[t * stride + s] =
+                    0.0005 + MARKET * (0.5 + 0.01 * static_cast<double>(s % 50)) + next() * 0.03;
+        }
+        return out;
+    }
+
+    // Reference: two-pass O(N^2 T) covariance.
+    std::vector<double> naiveCovariance(const std::vector<double>& x, std::size_t rows,
+                                        std::size_t n, std::size_t stride)
+    {
+        std::vector<double> mean(n, 0.0);
+        for (std::size_t t = 0; t < rows; ++t)
+            for (std::size_t s = 0; s < n; ++s)
+                mean[s] += x[t * stride + s] / static_cast<double>(rows);
+        std::vector<double> cov(n * n, 0.0);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                double acc = 0.0;
+                for (std::size_t t = 0; t < rows; ++t)
+                    acc += (x[t * stride + i] - mean[i]) * (x[t * stride + j] - mean[j]);
+                cov[i * n + j] = acc / static_cast<double>(rows - 1);
+            }
+        return cov;
+    }
+
+    double maxAbsDiff(const SymmetricMatrix& m, const std::vector<double>& ref)
+    {
+        double worst = 0.0;
+        for (std::size_t i = 0; i < m.size(); ++i)
+            for (std::size_t j = 0; j < m.size(); ++j)
+                worst = std::max(worst, std::abs(m(i, j) - ref[i * m.size() + j]));
+        return worst;
+    }
+
+    /// True if a Cholesky factorisation succeeds (the matrix is positive definite).
+    bool positiveDefinite(const SymmetricMatrix& m)
+    {
+        const std::size_t N = m.size();
+        std::vector<double> l(N * N, 0.0);
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            double d = m(j, j);
+            for (std::size_t k = 0; k < j; ++k)
+                d -= l[j * N + k] * l[j * N + k];
+            if (!(d > 0.0))
+                return false;
+            l[j * N + j] = std::sqrt(d);
+            for (std::size_t i = j + 1; i < N; ++i)
+            {
+                double v = m(i, j);
+                for (std::size_t k = 0; k < j; ++k)
+                    v -= l[i * N + k] * l[j * N + k];
+                l[i * N + j] = v / l[j * N + j];
+            }
+        }
+        return true;
+    }
+} // namespace
+
+TEST_SUITE("Core/Covariance")
+{
+    TEST_CASE("Blocked covariance matches the naive reference at every SIMD level")
+    {
+        const SimdLevel LEVELS[] = {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512};
+        // 300 rows span two period chunks; 270 symbols span two column blocks.
+        for (const auto [ROWS, N, STRIDE] :
+             {std::array<std::size_t, 3>{300, 37, 40}, std::array<std::size_t, 3>{40, 270, 272}})
+        {
+            const auto X = randomReturns(ROWS, N, STRIDE);
+            const auto REF = naiveCovariance(X, ROWS, N, STRIDE);
+            for (const auto LEVEL : LEVELS)
+                for (const std::size_t THREADS : {1, 3})
+                {
+                    CAPTURE(qga::core::toString(qga::core::clampSimdLevel(LEVEL)));
+                    CAPTURE(N);
+                    CAPTURE(THREADS);
+                    const auto COV = covariance(X, N, STRIDE, {THREADS, LEVEL});
+                    REQUIRE(COV.size() == N);
+                    CHECK(maxAbsDiff(COV, REF) < 1e-15);
+                    CHECK(COV(3, N - 1) == COV(N - 1, 3));
+                }
+        }
+    }
+
+    TEST_CASE("Correlation of panel returns")
+    {
+        std::vector<qga::domain::backtest::BarSeries> series{
+            testlib::makeSeries({10, 11, 12, 11, 13}), testlib::makeSeries({20, 22, 24, 22, 26}),
+            testlib::makeSeries({5, 5, 5, 5, 5}), testlib::makeSeries({8, 7, 6, 7, 5})};
+        const qga::domain::backtest::BarPanel PANEL{series};
+        const auto R = PANEL.returns();
+        REQUIRE(R.size() == 4 * PANEL.stride());
+        CHECK(R[0] == doctest::Approx(0.1));
+        CHECK(R[4] == 0.0); // padded column
+
+        const auto CORR = correlation(covariance(R, 4, PANEL.stride()));
+        for (std::size_t i = 0; i < 4; ++i)
+            CHECK(CORR(i, i) == 1.0);
+        CHECK(CORR(0, 1) == doctest::Approx(1.0)); // same returns
+        CHECK(CORR(0, 2) == 0.0);                  // constant price
+        CHECK(CORR(0, 3) < -0.9);
+    }
+
+    TEST_CASE("Ledoit-Wolf stays well conditioned with fewer periods than symbols")
+    {
+        const std::size_t ROWS = 30;
+        const std::size_t N = 60;
+        const auto X = randomReturns(ROWS, N, N);
+        const auto SAMPLE = covariance(X, N);
+        CHECK_FALSE(positiveDefinite(SAMPLE)); // rank <= ROWS - 1
+
+        const auto LW = ledoitWolf(X, N);
+        CHECK(LW.intensity_ > 0.0);
+        CHECK(LW.intensity_ <= 1.0);
+        CHECK(positiveDefinite(LW.matrix_));
+
+        // Same intensity through the generic shrinker.
+        const auto MANUAL = shrinkToIdentity(SAMPLE, LW.intensity_);
+        for (std::size_t i = 0; i < N; i += 7)
+            for (std::size_t j = 0; j < N; j += 5)
+                CHECK(MANUAL(i, j) == doctest::Approx(LW.matrix_(i, j)).epsilon(1e-12));
+
+        // Many more periods than symbols: much less shrinkage is needed.
+        const auto LONG = randomReturns(4000, 8, 8);
+        CHECK(ledoitWolf(LONG, 8).intensity_ < LW.intensity_);
+    }
+
+    TEST_CASE("Constant-correlation target keeps variances and averages correlations")
+    {
+        const auto X = randomReturns(200, 12, 16);
+        const auto COV = covariance(X, 12, 16);
+        const auto FULL = shrinkToConstantCorrelation(COV, 1.0);
+        const auto CORR = correlation(FULL);
+        for (std::size_t i = 0; i < 12; ++i)
+        {
+            CHECK(FULL(i, i) == COV(i, i));
+            for (std::size_t j = 0; j < 12; ++j)
+                if (i != j)
+                    CHECK(CORR(i, j) == doctest::Approx(CORR(0, 1)));
+        }
+        const auto NONE = shrinkToConstantCorrelation(COV, 0.0);
+        CHECK(NONE(2, 5) == COV(2, 5));
+        CHECK_THROWS_AS(shrinkToConstantCorrelation(COV, 1.5), std::invalid_argument);
+        CHECK_THROWS_AS(shrinkToIdentity(COV, -0.1), std::invalid_argument);
+    }
+
+    TEST_CASE("Rolling covariance tracks the window across rebases")
+    {
+        const std::size_t N = 21;
+        const std::size_t WINDOW = 50;
+        const auto X = randomReturns(180, N, N);
+        for (const auto LEVEL : {SimdLevel::Scalar, qga::core::activeSimdLevel()})
+        {
+            RollingCovariance roll{N, WINDOW, {1, LEVEL}};
+            CHECK_THROWS_AS(roll.covariance(), std::logic_error);
+            for (std::size_t t = 0; t < 180; ++t)
+            {
+                roll.push(std::span<const double>(X.data() + t * N, N));
+                if (t == 9 || t == WINDOW - 1 || t == 2 * WINDOW + 3 || t == 179)
+                {
+                    CAPTURE(t);
+                    const std::size_t FIRST = t + 1 > WINDOW ? t + 1 - WINDOW : 0;
+                    const std::vector<double> SLICE(
+                        X.begin() + static_cast<std::ptrdiff_t>(FIRST * N),
+                        X.begin() + static_cast<std::ptrdiff_t>((t + 1) * N));
+                    const auto REF = naiveCovariance(SLICE, t + 1 - FIRST, N, N);
+                    CHECK(roll.ready() == (t + 1 >= WINDOW));
+                    CHECK(maxAbsDiff(roll.covariance(), REF) < 1e-12);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("Invalid covariance arguments throw")
+    {
+        const std::vector<double> X(30, 0.01);
+        CHECK_THROWS_AS(covariance(X, 4), std::invalid_argument);    // 30 % 4 != 0
+        CHECK_THROWS_AS(covariance(X, 6, 5), std::invalid_argument); // symbols > stride
+        CHECK_THROWS_AS(covariance(X, 30), std::invalid_argument);   // a single row
+        CHECK_THROWS_AS(ledoitWolf(X, 0, 5), std::invalid_argument);
+        CHECK_THROWS_AS(RollingCovariance(0, 10), std::invalid_argument);
+        CHECK_THROWS_AS(RollingCovariance(3, 1), std::invalid_argument);
+        RollingCovariance roll{3, 5};
+        CHECK_THROWS_AS(roll.push(std::vector<double>(4, 0.0)), std::invalid_argument);
+    }
+}
@@ -0,0 +1,158 @@
+#include "doctest.h"
+#include "domain/backtest/BarPanel.hpp"
+#include "domain/backtest/RebalanceEngine.hpp"
+#include "strategy/CrossSectionalMomentum.hpp"
+#include "strategy/Ranker.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+using qga::strategy::CrossSection;
+using qga::strategy::CrossSectionalMomentum;
+using qga::strategy::Ranker;
+
+namespace
+{
+    std::vector<BarSeries> universe(std::size_t symbols, std::size_t bars)
+    {
+        std::vector<BarSeries> out;
+        for (std::size_t s = 0; s < symbols; ++s)
+        {
+            const auto CLOSES =
+                testlib::randomWalk(bars, 17 + s, 0.04, 20.0 + static_cast<double>(s));
+            // Every fifth symbol lists late, so early rows hold NaNs.
+            const std::size_t LATE = s % 5 == 4 ? bars / 3 : 0;
+            out.push_back(testlib::makeSeries(
+                std::vector<double>(CLOSES.begin() + static_cast<std::ptrdiff_t>(LATE),
+                                    CLOSES.end()),
+                static_cast<std::int64_t>(LATE) * 60'000));
+        }
+        return out;
+    }
+
+    // Reference selection: full sort.
+    std::vector<std::uint32_t> sortedSelect(const std::vector<double>& x, std::size_t k, bool high)
+    {
+        std::vector<std::uint32_t> idx;
+        for (std::uint32_t i = 0; i < x.size(); ++i)
+            if (!std::isnan(x[i]))
+                idx.push_back(i);
+        std::stable_sort(idx.begin(), idx.end(),
+                         [&](std::uint32_t a, std::uint32_t b)
+                         { return high ? x[a] > x[b] : x[a] < x[b]; });
+        idx.resize(std::min(k, idx.size()));
+        return idx;
+    }
+
+    // Same strategy, but declared stateful: forces the row-by-row path.
+    class Stateful final : public qga::strategy::ICrossSectionalStrategy
+    {
+      public:
+        explicit Stateful(CrossSectionalMomentum inner) : inner_(inner) {}
+        void onStart(std::size_t) override { rows_.clear(); }
+        bool targetWeights(const CrossSection& slice, std::span<double> weights,
+                           Ranker& ranker) override
+        {
+            rows_.push_back(slice.row());
+            return inner_.targetWeights(slice, weights, ranker);
+        }
+        std::vector<std::size_t> rows_;
+
+      private:
+        CrossSectionalMomentum inner_;
+    };
+} // namespace
+
+TEST_SUITE("Strategy/CrossSectional")
+{
+    TEST_CASE("Ranker matches a full sort, skipping NaN and breaking ties by column")
+    {
+        std::vector<double> x(300);
+        testlib::Lcg rng{3};
+        for (auto& v : x)
+            v = static_cast<double>((rng.next() >> 33) % 50); // many ties
+        for (std::size_t i = 0; i < x.size(); i += 7)
+            x[i] = std::nan("");
+
+        Ranker r;
+        for (const std::size_t K :
+             {std::size_t{0}, std::size_t{1}, std::size_t{10}, std::size_t{50}, x.size()})
+        {
+            const auto TOP = r.top(x, K);
+            const auto BOTTOM = r.bottom(x, K);
+            CHECK(std::vector<std::uint32_t>(TOP.begin(), TOP.end()) == sortedSelect(x, K, true));
+            CHECK(std::vector<std::uint32_t>(BOTTOM.begin(), BOTTOM.end())
+                  == sortedSelect(x, K, false));
+        }
+        CHECK(r.top(std::vector<double>(4, std::nan("")), 2).empty());
+    }
+
+    TEST_CASE("Momentum holds the leaders long and the laggards short")
+    {
+        //                  row:   0    1    2
+        std::vector<BarSeries> series{testlib::makeSeries({10, 11, 12}),  // +20%
+                                      testlib::makeSeries({10, 10, 9}),   // -10%
+                                      testlib::makeSeries({10, 12, 13}),  // +30%
+                                      testlib::makeSeries({10, 10, 10})}; //   0%
+        const BarPanel PANEL{series};
+        CrossSectionalMomentum mom{2, 1, 1, 5};
+        Ranker ranker;
+        std::vector<double> w(4, 0.0);
+        CHECK_FALSE(
+            mom.targetWeights(CrossSection{0, 1, PANEL.closeRow(0), PANEL.stride(), 4}, w, ranker));
+        REQUIRE(
+            mom.targetWeights(CrossSection{0, 2, PANEL.closeRow(0), PANEL.stride(), 4}, w, ranker));
+        CHECK(w == std::vector<double>{0.0, -1.0, 1.0, 0.0});
+
+        CrossSectionalMomentum rev{2, 2, 0, 5, /*reversal=*/true};
+        std::fill(w.begin(), w.end(), 0.0);
+        REQUIRE(
+            rev.targetWeights(CrossSection{0, 2, PANEL.closeRow(0), PANEL.stride(), 4}, w, ranker));
+        CHECK(w == std::vector<double>{0.0, 0.5, 0.0, 0.5});
+
+        // 3 + 3 picks from 4 symbols: the shorts only get the one symbol the longs left.
+        CrossSectionalMomentum wide{2, 3, 3, 5};
+        std::fill(w.begin(), w.end(), 0.0);
+        REQUIRE(wide.targetWeights(CrossSection{0, 2, PANEL.closeRow(0), PANEL.stride(), 4}, w,
+                                   ranker));
+        CHECK(w[0] == doctest::Approx(1.0 / 3));
+        CHECK(w[1] == -1.0);
+        CHECK(w[2] == doctest::Approx(1.0 / 3));
+        CHECK(w[3] == doctest::Approx(1.0 / 3));
+
+        CHECK_THROWS_AS(CrossSectionalMomentum(0, 1), std::invalid_argument);
+        CHECK_THROWS_AS(CrossSectionalMomentum(5, 0, 0), std::invalid_argument);
+        CHECK_THROWS_AS(CrossSectionalMomentum(5, 1, 0, 0), std::invalid_argument);
+    }
+
+    TEST_CASE("Parallel rebalances match the row-by-row run")
+    {
+        const auto SERIES = universe(37, 400);
+        const BarPanel PANEL{SERIES};
+        const RebalanceEngine ENGINE{1.0e6, ExecParams{0.0, 1.0, 2.0}};
+        const CrossSectionalMomentum MOM{20, 5, 5, 7};
+
+        Stateful seq{MOM};
+        const auto REF = ENGINE.run(PANEL, seq);
+        std::vector<std::size_t> all(PANEL.size());
+        std::iota(all.begin(), all.end(), std::size_t{0});
+        CHECK(seq.rows_ == all);
+        CHECK(REF.rebalances_ == (PANEL.size() - 20 + 6) / 7);
+
+        for (const std::size_t THREADS : {1, 3, 8})
+        {
+            CrossSectionalMomentum par{MOM};
+            const auto R = ENGINE.run(PANEL, par, THREADS);
+            CHECK(R.rebalances_ == REF.rebalances_);
+            CHECK(R.summary_.trades_executed_ == REF.summary_.trades_executed_);
+            CHECK(R.summary_.equity_curve_ == REF.summary_.equity_curve_);
+            CHECK(R.holdings_ == REF.holdings_);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include "doctest.h"
+#include "domain/backtest/Engine.hpp"
+#include "strategy/MACrossover.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace qga::domain::backtest;
+
+namespace
+{
+    BarSeries wave(std::size_t n)
+    {
+        BarSeries s;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double PX = 100.0 + 10.0 * std::sin(static_cast<double>(i) * 0.05);
+            s.add({static_cast<std::int64_t>(i), PX, PX, PX, PX, 1.0});
+        }
+        return s;
+    }
+} // namespace
+
+TEST_SUITE("Backtest/EngineCounters")
+{
+    TEST_CASE("Counters tally bars, signals and fills without changing the result")
+    {
+        const auto S = wave(2'000);
+        qga::strategy::MACrossover a{5, 20}, b{5, 20};
+        EngineCounters c;
+        const auto PLAIN = Engine{10'000.0}.run(S, a);
+        const auto COUNTED = Engine{10'000.0}.run(S, b, CaptureLevel::Full, &c);
+
+        CHECK(COUNTED.final_equity_ == PLAIN.final_equity_);
+        CHECK(c.bars_ == 2'000);
+        CHECK(c.signals_ >= c.fills_ - 1);
+        // Every round trip is two fills (the open one is closed out at the end).
+        CHECK(c.fills_ == 2 * COUNTED.round_trips_);
+        CHECK(c.wall_ns_ > 0);
+        CHECK(c.strategy_ns_ <= c.wall_ns_);
+        CHECK(c.engineNs() >= 0);
+        CHECK(c.nsPerBar() > 0.0);
+        CHECK(c.strategyShare() <= 1.0);
+    }
+
+    TEST_CASE("Counters accumulate across runs and respect early termination")
+    {
+        const auto S = wave(1'000);
+        StopRules rules;
+        rules.checkpoint_bar_ = 300;
+        rules.checkpoint_floor_ = 1e12;
+        EngineCounters total;
+        for (int k = 0; k < 3; ++k)
+        {
+            qga::strategy::MACrossover ma{5, 20};
+            const auto R = Engine{10'000.0, {}, rules}.run(S, ma, CaptureLevel::None, &total);
+            CHECK(R.aborted_);
+        }
+        CHECK(total.bars_ == 900);
+
+        EngineCounters sum;
+        sum += total;
+        sum += total;
+        CHECK(sum.bars_ == 1'800);
+        CHECK(sum.wall_ns_ == 2 * total.wall_ns_);
+    }
+}
@@ -0,0 +1,126 @@
+#include "doctest.h"
+#include "domain/backtest/Engine.hpp"
+#include "strategy/BuyHold.hpp"
+#include "strategy/MACrossover.hpp"
+#include "test_helpers.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+
+namespace
+{
+    std::vector<qga::domain::Quote> randomWalk(std::size_t bars)
+    {
+        std::vector<qga::domain::Quote> out;
+        for (const double PX : testlib::randomWalk(bars, 5, 0.05))
+            out.push_back({static_cast<std::int64_t>(out.size()) * 60'000, PX, PX, PX, PX, 100.0});
+        return out;
+    }
+
+    BarSeries slice(const std::vector<qga::domain::Quote>& q, std::size_t from, std::size_t to)
+    {
+        BarSeries s;
+        for (std::size_t i = from; i < to; ++i)
+            s.add(q[i]);
+        return s;
+    }
+
+    class NoSnapshot final : public qga::strategy::IStrategy
+    {
+      public:
+        qga::strategy::Signal onBar(const qga::domain::Quote&) override
+        {
+            return qga::strategy::Signal::None;
+        }
+    };
+} // namespace
+
+TEST_SUITE("Backtest/Resume")
+{
+    TEST_CASE("Resuming over appended bars matches a full re-run")
+    {
+        const auto BARS = randomWalk(600);
+        const ExecParams EXEC{1.0, 5.0, 2.0};
+        Engine engine{10'000.0, EXEC};
+
+        qga::strategy::MACrossover full_strat{5, 20};
+        const auto FULL = engine.run(slice(BARS, 0, BARS.size()), full_strat);
+        REQUIRE(FULL.trades_executed_ > 2);
+
+        SUBCASE("new-bars-only slices with a serialized round trip")
+        {
+            EngineCheckpoint cp;
+            BacktestResult r;
+            const std::vector<std::size_t> CUTS{0, 150, 151, 420, BARS.size()};
+            for (std::size_t k = 0; k + 1 < CUTS.size(); ++k)
+            {
+                qga::strategy::MACrossover strat{5, 20}; // fresh instance each time
+                r = engine.resume(slice(BARS, CUTS[k], CUTS[k + 1]), strat, cp);
+                cp = EngineCheckpoint::deserialize(cp.serialize());
+            }
+            CHECK(cp.bars_processed_ == BARS.size());
+            CHECK(r.final_equity_ == FULL.final_equity_);
+            CHECK(r.trades_executed_ == FULL.trades_executed_);
+        }
+
+        SUBCASE("grown full series skips already processed bars")
+        {
+            EngineCheckpoint cp;
+            qga::strategy::MACrossover strat{5, 20};
+            engine.resume(slice(BARS, 0, 333), strat, cp);
+            const auto R = engine.resume(slice(BARS, 0, BARS.size()), strat, cp);
+            CHECK(cp.bars_processed_ == BARS.size());
+            CHECK(R.final_equity_ == FULL.final_equity_);
+            CHECK(R.trades_executed_ == FULL.trades_executed_);
+
+            // Nothing new: result is unchanged
+            const auto AGAIN = engine.resume(slice(BARS, 0, BARS.size()), strat, cp);
+            CHECK(AGAIN.final_equity_ == FULL.final_equity_);
+        }
+    }
+
+    TEST_CASE("Checkpoint files round-trip and reject foreign data")
+    {
+        const auto BARS = randomWalk(50);
+        Engine engine{1'000.0};
+        EngineCheckpoint cp;
+        qga::strategy::BuyHold bh;
+        engine.resume(slice(BARS, 0, 20), bh, cp);
+        CHECK(cp.has_pos_);
+
+        const auto PATH = std::filesystem::temp_directory_path() / "qga_resume_test.ckpt";
+        cp.save(PATH);
+        auto loaded = EngineCheckpoint::load(PATH);
+        std::filesystem::remove(PATH);
+        CHECK(loaded.serialize() == cp.serialize());
+
+        qga::strategy::BuyHold bh2;
+        const auto R = engine.resume(slice(BARS, 20, 50), bh2, loaded);
+        qga::strategy::BuyHold bh3;
+        const auto FULL = engine.run(slice(BARS, 0, 50), bh3);
+        CHECK(R.final_equity_ == FULL.final_equity_);
+        CHECK(R.trades_executed_ == 1);
+
+        std::vector<std::uint8_t> junk(16, 0xAB);
+        CHECK_THROWS_AS(EngineCheckpoint::deserialize(junk), std::runtime_error);
+    }
+
+    TEST_CASE("Strategies without snapshots and mismatched parameters are rejected")
+    {
+        const auto BARS = slice(randomWalk(10), 0, 10);
+        Engine engine;
+        EngineCheckpoint cp;
+        NoSnapshot plain;
+        CHECK_THROWS_AS(engine.resume(BARS, plain, cp), std::logic_error);
+
+        EngineCheckpoint ma_cp;
+        qga::strategy::MACrossover ma{3, 5};
+        engine.resume(BARS, ma, ma_cp);
+        qga::strategy::MACrossover other{4, 8};
+        CHECK_THROWS_AS(engine.resume(BARS, other, ma_cp), std::invalid_argument);
+    }
+}
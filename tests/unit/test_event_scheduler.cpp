@@ -0,0 +1,129 @@
+#include "doctest.h"
+#include "domain/backtest/EventScheduler.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace qga::domain::backtest;
+using qga::domain::BarEvent;
+
+namespace
+{
+    // Records every batch it receives.
+    class Recorder : public qga::strategy::IBatchStrategy
+    {
+      public:
+        void onStart(std::size_t symbols) override { symbols_ = symbols; }
+        void onBatch(std::int64_t ts, std::span<const BarEvent> batch) override
+        {
+            stamps_.push_back(ts);
+            sizes_.push_back(batch.size());
+        }
+        void onFinish() override { finished_ = true; }
+
+        std::size_t symbols_ = 0;
+        std::vector<std::int64_t> stamps_;
+        std::vector<std::size_t> sizes_;
+        bool finished_ = false;
+    };
+} // namespace
+
+TEST_SUITE("Backtest/EventScheduler")
+{
+    TEST_CASE("Merges calendars into per-timestamp batches ordered by symbol")
+    {
+        std::vector<BarSeries> series(3);
+        series[0].add({10, 1, 1, 1, 1, 0});
+        series[0].add({30, 2, 2, 2, 2, 0});
+        series[1].add({20, 3, 3, 3, 3, 0});
+        series[1].add({30, 4, 4, 4, 4, 0});
+        series[2].add({30, 5, 5, 5, 5, 0});
+
+        EventScheduler sched{series};
+        CHECK(sched.symbols() == 3);
+        CHECK(sched.totalEvents() == 5);
+
+        std::vector<std::pair<std::int64_t, std::vector<std::size_t>>> seen;
+        const auto EVENTS = sched.run(
+            [&](std::int64_t ts, std::span<const BarEvent> batch)
+            {
+                std::vector<std::size_t> syms;
+                for (const auto& e : batch)
+                {
+                    CHECK(e.bar_->ts_ == ts);
+                    syms.push_back(e.symbol_);
+                }
+                seen.emplace_back(ts, syms);
+            });
+
+        CHECK(EVENTS == 5);
+        REQUIRE(seen.size() == 3);
+        CHECK(seen[0].first == 10);
+        CHECK(seen[0].second == std::vector<std::size_t>{0});
+        CHECK(seen[1].first == 20);
+        CHECK(seen[1].second == std::vector<std::size_t>{1});
+        CHECK(seen[2].first == 30);
+        CHECK(seen[2].second == std::vector<std::size_t>{0, 1, 2});
+    }
+
+    TEST_CASE("Matches a sort-based merge on random calendars")
+    {
+        constexpr std::size_t SYMBOLS = 37;
+        std::vector<BarSeries> series(SYMBOLS);
+        std::vector<std::tuple<std::int64_t, std::size_t, double>> expected;
+        testlib::Lcg rng{9};
+        for (std::size_t s = 0; s < SYMBOLS; ++s)
+        {
+            std::int64_t ts = 0;
+            for (std::size_t i = 0; i < 50; ++i)
+            {
+                ts += 1 + static_cast<std::int64_t>(rng.next() >> 61); // gaps of 1..8
+                const double PX = static_cast<double>(s * 1000 + i);
+                series[s].add({ts, PX, PX, PX, PX, 0});
+                expected.emplace_back(ts, s, PX);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+
+        EventScheduler sched{series};
+        std::vector<std::tuple<std::int64_t, std::size_t, double>> got;
+        std::int64_t last = -1;
+        sched.run(
+            [&](std::int64_t ts, std::span<const BarEvent> batch)
+            {
+                CHECK(ts > last);
+                last = ts;
+                for (const auto& e : batch)
+                    got.emplace_back(ts, e.symbol_, e.bar_->close_);
+            });
+        CHECK(got == expected);
+
+        // reset() replays the identical stream
+        sched.reset();
+        std::size_t again = 0;
+        sched.run([&](std::int64_t, std::span<const BarEvent> b) { again += b.size(); });
+        CHECK(again == expected.size());
+    }
+
+    TEST_CASE("Drives a batch strategy and tolerates empty inputs")
+    {
+        std::vector<BarSeries> series(2);
+        series[1].add({5, 1, 1, 1, 1, 0});
+
+        Recorder rec;
+        EventScheduler sched{series};
+        CHECK(sched.run(rec) == 1);
+        CHECK(rec.symbols_ == 2);
+        CHECK(rec.stamps_ == std::vector<std::int64_t>{5});
+        CHECK(rec.finished_);
+
+        EventScheduler none{std::vector<BarSeries>{}};
+        std::int64_t ts = 0;
+        std::span<const BarEvent> batch;
+        CHECK_FALSE(none.next(ts, batch));
+    }
+}
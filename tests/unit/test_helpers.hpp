@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include "domain/Quote.hpp"
@@ -22,4 +23,33 @@ inline qga::domain::backtest::BarSeries makeSeries(const std::vector<double>& cl
     return s;
 }
 
+/// Deterministic 64-bit LCG, so generated test data is the same on every platform.
+struct Lcg {
+    std::uint64_t state_;
+
+    explicit Lcg(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t next() {
+        state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state_;
+    }
+
+    /// Uniform in [-0.5, 0.5) from the top 24 bits.
+    double centered() { return static_cast<double>(next() >> 40) / double(1ULL << 24) - 0.5; }
+};
+
+/// @p n prices from @p start, each moving by a uniform fraction in [-vol/2, vol/2).
+inline std::vector<double> randomWalk(std::size_t n, std::uint64_t seed, double vol,
+                                      double start = 100.0) {
+    std::vector<double> out;
+    out.reserve(n);
+    Lcg rng{seed};
+    double px = start;
+    for (std::size_t i = 0; i < n; ++i) {
+        px *= 1.0 + rng.centered() * vol;
+        out.push_back(px);
+    }
+    return out;
+}
+
 } // namespace testlib
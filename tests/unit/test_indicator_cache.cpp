@@ -0,0 +1,219 @@
+#include "doctest.h"
+#include "strategy/MACrossover.hpp"
+#include "strategy/StateBlob.hpp"
+#include "strategy/indicators/IndicatorCache.hpp"
+#include "strategy/indicators/Indicators.hpp"
+#include "test_helpers.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace qga::strategy::indicators;
+using qga::domain::Quote;
+using qga::strategy::MACrossover;
+using qga::strategy::Signal;
+
+namespace
+{
+    std::vector<Quote> randomBars(std::size_t n)
+    {
+        std::vector<Quote> out;
+        for (const double PX : testlib::randomWalk(n, 11, 0.02))
+            out.push_back(
+                {static_cast<std::int64_t>(out.size()), PX, PX * 1.01, PX * 0.99, PX, 1.0});
+        return out;
+    }
+
+    /// Random walk that stalls for the first 500 of every 2'000 bars (as in quiet sessions).
+    std::vector<Quote> flatStretchBars(std::size_t n, std::uint64_t seed)
+    {
+        std::vector<Quote> out;
+        const auto CLOSES = testlib::randomWalk(n, seed, 0.02);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double PX = CLOSES[i % 2'000 < 500 ? i - i % 2'000 : i];
+            out.push_back({static_cast<std::int64_t>(i), PX, PX, PX, PX, 1.0});
+        }
+        return out;
+    }
+
+    /// Equal values, or both NaN (warm-up).
+    bool same(double a, double b) { return a == b || (std::isnan(a) && std::isnan(b)); }
+
+    std::vector<Signal> run(MACrossover& ma, const std::vector<Quote>& bars)
+    {
+        std::vector<Signal> out;
+        ma.onStart();
+        for (const auto& q : bars)
+            out.push_back(ma.onBar(q));
+        return out;
+    }
+} // namespace
+
+TEST_SUITE("Strategy/IndicatorCache")
+{
+    TEST_CASE("Columns are computed once and shared")
+    {
+        const auto BARS = randomBars(1'000);
+        IndicatorCache cache;
+        const auto A = cache.get({1, IndicatorKind::Sma, 20}, BARS);
+        const auto B = cache.get({1, IndicatorKind::Sma, 20}, BARS);
+        cache.get({1, IndicatorKind::Sma, 50}, BARS);
+        cache.get({2, IndicatorKind::Sma, 20}, BARS);
+
+        CHECK(A.values().data() == B.values().data());
+        CHECK(cache.stats().hits_ == 1);
+        CHECK(cache.stats().misses_ == 3);
+        CHECK(cache.size() == 3);
+        CHECK(cache.bytes() == 3 * BARS.size() * sizeof(double));
+        CHECK(cache.find({1, IndicatorKind::Sma, 50}));
+        CHECK_FALSE(cache.find({1, IndicatorKind::Ema, 50}));
+    }
+
+    TEST_CASE("Every indicator kind matches its streaming counterpart")
+    {
+        const auto BARS = randomBars(500);
+        Atr atr{14};
+        Rsi rsi{14};
+        Wma wma{14};
+        atr.reset();
+        rsi.reset();
+        wma.reset();
+        const auto ATR = computeIndicator(IndicatorKind::Atr, 14, BARS);
+        const auto RSI = computeIndicator(IndicatorKind::Rsi, 14, BARS);
+        const auto WMA = computeIndicator(IndicatorKind::Wma, 14, BARS);
+        const auto MAX = computeIndicator(IndicatorKind::Max, 14, BARS);
+        RollingMax max{14};
+        max.reset();
+        std::size_t bad = 0;
+        for (std::size_t i = 0; i < BARS.size(); ++i)
+        {
+            bad += same(ATR[i], atr.update(BARS[i])) ? 0 : 1;
+            bad += same(RSI[i], rsi.update(BARS[i].close_)) ? 0 : 1;
+            bad += same(WMA[i], wma.update(BARS[i].close_)) ? 0 : 1;
+            bad += same(MAX[i], max.update(BARS[i].close_)) ? 0 : 1;
+        }
+        CHECK(bad == 0);
+        CHECK(std::isfinite(ATR.back()));
+        CHECK_THROWS_AS(computeIndicator(IndicatorKind::Sma, 0, BARS), std::invalid_argument);
+    }
+
+    TEST_CASE("Concurrent requests compute a column exactly once")
+    {
+        const auto BARS = randomBars(200'000);
+        IndicatorCache cache;
+        std::vector<std::thread> threads;
+        std::vector<const double*> seen(8);
+        for (std::size_t t = 0; t < seen.size(); ++t)
+            threads.emplace_back(
+                [&, t] {
+                    seen[t] = cache.get({7, IndicatorKind::StdDev, 30}, BARS).values().data();
+                });
+        for (auto& t : threads)
+            t.join();
+
+        CHECK(cache.stats().misses_ == 1);
+        CHECK(cache.stats().hits_ == seen.size() - 1);
+        for (const auto* p : seen)
+            CHECK(p == seen.front());
+    }
+
+    TEST_CASE("Least recently used columns are evicted; handles outlive eviction")
+    {
+        const auto BARS = randomBars(1'000);
+        const std::size_t COLUMN = BARS.size() * sizeof(double);
+        IndicatorCache cache{2 * COLUMN};
+
+        const auto FIRST = cache.get({1, IndicatorKind::Sma, 5}, BARS);
+        cache.get({1, IndicatorKind::Sma, 6}, BARS);
+        cache.get({1, IndicatorKind::Sma, 5}, BARS); // now the most recent
+        cache.get({1, IndicatorKind::Sma, 7}, BARS); // evicts period 6
+
+        CHECK(cache.size() == 2);
+        CHECK(cache.bytes() <= cache.budget());
+        CHECK(cache.stats().evictions_ == 1);
+        CHECK(cache.find({1, IndicatorKind::Sma, 5}));
+        CHECK_FALSE(cache.find({1, IndicatorKind::Sma, 6}));
+
+        cache.clear();
+        CHECK(cache.size() == 0);
+        REQUIRE(FIRST.size() == BARS.size());
+        CHECK(std::isfinite(FIRST[BARS.size() - 1]));
+        CHECK_THROWS_AS(IndicatorCache{0}, std::invalid_argument);
+    }
+
+    TEST_CASE("MACrossover on cached columns matches the streaming strategy")
+    {
+        const auto BARS = randomBars(5'000);
+        IndicatorCache cache;
+        MACrossover plain{5, 20};
+        MACrossover cached{cache, 1, BARS, 5, 20};
+        const auto REF = run(plain, BARS);
+        CHECK(run(cached, BARS) == REF);
+        CHECK(cache.stats().misses_ == 2);
+
+        // Checkpoint mid-stream, resume in a fresh instance sharing the columns.
+        qga::strategy::StateWriter w;
+        cached.onStart();
+        for (std::size_t i = 0; i < 2'500; ++i)
+            cached.onBar(BARS[i]);
+        cached.saveState(w);
+        MACrossover resumed{cache, 1, BARS, 5, 20};
+        resumed.onStart();
+        qga::strategy::StateReader r{w.bytes()};
+        resumed.loadState(r);
+        for (std::size_t i = 2'500; i < BARS.size(); ++i)
+            CHECK(resumed.onBar(BARS[i]) == REF[i]);
+        CHECK(cache.stats().misses_ == 2);
+
+        CHECK_THROWS_AS(resumed.onBar(BARS.back()), std::out_of_range);
+        CHECK_THROWS_AS((MACrossover{5, 20, IndicatorHandle{}, IndicatorHandle{}, BARS}),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(
+            (MACrossover{5, 20, cache.get({1, IndicatorKind::Sma, 5}, BARS),
+                         cache.get({1, IndicatorKind::Sma, 20}, BARS), std::span{BARS}.first(100)}),
+            std::invalid_argument);
+    }
+
+    TEST_CASE("MACrossover on cached columns matches the streaming strategy on flat stretches")
+    {
+        const std::pair<int, int> PAIRS[] = {{5, 20}, {10, 50}, {7, 30}, {20, 100}};
+        std::size_t differ = 0;
+        for (std::uint64_t seed = 1; seed <= 5; ++seed)
+        {
+            const auto BARS = flatStretchBars(20'000, seed);
+            IndicatorCache cache;
+            for (const auto& [fast, slow] : PAIRS)
+            {
+                MACrossover plain{fast, slow};
+                MACrossover cached{cache, seed, BARS, fast, slow};
+                const auto REF = run(plain, BARS);
+                const auto GOT = run(cached, BARS);
+                for (std::size_t i = 0; i < BARS.size(); ++i)
+                    differ += GOT[i] == REF[i] ? 0 : 1;
+            }
+        }
+        CHECK(differ == 0);
+    }
+
+    TEST_CASE("MACrossover on cached columns rejects bars of another span")
+    {
+        const auto BARS = randomBars(1'000);
+        IndicatorCache cache;
+
+        // A later window of the same series (e.g. a walk-forward fold) would read shifted values.
+        MACrossover fold{cache, 1, BARS, 5, 20};
+        fold.onStart();
+        CHECK_THROWS_AS(fold.onBar(BARS[300]), std::invalid_argument);
+
+        // A shorter prefix of the same series streams fine.
+        MACrossover prefix{cache, 1, BARS, 5, 20};
+        MACrossover plain{5, 20};
+        const std::vector<Quote> HEAD(BARS.begin(), BARS.begin() + 200);
+        CHECK(run(prefix, HEAD) == run(plain, HEAD));
+    }
+}
@@ -0,0 +1,135 @@
+#include "doctest.h"
+#include "domain/backtest/WarmupCache.hpp"
+#include "io/BarFile.hpp"
+#include "io/IndicatorStore.hpp"
+#include "test_helpers.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace qga::io;
+using qga::domain::backtest::seriesFingerprint;
+using qga::strategy::indicators::computeIndicator;
+using qga::strategy::indicators::IndicatorCache;
+using qga::strategy::indicators::IndicatorKey;
+using qga::strategy::indicators::IndicatorKind;
+
+namespace
+{
+    std::vector<double> closes(std::size_t n, double drift)
+    {
+        std::vector<double> out;
+        for (std::size_t i = 0; i < n; ++i)
+            out.push_back(100.0 + drift * static_cast<double>(i)
+                          + std::sin(static_cast<double>(i) * 0.3));
+        return out;
+    }
+
+    std::size_t fileCount(const std::filesystem::path& dir)
+    {
+        std::size_t n = 0;
+        for (const auto& e : std::filesystem::directory_iterator(dir))
+            n += e.path().extension() == ".qgi" ? 1 : 0;
+        return n;
+    }
+} // namespace
+
+TEST_SUITE("IO/IndicatorStore")
+{
+    TEST_CASE("Columns persist across store instances and map back bit-identical")
+    {
+        const auto DIR = IndicatorStore::directoryFor(std::filesystem::temp_directory_path()
+                                                      / "qga_test_store.csv");
+        std::filesystem::remove_all(DIR);
+        const auto S = testlib::makeSeries(closes(500, 0.1), 1'000);
+        const IndicatorKey KEY{seriesFingerprint(S.data()), IndicatorKind::Ema, 20};
+        const auto REF = computeIndicator(KEY.kind_, KEY.period_, S.data());
+
+        {
+            IndicatorStore store{DIR};
+            const auto H = store.get(KEY, S.data());
+            CHECK(store.stats().computed_ == 1);
+            CHECK(std::filesystem::exists(store.pathFor(KEY)));
+            REQUIRE(H.size() == REF.size());
+        }
+
+        IndicatorStore store{DIR};
+        const auto H = store.get(KEY, S.data());
+        CHECK(store.stats().loaded_ == 1);
+        CHECK(store.stats().computed_ == 0);
+        REQUIRE(H.size() == REF.size());
+        std::size_t bad = 0;
+        for (std::size_t i = 0; i < REF.size(); ++i)
+            bad += (H[i] == REF[i] || (std::isnan(H[i]) && std::isnan(REF[i]))) ? 0 : 1;
+        CHECK(bad == 0);
+        std::filesystem::remove_all(DIR);
+    }
+
+    TEST_CASE("A changed dataset invalidates its old columns")
+    {
+        const auto DIR = std::filesystem::temp_directory_path() / "qga_test_store_inval";
+        std::filesystem::remove_all(DIR);
+        IndicatorStore store{DIR};
+        const auto OLD = testlib::makeSeries(closes(300, 0.1), 1'000);
+        const auto NEW = testlib::makeSeries(closes(301, 0.1), 1'000); // one bar appended
+
+        store.get({seriesFingerprint(OLD.data()), IndicatorKind::Sma, 10}, OLD.data());
+        store.get({seriesFingerprint(OLD.data()), IndicatorKind::Max, 10}, OLD.data());
+        CHECK(fileCount(DIR) == 2);
+
+        // Re-writing the SMA for the new content replaces the stale SMA file.
+        const auto H =
+            store.get({seriesFingerprint(NEW.data()), IndicatorKind::Sma, 10}, NEW.data());
+        CHECK(H.size() == 301);
+        CHECK(fileCount(DIR) == 2);
+        CHECK(store.stats().invalidated_ == 1);
+
+        CHECK(store.prune(seriesFingerprint(NEW.data())) == 1); // the stale max
+        CHECK(fileCount(DIR) == 1);
+        std::filesystem::remove_all(DIR);
+    }
+
+    TEST_CASE("Mismatched or corrupt files are recomputed")
+    {
+        const auto DIR = std::filesystem::temp_directory_path() / "qga_test_store_bad";
+        std::filesystem::remove_all(DIR);
+        IndicatorStore store{DIR};
+        const auto S = testlib::makeSeries(closes(200, 0.2), 1'000);
+        const IndicatorKey KEY{seriesFingerprint(S.data()), IndicatorKind::Sma, 5};
+
+        std::ofstream(store.pathFor(KEY)) << "garbage";
+        CHECK(store.get(KEY, S.data()).size() == 200);
+        CHECK(store.stats().invalidated_ == 1);
+        CHECK(store.stats().computed_ == 1);
+
+        // Same key, different bars (a caller passing a wrong hash): length check rejects the file.
+        const auto SHORT = testlib::makeSeries(closes(150, 0.2), 1'000);
+        CHECK(store.get(KEY, SHORT.data()).size() == 150);
+        CHECK(store.get(KEY, SHORT.data()).size() == 150);
+        CHECK(store.stats().loaded_ == 1);
+        std::filesystem::remove_all(DIR);
+    }
+
+    TEST_CASE("An in-process cache reads through the store")
+    {
+        const auto DIR = std::filesystem::temp_directory_path() / "qga_test_store_cache";
+        std::filesystem::remove_all(DIR);
+        IndicatorStore store{DIR};
+        const auto S = testlib::makeSeries(closes(400, 0.05), 1'000);
+        const auto ID = seriesFingerprint(S.data());
+        {
+            IndicatorCache cache{std::size_t{1} << 20, store.source()};
+            cache.get({ID, IndicatorKind::Rsi, 14}, S.data());
+            cache.get({ID, IndicatorKind::Rsi, 14}, S.data());
+            CHECK(cache.stats().misses_ == 1);
+        }
+        IndicatorCache fresh{std::size_t{1} << 20, store.source()};
+        const auto H = fresh.get({ID, IndicatorKind::Rsi, 14}, S.data());
+        CHECK(H.size() == 400);
+        CHECK(store.stats().computed_ == 1);
+        CHECK(store.stats().loaded_ == 1);
+        std::filesystem::remove_all(DIR);
+    }
+}
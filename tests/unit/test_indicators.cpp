@@ -0,0 +1,274 @@
+#include "doctest.h"
+#include "strategy/MACrossover.hpp"
+#include "strategy/StateBlob.hpp"
+#include "strategy/indicators/Indicators.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::strategy::indicators;
+using qga::strategy::StateReader;
+using qga::strategy::StateWriter;
+
+namespace
+{
+    // Naive references over x[i - p + 1 .. i].
+    double naiveMean(const std::vector<double>& x, std::size_t i, std::size_t p)
+    {
+        double s = 0.0;
+        for (std::size_t k = i + 1 - p; k <= i; ++k)
+            s += x[k];
+        return s / static_cast<double>(p);
+    }
+
+    double naiveStd(const std::vector<double>& x, std::size_t i, std::size_t p)
+    {
+        const double M = naiveMean(x, i, p);
+        double s = 0.0;
+        for (std::size_t k = i + 1 - p; k <= i; ++k)
+            s += (x[k] - M) * (x[k] - M);
+        return std::sqrt(s / static_cast<double>(p));
+    }
+} // namespace
+
+TEST_SUITE("Strategy/Indicators")
+{
+    TEST_CASE("RingBuffer overwrites the oldest element once full")
+    {
+        RingBuffer<int> r{3};
+        CHECK(r.push_back(1) == 0);
+        r.push_back(2);
+        r.push_back(3);
+        CHECK(r.full());
+        CHECK(r.push_back(4) == 1);
+        CHECK(r.front() == 2);
+        CHECK(r.back() == 4);
+        CHECK(r[1] == 3);
+        r.pop_front();
+        r.pop_back();
+        CHECK(r.size() == 1);
+        CHECK(r.front() == 3);
+    }
+
+    TEST_CASE("Moving averages match naive recomputation")
+    {
+        const auto X = testlib::randomWalk(500, 42, 0.04, 1000.0);
+        constexpr std::size_t P = 14;
+        Sma sma{P};
+        Wma wma{P};
+        Ema ema{P};
+        sma.reset();
+        wma.reset();
+        ema.reset();
+        double ref_ema = 0.0;
+        for (std::size_t i = 0; i < X.size(); ++i)
+        {
+            const double S = sma.update(X[i]);
+            const double W = wma.update(X[i]);
+            const double E = ema.update(X[i]);
+            if (i + 1 < P)
+            {
+                CHECK(std::isnan(S));
+                CHECK(std::isnan(W));
+                CHECK(std::isnan(E));
+                continue;
+            }
+            CHECK(S == doctest::Approx(naiveMean(X, i, P)).epsilon(1e-12));
+            double num = 0.0;
+            for (std::size_t k = 0; k < P; ++k)
+                num += static_cast<double>(k + 1) * X[i + 1 - P + k];
+            CHECK(W == doctest::Approx(num / (P * (P + 1) / 2.0)).epsilon(1e-12));
+            ref_ema =
+                i + 1 == P ? naiveMean(X, i, P) : ref_ema + 2.0 / (P + 1.0) * (X[i] - ref_ema);
+            CHECK(E == doctest::Approx(ref_ema).epsilon(1e-12));
+        }
+    }
+
+    TEST_CASE("Rolling stddev, Bollinger bands and extrema match naive recomputation")
+    {
+        // Large level: sum-of-squares would lose digits.
+        const auto X = testlib::randomWalk(400, 42, 0.04, 1.0e6);
+        constexpr std::size_t P = 20;
+        RollingStdDev sd{P};
+        Bollinger bb{P, 2.0};
+        RollingMax hi{P};
+        RollingMin lo{P};
+        sd.reset();
+        bb.reset();
+        hi.reset();
+        lo.reset();
+        for (std::size_t i = 0; i < X.size(); ++i)
+        {
+            const double SD = sd.update(X[i]);
+            const Bands B = bb.update(X[i]);
+            const double HI = hi.update(X[i]);
+            const double LO = lo.update(X[i]);
+            if (i + 1 < P)
+            {
+                CHECK(std::isnan(SD));
+                CHECK(std::isnan(B.middle_));
+                CHECK(std::isnan(HI));
+                continue;
+            }
+            const double REF = naiveStd(X, i, P);
+            CHECK(SD == doctest::Approx(REF).epsilon(1e-7));
+            CHECK(B.middle_ == doctest::Approx(naiveMean(X, i, P)).epsilon(1e-12));
+            CHECK(B.upper_ - B.middle_ == doctest::Approx(2.0 * REF).epsilon(1e-7));
+            const auto FIRST = X.begin() + static_cast<std::ptrdiff_t>(i + 1 - P);
+            const auto LAST = X.begin() + static_cast<std::ptrdiff_t>(i + 1);
+            CHECK(HI == *std::max_element(FIRST, LAST));
+            CHECK(LO == *std::min_element(FIRST, LAST));
+        }
+    }
+
+    TEST_CASE("RSI and ATR follow Wilder smoothing")
+    {
+        Rsi rsi{3};
+        rsi.reset();
+        for (double x : {10.0, 11.0, 12.0})
+            CHECK(std::isnan(rsi.update(x)));
+        CHECK(rsi.update(13.0) == doctest::Approx(100.0)); // only gains
+        CHECK(rsi.update(11.0)
+              == doctest::Approx(100.0 - 100.0 / (1.0 + (2.0 / 3.0) / (2.0 / 3.0))));
+
+        Atr atr{2};
+        atr.reset();
+        CHECK(std::isnan(atr.update(11.0, 9.0, 10.0)));               // TR 2
+        CHECK(atr.update(15.0, 12.0, 14.0) == doctest::Approx(3.5));  // TR max(3, 5, 2) = 5
+        CHECK(atr.update(14.0, 13.0, 13.5) == doctest::Approx(2.25)); // TR 1 -> (3.5 + 1) / 2
+    }
+
+    TEST_CASE("Snapshots restore the exact state")
+    {
+        const auto X = testlib::randomWalk(300, 42, 0.04, 1000.0);
+        Sma a{10}, b{10};
+        RollingMax m{7}, n{7};
+        Rsi r{14}, s{14};
+        a.reset();
+        m.reset();
+        r.reset();
+        for (std::size_t i = 0; i < 150; ++i)
+        {
+            a.update(X[i]);
+            m.update(X[i]);
+            r.update(X[i]);
+        }
+        StateWriter out;
+        a.save(out);
+        m.save(out);
+        r.save(out);
+        StateReader in{out.bytes()};
+        b.load(in);
+        n.load(in);
+        s.load(in);
+        CHECK(in.done());
+        for (std::size_t i = 150; i < X.size(); ++i)
+        {
+            CHECK(a.update(X[i]) == b.update(X[i]));
+            CHECK(m.update(X[i]) == n.update(X[i]));
+            CHECK(r.update(X[i]) == s.update(X[i]));
+        }
+    }
+
+    TEST_CASE("Fixed-window indicators match the runtime-sized ones bit for bit")
+    {
+        const auto X = testlib::randomWalk(500, 42, 0.04, 1000.0);
+        fixed::RingBuffer<int, 3> r; // 4 slots, capacity 3
+        for (int i = 1; i <= 3; ++i)
+            CHECK(r.push_back(i) == 0);
+        CHECK(r.push_back(4) == 1);
+        CHECK(r.push_back(5) == 2);
+        CHECK(r.front() == 3);
+        CHECK(r.back() == 5);
+        CHECK(r[1] == 4);
+
+        Sma sma{20};
+        Wma wma{7};
+        RollingStdDev sd{20};
+        RollingMax mx{50};
+        RollingMin mn{13};
+        sma.reset();
+        wma.reset();
+        sd.reset();
+        mx.reset();
+        mn.reset();
+        fixed::Sma<20> fsma;
+        fixed::Wma<7> fwma;
+        fixed::RollingStdDev<20> fsd;
+        fixed::RollingMax<50> fmx;
+        fixed::RollingMin<13> fmn;
+        static_assert(fixed::Sma<20>::period() == 20);
+        for (const double V : X)
+        {
+            const double A = sma.update(V), FA = fsma.update(V);
+            CHECK((A == FA || (std::isnan(A) && std::isnan(FA))));
+            const double B = wma.update(V), FB = fwma.update(V);
+            CHECK((B == FB || (std::isnan(B) && std::isnan(FB))));
+            const double C = sd.update(V), FC = fsd.update(V);
+            CHECK((C == FC || (std::isnan(C) && std::isnan(FC))));
+            const double D = mx.update(V), FD = fmx.update(V);
+            CHECK((D == FD || (std::isnan(D) && std::isnan(FD))));
+            CHECK(mx.age() == fmx.age());
+            const double E = mn.update(V), FE = fmn.update(V);
+            CHECK((E == FE || (std::isnan(E) && std::isnan(FE))));
+        }
+        fsma.reset();
+        CHECK_FALSE(fsma.ready());
+        CHECK(std::isnan(fsma.value()));
+    }
+
+    TEST_CASE("Fixed-window and runtime-sized snapshots are interchangeable")
+    {
+        const auto X = testlib::randomWalk(200, 42, 0.04, 1000.0);
+        Sma a{10};
+        RollingMax m{7};
+        a.reset();
+        m.reset();
+        fixed::Sma<10> fa;
+        fixed::RollingMax<7> fm;
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            a.update(X[i]);
+            m.update(X[i]);
+        }
+        StateWriter out;
+        a.save(out);
+        m.save(out);
+        StateReader in{out.bytes()};
+        fa.load(in);
+        fm.load(in);
+        CHECK(in.done());
+
+        StateWriter back;
+        fa.save(back);
+        fm.save(back);
+        CHECK(back.bytes() == out.bytes());
+        for (std::size_t i = 100; i < X.size(); ++i)
+        {
+            CHECK(a.update(X[i]) == fa.update(X[i]));
+            CHECK(m.update(X[i]) == fm.update(X[i]));
+        }
+
+        StateWriter big;
+        Sma wide{11};
+        wide.reset();
+        for (std::size_t i = 0; i < 20; ++i)
+            wide.update(X[i]);
+        wide.save(big);
+        StateReader too_big{big.bytes()};
+        CHECK_THROWS_AS(fa.load(too_big), std::runtime_error);
+    }
+
+    TEST_CASE("Invalid periods are rejected")
+    {
+        CHECK_THROWS_AS(Sma{0}, std::invalid_argument);
+        CHECK_THROWS_AS(RollingMin{0}, std::invalid_argument);
+        CHECK_THROWS_AS(Bollinger(5, -1.0), std::invalid_argument);
+        CHECK_THROWS_AS(qga::strategy::MACrossover(0, 5), std::invalid_argument);
+        CHECK_THROWS_AS(qga::strategy::MACrossover(3, -1), std::invalid_argument);
+    }
+}
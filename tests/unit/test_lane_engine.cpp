@@ -0,0 +1,95 @@
+#include "doctest.h"
+#include "core/CpuFeatures.hpp"
+#include "domain/backtest/BarPanel.hpp"
+#include "domain/backtest/Engine.hpp"
+#include "domain/backtest/LaneEngine.hpp"
+#include "strategy/MACrossover.hpp"
+#include "test_helpers.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+using qga::core::SimdLevel;
+
+// Deterministic random walks with gaps: symbol s skips every (s + 3)-th bar
+static std::vector<BarSeries> makeUniverse(std::size_t symbols, std::size_t bars)
+{
+    std::vector<BarSeries> out(symbols);
+    for (std::size_t s = 0; s < symbols; ++s)
+    {
+        const auto CLOSES = testlib::randomWalk(bars, 42 + s, 0.04, 50.0 + static_cast<double>(s));
+        for (std::size_t i = 0; i < bars; ++i)
+        {
+            if (i % (s + 3) == 2)
+                continue;
+            const auto TS = static_cast<std::int64_t>(i) * 60'000;
+            const double PX = CLOSES[i];
+            out[s].add({TS, PX, PX, PX, PX, 1000.0});
+        }
+    }
+    return out;
+}
+
+TEST_SUITE("Backtest/LaneEngine")
+{
+    TEST_CASE("BarPanel aligns symbols on the union of timestamps")
+    {
+        std::vector<BarSeries> series(2);
+        series[0].add({0, 1, 1, 1, 1, 0});
+        series[0].add({2, 3, 3, 3, 3, 0});
+        series[1].add({1, 2, 2, 2, 2, 0});
+        series[1].add({2, 4, 4, 4, 4, 0});
+
+        BarPanel panel{series};
+        REQUIRE(panel.size() == 3);
+        CHECK(panel.symbols() == 2);
+        CHECK(panel.stride() % BarPanel::LANE_PAD == 0);
+        CHECK(panel.closeRow(0)[0] == doctest::Approx(1.0));
+        CHECK(std::isnan(panel.closeRow(0)[1]));
+        CHECK(panel.quote(1, 0) == nullptr);
+        CHECK(panel.quote(2, 1)->close_ == doctest::Approx(4.0));
+    }
+
+    TEST_CASE("Every kernel matches the scalar engine per symbol")
+    {
+        const auto UNIVERSE = makeUniverse(11, 400); // 11 = not a multiple of any lane width
+        const BarPanel PANEL{UNIVERSE};
+        const ExecParams EXEC{0.5, 2.0, 5.0};
+
+        std::vector<BacktestResult> expected;
+        for (const auto& s : UNIVERSE)
+        {
+            qga::strategy::MACrossover ma{5, 20};
+            expected.push_back(Engine{10'000.0, EXEC}.run(s, ma));
+        }
+
+        const LaneEngine LANES{10'000.0, EXEC};
+        for (auto level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512})
+        {
+            CAPTURE(qga::core::toString(qga::core::clampSimdLevel(level)));
+            const auto GOT = LANES.runMACrossover(PANEL, 5, 20, level);
+            REQUIRE(GOT.size() == expected.size());
+            for (std::size_t s = 0; s < GOT.size(); ++s)
+            {
+                CHECK(GOT[s].final_equity_ == expected[s].final_equity_);
+                CHECK(GOT[s].trades_executed_ == expected[s].trades_executed_);
+            }
+        }
+    }
+
+    TEST_CASE("Requested level is clamped to host support")
+    {
+        const auto LEVEL = qga::core::clampSimdLevel(SimdLevel::Avx512);
+        CHECK(static_cast<int>(LEVEL) <= static_cast<int>(qga::core::detectSimdLevel()));
+        CHECK(LaneEngine::laneWidth(SimdLevel::Scalar) == 1);
+    }
+
+    TEST_CASE("Invalid periods are rejected")
+    {
+        const BarPanel PANEL{makeUniverse(1, 10)};
+        CHECK_THROWS_AS(LaneEngine{}.runMACrossover(PANEL, 0, 5), std::invalid_argument);
+    }
+}
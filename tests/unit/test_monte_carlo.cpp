@@ -0,0 +1,108 @@
+#include "doctest.h"
+#include "core/Random.hpp"
+#include "core/Statistics.hpp"
+#include "core/StatisticsKernels.hpp"
+#include "domain/backtest/MonteCarlo.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+
+namespace
+{
+    std::vector<double> sampleReturns(std::size_t n)
+    {
+        std::vector<double> out;
+        qga::core::Xoshiro256 rng{123};
+        for (std::size_t i = 0; i < n; ++i)
+            out.push_back((rng.uniform() - 0.48) * 0.02);
+        return out;
+    }
+} // namespace
+
+TEST_SUITE("Backtest/MonteCarlo")
+{
+    TEST_CASE("Kernels agree with Statistics")
+    {
+        const auto R = sampleReturns(500);
+        std::vector<double> eq{100.0};
+        for (double r : R)
+            eq.push_back(eq.back() * (1.0 + r));
+
+        CHECK(qga::core::stats::sharpeRatio(R, 0.01, 252.0)
+              == qga::core::Statistics::sharpeRatio(R, 0.01, 252.0));
+        CHECK(qga::core::stats::maxDrawdown(eq) == qga::core::Statistics::maxDrawdown(eq));
+        CHECK(qga::core::stats::cagr(eq, 252.0) == qga::core::Statistics::cagr(eq, 252.0));
+        CHECK(qga::core::stats::cagr(eq, -1.0) == 0.0);
+    }
+
+    TEST_CASE("Random streams are reproducible and distinct")
+    {
+        qga::core::Xoshiro256 a{7, 3}, b{7, 3}, c{7, 4};
+        bool differs = false;
+        for (int i = 0; i < 16; ++i)
+        {
+            const auto X = a();
+            CHECK(X == b());
+            differs |= X != c();
+        }
+        CHECK(differs);
+        for (int i = 0; i < 1000; ++i)
+        {
+            CHECK(a.below(10) < 10);
+            const double U = a.uniform();
+            CHECK((U >= 0.0 && U < 1.0));
+        }
+    }
+
+    TEST_CASE("Block bootstrap is deterministic for any thread count")
+    {
+        const auto R = sampleReturns(750);
+        MonteCarloParams p;
+        p.paths_ = 2'000;
+        p.block_size_ = 10;
+        p.threads_ = 1;
+        const auto ONE = MonteCarlo{p}.run(R);
+        p.threads_ = 4;
+        const auto FOUR = MonteCarlo{p}.run(R);
+
+        CHECK(ONE.sharpe_.values_ == FOUR.sharpe_.values_);
+        CHECK(ONE.max_drawdown_.values_ == FOUR.max_drawdown_.values_);
+        CHECK(ONE.cagr_.values_.size() == 2'000);
+
+        // Distribution brackets the observed path
+        const double OBSERVED = qga::core::stats::sharpeRatio(R, 0.0, 252.0);
+        CHECK(ONE.sharpe_.quantile(0.01) < OBSERVED);
+        CHECK(ONE.sharpe_.quantile(0.99) > OBSERVED);
+        CHECK(ONE.max_drawdown_.quantile(0.0) >= 0.0);
+        CHECK(ONE.sharpe_.quantile(0.5) == doctest::Approx(ONE.sharpe_.values_[999]).epsilon(0.01));
+    }
+
+    TEST_CASE("Trade shuffle keeps the total return and varies the path")
+    {
+        const auto R = sampleReturns(200);
+        MonteCarloParams p;
+        p.paths_ = 500;
+        p.method_ = ResampleMethod::TradeShuffle;
+        p.threads_ = 2;
+        const auto RES = MonteCarlo{p}.run(R, 1'000.0);
+
+        const double LO = RES.final_equity_.values_.front();
+        const double HI = RES.final_equity_.values_.back();
+        CHECK(LO == doctest::Approx(HI).epsilon(1e-9));
+        CHECK(RES.sharpe_.stddev_ < 1e-9);
+        CHECK(RES.max_drawdown_.stddev_ > 0.0);
+    }
+
+    TEST_CASE("Rejects degenerate input")
+    {
+        CHECK_THROWS_AS(MonteCarlo(MonteCarloParams{0}), std::invalid_argument);
+        const std::vector<double> ONE{0.01};
+        CHECK_THROWS_AS(MonteCarlo{MonteCarloParams{}}.run(ONE), std::invalid_argument);
+        CHECK(MonteCarlo::returnsFromEquity(std::vector<double>{100.0, 110.0, 99.0})[1]
+              == doctest::Approx(-0.1));
+    }
+}
@@ -0,0 +1,119 @@
+#include "doctest.h"
+#include "domain/backtest/Optimizer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+
+namespace
+{
+    constexpr std::size_t BARS = 400;
+    constexpr double INITIAL = 1'000.0;
+
+    // Price rises by 1 per bar, so buying at bar k and holding earns BARS - 1 - k.
+    BarSeries risingSeries()
+    {
+        BarSeries s;
+        for (std::size_t i = 0; i < BARS; ++i)
+        {
+            const double PX = 100.0 + static_cast<double>(i);
+            s.add({static_cast<std::int64_t>(i), PX, PX, PX, PX, 1.0});
+        }
+        return s;
+    }
+
+    // Grid distance from the optimum (fast = 37, slow = 140).
+    int distance(const ParamSet& p) { return std::abs(p[0] - 37) + std::abs(p[1] - 140) / 5; }
+
+    /// Enters after distance(params) bars: equity is a smooth landscape peaking at the optimum.
+    class DelayedEntry final : public qga::strategy::IStrategy
+    {
+      public:
+        explicit DelayedEntry(int delay) : delay_(delay) {}
+        void onStart() override { bar_ = 0; }
+        qga::strategy::Signal onBar(const qga::domain::Quote&) override
+        {
+            return bar_++ == delay_ ? qga::strategy::Signal::Buy : qga::strategy::Signal::None;
+        }
+
+      private:
+        int delay_;
+        int bar_ = 0;
+    };
+
+    const ParamSpace SPACE{{"fast", 2, 60, 1}, {"slow", 20, 300, 5}}; // 59 x 57 = 3363 points
+    const ParamStrategyFactory FACTORY = [](const ParamSet& p)
+    { return std::make_unique<DelayedEntry>(distance(p)); };
+} // namespace
+
+TEST_SUITE("Backtest/Optimizer")
+{
+    TEST_CASE("Parameter ranges and validation")
+    {
+        const ParamRange R{"x", 10, 30, 5};
+        CHECK(R.count() == 5);
+        CHECK(R.value(4) == 30);
+
+        CHECK_THROWS_AS(SuccessiveHalving(INITIAL, {}, HalvingParams{0.0}), std::invalid_argument);
+        CHECK_THROWS_AS(EvolutionarySearch(INITIAL, {}, EvolutionParams{0}), std::invalid_argument);
+        const SuccessiveHalving SH{INITIAL, {}, HalvingParams{}};
+        CHECK_THROWS_AS(SH.run(risingSeries(), ParamSpace{{"bad", 5, 1, 1}}, FACTORY),
+                        std::invalid_argument);
+    }
+
+    TEST_CASE("Successive halving finds a near-optimum within its budget")
+    {
+        const auto SERIES = risingSeries();
+        HalvingParams hp;
+        hp.budget_ = 20.0;
+        hp.threads_ = 3;
+        const auto RES = SuccessiveHalving{INITIAL, {}, hp}.run(SERIES, SPACE, FACTORY);
+
+        CHECK(RES.full_runs_ <= hp.budget_ + 1.0);
+        CHECK(RES.trials_.size() == RES.backtests_);
+        CHECK(RES.trials_.back().bars_ == BARS);
+        CHECK(distance(RES.best_) <= 8);
+        CHECK(RES.best_score_ == doctest::Approx(INITIAL + BARS - 1 - distance(RES.best_)));
+
+        hp.threads_ = 1;
+        const auto AGAIN = SuccessiveHalving{INITIAL, {}, hp}.run(SERIES, SPACE, FACTORY);
+        CHECK(AGAIN.best_ == RES.best_);
+        CHECK(AGAIN.backtests_ == RES.backtests_);
+    }
+
+    TEST_CASE("Evolutionary search converges with a fixed backtest budget")
+    {
+        const auto SERIES = risingSeries();
+        EvolutionParams ep;
+        ep.budget_ = 150;
+        ep.population_ = 16;
+        ep.threads_ = 4;
+        const auto RES = EvolutionarySearch{INITIAL, {}, ep}.run(SERIES, SPACE, FACTORY);
+
+        CHECK(RES.backtests_ == ep.budget_);
+        CHECK(RES.full_runs_ == doctest::Approx(150.0));
+        CHECK(distance(RES.best_) <= 3);
+
+        ep.threads_ = 1;
+        const auto AGAIN = EvolutionarySearch{INITIAL, {}, ep}.run(SERIES, SPACE, FACTORY);
+        CHECK(AGAIN.best_ == RES.best_);
+        REQUIRE(AGAIN.trials_.size() == RES.trials_.size());
+        for (std::size_t i = 0; i < RES.trials_.size(); ++i)
+            CHECK(AGAIN.trials_[i].params_ == RES.trials_[i].params_);
+    }
+
+    TEST_CASE("Small spaces are covered exhaustively")
+    {
+        const ParamSpace SMALL{{"fast", 35, 39, 1}, {"slow", 130, 150, 10}}; // 15 points
+        EvolutionParams ep;
+        ep.budget_ = 100;
+        ep.population_ = 32;
+        const auto RES = EvolutionarySearch{INITIAL, {}, ep}.run(risingSeries(), SMALL, FACTORY);
+        CHECK(RES.backtests_ == 15);
+        CHECK(RES.best_ == ParamSet{37, 140});
+    }
+}
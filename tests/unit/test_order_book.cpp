@@ -0,0 +1,125 @@
+#include "doctest.h"
+#include "domain/backtest/OrderBook.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+using qga::domain::AssetClass;
+using qga::domain::Instrument;
+using qga::domain::Quote;
+
+namespace
+{
+    const Instrument AAA{"AAA", AssetClass::Equity, "XNAS"};
+
+    Order limit(Side side, double px, double qty = 1.0)
+    {
+        return Order{AAA, side, qty, OrderType::Limit, px, 0.0};
+    }
+    Order stop(Side side, double px, double qty = 1.0)
+    {
+        return Order{AAA, side, qty, OrderType::Stop, 0.0, px};
+    }
+} // namespace
+
+TEST_SUITE("Backtest/OrderBook")
+{
+    TEST_CASE("Priced orders validate their prices")
+    {
+        CHECK_THROWS_AS(Order(AAA, Side::Buy, 1.0, OrderType::Limit), std::invalid_argument);
+        CHECK_THROWS_AS(Order(AAA, Side::Buy, 1.0, OrderType::Limit, 0.0, 0.0),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(Order(AAA, Side::Buy, 1.0, OrderType::StopLimit, 10.0, 0.0),
+                        std::invalid_argument);
+        CHECK_NOTHROW(Order(AAA, Side::Sell, 1.0, OrderType::StopLimit, 9.0, 10.0));
+
+        OrderBook book;
+        CHECK_THROWS_AS(book.submit(Order{AAA, Side::Buy, 1.0}), std::invalid_argument);
+    }
+
+    TEST_CASE("Limits fill only when the bar range reaches them, at the better of open and limit")
+    {
+        OrderBook book;
+        const auto SLOT = book.slotFor(AAA);
+        const auto BUY_LOW = book.submit(limit(Side::Buy, 95.0));
+        const auto BUY_HIGH = book.submit(limit(Side::Buy, 99.0));
+        const auto SELL = book.submit(limit(Side::Sell, 104.0, 2.0));
+        std::vector<Fill> fills;
+
+        book.onBar(SLOT, Quote{1, 100.0, 101.0, 98.0, 100.0, 0}, fills);
+        REQUIRE(fills.size() == 1);
+        CHECK(fills[0].id_ == BUY_HIGH);
+        CHECK(fills[0].price_ == doctest::Approx(99.0));
+        CHECK(book.status(BUY_LOW) == OrderStatus::Pending);
+
+        // Gap up through the sell limit: filled at the (better) open
+        fills.clear();
+        book.onBar(SLOT, Quote{2, 106.0, 107.0, 105.0, 106.0, 0}, fills);
+        REQUIRE(fills.size() == 1);
+        CHECK(fills[0].id_ == SELL);
+        CHECK(fills[0].price_ == doctest::Approx(106.0));
+        CHECK(fills[0].quantity_ == doctest::Approx(2.0));
+        CHECK(fills[0].ts_ == 2);
+        CHECK(book.openOrders() == 1);
+    }
+
+    TEST_CASE("Stops trigger on the range and take slippage")
+    {
+        OrderBook book{ExecParams{0.0, 0.0, 10.0}};
+        const auto SLOT = book.slotFor(AAA);
+        book.submit(stop(Side::Buy, 102.0));
+        book.submit(stop(Side::Sell, 97.0));
+        std::vector<Fill> fills;
+
+        book.onBar(SLOT, Quote{1, 100.0, 103.0, 99.0, 101.0, 0}, fills);
+        REQUIRE(fills.size() == 1);
+        CHECK(fills[0].side_ == Side::Buy);
+        CHECK(fills[0].price_ == doctest::Approx(102.0 * 1.001));
+
+        // Gap down below the sell stop: filled from the open
+        book.onBar(SLOT, Quote{2, 95.0, 96.0, 94.0, 95.0, 0}, fills);
+        REQUIRE(fills.size() == 2);
+        CHECK(fills[1].price_ == doctest::Approx(95.0 * 0.999));
+    }
+
+    TEST_CASE("Stop-limit fills at trigger when marketable, otherwise rests from the next bar")
+    {
+        OrderBook book;
+        const auto SLOT = book.slotFor(AAA);
+        const auto SL = book.submit(Order{AAA, Side::Buy, 1.0, OrderType::StopLimit, 101.0, 102.0});
+        std::vector<Fill> fills;
+
+        // Gaps above the limit: triggered but not filled
+        book.onBar(SLOT, Quote{1, 104.0, 105.0, 100.0, 104.0, 0}, fills);
+        CHECK(fills.empty());
+        CHECK(book.status(SL) == OrderStatus::Active);
+
+        book.onBar(SLOT, Quote{2, 103.0, 103.5, 100.5, 101.0, 0}, fills);
+        REQUIRE(fills.size() == 1);
+        CHECK(fills[0].price_ == doctest::Approx(101.0));
+        CHECK(fills[0].type_ == OrderType::StopLimit);
+        CHECK(book.status(SL) == OrderStatus::Filled);
+    }
+
+    TEST_CASE("Cancelled orders never fill; equal prices fill in submission order")
+    {
+        OrderBook book;
+        const auto SLOT = book.slotFor(AAA);
+        std::vector<OrderId> ids;
+        for (int i = 0; i < 200; ++i)
+            ids.push_back(book.submit(limit(Side::Buy, 90.0)));
+        for (int i = 0; i < 200; i += 2)
+            CHECK(book.cancel(ids[i]));
+        CHECK_FALSE(book.cancel(ids[0]));
+        CHECK(book.cancel(ids[1])); // majority stale: compacts the heaps
+        CHECK(book.openOrders() == 99);
+
+        std::vector<Fill> fills;
+        book.onBar(SLOT, Quote{1, 91.0, 92.0, 89.0, 90.0, 0}, fills);
+        REQUIRE(fills.size() == 99);
+        for (std::size_t k = 0; k < fills.size(); ++k)
+            CHECK(fills[k].id_ == ids[2 * k + 3]);
+        CHECK(book.openOrders() == 0);
+    }
+}
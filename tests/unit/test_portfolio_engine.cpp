@@ -0,0 +1,216 @@
+#include "doctest.h"
+#include "domain/Instrument.hpp"
+#include "domain/backtest/BarPanel.hpp"
+#include "domain/backtest/PortfolioEngine.hpp"
+#include "strategy/BuyHold.hpp"
+#include "strategy/IOrderStrategy.hpp"
+#include "strategy/MACrossover.hpp"
+#include "test_helpers.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain;
+using namespace qga::domain::backtest;
+
+static Instrument equity(const char* sym) { return Instrument{sym, AssetClass::Equity, "XNAS"}; }
+
+static std::unique_ptr<qga::strategy::IStrategy> buyHold(std::size_t)
+{
+    return std::make_unique<qga::strategy::BuyHold>();
+}
+
+namespace
+{
+    /// Buys `levels` rungs below the first close; each fill re-arms the other side one step away.
+    class Grid : public qga::strategy::IOrderStrategy
+    {
+      public:
+        Grid(double step, int levels, int* fills = nullptr)
+            : step_(step), levels_(levels), fills_(fills)
+        {
+        }
+
+        void onBar(const Quote& q, qga::strategy::OrderSink& orders) override
+        {
+            if (placed_)
+                return;
+            for (int k = 1; k <= levels_; ++k)
+                orders.limit(Side::Buy, 1.0, q.close_ - k * step_);
+            placed_ = true;
+        }
+
+        void onFill(qga::strategy::OrderTicket, Side side, double price, double qty,
+                    qga::strategy::OrderSink& orders) override
+        {
+            if (fills_)
+                ++*fills_;
+            orders.limit(side == Side::Buy ? Side::Sell : Side::Buy, qty,
+                         side == Side::Buy ? price + step_ : price - step_);
+        }
+
+      private:
+        double step_;
+        int levels_;
+        int* fills_;
+        bool placed_ = false;
+    };
+
+    BarSeries ohlcSeries(const std::vector<Quote>& bars)
+    {
+        BarSeries s;
+        for (const auto& q : bars)
+            s.add(q);
+        return s;
+    }
+} // namespace
+
+TEST_SUITE("Backtest/PortfolioEngine")
+{
+    TEST_CASE("Single instrument buy and hold is sized by equity fraction")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({100, 110, 120})};
+        BarPanel panel{series};
+
+        PortfolioEngine eng{10'000.0, ExecParams{}, SizingParams{0.5}};
+        auto res = eng.run(panel, {equity("AAPL")}, buyHold);
+
+        // 50 units bought at 100, closed at 120 -> +1000
+        REQUIRE(res.trades_.size() == 2);
+        CHECK(res.trades_[0].side() == Side::Buy);
+        CHECK(res.trades_[0].quantity() == doctest::Approx(50.0));
+        CHECK(res.trades_[1].side() == Side::Sell);
+        CHECK(res.trades_[1].price() == doctest::Approx(120.0));
+        CHECK(res.summary_.trades_executed_ == 1);
+        CHECK(res.summary_.final_equity_ == doctest::Approx(11'000.0));
+    }
+
+    TEST_CASE("Trades across instruments share one account")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({100, 100, 200}),
+                                      testlib::makeSeries({50, 25}, 60'000)};
+        BarPanel panel{series};
+
+        PortfolioEngine eng{10'000.0, ExecParams{1.0, 0.0, 0.0}, SizingParams{0.2}};
+        auto res = eng.run(panel, {equity("AAA"), equity("BBB")}, buyHold);
+
+        // AAA: 20 @100 -> 200 (+2000); BBB sized on equity after AAA's fee: 39 @50 -> 25 (-975)
+        CHECK(res.summary_.trades_executed_ == 2);
+        REQUIRE(res.trades_.size() == 4);
+        CHECK(res.trades_[1].quantity() == doctest::Approx(39.0));
+        CHECK(res.summary_.final_equity_ == doctest::Approx(10'000.0 + 2000.0 - 975.0 - 4.0));
+    }
+
+    TEST_CASE("Entries are capped by available cash")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({100, 100})};
+        BarPanel panel{series};
+
+        PortfolioEngine eng{1'000.0, ExecParams{10.0, 0.0, 0.0}, SizingParams{1.0}};
+        auto res = eng.run(panel, {equity("AAPL")}, buyHold);
+
+        REQUIRE_FALSE(res.trades_.empty());
+        // 10 units + fee would exceed cash
+        CHECK(res.trades_[0].quantity() == doctest::Approx(9.0));
+    }
+
+    TEST_CASE("Trade log is reserved up front")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({5, 4, 3, 4, 5, 6, 5, 4, 3})};
+        BarPanel panel{series};
+
+        PortfolioEngine eng{10'000.0, ExecParams{}, SizingParams{0.1, 16}};
+        auto res =
+            eng.run(panel, {equity("AAPL")},
+                    [](std::size_t) { return std::make_unique<qga::strategy::MACrossover>(3, 5); });
+        CHECK(res.trades_.capacity() >= 16);
+        CHECK(res.summary_.trades_executed_ >= 1);
+    }
+
+    TEST_CASE("Instrument count must match the panel")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({1, 2})};
+        BarPanel panel{series};
+        CHECK_THROWS_AS(PortfolioEngine{}.run(panel, {}, buyHold), std::invalid_argument);
+    }
+
+    TEST_CASE("Grid strategy works resting orders through the shared book")
+    {
+        // {ts, open, high, low, close, volume}
+        std::vector<BarSeries> series{ohlcSeries({{0, 100, 100, 100, 100, 0},
+                                                  {60'000, 100, 100, 98.5, 99, 0},
+                                                  {120'000, 99, 100.5, 99, 100, 0}})};
+        BarPanel panel{series};
+
+        int fills = 0;
+        PortfolioEngine eng{10'000.0};
+        auto res = eng.run(panel, {equity("AAPL")},
+                           [&](std::size_t) { return std::make_unique<Grid>(1.0, 2, &fills); });
+
+        // bar 1: buy limit 99 fills, arms a sell at 100; bar 2: that sell fills, and the
+        // buy re-armed at 99 rests until the next bar although bar 2 traded there.
+        REQUIRE(res.trades_.size() == 2);
+        CHECK(res.trades_[0].side() == Side::Buy);
+        CHECK(res.trades_[0].price() == doctest::Approx(99.0));
+        CHECK(res.trades_[0].order().type() == OrderType::Limit);
+        CHECK(res.trades_[1].side() == Side::Sell);
+        CHECK(res.trades_[1].price() == doctest::Approx(100.0));
+        CHECK(fills == 2);
+        CHECK(res.summary_.trades_executed_ == 1);
+        CHECK(res.summary_.final_equity_ == doctest::Approx(10'001.0));
+    }
+
+    TEST_CASE("Order fills are limited to cash and holdings; open positions are closed out")
+    {
+        std::vector<BarSeries> series{ohlcSeries({{0, 100, 100, 100, 100, 0},
+                                                  {60'000, 100, 100, 97, 97, 0},
+                                                  {120'000, 97, 97, 96, 96, 0}})};
+        BarPanel panel{series};
+
+        // 150 cash: only the first rung (99) is affordable; its sell at 100 never trades.
+        PortfolioEngine eng{150.0};
+        auto res = eng.run(panel, {equity("AAPL")},
+                           [](std::size_t) { return std::make_unique<Grid>(1.0, 2); });
+
+        REQUIRE(res.trades_.size() == 2);
+        CHECK(res.trades_[0].price() == doctest::Approx(99.0));
+        CHECK(res.trades_[1].side() == Side::Sell);
+        CHECK(res.trades_[1].price() == doctest::Approx(96.0));
+        CHECK(res.summary_.final_equity_ == doctest::Approx(150.0 - 3.0));
+    }
+
+    TEST_CASE("Volume fill model caps entries by participation and carries the remainder")
+    {
+        // {ts, open, high, low, close, volume}: 100 units traded per bar
+        std::vector<BarSeries> series{ohlcSeries({{0, 100, 100, 100, 100, 100},
+                                                  {60'000, 100, 100, 100, 100, 100},
+                                                  {120'000, 110, 110, 110, 110, 100},
+                                                  {180'000, 120, 120, 120, 120, 100},
+                                                  {240'000, 130, 130, 130, 130, 100}})};
+        BarPanel panel{series};
+
+        // 25 units wanted at the first close; at most 10 per bar from the next bar on.
+        PortfolioEngine eng{10'000.0, ExecParams{}, SizingParams{0.25}, VolumeFillParams{0.1, 0.0}};
+        auto res = eng.run(panel, {equity("AAPL")}, buyHold);
+
+        REQUIRE(res.trades_.size() == 4);
+        CHECK(res.trades_[0].quantity() == doctest::Approx(10.0));
+        CHECK(res.trades_[0].price() == doctest::Approx(100.0));
+        CHECK(res.trades_[1].quantity() == doctest::Approx(10.0));
+        CHECK(res.trades_[1].price() == doctest::Approx(110.0));
+        CHECK(res.trades_[2].quantity() == doctest::Approx(5.0));
+        CHECK(res.trades_[2].price() == doctest::Approx(120.0));
+        CHECK(res.trades_[3].side() == Side::Sell);
+        CHECK(res.trades_[3].quantity() == doctest::Approx(25.0));
+        CHECK(res.summary_.trades_executed_ == 1);
+        CHECK(res.summary_.final_equity_
+              == doctest::Approx(10'000.0 + 10 * 30.0 + 10 * 20.0 + 5 * 10.0));
+
+        // Without the model the same entry fills in full at the first close.
+        auto full = PortfolioEngine{10'000.0, ExecParams{}, SizingParams{0.25}}.run(
+            panel, {equity("AAPL")}, buyHold);
+        REQUIRE(full.trades_.size() == 2);
+        CHECK(full.trades_[0].quantity() == doctest::Approx(25.0));
+    }
+}
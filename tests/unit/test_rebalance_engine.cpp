@@ -0,0 +1,144 @@
+#include "doctest.h"
+#include "domain/backtest/BarPanel.hpp"
+#include "domain/backtest/RebalanceEngine.hpp"
+#include "strategy/EqualWeight.hpp"
+#include "test_helpers.hpp"
+
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain;
+using namespace qga::domain::backtest;
+
+namespace
+{
+    // Sets fixed weights on scheduled rows and holds otherwise.
+    class Scheduled final : public qga::strategy::IWeightStrategy
+    {
+      public:
+        explicit Scheduled(std::map<std::size_t, std::vector<double>> plan) : plan_(std::move(plan))
+        {
+        }
+        void onStart(std::size_t symbols) override
+        {
+            row_ = 0;
+            symbols_ = symbols;
+        }
+        bool targetWeights(std::int64_t, std::span<const double> prices,
+                           std::span<double> weights) override
+        {
+            last_prices_.assign(prices.begin(), prices.end());
+            const auto IT = plan_.find(row_++);
+            if (IT == plan_.end())
+                return false;
+            for (std::size_t s = 0; s < weights.size(); ++s)
+                weights[s] = IT->second[s];
+            return true;
+        }
+
+        std::size_t symbols_ = 0;
+        std::vector<double> last_prices_;
+
+      private:
+        std::map<std::size_t, std::vector<double>> plan_;
+        std::size_t row_ = 0;
+    };
+} // namespace
+
+TEST_SUITE("Backtest/RebalanceEngine")
+{
+    TEST_CASE("Equal weight on flat prices keeps equity and splits holdings")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({100, 100, 100}),
+                                      testlib::makeSeries({50, 50, 50})};
+        const BarPanel PANEL{series};
+        qga::strategy::EqualWeight ew{1};
+        const auto R = RebalanceEngine{10'000.0}.run(PANEL, ew);
+
+        REQUIRE(R.holdings_.size() == 2);
+        CHECK(R.holdings_[0] == doctest::Approx(50.0));
+        CHECK(R.holdings_[1] == doctest::Approx(100.0));
+        CHECK(R.rebalances_ == 3);
+        CHECK(R.summary_.trades_executed_ == 2); // later rebalances have nothing to do
+        CHECK(R.summary_.final_equity_ == doctest::Approx(10'000.0));
+        CHECK(R.summary_.equity_curve_.size() == 3);
+        CHECK(R.turnover_ == doctest::Approx(1.0));
+        CHECK_THROWS_AS(qga::strategy::EqualWeight{0}, std::invalid_argument);
+    }
+
+    TEST_CASE("Holdings follow prices between rebalances")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({100, 150, 200}),
+                                      testlib::makeSeries({100, 100, 50})};
+        const BarPanel PANEL{series};
+        Scheduled plan{{{0, {0.5, 0.5}}}};
+        const auto R = RebalanceEngine{1'000.0}.run(PANEL, plan);
+
+        CHECK(plan.symbols_ == 2);
+        const auto& eq = R.summary_.equity_curve_;
+        REQUIRE(eq.size() == 3);
+        CHECK(eq[0] == doctest::Approx(1'000.0));
+        CHECK(eq[1] == doctest::Approx(1'250.0));
+        CHECK(eq[2] == doctest::Approx(1'250.0));
+        CHECK(R.summary_.returns_[1] == doctest::Approx(0.25));
+        CHECK(R.summary_.final_equity_ == doctest::Approx(1'250.0));
+        CHECK(R.summary_.max_drawdown_ == doctest::Approx(0.0));
+    }
+
+    TEST_CASE("Slippage and commission are charged per traded symbol")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({100, 100})};
+        const BarPanel PANEL{series};
+        const ExecParams EXEC{1.0, 5.0, 10.0}; // fixed 1, 5 bps commission, 10 bps slippage
+        Scheduled plan{{{0, {1.0}}}};
+        const auto R = RebalanceEngine{10'000.0, EXEC}.run(PANEL, plan);
+
+        const double BUY_COST = 10'000.0 * (0.001 + 0.0005 * 1.001) + 1.0;
+        CHECK(R.costs_ == doctest::Approx(BUY_COST));
+        CHECK(R.summary_.equity_curve_[0] == doctest::Approx(10'000.0 - BUY_COST));
+
+        const double SELL_PX = 100.0 * 0.999;
+        const double SELL = 100.0 * SELL_PX - (1.0 + 0.0005 * 100.0 * SELL_PX);
+        CHECK(R.summary_.final_equity_ == doctest::Approx(-BUY_COST + SELL));
+    }
+
+    TEST_CASE("Symbols without a bar are not traded until they trade")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({10, 10, 10}),
+                                      testlib::makeSeries({20, 20}, 60'000)};
+        const BarPanel PANEL{series};
+        Scheduled plan{{{0, {0.5, 0.5}}, {1, {0.5, 0.5}}}};
+        const auto R = RebalanceEngine{1'000.0}.run(PANEL, plan);
+
+        CHECK(R.summary_.trades_executed_ == 2);
+        CHECK(R.holdings_[0] == doctest::Approx(50.0));
+        CHECK(R.holdings_[1] == doctest::Approx(25.0));
+        REQUIRE(plan.last_prices_.size() == 2);
+        CHECK(plan.last_prices_[1] == 20.0);
+    }
+
+    TEST_CASE("Short weights profit from falling prices")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({100, 80})};
+        const BarPanel PANEL{series};
+        Scheduled plan{{{0, {-0.5}}}};
+        const auto R = RebalanceEngine{1'000.0}.run(PANEL, plan);
+        CHECK(R.holdings_[0] == doctest::Approx(-5.0));
+        CHECK(R.summary_.final_equity_ == doctest::Approx(1'100.0));
+    }
+
+    TEST_CASE("No-trade band suppresses small adjustments")
+    {
+        std::vector<BarSeries> series{testlib::makeSeries({100, 101, 102, 130}),
+                                      testlib::makeSeries({100, 99, 98, 70})};
+        const BarPanel PANEL{series};
+        qga::strategy::EqualWeight a{1}, b{1};
+        const auto EVERY = RebalanceEngine{10'000.0}.run(PANEL, a);
+        const auto BANDED = RebalanceEngine{10'000.0, {}, RebalanceParams{0.05}}.run(PANEL, b);
+        CHECK(EVERY.summary_.trades_executed_ == 8);
+        CHECK(BANDED.summary_.trades_executed_ == 4);
+        CHECK(BANDED.turnover_ < EVERY.turnover_);
+    }
+}
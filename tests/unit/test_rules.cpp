@@ -0,0 +1,182 @@
+#include "doctest.h"
+#include "domain/backtest/Engine.hpp"
+#include "strategy/MACrossover.hpp"
+#include "strategy/StateBlob.hpp"
+#include "strategy/rules/Rule.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace qga::strategy::rules;
+using qga::domain::Quote;
+using qga::strategy::Signal;
+
+namespace
+{
+    std::vector<Quote> randomBars(std::size_t n)
+    {
+        std::vector<Quote> out;
+        const auto CLOSES = testlib::randomWalk(n, 3, 0.03, 50.0);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double PX = CLOSES[i];
+            out.push_back({static_cast<std::int64_t>(i) * 60'000, PX, PX * 1.01, PX * 0.99, PX,
+                           1000.0 + double(i % 7)});
+        }
+        return out;
+    }
+
+    std::vector<Signal> streamed(qga::strategy::IStrategy& s, const std::vector<Quote>& bars)
+    {
+        std::vector<Signal> out;
+        s.onStart();
+        for (const auto& q : bars)
+            out.push_back(s.onBar(q));
+        return out;
+    }
+
+    std::string invalidMessage(std::string_view buy)
+    {
+        try
+        {
+            Rule::compile(buy);
+        }
+        catch (const std::invalid_argument& ex)
+        {
+            return ex.what();
+        }
+        return {};
+    }
+
+    const char* const BUY_MA = "sma(close, 10) crosses above sma(close, 50)";
+    const char* const SELL_MA = "sma(close,10) crosses below sma(close,50)";
+} // namespace
+
+TEST_SUITE("Strategy/Rules")
+{
+    TEST_CASE("An MA crossover rule reproduces MACrossover bar for bar")
+    {
+        const auto BARS = randomBars(3'001); // not a multiple of the block size
+        qga::strategy::MACrossover ma{10, 50};
+        const auto REF = streamed(ma, BARS);
+        CHECK(std::count(REF.begin(), REF.end(), Signal::Buy) > 5);
+
+        const auto RULE = std::make_shared<const Rule>(Rule::compile(BUY_MA, SELL_MA));
+        CHECK(RULE->evaluate(BARS) == REF);
+
+        RuleStrategy streaming{RULE};
+        CHECK(streamed(streaming, BARS) == REF);
+        RuleStrategy precomputed{RULE, BARS};
+        CHECK(streamed(precomputed, BARS) == REF);
+
+        qga::domain::backtest::BarSeries series;
+        for (const auto& q : BARS)
+            series.add(q);
+        qga::strategy::MACrossover ma2{10, 50};
+        RuleStrategy rs{BUY_MA, SELL_MA};
+        CHECK(qga::domain::backtest::Engine{10'000.0}.run(series, rs).final_equity_
+              == qga::domain::backtest::Engine{10'000.0}.run(series, ma2).final_equity_);
+    }
+
+    TEST_CASE("Precomputed signals reject bars from another series")
+    {
+        const auto BARS = randomBars(200);
+        auto other = BARS;
+        for (auto& q : other)
+            q.ts_ += 30'000;
+
+        RuleStrategy precomputed{std::make_shared<const Rule>(Rule::compile(BUY_MA, SELL_MA)),
+                                 BARS};
+        precomputed.onStart();
+        CHECK_THROWS_AS(precomputed.onBar(other.front()), std::invalid_argument);
+        CHECK_NOTHROW(precomputed.onBar(BARS.front()));
+    }
+
+    TEST_CASE("Common subexpressions are shared, comparisons normalised and constants folded")
+    {
+        const auto RULE = Rule::compile(BUY_MA, SELL_MA);
+        // close, sma10, sma50, crosses above, crosses below
+        CHECK(RULE.nodes().size() == 5);
+
+        // `a > b` is stored as `b < a`, so both sides are one node: close, sma10, lt, and,
+        // plus the constant 0 of the empty sell rule.
+        const auto SAME = Rule::compile("close > sma(close, 2 * 5) and sma(close, 10) < close");
+        CHECK(SAME.nodes().size() == 5);
+        // close, 2 (from 1 * 2), add, 3, sub, 0 (shared with the empty sell rule), lt
+        const auto FOLDED = Rule::compile("close + 1 * 2 - 3 > 0");
+        CHECK(FOLDED.nodes().size() == 7);
+        CHECK(FOLDED.toString().find("n1 = 2\n") != std::string::npos);
+
+        const auto NEVER = Rule::compile("", "close > 0");
+        const auto BARS = randomBars(10);
+        const auto S = NEVER.evaluate(BARS);
+        CHECK(std::all_of(S.begin(), S.end(), [](Signal s) { return s == Signal::Sell; }));
+    }
+
+    TEST_CASE("Oscillators, arithmetic and lag evaluate like their hand-written counterparts")
+    {
+        const auto BARS = randomBars(1'000);
+        const auto RULE =
+            Rule::compile("rsi(14) < 40 and close > lag(close, 3) * 0.99", "rsi(close, 14) > 60");
+        qga::strategy::indicators::Rsi rsi{14};
+        rsi.reset();
+        std::vector<Signal> ref;
+        for (std::size_t i = 0; i < BARS.size(); ++i)
+        {
+            const double R = rsi.update(BARS[i].close_);
+            const bool BUY = R < 40 && i >= 3 && BARS[i].close_ > BARS[i - 3].close_ * 0.99;
+            const bool SELL = R > 60;
+            ref.push_back(BUY == SELL ? Signal::None : (BUY ? Signal::Buy : Signal::Sell));
+        }
+        CHECK(RULE.evaluate(BARS) == ref);
+        CHECK(std::count(ref.begin(), ref.end(), Signal::Sell) > 10);
+    }
+
+    TEST_CASE("Streaming state survives a checkpoint")
+    {
+        const auto BARS = randomBars(800);
+        const auto RULE = std::make_shared<const Rule>(Rule::compile(
+            "ema(close, 12) crosses above wma(close, 30) or close < lowest(low, 20) * 1.01",
+            "atr(14) > 2 * stddev(close, 20) or close > highest(high, 40)"));
+        const auto REF = RULE->evaluate(BARS);
+
+        RuleStrategy first{RULE};
+        first.onStart();
+        for (std::size_t i = 0; i < 400; ++i)
+            CHECK(first.onBar(BARS[i]) == REF[i]);
+        qga::strategy::StateWriter w;
+        first.saveState(w);
+
+        RuleStrategy resumed{RULE};
+        resumed.onStart();
+        qga::strategy::StateReader r{w.bytes()};
+        resumed.loadState(r);
+        for (std::size_t i = 400; i < BARS.size(); ++i)
+            CHECK(resumed.onBar(BARS[i]) == REF[i]);
+
+        RuleStrategy other{"close > 0", ""};
+        qga::strategy::StateReader r2{w.bytes()};
+        CHECK_THROWS_AS(other.loadState(r2), std::invalid_argument);
+    }
+
+    TEST_CASE("Syntax and type errors name the offending column")
+    {
+        CHECK(invalidMessage("close >").find("column 8") != std::string::npos);
+        CHECK(invalidMessage("sma(close, 10)").find("condition") != std::string::npos);
+        CHECK(invalidMessage("close > 1 and 2").find("column 15") != std::string::npos);
+        CHECK(invalidMessage("foo(close) > 1").find("unknown name 'foo'") != std::string::npos);
+        CHECK(invalidMessage("sma(close, close) > 1").find("period") != std::string::npos);
+        CHECK(invalidMessage("sma(close, 2.5) > 1").find("period") != std::string::npos);
+        CHECK(invalidMessage("close crosses over open").find("above") != std::string::npos);
+        CHECK(invalidMessage("(close > 1").find("')'") != std::string::npos);
+        CHECK(invalidMessage("close > 1 )").find("unexpected") != std::string::npos);
+        CHECK_NOTHROW(
+            Rule::compile("not (close >= open) && !(volume != 0) || abs(-close) == close"));
+    }
+}
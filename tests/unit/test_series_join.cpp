@@ -0,0 +1,156 @@
+#include "doctest.h"
+#include "domain/backtest/SeriesJoin.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+
+namespace
+{
+    constexpr std::uint32_t NONE = AlignedRows::NO_MATCH;
+
+    BarSeries seriesAt(const std::vector<std::int64_t>& ts)
+    {
+        BarSeries s;
+        for (std::size_t i = 0; i < ts.size(); ++i)
+            s.add({ts[i], 1.0, 1.0, 1.0, 100.0 + static_cast<double>(i), 10.0});
+        return s;
+    }
+
+    /// Sorted timestamps: gaps of 1-3 steps, occasional duplicates.
+    std::vector<std::int64_t> randomClock(std::size_t n, std::int64_t step, std::uint64_t seed)
+    {
+        std::vector<std::int64_t> out;
+        testlib::Lcg rng{seed};
+        std::int64_t t = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            t += static_cast<std::int64_t>((rng.next() >> 40) % 4) * step; // 0 = duplicate
+            out.push_back(t);
+        }
+        return out;
+    }
+
+    // Reference: std::lower_bound / upper_bound per left row.
+    AlignedRows reference(const std::vector<std::int64_t>& l, const std::vector<std::int64_t>& r,
+                          const JoinOptions& opt)
+    {
+        AlignedRows out;
+        for (std::size_t i = 0; i < l.size(); ++i)
+        {
+            std::uint32_t m = NONE;
+            if (opt.kind_ == JoinKind::AsOf)
+            {
+                const auto IT = std::upper_bound(r.begin(), r.end(), l[i]);
+                if (IT != r.begin() && l[i] - *(IT - 1) <= opt.tolerance_)
+                    m = static_cast<std::uint32_t>(IT - 1 - r.begin());
+            }
+            else
+            {
+                const auto IT = std::lower_bound(r.begin(), r.end(), l[i]);
+                if (IT != r.end() && *IT == l[i])
+                    m = static_cast<std::uint32_t>(IT - r.begin());
+            }
+            if (opt.kind_ == JoinKind::Inner && m == NONE)
+                continue;
+            out.left_.push_back(static_cast<std::uint32_t>(i));
+            out.right_.push_back(m);
+        }
+        return out;
+    }
+} // namespace
+
+TEST_SUITE("Backtest/SeriesJoin")
+{
+    TEST_CASE("Inner, left and as-of semantics")
+    {
+        //                         0   1   2   3   4   5
+        const std::vector<std::int64_t> L{10, 20, 30, 30, 50, 70};
+        const std::vector<std::int64_t> R{5, 20, 30, 30, 45, 71};
+
+        const auto INNER = joinTimestamps(L, R, {JoinKind::Inner});
+        CHECK(INNER.left_ == std::vector<std::uint32_t>{1, 2, 3});
+        CHECK(INNER.right_ == std::vector<std::uint32_t>{1, 2, 2}); // first right row of a tie
+
+        const auto LEFT = joinTimestamps(L, R, {JoinKind::Left});
+        CHECK(LEFT.left_ == std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5});
+        CHECK(LEFT.right_ == std::vector<std::uint32_t>{NONE, 1, 2, 2, NONE, NONE});
+
+        const auto ASOF = joinTimestamps(L, R, {JoinKind::AsOf});
+        // last right row at or before
+        CHECK(ASOF.right_ == std::vector<std::uint32_t>{0, 1, 3, 3, 4, 4});
+
+        const auto FRESH = joinTimestamps(L, R, {JoinKind::AsOf, 5});
+        CHECK(FRESH.right_ == std::vector<std::uint32_t>{0, 1, 3, 3, 4, NONE});
+
+        CHECK(joinTimestamps({}, R).size() == 0);
+        CHECK(joinTimestamps(L, {}, {JoinKind::AsOf}).right_
+              == std::vector<std::uint32_t>(6, NONE));
+    }
+
+    TEST_CASE("Merge and search paths match the reference")
+    {
+        const auto MINUTES = randomClock(20'000, 60'000, 5);
+        const auto SPARSE = randomClock(300, 3'600'000, 9); // right > 16x left: search path
+        const auto OTHER = randomClock(18'000, 60'000, 7);  // comparable sizes: merge path
+        for (const JoinOptions OPT :
+             {JoinOptions{JoinKind::Inner}, JoinOptions{JoinKind::Left},
+              JoinOptions{JoinKind::AsOf}, JoinOptions{JoinKind::AsOf, 90'000}})
+        {
+            CAPTURE(static_cast<int>(OPT.kind_));
+            for (const auto* L : {&SPARSE, &OTHER, &MINUTES})
+            {
+                const auto GOT = joinTimestamps(*L, MINUTES, OPT);
+                const auto REF = reference(*L, MINUTES, OPT);
+                CHECK(GOT.left_ == REF.left_);
+                CHECK(GOT.right_ == REF.right_);
+            }
+            const auto BACK = joinTimestamps(MINUTES, SPARSE, OPT);
+            CHECK(BACK.right_ == reference(MINUTES, SPARSE, OPT).right_);
+        }
+    }
+
+    TEST_CASE("Batched pairs and aligned columns")
+    {
+        std::vector<BarSeries> universe;
+        for (std::uint64_t s = 0; s < 6; ++s)
+            universe.push_back(seriesAt(randomClock(500 + 40 * s, 60'000, 11 + s)));
+        std::vector<SeriesPair> pairs;
+        for (std::size_t a = 0; a < universe.size(); ++a)
+            for (std::size_t b = a + 1; b < universe.size(); ++b)
+                pairs.push_back({a, b});
+
+        const JoinOptions OPT{JoinKind::AsOf, 120'000};
+        for (const std::size_t THREADS : {1, 3})
+        {
+            const auto ALL = joinPairs(universe, pairs, OPT, THREADS);
+            REQUIRE(ALL.size() == pairs.size());
+            for (std::size_t k = 0; k < pairs.size(); ++k)
+            {
+                const auto ONE = join(universe[pairs[k].left_], universe[pairs[k].right_], OPT);
+                CHECK(ALL[k].left_ == ONE.left_);
+                CHECK(ALL[k].right_ == ONE.right_);
+            }
+        }
+
+        const auto A = seriesAt({10, 20, 30});
+        const auto B = seriesAt({20, 30, 40});
+        const auto ROWS = join(A, B, {JoinKind::Left});
+        const auto LC = alignedColumn(A, ROWS.left_);
+        const auto RC = alignedColumn(B, ROWS.right_);
+        CHECK(LC == std::vector<double>{100.0, 101.0, 102.0});
+        CHECK(std::isnan(RC[0]));
+        CHECK(RC[1] == 100.0);
+        CHECK(RC[2] == 101.0);
+        CHECK(alignedColumn(B, ROWS.right_, &qga::domain::Quote::volume_)[2] == 10.0);
+
+        const std::vector<SeriesPair> BAD{{0, 6}};
+        CHECK_THROWS_AS(joinPairs(universe, BAD), std::out_of_range);
+        CHECK_THROWS_AS(join(A, B, {JoinKind::AsOf, -1}), std::invalid_argument);
+    }
+}
@@ -0,0 +1,138 @@
+#include "doctest.h"
+#include "domain/backtest/Engine.hpp"
+#include "domain/backtest/SweepRunner.hpp"
+#include "strategy/BuyHold.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+
+namespace
+{
+    BarSeries fromCloses(const std::vector<double>& closes)
+    {
+        BarSeries s;
+        for (std::size_t i = 0; i < closes.size(); ++i)
+            s.add({static_cast<std::int64_t>(i), closes[i], closes[i], closes[i], closes[i], 1.0});
+        return s;
+    }
+
+    BarSeries rising(std::size_t n)
+    {
+        std::vector<double> c;
+        for (std::size_t i = 0; i < n; ++i)
+            c.push_back(100.0 + static_cast<double>(i));
+        return fromCloses(c);
+    }
+
+    class DelayedEntry final : public qga::strategy::IStrategy
+    {
+      public:
+        explicit DelayedEntry(int delay) : delay_(delay) {}
+        void onStart() override { bar_ = 0; }
+        qga::strategy::Signal onBar(const qga::domain::Quote&) override
+        {
+            return bar_++ == delay_ ? qga::strategy::Signal::Buy : qga::strategy::Signal::None;
+        }
+
+      private:
+        int delay_;
+        int bar_ = 0;
+    };
+} // namespace
+
+TEST_SUITE("Backtest/StopRules")
+{
+    TEST_CASE("Inactive rules leave the run untouched")
+    {
+        const auto S = rising(100);
+        qga::strategy::BuyHold a, b;
+        const auto PLAIN = Engine{1'000.0}.run(S, a);
+        const auto RULED = Engine{1'000.0, {}, StopRules{}}.run(S, b);
+        CHECK_FALSE(RULED.aborted_);
+        CHECK(RULED.bars_processed_ == 100);
+        CHECK(RULED.final_equity_ == PLAIN.final_equity_);
+        CHECK(std::isnan(RULED.checkpoint_equity_));
+    }
+
+    TEST_CASE("Max drawdown and equity floor abort at the offending bar")
+    {
+        // Account: 200 cash, buys 1 unit at 100, then the price collapses.
+        const auto S = fromCloses({100, 110, 120, 100, 80, 60, 40, 20});
+        qga::strategy::BuyHold bh;
+
+        StopRules dd;
+        dd.max_drawdown_ = 0.2;
+        const auto R = Engine{200.0, {}, dd}.run(S, bh);
+        CHECK(R.aborted_);
+        CHECK(R.stop_reason_ == StopReason::MaxDrawdown);
+        // Peak 220 at bar 2; 180 at bar 4 is an 18% drawdown, 160 at bar 5 is 27%.
+        CHECK(R.bars_processed_ == 6);
+        CHECK(R.final_equity_ == doctest::Approx(160.0));
+
+        StopRules floor;
+        floor.equity_floor_ = 190.0;
+        const auto F = Engine{200.0, {}, floor}.run(S, bh);
+        CHECK(F.stop_reason_ == StopReason::EquityFloor);
+        CHECK(F.bars_processed_ == 5);
+    }
+
+    TEST_CASE("Checkpoint records equity and prunes runs below its floor")
+    {
+        const auto S = rising(100);
+        StopRules cp;
+        cp.checkpoint_bar_ = 10;
+        DelayedEntry late{5};
+        const auto R = Engine{1'000.0, {}, cp}.run(S, late);
+        CHECK_FALSE(R.aborted_);
+        // bought at 105, marked at 109
+        CHECK(R.checkpoint_equity_ == doctest::Approx(1'000.0 + 4.0));
+
+        cp.checkpoint_floor_ = 1'010.0;
+        DelayedEntry again{5};
+        const auto P = Engine{1'000.0, {}, cp}.run(S, again);
+        CHECK(P.aborted_);
+        CHECK(P.stop_reason_ == StopReason::BehindBest);
+        CHECK(P.bars_processed_ == 10);
+    }
+
+    TEST_CASE("Sweep runner tightens the checkpoint floor as better runs finish")
+    {
+        const auto S = rising(200);
+        const std::vector<int> DELAYS{5, 0, 20, 30, 3, 40};
+        SweepParams sp;
+        sp.rules_.checkpoint_bar_ = 50;
+        sp.behind_best_ = 10.0;
+        sp.threads_ = 1;
+        const auto RES = SweepRunner{1'000.0, {}, sp}.run(
+            S.data(), DELAYS.size(),
+            [&](std::size_t i) { return std::make_unique<DelayedEntry>(DELAYS[i]); });
+
+        REQUIRE(RES.best_.has_value());
+        CHECK(*RES.best_ == 1);
+        CHECK(RES.aborted_ == 3);
+        CHECK(RES.results_[2].stop_reason_ == StopReason::BehindBest);
+        CHECK_FALSE(RES.results_[4].aborted_);
+        CHECK(RES.bars_processed_ == 3 * 200 + 3 * 50);
+
+        CHECK_THROWS_AS(SweepRunner(1'000.0, {}, SweepParams{StopRules{}, 5.0}),
+                        std::invalid_argument);
+    }
+
+    TEST_CASE("Sweep runner reports no best run when every run aborts")
+    {
+        const auto S = fromCloses({100, 90, 80, 70, 60});
+        SweepParams sp;
+        sp.rules_.max_drawdown_ = 0.01;
+        sp.threads_ = 1;
+        const auto RES = SweepRunner{200.0, {}, sp}.run(
+            S.data(), 3, [](std::size_t) { return std::make_unique<qga::strategy::BuyHold>(); });
+
+        CHECK(RES.aborted_ == 3);
+        CHECK_FALSE(RES.best_.has_value());
+    }
+}
@@ -34,6 +34,16 @@ TEST_SUITE("Strategies/MACrossover")
         // we don't assert PnL sign here; it's a logic smoke test
         CHECK(res.final_equity_ > 0.0);
     }
+
+    TEST_CASE("onBar works without onStart")
+    {
+        const auto S = testlib::makeSeries({5, 4, 3, 4, 5, 6, 5, 4, 3});
+        qga::strategy::MACrossover fresh{3, 5};
+        qga::strategy::MACrossover started{3, 5};
+        started.onStart();
+        for (const auto& q : S.data())
+            CHECK(fresh.onBar(q) == started.onBar(q));
+    }
 }
 
 static qga::domain::backtest::BarSeries makeSeries(const std::vector<double>& closes)
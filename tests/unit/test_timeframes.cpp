@@ -0,0 +1,261 @@
+#include "doctest.h"
+#include "domain/backtest/Engine.hpp"
+#include "domain/backtest/WarmupCache.hpp"
+#include "strategy/StateBlob.hpp"
+#include "strategy/Timeframe.hpp"
+#include "strategy/TimeframeFeed.hpp"
+#include "test_helpers.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::strategy;
+using qga::domain::Quote;
+
+namespace
+{
+    constexpr std::int64_t MINUTE = 60'000;
+
+    std::vector<Quote> minuteBars(std::size_t n, std::int64_t first_ts = 0)
+    {
+        std::vector<Quote> out;
+        const auto CLOSES = testlib::randomWalk(n, 11, 0.01);
+        double px = 100.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double NEXT = CLOSES[i];
+            out.push_back({first_ts + static_cast<std::int64_t>(i) * MINUTE, px,
+                           std::max(px, NEXT) + 0.1, std::min(px, NEXT) - 0.1, NEXT,
+                           1.0 + static_cast<double>(i % 7)});
+            px = NEXT;
+        }
+        return out;
+    }
+
+    struct Delivery
+    {
+        std::size_t index_;
+        Quote bar_;
+        std::int64_t at_; ///< Timestamp of the base bar whose onBar() followed.
+    };
+
+    // Buys above the last closed hourly close, sells below it.
+    class HourlyBias final : public IStrategy
+    {
+      public:
+        explicit HourlyBias(std::vector<Timeframe> tfs = {Timeframe::hours(1, MINUTE),
+                                                          Timeframe::minutes(15)})
+            : tfs_(std::move(tfs))
+        {
+        }
+
+        std::vector<Timeframe> timeframes() const override { return tfs_; }
+
+        void onStart() override
+        {
+            hour_close_ = std::nan("");
+            pending_.clear();
+        }
+
+        void onTimeframeBar(std::size_t index, const Quote& bar) override
+        {
+            pending_.push_back({index, bar, 0});
+            if (index == 0)
+                hour_close_ = bar.close_;
+        }
+
+        Signal onBar(const Quote& q) override
+        {
+            for (auto& d : pending_)
+                d.at_ = q.ts_;
+            log_.insert(log_.end(), pending_.begin(), pending_.end());
+            pending_.clear();
+            if (std::isnan(hour_close_))
+                return Signal::None;
+            return q.close_ > hour_close_ ? Signal::Buy : Signal::Sell;
+        }
+
+        void saveState(StateWriter& out) const override { out.put(hour_close_); }
+        void loadState(StateReader& in) override { hour_close_ = in.get<double>(); }
+
+        std::vector<Timeframe> tfs_;
+        double hour_close_ = std::nan("");
+        std::vector<Delivery> pending_;
+        std::vector<Delivery> log_;
+    };
+
+    // Naive reference: OHLCV of the bars in [start, start + period).
+    Quote aggregate(const std::vector<Quote>& bars, std::int64_t start, std::int64_t period)
+    {
+        Quote out{start, 0.0, -1e300, 1e300, 0.0, 0.0};
+        bool first = true;
+        for (const auto& q : bars)
+        {
+            if (q.ts_ < start || q.ts_ >= start + period)
+                continue;
+            if (first)
+                out.open_ = q.open_;
+            first = false;
+            out.high_ = std::max(out.high_, q.high_);
+            out.low_ = std::min(out.low_, q.low_);
+            out.close_ = q.close_;
+            out.volume_ += q.volume_;
+        }
+        return out;
+    }
+
+    void checkSame(const Quote& a, const Quote& b)
+    {
+        CHECK(a.ts_ == b.ts_);
+        CHECK(a.open_ == b.open_);
+        CHECK(a.high_ == b.high_);
+        CHECK(a.low_ == b.low_);
+        CHECK(a.close_ == b.close_);
+        CHECK(a.volume_ == doctest::Approx(b.volume_));
+    }
+} // namespace
+
+TEST_SUITE("Strategy/Timeframes")
+{
+    TEST_CASE("Resampler aggregates OHLCV and hands bars out once closed")
+    {
+        const auto BARS = minuteBars(125);
+        Resampler r{Timeframe::minutes(15)};
+        std::vector<std::pair<Quote, std::int64_t>> closed;
+        for (const auto& q : BARS)
+            r.update(q, [&](const Quote& bar) { closed.emplace_back(bar, q.ts_); });
+
+        // 125 minutes: 8 full quarters closed, the ninth (5 bars) still forming.
+        REQUIRE(closed.size() == 8);
+        for (std::size_t k = 0; k < closed.size(); ++k)
+        {
+            const std::int64_t START = static_cast<std::int64_t>(k) * 15 * MINUTE;
+            checkSame(closed[k].first, aggregate(BARS, START, 15 * MINUTE));
+            // delivered with the next period's first bar
+            CHECK(closed[k].second == START + 15 * MINUTE);
+        }
+        REQUIRE(r.forming() != nullptr);
+        checkSame(*r.forming(), aggregate(BARS, 120 * MINUTE, 15 * MINUTE));
+    }
+
+    TEST_CASE("A known base bar length closes the period with its last bar")
+    {
+        const auto BARS = minuteBars(60 * 3);
+        Resampler r{Timeframe::hours(1, MINUTE)};
+        std::vector<std::int64_t> at;
+        for (const auto& q : BARS)
+            r.update(q,
+                     [&](const Quote& bar)
+                     {
+                         CHECK(bar.ts_ + 60 * MINUTE == q.ts_ + MINUTE);
+                         at.push_back(q.ts_);
+                     });
+        CHECK(at == std::vector<std::int64_t>{59 * MINUTE, 119 * MINUTE, 179 * MINUTE});
+        CHECK(r.forming() == nullptr);
+    }
+
+    TEST_CASE("Gaps, negative timestamps and misuse")
+    {
+        // A period missing its last bars is closed by the next bar that arrives.
+        Resampler r{Timeframe::hours(1, MINUTE)};
+        std::vector<Quote> out;
+        const auto PUSH = [&](std::int64_t ts) {
+            r.update(Quote{ts, 1, 2, 0.5, 1.5, 1}, [&](const Quote& b) { out.push_back(b); });
+        };
+        PUSH(-30 * MINUTE); // period [-60, 0) minutes
+        PUSH(10 * MINUTE);  // closes it; starts [0, 60)
+        REQUIRE(out.size() == 1);
+        CHECK(out[0].ts_ == -60 * MINUTE);
+        PUSH(59 * MINUTE); // last minute: closes [0, 60) immediately
+        REQUIRE(out.size() == 2);
+        CHECK(out[1].ts_ == 0);
+        CHECK(out[1].volume_ == 2.0);
+        CHECK_THROWS_AS(PUSH(59 * MINUTE + 1), std::invalid_argument);
+
+        CHECK_THROWS_AS(Resampler{Timeframe{}}, std::invalid_argument);
+        CHECK_THROWS_AS(Resampler(Timeframe{MINUTE, 2 * MINUTE}), std::invalid_argument);
+    }
+
+    TEST_CASE("The engine delivers declared timeframes before the bar that closes them")
+    {
+        const auto BARS = minuteBars(60 * 8 + 30);
+        qga::domain::backtest::BarSeries series;
+        for (const auto& q : BARS)
+            series.add(q);
+
+        HourlyBias strat;
+        qga::domain::backtest::Engine engine;
+        const auto R = engine.run(series, strat);
+        CHECK(R.trades_executed_ > 0);
+
+        std::size_t hours = 0, quarters = 0;
+        for (const auto& d : strat.log_)
+        {
+            if (d.index_ == 0)
+            {
+                checkSame(d.bar_, aggregate(BARS, d.bar_.ts_, 60 * MINUTE));
+                CHECK(d.at_ == d.bar_.ts_ + 59 * MINUTE);
+                ++hours;
+            }
+            else
+            {
+                checkSame(d.bar_, aggregate(BARS, d.bar_.ts_, 15 * MINUTE));
+                CHECK(d.at_ == d.bar_.ts_ + 15 * MINUTE);
+                ++quarters;
+            }
+        }
+        CHECK(hours == 8);
+        CHECK(quarters == 33);
+
+        // A strategy without timeframes is not wrapped.
+        HourlyBias plain{std::vector<Timeframe>{}};
+        engine.run(series, plain);
+        CHECK(plain.log_.empty());
+    }
+
+    TEST_CASE("Forming bars survive checkpoints and warm-up snapshots")
+    {
+        const auto BARS = minuteBars(60 * 6);
+        qga::domain::backtest::Engine engine;
+        qga::domain::backtest::BarSeries full;
+        for (const auto& q : BARS)
+            full.add(q);
+        HourlyBias reference;
+        const auto FULL = engine.run(full, reference);
+
+        qga::domain::backtest::EngineCheckpoint cp;
+        HourlyBias resumed;
+        qga::domain::backtest::BacktestResult r;
+        for (const std::size_t CUT : {std::size_t{100}, std::size_t{217}, BARS.size()})
+        {
+            qga::domain::backtest::BarSeries part;
+            for (std::size_t i = 0; i < CUT; ++i)
+                part.add(BARS[i]);
+            r = engine.resume(part, resumed, cp);
+        }
+        CHECK(r.final_equity_ == doctest::Approx(FULL.final_equity_));
+        CHECK(r.trades_executed_ == FULL.trades_executed_);
+        CHECK(resumed.log_.size() == reference.log_.size());
+
+        // Warm up to minute 100 (mid-quarter, mid-hour), then run the rest from the snapshot.
+        qga::domain::backtest::WarmupCache cache;
+        HourlyBias scratch;
+        const auto STATE = cache.state({"hourly-bias", {}, 1}, BARS, 100 * MINUTE, scratch);
+        HourlyBias tail;
+        const std::span<const Quote> REST{BARS.data() + 100, BARS.size() - 100};
+        engine.runFrom(REST, tail, *STATE);
+        // 1 hour and 6 quarters closed before minute 100
+        REQUIRE(tail.log_.size() + 7 == reference.log_.size());
+        for (std::size_t i = 0; i < tail.log_.size(); ++i)
+            checkSame(tail.log_[i].bar_,
+                      reference.log_[reference.log_.size() - tail.log_.size() + i].bar_);
+
+        // The wrapper refuses state saved for a different number of timeframes.
+        HourlyBias one{std::vector<Timeframe>{Timeframe::hours(1)}};
+        TimeframeFeed feed{one};
+        StateReader in{*STATE};
+        CHECK_THROWS_AS(feed.loadState(in), std::invalid_argument);
+    }
+}
@@ -0,0 +1,143 @@
+#include "doctest.h"
+#include "domain/backtest/VolumeFillModel.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+using qga::domain::AssetClass;
+using qga::domain::Instrument;
+using qga::domain::Quote;
+
+namespace
+{
+    Quote bar(std::int64_t ts, double px, double volume, double range = 0.0)
+    {
+        return {ts, px, px + range / 2, px - range / 2, px, volume};
+    }
+} // namespace
+
+TEST_SUITE("Backtest/VolumeFillModel")
+{
+    const Instrument AAA{"AAA", AssetClass::Equity, "XNAS"};
+    const Instrument BBB{"BBB", AssetClass::Equity, "XNAS"};
+
+    TEST_CASE("Fills are capped by participation and remainders carry over")
+    {
+        VolumeFillModel m{{0.1, 0.0}};
+        const auto S = m.slotFor(AAA);
+        const auto ID = m.submit(S, Side::Buy, 250.0);
+        std::vector<Fill> fills;
+
+        m.onBar(S, bar(1, 100.0, 1'000.0), fills);
+        REQUIRE(fills.size() == 1);
+        CHECK(fills[0].quantity_ == doctest::Approx(100.0));
+        CHECK(fills[0].price_ == doctest::Approx(100.0));
+        CHECK(m.remaining(ID) == doctest::Approx(150.0));
+        CHECK(m.openOrders() == 1);
+
+        m.onBar(S, bar(2, 101.0, 500.0), fills);
+        m.onBar(S, bar(3, 102.0, 0.0), fills); // no volume, no fill
+        m.onBar(S, bar(4, 103.0, 10'000.0), fills);
+        REQUIRE(fills.size() == 3);
+        CHECK(fills[1].quantity_ == doctest::Approx(50.0));
+        CHECK(fills[2].quantity_ == doctest::Approx(100.0));
+        CHECK(fills[2].ts_ == 4);
+        CHECK(m.remaining(ID) == 0.0);
+        CHECK(m.filled(ID) == doctest::Approx(250.0));
+        CHECK(m.averagePrice(ID)
+              == doctest::Approx((100.0 * 100 + 50.0 * 101 + 100.0 * 103) / 250.0));
+        CHECK(m.openOrders() == 0);
+    }
+
+    TEST_CASE("Orders share the budget in submission order")
+    {
+        VolumeFillModel m{{0.5, 0.0}};
+        const auto S = m.slotFor(AAA);
+        const auto A = m.submit(S, Side::Buy, 30.0);
+        const auto B = m.submit(S, Side::Sell, 40.0);
+        const auto C = m.submit(S, Side::Buy, 10.0);
+        std::vector<Fill> fills;
+        m.onBar(S, bar(1, 50.0, 100.0), fills); // budget 50
+        REQUIRE(fills.size() == 2);
+        CHECK(fills[0].id_ == A);
+        CHECK(fills[1].id_ == B);
+        CHECK(fills[1].quantity_ == doctest::Approx(20.0));
+        CHECK(m.remaining(C) == 10.0);
+
+        CHECK(m.cancel(B));
+        CHECK_FALSE(m.cancel(B));
+        CHECK_FALSE(m.cancel(A));
+        fills.clear();
+        m.onBar(S, bar(2, 50.0, 100.0), fills);
+        REQUIRE(fills.size() == 1);
+        CHECK(fills[0].id_ == C);
+        CHECK(m.openOrders() == 0);
+    }
+
+    TEST_CASE("Square-root impact moves the price against the order")
+    {
+        VolumeFillModel m{{1.0, 0.5, 0.02}};
+        const auto S = m.slotFor(AAA);
+        m.submit(S, Side::Buy, 100.0);
+        m.submit(S, Side::Sell, 300.0);
+        std::vector<Fill> fills;
+        m.onBar(S, bar(1, 100.0, 400.0), fills);
+        REQUIRE(fills.size() == 2);
+        CHECK(fills[0].price_ == doctest::Approx(100.0 * (1.0 + 0.5 * 0.02 * std::sqrt(0.25))));
+        CHECK(fills[1].price_ == doctest::Approx(100.0 * (1.0 - 0.5 * 0.02 * 1.0)));
+
+        // Default volatility comes from the bar range; slippage is added on top.
+        VolumeFillModel r{{1.0, 1.0}, ExecParams{0.0, 0.0, 10.0}};
+        const auto T = r.slotFor(BBB);
+        r.submit(T, Side::Buy, 25.0);
+        fills.clear();
+        r.onBar(T, bar(1, 100.0, 100.0, 4.0), fills);
+        REQUIRE(fills.size() == 1);
+        CHECK(fills[0].price_ == doctest::Approx(100.0 * (1.0 + 0.04 * 0.5) * 1.001));
+    }
+
+    TEST_CASE("Instruments keep separate queues")
+    {
+        VolumeFillModel m{{0.1, 0.0}};
+        const auto A = m.submit(Order{AAA, Side::Buy, 5.0});
+        const auto B = m.submit(Order{BBB, Side::Sell, 5.0});
+        CHECK(m.slotFor(AAA) != m.slotFor(BBB));
+        std::vector<Fill> fills;
+        m.onBar(m.slotFor(AAA), bar(1, 10.0, 1'000.0), fills);
+        REQUIRE(fills.size() == 1);
+        CHECK(fills[0].id_ == A);
+        CHECK(m.remaining(B) == 5.0);
+    }
+
+    TEST_CASE("Long queues stay consistent across compaction")
+    {
+        VolumeFillModel m{{0.1, 0.0}};
+        const auto S = m.slotFor(AAA);
+        std::vector<OrderId> ids;
+        for (int i = 0; i < 200; ++i)
+            ids.push_back(m.submit(S, Side::Buy, 1.0));
+        std::vector<Fill> fills;
+        for (int t = 0; t < 20; ++t)
+            m.onBar(S, bar(t, 10.0, 30.0), fills); // 3 per bar
+        CHECK(fills.size() == 60);
+        CHECK(m.openOrders() == 140);
+        for (std::size_t i = 0; i < ids.size(); ++i)
+            CHECK(m.filled(ids[i]) == (i < 60 ? 1.0 : 0.0));
+    }
+
+    TEST_CASE("Invalid input is rejected")
+    {
+        CHECK_THROWS_AS(VolumeFillModel({0.0}), std::invalid_argument);
+        CHECK_THROWS_AS(VolumeFillModel({1.5}), std::invalid_argument);
+        CHECK_THROWS_AS(VolumeFillModel({0.1, -1.0}), std::invalid_argument);
+        VolumeFillModel m;
+        const auto S = m.slotFor(AAA);
+        CHECK_THROWS_AS(m.submit(S, Side::Buy, 0.0), std::invalid_argument);
+        CHECK_THROWS_AS(m.submit(S + 1, Side::Buy, 1.0), std::out_of_range);
+        CHECK_THROWS_AS(m.submit(Order{AAA, Side::Buy, 1.0, OrderType::Limit, 10.0, 0.0}),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(m.remaining(99), std::out_of_range);
+    }
+}
@@ -0,0 +1,149 @@
+#include "doctest.h"
+#include "domain/backtest/Engine.hpp"
+#include "domain/backtest/WalkForward.hpp"
+#include "strategy/MACrossover.hpp"
+#include "test_helpers.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+
+namespace
+{
+    BarSeries makeSeries(std::size_t bars)
+    {
+        BarSeries s;
+        const auto CLOSES = testlib::randomWalk(bars, 17, 0.04);
+        for (std::size_t i = 0; i < bars; ++i)
+            s.add({static_cast<std::int64_t>(i), CLOSES[i], CLOSES[i], CLOSES[i], CLOSES[i], 1.0});
+        return s;
+    }
+
+    const int FAST[] = {2, 3, 5, 8};
+    const int SLOW[] = {10, 15, 20};
+
+    std::unique_ptr<qga::strategy::IStrategy> makeMa(std::size_t p)
+    {
+        return std::make_unique<qga::strategy::MACrossover>(FAST[p % 4], SLOW[p / 4]);
+    }
+} // namespace
+
+TEST_SUITE("Backtest/WalkForward")
+{
+    TEST_CASE("Folds split by timestamp in rolling and anchored mode")
+    {
+        const auto S = makeSeries(100);
+        WalkForwardParams p{30, 10, WindowMode::Rolling, 1};
+        const auto ROLL = WalkForward::makeFolds(S.data(), p);
+        REQUIRE(ROLL.size() == 7);
+        CHECK(ROLL[0].train_begin_ == 0);
+        CHECK(ROLL[0].test_begin_ == 30);
+        CHECK(ROLL[0].test_end_ == 40);
+        CHECK(ROLL[6].train_begin_ == 60);
+        CHECK(ROLL[6].test_end_ == 100);
+
+        p.mode_ = WindowMode::Anchored;
+        const auto ANCH = WalkForward::makeFolds(S.data(), p);
+        REQUIRE(ANCH.size() == 7);
+        CHECK(ANCH[6].train_begin_ == 0);
+        CHECK(ANCH[6].train_end_ == 90);
+
+        CHECK_THROWS_AS(WalkForward(1'000.0, {}, WalkForwardParams{0, 10}), std::invalid_argument);
+    }
+
+    TEST_CASE("Picks the in-sample best and stitches the out-of-sample curve")
+    {
+        const auto S = makeSeries(2'000);
+        const WalkForwardParams P{600, 200, WindowMode::Rolling, 4};
+        const ExecParams EXEC{0.5, 2.0, 1.0};
+        const WalkForward WF{1'000.0, EXEC, P};
+        constexpr std::size_t PARAMS = 12;
+
+        const auto RES = WF.run(S, PARAMS, makeMa);
+        REQUIRE(RES.folds_.size() == 7);
+
+        const std::span<const qga::domain::Quote> BARS{S.data()};
+        double level = 1'000.0;
+        std::size_t points = 0;
+        for (const auto& fr : RES.folds_)
+        {
+            // Same choice as a sequential sweep
+            std::size_t best = 0;
+            double best_score = -1e300;
+            for (std::size_t k = 0; k < PARAMS; ++k)
+            {
+                auto strat = makeMa(k);
+                Engine e{1'000.0, EXEC};
+                const double SCORE =
+                    e.run(BARS.subspan(fr.fold_.train_begin_,
+                                       fr.fold_.train_end_ - fr.fold_.train_begin_),
+                          *strat)
+                        .final_equity_;
+                if (SCORE > best_score)
+                {
+                    best_score = SCORE;
+                    best = k;
+                }
+            }
+            CHECK(fr.best_param_ == best);
+            CHECK(fr.train_score_ == best_score);
+
+            points += fr.fold_.test_end_ - fr.fold_.test_begin_;
+            level += fr.test_.final_equity_ - 1'000.0;
+            CHECK(RES.oos_equity_[points - 1] == doctest::Approx(level));
+        }
+        CHECK(RES.oos_equity_.size() == points);
+        CHECK(RES.oos_ts_.front() == 600);
+
+        // Thread count does not change the outcome
+        const WalkForward SERIAL{1'000.0, EXEC,
+                                 WalkForwardParams{600, 200, WindowMode::Rolling, 1}};
+        const auto SEQ = SERIAL.run(S, PARAMS, makeMa);
+        CHECK(SEQ.oos_equity_ == RES.oos_equity_);
+    }
+
+    TEST_CASE("Test windows start with indicators warmed on the training window")
+    {
+        // Falls for 30 bars, then jumps: MA(2) crosses above MA(5) on the first test bar.
+        BarSeries s;
+        for (std::int64_t i = 0; i < 40; ++i)
+        {
+            const double PX =
+                i < 30 ? 100.0 - static_cast<double>(i) : 200.0 + static_cast<double>(i);
+            s.add({i, PX, PX, PX, PX, 1.0});
+        }
+        const auto MAKE = [](std::size_t)
+        { return std::make_unique<qga::strategy::MACrossover>(2, 5); };
+
+        const WalkForward WARM{1'000.0, {}, WalkForwardParams{30, 10, WindowMode::Rolling, 1}};
+        const auto RES = WARM.run(s, 1, MAKE);
+        REQUIRE(RES.folds_.size() == 1);
+        REQUIRE(RES.folds_[0].test_.trades_.size() == 1);
+        CHECK(RES.folds_[0].test_.trades_[0].entry_ts_ == 30);
+
+        const WalkForward COLD{
+            1'000.0, {}, WalkForwardParams{30, 10, WindowMode::Rolling, 1, false}};
+        CHECK(COLD.run(s, 1, MAKE).folds_[0].test_.trades_executed_ == 0);
+    }
+
+    TEST_CASE("Custom objective and worker exceptions propagate")
+    {
+        const auto S = makeSeries(300);
+        const WalkForward WF{1'000.0, {}, WalkForwardParams{100, 50, WindowMode::Anchored, 3}};
+
+        // Minimising trades picks a parameter set with the fewest entries
+        const auto RES =
+            WF.run(S, 12, makeMa, [](const BacktestResult& r) { return -r.trades_executed_; });
+        CHECK(RES.folds_.size() == 4);
+
+        CHECK_THROWS_AS(WF.run(S, 0, makeMa), std::invalid_argument);
+        CHECK_THROWS_AS(WF.run(S, 3,
+                               [](std::size_t) -> std::unique_ptr<qga::strategy::IStrategy>
+                               { throw std::runtime_error("boom"); }),
+                        std::runtime_error);
+    }
+}
@@ -0,0 +1,155 @@
+#include "doctest.h"
+#include "domain/backtest/Engine.hpp"
+#include "domain/backtest/WarmupCache.hpp"
+#include "strategy/MACrossover.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace qga::domain::backtest;
+using qga::strategy::MACrossover;
+using qga::strategy::Signal;
+
+namespace
+{
+    BarSeries wave(std::size_t n)
+    {
+        BarSeries s;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double PX = 100.0 + 10.0 * std::sin(static_cast<double>(i) * 0.05) + 0.01 * i;
+            s.add({static_cast<std::int64_t>(i) * 60, PX, PX, PX, PX, 1.0});
+        }
+        return s;
+    }
+
+    // Forwards to the inner strategy but trades only from `from` on.
+    class Muted final : public qga::strategy::IStrategy
+    {
+      public:
+        Muted(qga::strategy::IStrategy& inner, std::int64_t from) : inner_(inner), from_(from) {}
+        void onStart() override { inner_.onStart(); }
+        Signal onBar(const qga::domain::Quote& q) override
+        {
+            const auto SIG = inner_.onBar(q);
+            return q.ts_ < from_ ? Signal::None : SIG;
+        }
+
+      private:
+        qga::strategy::IStrategy& inner_;
+        std::int64_t from_;
+    };
+
+    class NoSnapshots final : public qga::strategy::IStrategy
+    {
+      public:
+        Signal onBar(const qga::domain::Quote&) override { return Signal::None; }
+    };
+
+    WarmupKey key(std::uint64_t series) { return {"MACrossover", {10.0, 50.0}, series}; }
+} // namespace
+
+TEST_SUITE("Backtest/WarmupCache")
+{
+    TEST_CASE("A warm start trades exactly like a full run muted before the start")
+    {
+        const auto S = wave(1'000);
+        const auto BARS = std::span<const qga::domain::Quote>{S.data()};
+        const std::size_t START = 400;
+        const auto TS = BARS[START].ts_;
+
+        WarmupCache cache;
+        MACrossover scratch{10, 50};
+        const auto STATE = cache.state(key(seriesFingerprint(BARS)), BARS, TS, scratch);
+
+        MACrossover warm{10, 50};
+        const auto R =
+            Engine{10'000.0}.runFrom(BARS.subspan(START), warm, *STATE, CaptureLevel::Full);
+
+        MACrossover inner{10, 50};
+        Muted muted{inner, TS};
+        const auto REF = Engine{10'000.0}.run(BARS, muted, CaptureLevel::Full);
+
+        CHECK(R.trades_executed_ == REF.trades_executed_);
+        CHECK(R.trades_executed_ > 0);
+        CHECK(R.final_equity_ == doctest::Approx(REF.final_equity_));
+        REQUIRE(R.trades_.size() == REF.trades_.size());
+        CHECK(R.trades_.front().entry_ts_ == REF.trades_.front().entry_ts_);
+    }
+
+    TEST_CASE("Later snapshots continue from the latest earlier one")
+    {
+        const auto S = wave(1'000);
+        const auto BARS = std::span<const qga::domain::Quote>{S.data()};
+        const auto K = key(seriesFingerprint(BARS));
+        WarmupCache cache;
+        MACrossover scratch{10, 50};
+
+        const auto A = cache.state(K, BARS, BARS[300].ts_, scratch);
+        const auto B = cache.state(K, BARS, BARS[700].ts_, scratch);
+        const auto AGAIN = cache.state(K, BARS, BARS[300].ts_, scratch);
+
+        const auto ST = cache.stats();
+        CHECK(ST.misses_ == 1);
+        CHECK(ST.extended_ == 1);
+        CHECK(ST.hits_ == 1);
+        CHECK(ST.bars_fed_ == 700);
+        CHECK(AGAIN == A);
+        CHECK(cache.find(K, BARS[700].ts_) == B);
+        CHECK(cache.find(K, BARS[701].ts_) == nullptr);
+
+        // Same bytes as a cold warm-up straight to bar 700.
+        WarmupCache cold;
+        MACrossover other{10, 50};
+        CHECK(*cold.state(K, BARS, BARS[700].ts_, other) == *B);
+    }
+
+    TEST_CASE("Keys separate parameters and series")
+    {
+        const auto S = wave(500);
+        const auto BARS = std::span<const qga::domain::Quote>{S.data()};
+        WarmupCache cache;
+        MACrossover a{10, 50}, b{5, 50};
+        const auto TS = BARS[200].ts_;
+        cache.state({"MACrossover", {10.0, 50.0}, 1}, BARS, TS, a);
+        cache.state({"MACrossover", {5.0, 50.0}, 1}, BARS, TS, b);
+        cache.state({"MACrossover", {10.0, 50.0}, 2}, BARS, TS, a);
+        CHECK(cache.size() == 3);
+        CHECK(cache.stats().misses_ == 3);
+    }
+
+    TEST_CASE("Oldest snapshots are evicted beyond the budget")
+    {
+        const auto S = wave(500);
+        const auto BARS = std::span<const qga::domain::Quote>{S.data()};
+        const auto K = key(7);
+        WarmupCache cache{2};
+        MACrossover scratch{10, 50};
+        for (std::size_t i : {100u, 200u, 300u})
+            cache.state(K, BARS, BARS[i].ts_, scratch);
+        CHECK(cache.size() == 2);
+        CHECK(cache.find(K, BARS[100].ts_) == nullptr);
+        CHECK(cache.find(K, BARS[300].ts_) != nullptr);
+
+        cache.clear();
+        CHECK(cache.size() == 0);
+        CHECK(cache.stats().misses_ == 0);
+        CHECK_THROWS_AS(WarmupCache{0}, std::invalid_argument);
+    }
+
+    TEST_CASE("Fingerprint tracks content and strategies must support snapshots")
+    {
+        auto s = wave(100);
+        const auto H = seriesFingerprint(s.data());
+        CHECK(H == seriesFingerprint(wave(100).data()));
+        CHECK(H != seriesFingerprint(wave(101).data()));
+        s.add({100 * 60, 1.0, 1.0, 1.0, 1.0, 1.0});
+        CHECK(H != seriesFingerprint(s.data()));
+
+        WarmupCache cache;
+        NoSnapshots plain;
+        CHECK_THROWS_AS(cache.state(key(H), s.data(), 50 * 60, plain), std::logic_error);
+    }
+}
@@ -0,0 +1,112 @@
+#include "doctest.h"
+#include "core/WorkerPool.hpp"
+
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+
+using namespace qga::core;
+
+namespace
+{
+    // sh worker: reports "<task> r<task>" for each task of its chunk.
+    const std::string ECHO_TASKS =
+        "i=$0; while [ $i -lt $(( $0 + $1 )) ]; do echo \"$i r$i\"; i=$((i+1)); done";
+
+    WorkerPool::Command shell(const std::string& script)
+    {
+        return [script](std::size_t first, std::size_t count)
+        {
+            return std::vector<std::string>{"sh", "-c", script, std::to_string(first),
+                                            std::to_string(count)};
+        };
+    }
+
+    std::filesystem::path scratchDir(const char* name)
+    {
+        const auto DIR = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(DIR);
+        std::filesystem::create_directories(DIR);
+        return DIR;
+    }
+} // namespace
+
+TEST_SUITE("Core/WorkerPool")
+{
+    TEST_CASE("Every task result is streamed back exactly once")
+    {
+        std::map<std::size_t, std::string> got;
+        const auto STATS = WorkerPool{{2, 3}}.run(10, shell(ECHO_TASKS),
+                                                  [&](std::size_t t, std::string_view p) {
+                                                      CHECK(got.emplace(t, std::string{p}).second);
+                                                  });
+        REQUIRE(got.size() == 10);
+        for (std::size_t t = 0; t < 10; ++t)
+            CHECK(got[t] == "r" + std::to_string(t));
+        CHECK(STATS.launched_ == 4);
+        CHECK(STATS.failed_ == 0);
+    }
+
+    TEST_CASE("Tasks of a crashed worker are retried, reported ones are kept")
+    {
+        const auto DIR = scratchDir("qga_worker_pool_crash");
+        // The first chunk reports one task and then kills itself once.
+        const std::string SCRIPT = "if [ $0 -eq 0 ] && [ ! -f " + (DIR / "crashed").string()
+                                   + " ]; then touch " + (DIR / "crashed").string()
+                                   + "; echo \"0 first\"; kill -9 $$; fi; " + ECHO_TASKS;
+        std::map<std::size_t, std::string> got;
+        const auto STATS = WorkerPool{{2, 4}}.run(8, shell(SCRIPT),
+                                                  [&](std::size_t t, std::string_view p) {
+                                                      CHECK(got.emplace(t, std::string{p}).second);
+                                                  });
+        REQUIRE(got.size() == 8);
+        CHECK(got[0] == "first");
+        CHECK(got[3] == "r3");
+        CHECK(STATS.failed_ == 1);
+        CHECK(STATS.retried_tasks_ == 3);
+        CHECK(STATS.launched_ == 3);
+        std::filesystem::remove_all(DIR);
+    }
+
+    TEST_CASE("Incomplete output counts as a failure even with exit status 0")
+    {
+        const auto DIR = scratchDir("qga_worker_pool_short");
+        const std::string SCRIPT = "if [ ! -f " + (DIR / "once").string() + " ]; then touch "
+                                   + (DIR / "once").string() + "; exit 0; fi; " + ECHO_TASKS;
+        std::size_t results = 0;
+        const auto STATS = WorkerPool{{1, 5}}.run(
+            5, shell(SCRIPT), [&](std::size_t, std::string_view) { ++results; });
+        CHECK(results == 5);
+        CHECK(STATS.failed_ == 1);
+        std::filesystem::remove_all(DIR);
+    }
+
+    TEST_CASE("A task failing every attempt aborts the run")
+    {
+        CHECK_THROWS_AS(
+            WorkerPool({2, 2, 2}).run(4, shell("exit 1"), [](std::size_t, std::string_view) {}),
+            std::runtime_error);
+        const auto MISSING = [](std::size_t, std::size_t)
+        { return std::vector<std::string>{"qga-no-such-worker-binary"}; };
+        CHECK_THROWS_AS(WorkerPool({1, 1, 1}).run(1, MISSING, [](std::size_t, std::string_view) {}),
+                        std::runtime_error);
+        CHECK_THROWS_AS(WorkerPool({1, 1, 0}), std::invalid_argument);
+    }
+
+    TEST_CASE("Callback exceptions propagate")
+    {
+        CHECK_THROWS_AS(WorkerPool({2, 1}).run(4, shell(ECHO_TASKS),
+                                               [](std::size_t t, std::string_view)
+                                               {
+                                                   if (t == 2)
+                                                       throw std::logic_error("stop");
+                                               }),
+                        std::logic_error);
+    }
+}
+
+#endif